@@ -15,6 +15,8 @@
 
 #include "draco/attributes/attribute_octahedron_transform.h"
 
+#include <algorithm>
+
 #include "draco/attributes/attribute_transform_type.h"
 #include "draco/compression/attributes/normal_compression_utils.h"
 
@@ -54,31 +56,41 @@ std::unique_ptr<PointAttribute>
 AttributeOctahedronTransform::GeneratePortableAttribute(
     const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
     int num_points) const {
+  std::unique_ptr<PointAttribute> portable_attribute(new PointAttribute());
+  GeneratePortableAttribute(attribute, point_ids, num_points,
+                            portable_attribute.get());
+  return portable_attribute;
+}
+
+void AttributeOctahedronTransform::GeneratePortableAttribute(
+    const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
+    int num_points, PointAttribute *portable_attribute) const {
   DCHECK(is_initialized());
 
   // Allocate portable attribute.
   const int num_entries = point_ids.size();
-  std::unique_ptr<PointAttribute> portable_attribute =
-      InitPortableAttribute(num_entries, 2, num_points, attribute);
+  InitPortableAttribute(num_entries, 2, num_points, attribute,
+                        portable_attribute);
 
   // Quantize all values in the order given by point_ids into portable
   // attribute.
   int32_t *const portable_attribute_data = reinterpret_cast<int32_t *>(
       portable_attribute->GetAddress(AttributeValueIndex(0)));
-  float att_val[3];
-  int32_t dst_index = 0;
   const OctahedronToolBox converter(quantization_bits_);
-  for (uint32_t i = 0; i < point_ids.size(); ++i) {
-    const AttributeValueIndex att_val_id = attribute.mapped_index(point_ids[i]);
-    attribute.GetValue(att_val_id, att_val);
-    // Encode the vector into a s and t octahedral coordinates.
-    int32_t s, t;
-    converter.FloatVectorToQuantizedOctahedralCoords(att_val, &s, &t);
-    portable_attribute_data[dst_index++] = s;
-    portable_attribute_data[dst_index++] = t;
+  // Gather the vectors in small batches and encode each batch into s and t
+  // octahedral coordinates at once.
+  const int kBatchSize = 256;
+  float att_vals[kBatchSize * 3];
+  for (int i = 0; i < num_entries; i += kBatchSize) {
+    const int batch_size = std::min(kBatchSize, num_entries - i);
+    for (int j = 0; j < batch_size; ++j) {
+      const AttributeValueIndex att_val_id =
+          attribute.mapped_index(point_ids[i + j]);
+      attribute.GetValue(att_val_id, att_vals + 3 * j);
+    }
+    converter.FloatVectorsToQuantizedOctahedralCoords(
+        att_vals, batch_size, portable_attribute_data + 2 * i);
   }
-
-  return portable_attribute;
 }
 
 }  // namespace draco
@@ -51,6 +51,13 @@ class AttributeOctahedronTransform : public AttributeTransform {
       const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
       int num_points) const;
 
+  // Same as above but the portable attribute is generated into an existing
+  // |portable_attribute| whose memory is reused when possible.
+  void GeneratePortableAttribute(const PointAttribute &attribute,
+                                 const std::vector<PointIndex> &point_ids,
+                                 int num_points,
+                                 PointAttribute *portable_attribute) const;
+
  private:
   int32_t quantization_bits_;
 };
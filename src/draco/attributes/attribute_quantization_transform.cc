@@ -15,11 +15,21 @@
 //
 #include "draco/attributes/attribute_quantization_transform.h"
 
+#include <limits>
+
 #include "draco/attributes/attribute_transform_type.h"
 #include "draco/core/quantization_utils.h"
 
 namespace draco {
 
+namespace {
+
+// Maximum number of components of an attribute value (the number of
+// components is stored as int8_t).
+constexpr int kMaxNumComponents = std::numeric_limits<int8_t>::max();
+
+}  // namespace
+
 bool AttributeQuantizationTransform::InitFromAttribute(
     const PointAttribute &attribute) {
   const AttributeTransformData *const transform_data =
@@ -68,16 +78,16 @@ bool AttributeQuantizationTransform::ComputeParameters(
 
   const int num_components = attribute.num_components();
   range_ = 0.f;
-  min_values_ = std::vector<float>(num_components, 0.f);
-  const std::unique_ptr<float[]> max_values(new float[num_components]);
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
+  min_values_.assign(num_components, 0.f);
+  float max_values[kMaxNumComponents];
+  float att_val[kMaxNumComponents];
   // Compute minimum values and max value difference.
-  attribute.GetValue(AttributeValueIndex(0), att_val.get());
+  attribute.GetValue(AttributeValueIndex(0), att_val);
   attribute.GetValue(AttributeValueIndex(0), min_values_.data());
-  attribute.GetValue(AttributeValueIndex(0), max_values.get());
+  attribute.GetValue(AttributeValueIndex(0), max_values);
 
   for (AttributeValueIndex i(1); i < attribute.size(); ++i) {
-    attribute.GetValue(i, att_val.get());
+    attribute.GetValue(i, att_val);
     for (int c = 0; c < num_components; ++c) {
       if (min_values_[c] > att_val[c])
         min_values_[c] = att_val[c];
@@ -110,13 +120,22 @@ std::unique_ptr<PointAttribute>
 AttributeQuantizationTransform::GeneratePortableAttribute(
     const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
     int num_points) const {
+  std::unique_ptr<PointAttribute> portable_attribute(new PointAttribute());
+  GeneratePortableAttribute(attribute, point_ids, num_points,
+                            portable_attribute.get());
+  return portable_attribute;
+}
+
+void AttributeQuantizationTransform::GeneratePortableAttribute(
+    const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
+    int num_points, PointAttribute *portable_attribute) const {
   DCHECK(is_initialized());
 
   // Allocate portable attribute.
   const int num_entries = point_ids.size();
   const int num_components = attribute.num_components();
-  std::unique_ptr<PointAttribute> portable_attribute =
-      InitPortableAttribute(num_entries, num_components, num_points, attribute);
+  InitPortableAttribute(num_entries, num_components, num_points, attribute,
+                        portable_attribute);
 
   // Quantize all values using the order given by point_ids.
   int32_t *const portable_attribute_data = reinterpret_cast<int32_t *>(
@@ -125,17 +144,16 @@ AttributeQuantizationTransform::GeneratePortableAttribute(
   Quantizer quantizer;
   quantizer.Init(range(), max_quantized_value);
   int32_t dst_index = 0;
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
+  float att_val[kMaxNumComponents];
   for (uint32_t i = 0; i < point_ids.size(); ++i) {
     const AttributeValueIndex att_val_id = attribute.mapped_index(point_ids[i]);
-    attribute.GetValue(att_val_id, att_val.get());
+    attribute.GetValue(att_val_id, att_val);
     for (int c = 0; c < num_components; ++c) {
       const float value = (att_val[c] - min_values()[c]);
       const int32_t q_val = quantizer.QuantizeFloat(value);
       portable_attribute_data[dst_index++] = q_val;
     }
   }
-  return portable_attribute;
 }
 
 }  // namespace draco
@@ -43,6 +43,15 @@ class AttributeQuantizationTransform : public AttributeTransform {
   bool ComputeParameters(const PointAttribute &attribute,
                          const int quantization_bits);
 
+  // Returns the transform to the uninitialized state so that its parameters
+  // can be set or computed again, e.g. when the transform is reused for a new
+  // attribute.
+  void ClearParameters() {
+    quantization_bits_ = -1;
+    min_values_.clear();
+    range_ = 0.f;
+  }
+
   // Encode relevant parameters into buffer.
   bool EncodeParameters(EncoderBuffer *encoder_buffer) const;
 
@@ -57,6 +66,13 @@ class AttributeQuantizationTransform : public AttributeTransform {
       const PointAttribute &attribute, const std::vector<PointIndex> &point_ids,
       int num_points) const;
 
+  // Same as above but the portable attribute is generated into an existing
+  // |portable_attribute| whose memory is reused when possible.
+  void GeneratePortableAttribute(const PointAttribute &attribute,
+                                 const std::vector<PointIndex> &point_ids,
+                                 int num_points,
+                                 PointAttribute *portable_attribute) const;
+
  private:
   int32_t quantization_bits_;
 
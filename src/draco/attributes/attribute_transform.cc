@@ -24,18 +24,18 @@ bool AttributeTransform::TransferToAttribute(PointAttribute *attribute) const {
   return true;
 }
 
-std::unique_ptr<PointAttribute> AttributeTransform::InitPortableAttribute(
+void AttributeTransform::InitPortableAttribute(
     int num_entries, int num_components, int num_points,
-    const PointAttribute &attribute) const {
-  GeometryAttribute va;
-  va.Init(attribute.attribute_type(), nullptr, num_components, DT_INT32, false,
-          num_components * DataTypeLength(DT_INT32), 0);
-  std::unique_ptr<PointAttribute> portable_attribute(new PointAttribute(va));
+    const PointAttribute &attribute, PointAttribute *portable_attribute) const {
+  portable_attribute->Init(attribute.attribute_type(), nullptr, num_components,
+                           DT_INT32, false,
+                           num_components * DataTypeLength(DT_INT32), 0);
   portable_attribute->Reset(num_entries);
+  // Drop any point mapping left from the previous use of the attribute.
+  portable_attribute->SetIdentityMapping();
   if (num_points) {
     portable_attribute->SetExplicitMapping(num_points);
   }
-  return portable_attribute;
 }
 
 }  // namespace draco
@@ -36,9 +36,12 @@ class AttributeTransform {
   bool TransferToAttribute(PointAttribute *attribute) const;
 
  protected:
-  std::unique_ptr<PointAttribute> InitPortableAttribute(
-      int num_entries, int num_components, int num_points,
-      const PointAttribute &attribute) const;
+  // Initializes |portable_attribute| for storing |num_entries| transformed
+  // values of |attribute|. Any data stored in |portable_attribute| before the
+  // call is discarded but its memory is reused when possible.
+  void InitPortableAttribute(int num_entries, int num_components,
+                             int num_points, const PointAttribute &attribute,
+                             PointAttribute *portable_attribute) const;
 };
 
 }  // namespace draco
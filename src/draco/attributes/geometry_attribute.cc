@@ -47,7 +47,7 @@ void GeometryAttribute::Init(GeometryAttribute::Type attribute_type,
 bool GeometryAttribute::CopyFrom(const GeometryAttribute &src_att) {
   if (buffer_ == nullptr || src_att.buffer_ == nullptr)
     return false;
-  buffer_->Update(src_att.buffer_->data(), src_att.buffer_->data_size());
+  buffer_->Update(src_att.buffer()->data(), src_att.buffer()->data_size());
   num_components_ = src_att.num_components_;
   data_type_ = src_att.data_type_;
   normalized_ = src_att.normalized_;
@@ -104,7 +104,8 @@ class GeometryAttribute {
 
   inline const uint8_t *GetAddress(AttributeValueIndex att_index) const {
     const int64_t byte_pos = GetBytePos(att_index);
-    return buffer_->data() + byte_pos;
+    // Read-only access must not copy external buffer data.
+    return buffer()->data() + byte_pos;
   }
   inline uint8_t *GetAddress(AttributeValueIndex att_index) {
     const int64_t byte_pos = GetBytePos(att_index);
@@ -112,10 +113,13 @@ class GeometryAttribute {
   }
 
   // Fills out_data with the raw value of the requested attribute entry.
-  // out_data must be at least byte_stride_ long.
+  // out_data must be at least num_components_ * DataTypeLength(data_type_)
+  // long. Note that byte_stride_ can be larger when the values are interleaved
+  // with other data.
   void GetValue(AttributeValueIndex att_index, void *out_data) const {
     const int64_t byte_pos = byte_offset_ + byte_stride_ * att_index.value();
-    buffer_->Read(byte_pos, out_data, byte_stride_);
+    buffer_->Read(byte_pos, out_data,
+                  num_components_ * DataTypeLength(data_type_));
   }
 
   // DEPRECATED: Use
@@ -14,9 +14,7 @@
 //
 #include "draco/attributes/point_attribute.h"
 
-#include <unordered_map>
-
-using std::unordered_map;
+#include "draco/core/flat_hash_set.h"
 
 // Shortcut for typed conditionals.
 template <bool B, class T, class F>
@@ -64,6 +62,51 @@ bool PointAttribute::Reset(size_t num_attribute_values) {
   return true;
 }
 
+bool PointAttribute::ResetExternal(const void *data,
+                                   size_t num_attribute_values,
+                                   int64_t byte_stride) {
+  if (attribute_buffer_ == nullptr) {
+    attribute_buffer_ = std::unique_ptr<DataBuffer>(new DataBuffer());
+  }
+  const int64_t entry_size = DataTypeLength(data_type()) * num_components();
+  if (byte_stride == 0)
+    byte_stride = entry_size;
+  if (byte_stride < entry_size)
+    return false;
+  // The last value doesn't need to be followed by the padding.
+  const int64_t data_size =
+      num_attribute_values == 0
+          ? 0
+          : (num_attribute_values - 1) * byte_stride + entry_size;
+  attribute_buffer_->SetExternalData(data, data_size);
+  ResetBuffer(attribute_buffer_.get(), byte_stride, 0);
+  num_unique_entries_ = num_attribute_values;
+  return true;
+}
+
+void PointAttribute::SetAttributeValues(AttributeValueIndex first_entry,
+                                        int num_values, const void *values,
+                                        int64_t input_byte_stride) {
+  if (num_values <= 0)
+    return;
+  const int64_t stride = byte_stride();
+  if (input_byte_stride == 0)
+    input_byte_stride = stride;
+  const int64_t byte_pos = first_entry.value() * stride;
+  if (input_byte_stride == stride) {
+    // All values can be copied at once.
+    buffer()->Write(byte_pos, values, num_values * stride);
+    return;
+  }
+  const uint8_t *src = static_cast<const uint8_t *>(values);
+  uint8_t *dst = buffer()->data() + byte_pos;
+  for (int i = 0; i < num_values; ++i) {
+    memcpy(dst, src, stride);
+    src += input_byte_stride;
+    dst += stride;
+  }
+}
+
 #ifdef DRACO_ATTRIBUTE_DEDUPLICATION_SUPPORTED
 AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
     const GeometryAttribute &in_att) {
@@ -72,30 +115,43 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
 
 AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
     const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
+  return DeduplicateValues(in_att, in_att_offset, nullptr);
+}
+
+AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
   AttributeValueIndex::ValueType unique_vals = 0;
   switch (in_att.data_type()) {
     // Currently we support only float, uint8, and uint16 arguments.
     case DT_FLOAT32:
-      unique_vals = DeduplicateTypedValues<float>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<float>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT8:
-      unique_vals = DeduplicateTypedValues<int8_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int8_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT8:
     case DT_BOOL:
-      unique_vals = DeduplicateTypedValues<uint8_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint8_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT16:
-      unique_vals = DeduplicateTypedValues<uint16_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint16_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT16:
-      unique_vals = DeduplicateTypedValues<int16_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int16_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT32:
-      unique_vals = DeduplicateTypedValues<uint32_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint32_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT32:
-      unique_vals = DeduplicateTypedValues<int32_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int32_t>(in_att, in_att_offset, thread_pool);
       break;
     default:
       return -1;  // Unsupported data type.
@@ -110,18 +166,23 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
 // Returns the number of unique attribute values.
 template <typename T>
 AttributeValueIndex::ValueType PointAttribute::DeduplicateTypedValues(
-    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
   // Select the correct method to call based on the number of attribute
   // components.
   switch (in_att.num_components()) {
     case 1:
-      return DeduplicateFormattedValues<T, 1>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 1>(in_att, in_att_offset,
+                                              thread_pool);
     case 2:
-      return DeduplicateFormattedValues<T, 2>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 2>(in_att, in_att_offset,
+                                              thread_pool);
     case 3:
-      return DeduplicateFormattedValues<T, 3>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 3>(in_att, in_att_offset,
+                                              thread_pool);
     case 4:
-      return DeduplicateFormattedValues<T, 4>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 4>(in_att, in_att_offset,
+                                              thread_pool);
     default:
       return 0;
   }
@@ -129,7 +190,8 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateTypedValues(
 
 template <typename T, int num_components_t>
 AttributeValueIndex::ValueType PointAttribute::DeduplicateFormattedValues(
-    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
   // We want to detect duplicates using a hash map but we cannot hash floating
   // point numbers directly so bit-copy floats to the same sized integers and
   // hash them.
@@ -147,33 +209,41 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateFormattedValues(
   AttributeValueIndex unique_vals(0);
   typedef std::array<T, num_components_t> AttributeValue;
   typedef std::array<HashType, num_components_t> AttributeHashableValue;
-  // Hash map storing index of the first attribute with a given value.
-  unordered_map<AttributeHashableValue, AttributeValueIndex,
-                HashArray<AttributeHashableValue>>
-      value_to_index_map;
+  const auto get_value = [&in_att, in_att_offset](int i) {
+    // Convert the value to hashable type. Bit-copy real attributes to
+    // integers.
+    AttributeHashableValue hashable_value;
+    memcpy(&(hashable_value[0]),
+           in_att.GetAddress(AttributeValueIndex(i) + in_att_offset),
+           sizeof(hashable_value));
+    return hashable_value;
+  };
+  const auto value_hash = [](const AttributeHashableValue &value) {
+    uint64_t hash = 79;  // Magic number.
+    for (int c = 0; c < num_components_t; ++c) {
+      hash = MixHashBits(hash ^ value[c]);
+    }
+    return hash;
+  };
+  // Find the first attribute value equal to each value.
+  std::vector<int> first_values;
+  FindDuplicateKeys<AttributeHashableValue>(
+      num_unique_entries_, get_value, value_hash,
+      std::equal_to<AttributeHashableValue>(), thread_pool, &first_values);
+
   AttributeValue att_value;
-  AttributeHashableValue hashable_value;
   IndexTypeVector<AttributeValueIndex, AttributeValueIndex> value_map(
       num_unique_entries_);
   for (AttributeValueIndex i(0); i < num_unique_entries_; ++i) {
-    const AttributeValueIndex att_pos = i + in_att_offset;
-    att_value = in_att.GetValue<T, num_components_t>(att_pos);
-    // Convert the value to hashable type. Bit-copy real attributes to integers.
-    memcpy(&(hashable_value[0]), &(att_value[0]), sizeof(att_value));
-
-    // Check if the given attribute value has been used before already.
-    auto it = value_to_index_map.find(hashable_value);
-    if (it != value_to_index_map.end()) {
+    const AttributeValueIndex first_value(first_values[i.value()]);
+    if (first_value != i) {
       // Duplicated value found. Update index mapping.
-      value_map[i] = it->second;
+      value_map[i] = value_map[first_value];
     } else {
-      // New unique value.
-      // Update the hash map with a new entry pointing to the latest unique
-      // vertex index.
-      value_to_index_map.insert(
-          std::pair<AttributeHashableValue, AttributeValueIndex>(hashable_value,
-                                                                 unique_vals));
-      // Add the unique value to the mesh builder.
+      // New unique value. Note that the values are compacted in place when
+      // |in_att| is equal to |this|, but the value at |unique_vals| was
+      // already processed.
+      att_value = in_att.GetValue<T, num_components_t>(i + in_att_offset);
       SetAttributeValue(unique_vals, &att_value);
       // Update index mapping.
       value_map[i] = unique_vals;
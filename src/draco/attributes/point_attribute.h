@@ -22,6 +22,7 @@
 #include "draco/core/draco_index_type_vector.h"
 #include "draco/core/hash_utils.h"
 #include "draco/core/macros.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -45,6 +46,20 @@ class PointAttribute : public GeometryAttribute {
   // Prepares the attribute storage for the specified number of entries.
   bool Reset(size_t num_attribute_values);
 
+  // Makes the attribute use |num_attribute_values| values stored in external
+  // memory at |data| without copying them. Consecutive values are
+  // |byte_stride| bytes apart, or tightly packed when |byte_stride| is 0. The
+  // memory is not owned by the attribute and it must remain valid and
+  // unchanged while the attribute is used (e.g., until the geometry is
+  // encoded). Any modification of the attribute values first copies the
+  // external data into the attribute's own storage.
+  bool ResetExternal(const void *data, size_t num_attribute_values,
+                     int64_t byte_stride = 0);
+  // Returns true when the attribute values are stored in external memory.
+  bool is_external() const {
+    return attribute_buffer_ != nullptr && attribute_buffer_->is_external();
+  }
+
   size_t size() const { return num_unique_entries_; }
   AttributeValueIndex mapped_index(PointIndex point_index) const {
     if (identity_mapping_)
@@ -94,9 +109,18 @@ class PointAttribute : public GeometryAttribute {
   // cover all components of a single attribute entry.
   void SetAttributeValue(AttributeValueIndex entry_index, const void *value) {
     const int64_t byte_pos = entry_index.value() * byte_stride();
-    buffer()->Write(byte_pos, value, byte_stride());
+    buffer()->Write(byte_pos, value,
+                    num_components() * DataTypeLength(data_type()));
   }
 
+  // Sets |num_values| consecutive attribute entries starting at |first_entry|.
+  // The values are read from |values| where the consecutive values are
+  // |input_byte_stride| bytes apart. When |input_byte_stride| is 0, the values
+  // are expected to be tightly packed. The attribute must already have space
+  // for all the entries.
+  void SetAttributeValues(AttributeValueIndex first_entry, int num_values,
+                          const void *values, int64_t input_byte_stride = 0);
+
   // Same as GeometryAttribute::GetValue(), but using point id as the input.
   // Mapping to attribute value index is performed automatically.
   void GetMappedValue(PointIndex point_index, void *out_data) const {
@@ -114,6 +138,12 @@ class PointAttribute : public GeometryAttribute {
   // provided offset |in_att_offset|.
   AttributeValueIndex::ValueType DeduplicateValues(
       const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+
+  // Same as above but the duplicates are searched for on all threads of
+  // |thread_pool|. |thread_pool| can be nullptr.
+  AttributeValueIndex::ValueType DeduplicateValues(
+      const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+      ThreadPool *thread_pool);
 #endif
 
   // Set attribute transform data for the attribute. The data is used to store
@@ -131,10 +161,12 @@ class PointAttribute : public GeometryAttribute {
 #ifdef DRACO_ATTRIBUTE_DEDUPLICATION_SUPPORTED
   template <typename T>
   AttributeValueIndex::ValueType DeduplicateTypedValues(
-      const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+      const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+      ThreadPool *thread_pool);
   template <typename T, int COMPONENTS_COUNT>
   AttributeValueIndex::ValueType DeduplicateFormattedValues(
-      const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+      const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+      ThreadPool *thread_pool);
 #endif
 
   // Data storage for attribute values. GeometryAttribute itself doesn't own its
@@ -170,9 +202,9 @@ struct PointAttributeHasher {
       hash = HashCombine(indices_hash, hash);
     }
     if (attribute.attribute_buffer_ != nullptr) {
+      const DataBuffer *const buffer = attribute.attribute_buffer_.get();
       const uint64_t buffer_hash = FingerprintString(
-          reinterpret_cast<const char *>(attribute.attribute_buffer_->data()),
-          attribute.attribute_buffer_->data_size());
+          reinterpret_cast<const char *>(buffer->data()), buffer->data_size());
       hash = HashCombine(buffer_hash, hash);
     }
     return hash;
@@ -126,4 +126,54 @@ TEST_F(PointAttributeTest, TestArrayReadError) {
       (pa.GetValue<float, 3>(draco::AttributeValueIndex(5), &att_value)));
 }
 
+TEST_F(PointAttributeTest, TestExternalValues) {
+  // This test verifies that PointAttribute can read interleaved values from
+  // external memory and that the memory is copied before any modification.
+  draco::GeometryAttribute pos_att;
+  pos_att.Init(draco::GeometryAttribute::POSITION, nullptr, 3,
+               draco::DT_FLOAT32, false, 12, 0);
+  draco::PointAttribute pa(pos_att);
+  pa.SetIdentityMapping();
+  // Each position is followed by a value that is not part of the attribute.
+  float vertices[5][4];
+  for (int32_t i = 0; i < 5; ++i) {
+    vertices[i][0] = i * 3.f;
+    vertices[i][1] = (i * 3.f) + 1.f;
+    vertices[i][2] = (i * 3.f) + 2.f;
+    vertices[i][3] = -1.f;
+  }
+  ASSERT_TRUE(pa.ResetExternal(vertices, 5, sizeof(vertices[0])));
+  ASSERT_TRUE(pa.is_external());
+  ASSERT_EQ(pa.size(), 5);
+  const draco::PointAttribute &const_pa = pa;
+  ASSERT_EQ(const_pa.GetAddress(draco::AttributeValueIndex(1)),
+            reinterpret_cast<const uint8_t *>(vertices[1]));
+  for (int32_t i = 0; i < 5; ++i) {
+    float att_value[3];
+    pa.GetValue(draco::AttributeValueIndex(i), att_value);
+    ASSERT_FLOAT_EQ(att_value[0], i * 3.f);
+    ASSERT_FLOAT_EQ(att_value[1], (i * 3.f) + 1.f);
+    ASSERT_FLOAT_EQ(att_value[2], (i * 3.f) + 2.f);
+  }
+  ASSERT_TRUE(pa.is_external());
+  std::array<float, 3> att_value;
+  EXPECT_FALSE(
+      (pa.GetValue<float, 3>(draco::AttributeValueIndex(5), &att_value)));
+
+  // Modification of a value must not change the external memory.
+  const float new_value[3] = {7.f, 8.f, 9.f};
+  pa.SetAttributeValue(draco::AttributeValueIndex(2), new_value);
+  ASSERT_FALSE(pa.is_external());
+  ASSERT_FLOAT_EQ(vertices[2][0], 6.0);
+  EXPECT_TRUE(
+      (pa.GetValue<float, 3>(draco::AttributeValueIndex(2), &att_value)));
+  ASSERT_FLOAT_EQ(att_value[0], 7.0);
+  EXPECT_TRUE(
+      (pa.GetValue<float, 3>(draco::AttributeValueIndex(3), &att_value)));
+  ASSERT_FLOAT_EQ(att_value[0], 9.0);
+
+  // Stride smaller than the size of an entry is not valid.
+  ASSERT_FALSE(pa.ResetExternal(vertices, 5, 8));
+}
+
 }  // namespace
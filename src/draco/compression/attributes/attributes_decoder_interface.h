@@ -55,6 +55,15 @@ class AttributesDecoderInterface {
       int32_t /* point_attribute_id */) {
     return nullptr;
   }
+
+  // Returns true when the attribute |parent_att_id| is decoded before the
+  // attribute |att_id|. Both attributes must belong to this decoder. Used
+  // only when the attribute data is preceded by dependency levels (see
+  // PointCloudDecoder::has_attribute_offsets()).
+  virtual bool IsAttributeDecodedBefore(int32_t /* parent_att_id */,
+                                        int32_t /* att_id */) const {
+    return true;
+  }
 };
 
 }  // namespace draco
@@ -102,10 +102,16 @@ class AttributesEncoder {
     point_attribute_to_local_id_map_[id] = point_attribute_ids_.size() - 1;
   }
 
-  // Sets new attribute point ids (replacing the existing ones).
-  void SetAttributeIds(const std::vector<int32_t> &point_attribute_ids) {
+  // Removes all attribute ids from the encoder. Memory used by the ids is kept
+  // so that it can be reused for new ids.
+  void ClearAttributeIds() {
     point_attribute_ids_.clear();
     point_attribute_to_local_id_map_.clear();
+  }
+
+  // Sets new attribute point ids (replacing the existing ones).
+  void SetAttributeIds(const std::vector<int32_t> &point_attribute_ids) {
+    ClearAttributeIds();
     for (int32_t att_id : point_attribute_ids) {
       AddAttributeId(att_id);
     }
@@ -33,6 +33,17 @@ class MeshTraversalSequencer : public PointsSequencer {
       : mesh_(mesh), encoding_data_(encoding_data), corner_order_(nullptr) {}
   void SetTraverser(const TraverserT &t) { traverser_ = t; }
 
+  // Re-initializes the sequencer for a new |mesh| and |encoding_data|. The
+  // traverser is kept and it can be re-initialized in place using traverser()
+  // which avoids reallocating its memory.
+  void Reset(const Mesh *mesh,
+             const MeshAttributeIndicesEncodingData *encoding_data) {
+    mesh_ = mesh;
+    encoding_data_ = encoding_data;
+    corner_order_ = nullptr;
+  }
+  TraverserT *traverser() { return &traverser_; }
+
   // Function that can be used to set an order in which the mesh corners should
   // be processed. This is an optional flag used usually only by the encoder
   // to match the same corner order that is going to be used by the decoder.
@@ -42,8 +42,16 @@
 #include <algorithm>
 #include <cmath>
 
+#include "draco/core/cpu_features.h"
 #include "draco/core/macros.h"
 
+#ifdef DRACO_SSE2_SUPPORTED
+#include <emmintrin.h>
+#endif
+#ifdef DRACO_AVX2_SUPPORTED
+#include <immintrin.h>
+#endif
+
 namespace draco {
 
 class OctahedronToolBox {
@@ -140,28 +148,38 @@ class OctahedronToolBox {
     }
 
     // Scale vector such that the sum equals the center value.
-    int32_t int_vec[3];
-    int_vec[0] =
+    const int32_t int_x =
         static_cast<int32_t>(floor(scaled_vector[0] * center_value_ + 0.5));
-    int_vec[1] =
+    const int32_t int_y =
         static_cast<int32_t>(floor(scaled_vector[1] * center_value_ + 0.5));
-    // Make sure the sum is exactly the center value.
-    int_vec[2] = center_value_ - std::abs(int_vec[0]) - std::abs(int_vec[1]);
-    if (int_vec[2] < 0) {
-      // If the sum of first two coordinates is too large, we need to decrease
-      // the length of one of the coordinates.
-      if (int_vec[1] > 0) {
-        int_vec[1] += int_vec[2];
-      } else {
-        int_vec[1] -= int_vec[2];
-      }
-      int_vec[2] = 0;
-    }
-    // Take care of the sign.
-    if (scaled_vector[2] < 0)
-      int_vec[2] *= -1;
+    RoundedVectorToQuantizedOctahedralCoords(int_x, int_y,
+                                             scaled_vector[2] < 0, out_s,
+                                             out_t);
+  }
 
-    IntegerVectorToQuantizedOctahedralCoords(int_vec, out_s, out_t);
+  // Converts |num_vectors| vectors stored as (x, y, z) triplets in
+  // |in_vectors| into quantized octahedral coordinates stored as (s, t) pairs
+  // in |out_coords|. The results are the same as when
+  // FloatVectorToQuantizedOctahedralCoords() is called for each vector
+  // separately, but the projection onto the octahedron uses SIMD instructions
+  // when they are supported by the CPU.
+  void FloatVectorsToQuantizedOctahedralCoords(const float *in_vectors,
+                                               int num_vectors,
+                                               int32_t *out_coords) const {
+    int num_processed_vectors = 0;
+#ifdef DRACO_AVX2_SUPPORTED
+    if (CpuSupportsAvx2()) {
+      const int num_blocks = num_vectors / 4;
+      FloatVectorsToQuantizedOctahedralCoordsAvx2(in_vectors, num_blocks,
+                                                  out_coords);
+      num_processed_vectors = num_blocks * 4;
+    }
+#endif
+    for (int i = num_processed_vectors; i < num_vectors; ++i) {
+      FloatVectorToQuantizedOctahedralCoords(in_vectors + 3 * i,
+                                             out_coords + 2 * i,
+                                             out_coords + 2 * i + 1);
+    }
   }
 
   // Normalize |vec| such that its abs sum is equal to the center value;
@@ -244,6 +262,42 @@ class OctahedronToolBox {
     OctaherdalCoordsToUnitVector(in_s * scale, in_t * scale, out_vector);
   }
 
+  // Converts |num_vectors| quantized octahedral coordinates stored as (s, t)
+  // pairs in |in_coords| into unit vectors stored as (x, y, z) triplets in
+  // |out_vectors|. The results are the same as when
+  // QuantizedOctaherdalCoordsToUnitVector<float>() is called for each pair
+  // separately, but the processing uses SIMD instructions when they are
+  // supported by the CPU.
+  void QuantizedOctahedralCoordsToUnitVectors(const int32_t *in_coords,
+                                              int num_vectors,
+                                              float *out_vectors) const {
+    int num_processed_vectors = 0;
+#ifdef DRACO_SSE2_SUPPORTED
+    // AVX2 support implies SSE2 support.
+    int num_lanes = 4;
+#ifdef DRACO_AVX2_SUPPORTED
+    if (CpuSupportsAvx2())
+      num_lanes = 8;
+#endif
+    const int num_blocks = num_vectors / num_lanes;
+#ifdef DRACO_AVX2_SUPPORTED
+    if (num_lanes == 8) {
+      QuantizedOctahedralCoordsToUnitVectorsAvx2(in_coords, num_blocks,
+                                                 out_vectors);
+    }
+#endif
+    if (num_lanes == 4) {
+      QuantizedOctahedralCoordsToUnitVectorsSse2(in_coords, num_blocks,
+                                                 out_vectors);
+    }
+    num_processed_vectors = num_blocks * num_lanes;
+#endif
+    for (int i = num_processed_vectors; i < num_vectors; ++i) {
+      QuantizedOctaherdalCoordsToUnitVector(
+          in_coords[2 * i], in_coords[2 * i + 1], out_vectors + 3 * i);
+    }
+  }
+
   // |s| and |t| are expected to be signed values.
   inline bool IsInDiamond(const int32_t &s, const int32_t &t) const {
     // Expect center already at origin.
@@ -322,6 +376,274 @@ class OctahedronToolBox {
   int32_t center_value() const { return center_value_; }
 
  private:
+  // Computes the octahedral coordinates of a vector that was projected onto
+  // the octahedron and scaled by the center value. |int_x| and |int_y| are the
+  // rounded x and y components of the vector and |negative_z| is the sign of
+  // its z component.
+  inline void RoundedVectorToQuantizedOctahedralCoords(int32_t int_x,
+                                                       int32_t int_y,
+                                                       bool negative_z,
+                                                       int32_t *out_s,
+                                                       int32_t *out_t) const {
+    int32_t int_vec[3] = {int_x, int_y, 0};
+    // Make sure the sum is exactly the center value.
+    int_vec[2] = center_value_ - std::abs(int_vec[0]) - std::abs(int_vec[1]);
+    if (int_vec[2] < 0) {
+      // If the sum of first two coordinates is too large, we need to decrease
+      // the length of one of the coordinates.
+      if (int_vec[1] > 0) {
+        int_vec[1] += int_vec[2];
+      } else {
+        int_vec[1] -= int_vec[2];
+      }
+      int_vec[2] = 0;
+    }
+    // Take care of the sign.
+    if (negative_z)
+      int_vec[2] *= -1;
+
+    IntegerVectorToQuantizedOctahedralCoords(int_vec, out_s, out_t);
+  }
+
+  // The SIMD kernels below mirror the scalar code step by step. All
+  // operations are kept separate (no fused multiply-add) and the left
+  // hemisphere branches are replaced by selects, so the results are
+  // bit-identical to the scalar functions.
+
+#ifdef DRACO_SSE2_SUPPORTED
+  // Returns |a| where |mask| is set and |b| elsewhere.
+  static __m128 SelectSse2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+
+  // Processes |num_blocks| blocks of four vectors.
+  void QuantizedOctahedralCoordsToUnitVectorsSse2(const int32_t *in_coords,
+                                                  int num_blocks,
+                                                  float *out_vectors) const {
+    const float scale = 1.f / static_cast<float>(max_value_);
+    const __m128 scale_v = _mm_set1_ps(scale);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 neg_half = _mm_set1_ps(-0.5f);
+    const __m128 one_and_half = _mm_set1_ps(1.5f);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 neg_one = _mm_set1_ps(-1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 three = _mm_set1_ps(3.f);
+    const __m128 min_norm_squared = _mm_set1_ps(1e-6f);
+    float x_vals[4], y_vals[4], z_vals[4];
+    for (int b = 0; b < num_blocks; ++b) {
+      // Load four (s, t) pairs and split them into s and t vectors.
+      const __m128 st0 = _mm_cvtepi32_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_coords)));
+      const __m128 st1 = _mm_cvtepi32_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_coords + 4)));
+      const __m128 in_s =
+          _mm_mul_ps(_mm_shuffle_ps(st0, st1, _MM_SHUFFLE(2, 0, 2, 0)),
+                     scale_v);
+      const __m128 in_t =
+          _mm_mul_ps(_mm_shuffle_ps(st0, st1, _MM_SHUFFLE(3, 1, 3, 1)),
+                     scale_v);
+      __m128 spt = _mm_add_ps(in_s, in_t);
+      __m128 smt = _mm_sub_ps(in_s, in_t);
+      const __m128 right = _mm_and_ps(
+          _mm_and_ps(_mm_cmpge_ps(spt, half), _mm_cmple_ps(spt, one_and_half)),
+          _mm_and_ps(_mm_cmpge_ps(smt, neg_half), _mm_cmple_ps(smt, half)));
+      // Left hemisphere, the cases are selected in the reverse order of the
+      // scalar if-else chain.
+      __m128 s = _mm_add_ps(in_t, half);
+      __m128 t = _mm_sub_ps(in_s, half);
+      __m128 mask = _mm_cmple_ps(smt, neg_half);
+      s = SelectSse2(mask, _mm_sub_ps(in_t, half), s);
+      t = SelectSse2(mask, _mm_add_ps(in_s, half), t);
+      mask = _mm_cmpge_ps(spt, one_and_half);
+      s = SelectSse2(mask, _mm_sub_ps(one_and_half, in_t), s);
+      t = SelectSse2(mask, _mm_sub_ps(one_and_half, in_s), t);
+      mask = _mm_cmple_ps(spt, half);
+      s = SelectSse2(mask, _mm_sub_ps(half, in_t), s);
+      t = SelectSse2(mask, _mm_sub_ps(half, in_s), t);
+      s = SelectSse2(right, in_s, s);
+      t = SelectSse2(right, in_t, t);
+      const __m128 x_sign = SelectSse2(right, one, neg_one);
+      spt = _mm_add_ps(s, t);
+      smt = _mm_sub_ps(s, t);
+
+      const __m128 y = _mm_sub_ps(_mm_mul_ps(two, s), one);
+      const __m128 z = _mm_sub_ps(_mm_mul_ps(two, t), one);
+      const __m128 two_spt = _mm_mul_ps(two, spt);
+      const __m128 two_smt = _mm_mul_ps(two, smt);
+      // The arguments of _mm_min_ps() are swapped to match std::min().
+      const __m128 x = _mm_mul_ps(
+          _mm_min_ps(_mm_min_ps(_mm_sub_ps(one, two_smt),
+                                _mm_add_ps(two_smt, one)),
+                     _mm_min_ps(_mm_sub_ps(three, two_spt),
+                                _mm_sub_ps(two_spt, one))),
+          x_sign);
+      // Normalize the computed vectors.
+      const __m128 norm_squared = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+      const __m128 d = _mm_div_ps(one, _mm_sqrt_ps(norm_squared));
+      const __m128 zero_mask = _mm_cmplt_ps(norm_squared, min_norm_squared);
+      _mm_storeu_ps(x_vals, _mm_andnot_ps(zero_mask, _mm_mul_ps(x, d)));
+      _mm_storeu_ps(y_vals, _mm_andnot_ps(zero_mask, _mm_mul_ps(y, d)));
+      _mm_storeu_ps(z_vals, _mm_andnot_ps(zero_mask, _mm_mul_ps(z, d)));
+      for (int i = 0; i < 4; ++i) {
+        out_vectors[3 * i] = x_vals[i];
+        out_vectors[3 * i + 1] = y_vals[i];
+        out_vectors[3 * i + 2] = z_vals[i];
+      }
+      in_coords += 8;
+      out_vectors += 12;
+    }
+  }
+#endif
+
+#ifdef DRACO_AVX2_SUPPORTED
+  // Processes |num_blocks| blocks of eight vectors.
+  DRACO_TARGET_AVX2 void QuantizedOctahedralCoordsToUnitVectorsAvx2(
+      const int32_t *in_coords, int num_blocks, float *out_vectors) const {
+    const float scale = 1.f / static_cast<float>(max_value_);
+    const __m256 scale_v = _mm256_set1_ps(scale);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 neg_half = _mm256_set1_ps(-0.5f);
+    const __m256 one_and_half = _mm256_set1_ps(1.5f);
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 neg_one = _mm256_set1_ps(-1.f);
+    const __m256 two = _mm256_set1_ps(2.f);
+    const __m256 three = _mm256_set1_ps(3.f);
+    const __m256 min_norm_squared = _mm256_set1_ps(1e-6f);
+    float x_vals[8], y_vals[8], z_vals[8];
+    for (int b = 0; b < num_blocks; ++b) {
+      // Load eight (s, t) pairs and split them into s and t vectors. The
+      // shuffle works within 128-bit lanes so the 64-bit halves need to be
+      // reordered afterwards.
+      const __m256 st0 = _mm256_cvtepi32_ps(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in_coords)));
+      const __m256 st1 = _mm256_cvtepi32_ps(_mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(in_coords + 8)));
+      const __m256 in_s = _mm256_mul_ps(
+          _mm256_castpd_ps(_mm256_permute4x64_pd(
+              _mm256_castps_pd(
+                  _mm256_shuffle_ps(st0, st1, _MM_SHUFFLE(2, 0, 2, 0))),
+              _MM_SHUFFLE(3, 1, 2, 0))),
+          scale_v);
+      const __m256 in_t = _mm256_mul_ps(
+          _mm256_castpd_ps(_mm256_permute4x64_pd(
+              _mm256_castps_pd(
+                  _mm256_shuffle_ps(st0, st1, _MM_SHUFFLE(3, 1, 3, 1))),
+              _MM_SHUFFLE(3, 1, 2, 0))),
+          scale_v);
+      __m256 spt = _mm256_add_ps(in_s, in_t);
+      __m256 smt = _mm256_sub_ps(in_s, in_t);
+      const __m256 right = _mm256_and_ps(
+          _mm256_and_ps(_mm256_cmp_ps(spt, half, _CMP_GE_OQ),
+                        _mm256_cmp_ps(spt, one_and_half, _CMP_LE_OQ)),
+          _mm256_and_ps(_mm256_cmp_ps(smt, neg_half, _CMP_GE_OQ),
+                        _mm256_cmp_ps(smt, half, _CMP_LE_OQ)));
+      // Left hemisphere, the cases are selected in the reverse order of the
+      // scalar if-else chain.
+      __m256 s = _mm256_add_ps(in_t, half);
+      __m256 t = _mm256_sub_ps(in_s, half);
+      __m256 mask = _mm256_cmp_ps(smt, neg_half, _CMP_LE_OQ);
+      s = _mm256_blendv_ps(s, _mm256_sub_ps(in_t, half), mask);
+      t = _mm256_blendv_ps(t, _mm256_add_ps(in_s, half), mask);
+      mask = _mm256_cmp_ps(spt, one_and_half, _CMP_GE_OQ);
+      s = _mm256_blendv_ps(s, _mm256_sub_ps(one_and_half, in_t), mask);
+      t = _mm256_blendv_ps(t, _mm256_sub_ps(one_and_half, in_s), mask);
+      mask = _mm256_cmp_ps(spt, half, _CMP_LE_OQ);
+      s = _mm256_blendv_ps(s, _mm256_sub_ps(half, in_t), mask);
+      t = _mm256_blendv_ps(t, _mm256_sub_ps(half, in_s), mask);
+      s = _mm256_blendv_ps(s, in_s, right);
+      t = _mm256_blendv_ps(t, in_t, right);
+      const __m256 x_sign = _mm256_blendv_ps(neg_one, one, right);
+      spt = _mm256_add_ps(s, t);
+      smt = _mm256_sub_ps(s, t);
+
+      const __m256 y = _mm256_sub_ps(_mm256_mul_ps(two, s), one);
+      const __m256 z = _mm256_sub_ps(_mm256_mul_ps(two, t), one);
+      const __m256 two_spt = _mm256_mul_ps(two, spt);
+      const __m256 two_smt = _mm256_mul_ps(two, smt);
+      // The arguments of _mm256_min_ps() are swapped to match std::min().
+      const __m256 x = _mm256_mul_ps(
+          _mm256_min_ps(_mm256_min_ps(_mm256_sub_ps(one, two_smt),
+                                      _mm256_add_ps(two_smt, one)),
+                        _mm256_min_ps(_mm256_sub_ps(three, two_spt),
+                                      _mm256_sub_ps(two_spt, one))),
+          x_sign);
+      // Normalize the computed vectors.
+      const __m256 norm_squared =
+          _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                        _mm256_mul_ps(z, z));
+      const __m256 d = _mm256_div_ps(one, _mm256_sqrt_ps(norm_squared));
+      const __m256 zero_mask =
+          _mm256_cmp_ps(norm_squared, min_norm_squared, _CMP_LT_OQ);
+      _mm256_storeu_ps(x_vals,
+                       _mm256_andnot_ps(zero_mask, _mm256_mul_ps(x, d)));
+      _mm256_storeu_ps(y_vals,
+                       _mm256_andnot_ps(zero_mask, _mm256_mul_ps(y, d)));
+      _mm256_storeu_ps(z_vals,
+                       _mm256_andnot_ps(zero_mask, _mm256_mul_ps(z, d)));
+      for (int i = 0; i < 8; ++i) {
+        out_vectors[3 * i] = x_vals[i];
+        out_vectors[3 * i + 1] = y_vals[i];
+        out_vectors[3 * i + 2] = z_vals[i];
+      }
+      in_coords += 16;
+      out_vectors += 24;
+    }
+  }
+
+  // Processes |num_blocks| blocks of four vectors. Only the projection onto
+  // the octahedron is vectorized, the final integer adjustments are done by
+  // RoundedVectorToQuantizedOctahedralCoords().
+  DRACO_TARGET_AVX2 void FloatVectorsToQuantizedOctahedralCoordsAvx2(
+      const float *in_vectors, int num_blocks, int32_t *out_coords) const {
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d min_abs_sum = _mm256_set1_pd(1e-6);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d center = _mm256_set1_pd(center_value_);
+    int32_t int_x[4], int_y[4];
+    for (int b = 0; b < num_blocks; ++b) {
+      const float *const v = in_vectors;
+      const __m256d x =
+          _mm256_cvtps_pd(_mm_set_ps(v[9], v[6], v[3], v[0]));
+      const __m256d y =
+          _mm256_cvtps_pd(_mm_set_ps(v[10], v[7], v[4], v[1]));
+      const __m256d z =
+          _mm256_cvtps_pd(_mm_set_ps(v[11], v[8], v[5], v[2]));
+      const __m256d abs_sum =
+          _mm256_add_pd(_mm256_add_pd(_mm256_andnot_pd(sign_mask, x),
+                                      _mm256_andnot_pd(sign_mask, y)),
+                        _mm256_andnot_pd(sign_mask, z));
+      // Degenerate vectors are replaced by (1, 0, 0).
+      const __m256d valid = _mm256_cmp_pd(abs_sum, min_abs_sum, _CMP_GT_OQ);
+      const __m256d scale = _mm256_div_pd(one, abs_sum);
+      const __m256d scaled_x =
+          _mm256_blendv_pd(one, _mm256_mul_pd(x, scale), valid);
+      const __m256d scaled_y =
+          _mm256_blendv_pd(zero, _mm256_mul_pd(y, scale), valid);
+      const __m256d scaled_z =
+          _mm256_blendv_pd(zero, _mm256_mul_pd(z, scale), valid);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(int_x),
+                       _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(
+                           _mm256_mul_pd(scaled_x, center), half))));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(int_y),
+                       _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(
+                           _mm256_mul_pd(scaled_y, center), half))));
+      const int negative_z_bits =
+          _mm256_movemask_pd(_mm256_cmp_pd(scaled_z, zero, _CMP_LT_OQ));
+      for (int i = 0; i < 4; ++i) {
+        RoundedVectorToQuantizedOctahedralCoords(
+            int_x[i], int_y[i], (negative_z_bits >> i) & 1, out_coords + 2 * i,
+            out_coords + 2 * i + 1);
+      }
+      in_vectors += 12;
+      out_coords += 8;
+    }
+  }
+#endif
+
   int32_t quantization_bits_;
   int32_t max_quantized_value_;
   int32_t max_value_;
@@ -0,0 +1,82 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#include <cmath>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace draco {
+
+class NormalCompressionUtilsTest : public ::testing::Test {};
+
+TEST_F(NormalCompressionUtilsTest, TestBatchDecoding) {
+  // Tests that the batch conversion produces the same results as the
+  // conversion of individual coordinates. All coordinates are tested for a
+  // small number of quantization bits, including an odd number of values that
+  // is not a multiple of the SIMD block size.
+  for (int q = 2; q <= 8; ++q) {
+    const OctahedronToolBox tool_box(q);
+    std::vector<int32_t> coords;
+    for (int32_t s = 0; s <= tool_box.max_value(); ++s) {
+      for (int32_t t = 0; t <= tool_box.max_value(); ++t) {
+        coords.push_back(s);
+        coords.push_back(t);
+      }
+    }
+    const int num_vectors = static_cast<int>(coords.size() / 2);
+    std::vector<float> vectors(num_vectors * 3);
+    tool_box.QuantizedOctahedralCoordsToUnitVectors(coords.data(),
+                                                    num_vectors,
+                                                    vectors.data());
+    for (int i = 0; i < num_vectors; ++i) {
+      float expected[3];
+      tool_box.QuantizedOctaherdalCoordsToUnitVector(
+          coords[2 * i], coords[2 * i + 1], expected);
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(expected[c], vectors[3 * i + c]);
+      }
+    }
+  }
+}
+
+TEST_F(NormalCompressionUtilsTest, TestBatchEncoding) {
+  // Tests that the batch conversion produces the same results as the
+  // conversion of individual vectors, including degenerate vectors.
+  const OctahedronToolBox tool_box(10);
+  std::vector<float> vectors;
+  for (int i = 0; i < 1001; ++i) {
+    vectors.push_back(std::sin(0.37f * i));
+    vectors.push_back(std::cos(1.13f * i) * (i % 3));
+    vectors.push_back(std::sin(2.71f * i + 1.f) * (i % 5 - 2));
+  }
+  const float zero_vector[3] = {0.f, 0.f, 0.f};
+  vectors.insert(vectors.begin() + 30, zero_vector, zero_vector + 3);
+  const float tiny_vector[3] = {-1e-8f, 0.f, -1e-9f};
+  vectors.insert(vectors.begin() + 51, tiny_vector, tiny_vector + 3);
+  const int num_vectors = static_cast<int>(vectors.size() / 3);
+  std::vector<int32_t> coords(num_vectors * 2);
+  tool_box.FloatVectorsToQuantizedOctahedralCoords(vectors.data(), num_vectors,
+                                                   coords.data());
+  for (int i = 0; i < num_vectors; ++i) {
+    int32_t s, t;
+    tool_box.FloatVectorToQuantizedOctahedralCoords(&vectors[3 * i], &s, &t);
+    ASSERT_EQ(s, coords[2 * i]);
+    ASSERT_EQ(t, coords[2 * i + 1]);
+  }
+}
+
+}  // namespace draco
@@ -55,6 +55,12 @@ class MeshPredictionSchemeMultiParallelogramEncoder
   bool IsInitialized() const override {
     return this->mesh_data().IsInitialized();
   }
+
+ private:
+  // Storage for the predicted values that is kept between calls to avoid
+  // memory allocations when the encoder is reused.
+  std::vector<DataTypeT> pred_vals_;
+  std::vector<DataTypeT> parallelogram_pred_vals_;
 };
 
 template <typename DataTypeT, class TransformT, class MeshDataT>
@@ -68,9 +74,10 @@ bool MeshPredictionSchemeMultiParallelogramEncoder<DataTypeT, TransformT,
   const std::vector<int32_t> *const vertex_to_data_map =
       this->mesh_data().vertex_to_data_map();
 
-  std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
-  std::unique_ptr<DataTypeT[]> parallelogram_pred_vals(
-      new DataTypeT[num_components]());
+  pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  parallelogram_pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  DataTypeT *const pred_vals = pred_vals_.data();
+  DataTypeT *const parallelogram_pred_vals = parallelogram_pred_vals_.data();
 
   // We start processing from the end because this prediction uses data from
   // previous entries that could be overwritten when an entry is processed.
@@ -88,7 +95,7 @@ bool MeshPredictionSchemeMultiParallelogramEncoder<DataTypeT, TransformT,
     while (corner_id != kInvalidCornerIndex) {
       if (ComputeParallelogramPrediction(
               p, corner_id, table, *vertex_to_data_map, in_data, num_components,
-              parallelogram_pred_vals.get())) {
+              parallelogram_pred_vals)) {
         for (int c = 0; c < num_components; ++c) {
           pred_vals[c] += parallelogram_pred_vals[c];
         }
@@ -113,7 +120,7 @@ bool MeshPredictionSchemeMultiParallelogramEncoder<DataTypeT, TransformT,
       for (int c = 0; c < num_components; ++c) {
         pred_vals[c] /= num_parallelograms;
       }
-      this->transform().ComputeCorrection(in_data + dst_offset, pred_vals.get(),
+      this->transform().ComputeCorrection(in_data + dst_offset, pred_vals,
                                           out_corr + dst_offset);
     }
   }
@@ -121,7 +128,7 @@ bool MeshPredictionSchemeMultiParallelogramEncoder<DataTypeT, TransformT,
   for (int i = 0; i < num_components; ++i) {
     pred_vals[i] = static_cast<DataTypeT>(0);
   }
-  this->transform().ComputeCorrection(in_data, pred_vals.get(), out_corr);
+  this->transform().ComputeCorrection(in_data, pred_vals, out_corr);
   return true;
 }
 
@@ -62,6 +62,11 @@ class MeshPredictionSchemeParallelogramEncoder
   bool IsInitialized() const override {
     return this->mesh_data().IsInitialized();
   }
+
+ private:
+  // Storage for the predicted value that is kept between calls to avoid
+  // memory allocations when the encoder is reused.
+  std::vector<DataTypeT> pred_vals_;
 };
 
 template <typename DataTypeT, class TransformT, class MeshDataT>
@@ -72,7 +77,8 @@ bool MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
                             const PointIndex * /* entry_to_point_id_map */) {
   PSY_DRACO_PROFILE_SECTION("ParallelogramEncoder::ComputeCorrectionValues");
   this->transform().Initialize(in_data, size, num_components);
-  std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
+  pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  DataTypeT *const pred_vals = pred_vals_.data();
 
   // We start processing from the end because this prediction uses data from
   // previous entries that could be overwritten when an entry is processed.
@@ -84,7 +90,7 @@ bool MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
     const int dst_offset = p * num_components;
     if (!ComputeParallelogramPrediction(p, corner_id, table,
                                         *vertex_to_data_map, in_data,
-                                        num_components, pred_vals.get())) {
+                                        num_components, pred_vals)) {
       // Parallelogram could not be computed, Possible because some of the
       // vertices are not valid (not encoded yet).
       // We use the last encoded point as a reference (delta coding).
@@ -93,7 +99,7 @@ bool MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
           in_data + dst_offset, in_data + src_offset, out_corr + dst_offset);
     } else {
       // Apply the parallelogram prediction.
-      this->transform().ComputeCorrection(in_data + dst_offset, pred_vals.get(),
+      this->transform().ComputeCorrection(in_data + dst_offset, pred_vals,
                                           out_corr + dst_offset);
     }
   }
@@ -101,7 +107,7 @@ bool MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
   for (int i = 0; i < num_components; ++i) {
     pred_vals[i] = static_cast<DataTypeT>(0);
   }
-  this->transform().ComputeCorrection(in_data, pred_vals.get(), out_corr);
+  this->transform().ComputeCorrection(in_data, pred_vals, out_corr);
   return true;
 }
 
@@ -0,0 +1,131 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_DECODER_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_DECODER_H_
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_temporal_shared.h"
+#include "draco/psy/psy_draco.h"
+
+namespace draco {
+
+// Decoder for attribute values encoded with the temporal prediction. The
+// decoder must be provided with the same reference attribute that was used by
+// the encoder. See the description of the corresponding encoder for more
+// details.
+template <typename DataTypeT, class TransformT, class MeshDataT>
+class MeshPredictionSchemeTemporalDecoder
+    : public MeshPredictionSchemeDecoder<DataTypeT, TransformT, MeshDataT> {
+ public:
+  using CorrType =
+      typename PredictionSchemeDecoder<DataTypeT, TransformT>::CorrType;
+  using CornerTable = typename MeshDataT::CornerTable;
+  explicit MeshPredictionSchemeTemporalDecoder(const PointAttribute *attribute)
+      : MeshPredictionSchemeDecoder<DataTypeT, TransformT, MeshDataT>(
+            attribute),
+        reference_attribute_(nullptr),
+        selected_mode_(temporal_prediction::PARALLELOGRAM) {}
+  MeshPredictionSchemeTemporalDecoder(const PointAttribute *attribute,
+                                      const TransformT &transform,
+                                      const MeshDataT &mesh_data)
+      : MeshPredictionSchemeDecoder<DataTypeT, TransformT, MeshDataT>(
+            attribute, transform, mesh_data),
+        reference_attribute_(nullptr),
+        selected_mode_(temporal_prediction::PARALLELOGRAM) {}
+
+  bool ComputeOriginalValues(const CorrType *in_corr, DataTypeT *out_data,
+                             int size, int num_components,
+                             const PointIndex *entry_to_point_id_map) override;
+
+  bool DecodePredictionData(DecoderBuffer *buffer) override;
+
+  PredictionSchemeMethod GetPredictionMethod() const override {
+    return MESH_PREDICTION_TEMPORAL;
+  }
+
+  bool IsInitialized() const override {
+    return this->mesh_data().IsInitialized();
+  }
+
+  bool UsesReferenceAttribute() const override { return true; }
+
+  bool SetReferenceAttribute(const PointAttribute *att) override {
+    reference_attribute_ = att;
+    return true;
+  }
+
+ private:
+  typedef temporal_prediction::Mode Mode;
+
+  const PointAttribute *reference_attribute_;
+  Mode selected_mode_;
+};
+
+template <typename DataTypeT, class TransformT, class MeshDataT>
+bool MeshPredictionSchemeTemporalDecoder<DataTypeT, TransformT, MeshDataT>::
+    ComputeOriginalValues(const CorrType *in_corr, DataTypeT *out_data,
+                          int size, int num_components,
+                          const PointIndex * /* entry_to_point_id_map */) {
+  PSY_DRACO_PROFILE_SECTION("TemporalDecoder::ComputeOriginalValues");
+  this->transform().Initialize(num_components);
+
+  const DataTypeT *reference_data = nullptr;
+  if (selected_mode_ != temporal_prediction::PARALLELOGRAM) {
+    reference_data = temporal_prediction::GetReferenceValues<DataTypeT>(
+        reference_attribute_, size / num_components, num_components);
+    if (reference_data == nullptr)
+      return false;  // The reference used by the encoder is not available.
+  }
+
+  const CornerTable *const table = this->mesh_data().corner_table();
+  const std::vector<int32_t> *const vertex_to_data_map =
+      this->mesh_data().vertex_to_data_map();
+  std::unique_ptr<DataTypeT[]> pred_vals(new DataTypeT[num_components]());
+  std::unique_ptr<DataTypeT[]> reference_pred_vals(
+      new DataTypeT[num_components]());
+  const int corner_map_size = this->mesh_data().data_to_corner_map()->size();
+  for (int p = 0; p < corner_map_size; ++p) {
+    const CornerIndex corner_id = this->mesh_data().data_to_corner_map()->at(p);
+    temporal_prediction::ComputeTemporalPrediction(
+        selected_mode_, p, corner_id, table, *vertex_to_data_map, out_data,
+        reference_data, num_components, reference_pred_vals.get(),
+        pred_vals.get());
+    const int dst_offset = p * num_components;
+    this->transform().ComputeOriginalValue(
+        pred_vals.get(), in_corr + dst_offset, out_data + dst_offset);
+  }
+  return true;
+}
+
+template <typename DataTypeT, class TransformT, class MeshDataT>
+bool MeshPredictionSchemeTemporalDecoder<
+    DataTypeT, TransformT, MeshDataT>::DecodePredictionData(DecoderBuffer
+                                                                *buffer) {
+  // Decode the selected mode.
+  uint8_t mode;
+  if (!buffer->Decode(&mode))
+    return false;
+  if (mode > temporal_prediction::REFERENCE_WITH_PARALLELOGRAM) {
+    // Unsupported mode.
+    return false;
+  }
+  selected_mode_ = static_cast<Mode>(mode);
+  return MeshPredictionSchemeDecoder<DataTypeT, TransformT,
+                                     MeshDataT>::DecodePredictionData(buffer);
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_DECODER_H_
@@ -0,0 +1,186 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_ENCODER_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_ENCODER_H_
+
+#include <stdint.h>
+#include <cstdlib>
+
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_temporal_shared.h"
+#include "draco/psy/psy_draco.h"
+
+namespace draco {
+
+// Temporal prediction predicts attribute values of a mesh from the values of
+// the previously encoded mesh (the reference) that has the same connectivity
+// and the same encoding order of attribute values, such as the consecutive
+// frames of an animated mesh. The reference is provided in its portable form
+// using SetReferenceAttribute(), therefore the values of both meshes should be
+// quantized with the same quantization parameters.
+//
+// The value of each entry is predicted either directly by the reference value
+// of the same entry, or by the reference value moved by the difference
+// between the parallelogram predictions computed on the current and the
+// reference values. The encoder selects the mode that produces the smaller
+// corrections. When no valid reference is available, the standard
+// parallelogram prediction is used instead.
+template <typename DataTypeT, class TransformT, class MeshDataT>
+class MeshPredictionSchemeTemporalEncoder
+    : public MeshPredictionSchemeEncoder<DataTypeT, TransformT, MeshDataT> {
+ public:
+  using CorrType =
+      typename PredictionSchemeEncoder<DataTypeT, TransformT>::CorrType;
+  using CornerTable = typename MeshDataT::CornerTable;
+  explicit MeshPredictionSchemeTemporalEncoder(const PointAttribute *attribute)
+      : MeshPredictionSchemeEncoder<DataTypeT, TransformT, MeshDataT>(
+            attribute),
+        reference_attribute_(nullptr),
+        selected_mode_(temporal_prediction::PARALLELOGRAM) {}
+  MeshPredictionSchemeTemporalEncoder(const PointAttribute *attribute,
+                                      const TransformT &transform,
+                                      const MeshDataT &mesh_data)
+      : MeshPredictionSchemeEncoder<DataTypeT, TransformT, MeshDataT>(
+            attribute, transform, mesh_data),
+        reference_attribute_(nullptr),
+        selected_mode_(temporal_prediction::PARALLELOGRAM) {}
+
+  bool ComputeCorrectionValues(
+      const DataTypeT *in_data, CorrType *out_corr, int size,
+      int num_components, const PointIndex *entry_to_point_id_map) override;
+
+  bool EncodePredictionData(EncoderBuffer *buffer) override;
+
+  PredictionSchemeMethod GetPredictionMethod() const override {
+    return MESH_PREDICTION_TEMPORAL;
+  }
+
+  bool IsInitialized() const override {
+    return this->mesh_data().IsInitialized();
+  }
+
+  bool UsesReferenceAttribute() const override { return true; }
+
+  bool SetReferenceAttribute(const PointAttribute *att) override {
+    reference_attribute_ = att;
+    return true;
+  }
+
+ private:
+  typedef temporal_prediction::Mode Mode;
+
+  // Returns the sum of absolute differences between |in_data| and the values
+  // predicted with the given |mode|.
+  int64_t ComputePredictionCost(Mode mode, const DataTypeT *in_data,
+                                const DataTypeT *reference_data,
+                                int num_components);
+
+  const PointAttribute *reference_attribute_;
+  Mode selected_mode_;
+
+  // Storage for the predicted values that is kept between calls to avoid
+  // memory allocations when the encoder is reused.
+  std::vector<DataTypeT> pred_vals_;
+  std::vector<DataTypeT> reference_pred_vals_;
+};
+
+template <typename DataTypeT, class TransformT, class MeshDataT>
+int64_t MeshPredictionSchemeTemporalEncoder<DataTypeT, TransformT, MeshDataT>::
+    ComputePredictionCost(Mode mode, const DataTypeT *in_data,
+                          const DataTypeT *reference_data,
+                          int num_components) {
+  const CornerTable *const table = this->mesh_data().corner_table();
+  const std::vector<int32_t> *const vertex_to_data_map =
+      this->mesh_data().vertex_to_data_map();
+  pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  reference_pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  DataTypeT *const pred_vals = pred_vals_.data();
+  DataTypeT *const reference_pred_vals = reference_pred_vals_.data();
+  int64_t cost = 0;
+  const int corner_map_size = this->mesh_data().data_to_corner_map()->size();
+  for (int p = 0; p < corner_map_size; ++p) {
+    const CornerIndex corner_id = this->mesh_data().data_to_corner_map()->at(p);
+    temporal_prediction::ComputeTemporalPrediction(
+        mode, p, corner_id, table, *vertex_to_data_map, in_data,
+        reference_data, num_components, reference_pred_vals, pred_vals);
+    const int offset = p * num_components;
+    for (int c = 0; c < num_components; ++c) {
+      cost += std::abs(static_cast<int64_t>(in_data[offset + c]) -
+                       static_cast<int64_t>(pred_vals[c]));
+    }
+  }
+  return cost;
+}
+
+template <typename DataTypeT, class TransformT, class MeshDataT>
+bool MeshPredictionSchemeTemporalEncoder<DataTypeT, TransformT, MeshDataT>::
+    ComputeCorrectionValues(const DataTypeT *in_data, CorrType *out_corr,
+                            int size, int num_components,
+                            const PointIndex * /* entry_to_point_id_map */) {
+  PSY_DRACO_PROFILE_SECTION("TemporalEncoder::ComputeCorrectionValues");
+  this->transform().Initialize(in_data, size, num_components);
+
+  const DataTypeT *const reference_data =
+      temporal_prediction::GetReferenceValues<DataTypeT>(
+          reference_attribute_, size / num_components, num_components);
+  selected_mode_ = temporal_prediction::PARALLELOGRAM;
+  if (reference_data != nullptr) {
+    // Select the mode with the smaller prediction error.
+    const int64_t reference_cost =
+        ComputePredictionCost(temporal_prediction::REFERENCE, in_data,
+                              reference_data, num_components);
+    const int64_t reference_with_parallelogram_cost = ComputePredictionCost(
+        temporal_prediction::REFERENCE_WITH_PARALLELOGRAM, in_data,
+        reference_data, num_components);
+    selected_mode_ = reference_with_parallelogram_cost < reference_cost
+                         ? temporal_prediction::REFERENCE_WITH_PARALLELOGRAM
+                         : temporal_prediction::REFERENCE;
+  }
+
+  const CornerTable *const table = this->mesh_data().corner_table();
+  const std::vector<int32_t> *const vertex_to_data_map =
+      this->mesh_data().vertex_to_data_map();
+  pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  reference_pred_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  DataTypeT *const pred_vals = pred_vals_.data();
+  DataTypeT *const reference_pred_vals = reference_pred_vals_.data();
+  // We start processing from the end because this prediction uses data from
+  // previous entries that could be overwritten when an entry is processed.
+  for (int p = this->mesh_data().data_to_corner_map()->size() - 1; p >= 0;
+       --p) {
+    const CornerIndex corner_id = this->mesh_data().data_to_corner_map()->at(p);
+    temporal_prediction::ComputeTemporalPrediction(
+        selected_mode_, p, corner_id, table, *vertex_to_data_map, in_data,
+        reference_data, num_components, reference_pred_vals, pred_vals);
+    const int dst_offset = p * num_components;
+    this->transform().ComputeCorrection(in_data + dst_offset, pred_vals,
+                                        out_corr + dst_offset);
+  }
+  return true;
+}
+
+template <typename DataTypeT, class TransformT, class MeshDataT>
+bool MeshPredictionSchemeTemporalEncoder<
+    DataTypeT, TransformT, MeshDataT>::EncodePredictionData(EncoderBuffer
+                                                                *buffer) {
+  // Encode the selected mode.
+  buffer->Encode(static_cast<uint8_t>(selected_mode_));
+  return MeshPredictionSchemeEncoder<DataTypeT, TransformT,
+                                     MeshDataT>::EncodePredictionData(buffer);
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_ENCODER_H_
@@ -0,0 +1,114 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Shared functionality for the temporal prediction scheme encoder and decoder.
+
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_SHARED_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_SHARED_H_
+
+#include "draco/attributes/point_attribute.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_shared.h"
+
+namespace draco {
+
+// Data shared between temporal prediction encoder and decoder.
+namespace temporal_prediction {
+
+enum Mode {
+  // No reference values were available. The values are predicted using the
+  // standard parallelogram prediction.
+  PARALLELOGRAM = 0,
+  // Each value is predicted by the value of the same entry in the reference.
+  REFERENCE = 1,
+  // The reference value is moved by the difference between the parallelogram
+  // predictions computed on the current values and on the reference values,
+  // i.e., the motion of the predicted vertex is predicted from the motion of
+  // its neighbors.
+  REFERENCE_WITH_PARALLELOGRAM = 2,
+};
+
+// Returns the values of the |reference| attribute or nullptr when they can't
+// be used for prediction of |num_entries| entries with |num_components|
+// components each.
+template <typename DataTypeT>
+inline const DataTypeT *GetReferenceValues(const PointAttribute *reference,
+                                           int num_entries,
+                                           int num_components) {
+  if (reference == nullptr || reference->buffer() == nullptr)
+    return nullptr;
+  if (reference->size() != static_cast<size_t>(num_entries) ||
+      reference->num_components() != num_components ||
+      reference->byte_stride() !=
+          static_cast<int64_t>(sizeof(DataTypeT)) * num_components)
+    return nullptr;
+  return reinterpret_cast<const DataTypeT *>(
+      reference->GetAddress(AttributeValueIndex(0)));
+}
+
+// Computes prediction of the data entry |data_entry_id| using the given
+// |mode|. |data| are the values of the current geometry that are available
+// for all entries preceding |data_entry_id| and |reference_data| are the
+// values of all entries of the reference geometry. |reference_pred| is
+// a temporary storage for |num_components| values.
+template <class CornerTableT, typename DataTypeT>
+inline void ComputeTemporalPrediction(
+    Mode mode, int data_entry_id, const CornerIndex ci,
+    const CornerTableT *table, const std::vector<int32_t> &vertex_to_data_map,
+    const DataTypeT *data, const DataTypeT *reference_data, int num_components,
+    DataTypeT *reference_pred, DataTypeT *out_prediction) {
+  const int offset = data_entry_id * num_components;
+  if (mode == REFERENCE) {
+    for (int c = 0; c < num_components; ++c) {
+      out_prediction[c] = reference_data[offset + c];
+    }
+    return;
+  }
+  if (ComputeParallelogramPrediction(data_entry_id, ci, table,
+                                     vertex_to_data_map, data, num_components,
+                                     out_prediction)) {
+    if (mode == REFERENCE_WITH_PARALLELOGRAM) {
+      // The parallelogram uses the same entries on the reference values so it
+      // can always be computed when it was computed for the current values.
+      ComputeParallelogramPrediction(data_entry_id, ci, table,
+                                     vertex_to_data_map, reference_data,
+                                     num_components, reference_pred);
+      for (int c = 0; c < num_components; ++c) {
+        out_prediction[c] =
+            reference_data[offset + c] + (out_prediction[c] - reference_pred[c]);
+      }
+    }
+    return;
+  }
+  // Parallelogram could not be computed.
+  if (mode == REFERENCE_WITH_PARALLELOGRAM) {
+    for (int c = 0; c < num_components; ++c) {
+      out_prediction[c] = reference_data[offset + c];
+    }
+  } else if (data_entry_id > 0) {
+    // Use the last encoded point as a reference (delta coding).
+    for (int c = 0; c < num_components; ++c) {
+      out_prediction[c] = data[offset - num_components + c];
+    }
+  } else {
+    // First element cannot be predicted.
+    for (int c = 0; c < num_components; ++c) {
+      out_prediction[c] = static_cast<DataTypeT>(0);
+    }
+  }
+}
+
+}  // namespace temporal_prediction
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TEMPORAL_SHARED_H_
@@ -0,0 +1,126 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+class MeshPredictionSchemeTemporalTest : public ::testing::Test {
+ protected:
+  EncoderOptions CreateOptions(int grid_size) const {
+    EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+    options.SetAttributeInt(0, "quantization_bits", 14);
+    // Use the same quantization for all frames.
+    const float origin[3] = {0.f, 0.f, -1.f};
+    options.SetAttributeVector(0, "quantization_origin", 3, origin);
+    options.SetAttributeFloat(0, "quantization_range",
+                              static_cast<float>(grid_size));
+    return options;
+  }
+};
+
+TEST_F(MeshPredictionSchemeTemporalTest, TestSequenceEncoding) {
+  const int grid_size = 40;
+  const float max_position_error =
+      static_cast<float>(grid_size) / ((1 << 14) - 1);
+
+  EncoderOptions options = CreateOptions(grid_size);
+  options.SetGlobalBool("store_reference_attributes", true);
+  options.SetAttributeInt(0, "prediction_scheme", MESH_PREDICTION_TEMPORAL);
+  options.SetAttributeInt(1, "prediction_scheme", MESH_PREDICTION_TEMPORAL);
+  DecoderOptions dec_options;
+  dec_options.SetGlobalBool("store_reference_attributes", true);
+
+  // The same encoder and decoder must be used for all frames.
+  MeshEdgeBreakerEncoder encoder;
+  MeshEdgeBreakerDecoder decoder;
+  for (int frame = 0; frame < 4; ++frame) {
+    const std::unique_ptr<Mesh> mesh = CreateAnimatedGridMesh(grid_size, frame);
+    EncoderBuffer buffer;
+    encoder.SetMesh(*mesh);
+    ASSERT_TRUE(encoder.Encode(options, &buffer).ok());
+
+    if (frame > 0) {
+      // Frames predicted from their predecessors should be smaller than
+      // independently encoded frames.
+      MeshEdgeBreakerEncoder intra_encoder;
+      EncoderBuffer intra_buffer;
+      intra_encoder.SetMesh(*mesh);
+      ASSERT_TRUE(
+          intra_encoder.Encode(CreateOptions(grid_size), &intra_buffer).ok());
+      ASSERT_LT(buffer.size(), intra_buffer.size())
+          << "Temporal prediction was not efficient in frame " << frame;
+    }
+
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Mesh decoded_mesh;
+    ASSERT_TRUE(decoder.Decode(dec_options, &dec_buffer, &decoded_mesh).ok());
+    ASSERT_EQ(decoded_mesh.num_points(), mesh->num_points());
+
+    // The decoder may reorder the points so we match them using their grid
+    // coordinates.
+    for (PointIndex dec_pi(0); dec_pi < decoded_mesh.num_points(); ++dec_pi) {
+      float dec_pos[3];
+      decoded_mesh.attribute(0)->GetMappedValue(dec_pi, dec_pos);
+      const PointIndex src_pi(static_cast<int>(std::round(dec_pos[1])) *
+                                  grid_size +
+                              static_cast<int>(std::round(dec_pos[0])));
+      ASSERT_LT(src_pi.value(), mesh->num_points());
+      float src_pos[3];
+      mesh->attribute(0)->GetMappedValue(src_pi, src_pos);
+      for (int i = 0; i < 3; ++i) {
+        ASSERT_NEAR(src_pos[i], dec_pos[i], max_position_error);
+      }
+      uint8_t src_color[3], dec_color[3];
+      mesh->attribute(1)->GetMappedValue(src_pi, src_color);
+      decoded_mesh.attribute(1)->GetMappedValue(dec_pi, dec_color);
+      for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(src_color[i], dec_color[i]);
+      }
+    }
+  }
+}
+
+TEST_F(MeshPredictionSchemeTemporalTest, TestMissingReference) {
+  // A frame encoded with a reference can't be decoded by a decoder that did
+  // not decode the previous frame.
+  const int grid_size = 20;
+  EncoderOptions options = CreateOptions(grid_size);
+  options.SetGlobalBool("store_reference_attributes", true);
+  options.SetAttributeInt(0, "prediction_scheme", MESH_PREDICTION_TEMPORAL);
+  MeshEdgeBreakerEncoder encoder;
+  EncoderBuffer buffer;
+  for (int frame = 0; frame < 2; ++frame) {
+    const std::unique_ptr<Mesh> mesh = CreateAnimatedGridMesh(grid_size, frame);
+    buffer.Clear();
+    encoder.SetMesh(*mesh);
+    ASSERT_TRUE(encoder.Encode(options, &buffer).ok());
+  }
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  MeshEdgeBreakerDecoder decoder;
+  Mesh decoded_mesh;
+  DecoderOptions dec_options;
+  dec_options.SetGlobalBool("store_reference_attributes", true);
+  ASSERT_FALSE(decoder.Decode(dec_options, &dec_buffer, &decoded_mesh).ok());
+}
+
+}  // namespace draco
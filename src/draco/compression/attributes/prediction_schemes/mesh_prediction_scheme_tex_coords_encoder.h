@@ -99,7 +99,7 @@ class MeshPredictionSchemeTexCoordsEncoder
  private:
   const PointAttribute *pos_attribute_;
   const PointIndex *entry_to_point_id_map_;
-  std::unique_ptr<DataTypeT[]> predicted_value_;
+  std::vector<DataTypeT> predicted_value_;
   int num_components_;
   // Encoded / decoded array of UV flips.
   std::vector<bool> orientations_;
@@ -112,8 +112,7 @@ bool MeshPredictionSchemeTexCoordsEncoder<DataTypeT, TransformT, MeshDataT>::
                             const PointIndex *entry_to_point_id_map) {
   num_components_ = num_components;
   entry_to_point_id_map_ = entry_to_point_id_map;
-  predicted_value_ =
-      std::unique_ptr<DataTypeT[]>(new DataTypeT[num_components]);
+  predicted_value_.resize(num_components);
   this->transform().Initialize(in_data, size, num_components);
   // We start processing from the end because this prediction uses data from
   // previous entries that could be overwritten when an entry is processed.
@@ -124,7 +123,7 @@ bool MeshPredictionSchemeTexCoordsEncoder<DataTypeT, TransformT, MeshDataT>::
 
     const int dst_offset = p * num_components;
     this->transform().ComputeCorrection(
-        in_data + dst_offset, predicted_value_.get(), out_corr + dst_offset);
+        in_data + dst_offset, predicted_value_.data(), out_corr + dst_offset);
   }
   return true;
 }
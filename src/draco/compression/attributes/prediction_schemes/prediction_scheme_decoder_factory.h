@@ -22,6 +22,7 @@
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_multi_parallelogram_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_decoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_temporal_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_tex_coords_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_tex_coords_portable_decoder.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_decoder.h"
@@ -85,6 +86,11 @@ struct MeshPredictionSchemeDecoderFactory {
             new MeshPredictionSchemeGeometricNormalDecoder<
                 DataTypeT, TransformT, MeshDataT>(attribute, transform,
                                                   mesh_data));
+      } else if (method == MESH_PREDICTION_TEMPORAL) {
+        return std::unique_ptr<PredictionSchemeDecoder<DataTypeT, TransformT>>(
+            new MeshPredictionSchemeTemporalDecoder<DataTypeT, TransformT,
+                                                    MeshDataT>(
+                attribute, transform, mesh_data));
       }
       return nullptr;
     }
@@ -43,6 +43,11 @@ class PredictionSchemeDeltaEncoder
     return PREDICTION_DIFFERENCE;
   }
   bool IsInitialized() const override { return true; }
+
+ private:
+  // Zero prediction for the first element that is kept between calls to avoid
+  // memory allocations when the encoder is reused.
+  std::vector<DataTypeT> zero_vals_;
 };
 
 template <typename DataTypeT, class TransformT>
@@ -59,8 +64,8 @@ bool PredictionSchemeDeltaEncoder<
         in_data + i, in_data + i - num_components, out_corr + i);
   }
   // Encode correction for the first element.
-  std::unique_ptr<DataTypeT[]> zero_vals(new DataTypeT[num_components]());
-  this->transform().ComputeCorrection(in_data, zero_vals.get(), out_corr);
+  zero_vals_.assign(num_components, static_cast<DataTypeT>(0));
+  this->transform().ComputeCorrection(in_data, zero_vals_.data(), out_corr);
   return true;
 }
 
@@ -66,6 +66,13 @@ class PredictionSchemeEncoder : public PredictionSchemeTypedEncoderInterface<
     return false;
   }
 
+  // By default, no reference attribute is used.
+  bool UsesReferenceAttribute() const override { return false; }
+
+  bool SetReferenceAttribute(const PointAttribute * /* att */) override {
+    return false;
+  }
+
   bool AreCorrectionsPositive() override {
     return transform_.AreCorrectionsPositive();
   }
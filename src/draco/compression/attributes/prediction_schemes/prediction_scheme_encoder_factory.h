@@ -22,6 +22,7 @@
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_geometric_normal_encoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_multi_parallelogram_encoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_encoder.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_temporal_encoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_tex_coords_encoder.h"
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_tex_coords_portable_encoder.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_delta_encoder.h"
@@ -36,57 +37,107 @@ namespace draco {
 PredictionSchemeMethod SelectPredictionMethod(int att_id,
                                               const PointCloudEncoder *encoder);
 
-// Factory class for creating mesh prediction schemes.
+// Creates a prediction scheme of type |PredictionSchemeT| from the
+// constructor arguments |args|. When |prev_scheme| holds a scheme of the same
+// type, the scheme is re-initialized by assigning it a newly constructed
+// scheme and its ownership is moved to the returned pointer. The assignment
+// keeps memory allocated by the internal buffers of the previous scheme.
+template <class PredictionSchemeT, class... Args>
+std::unique_ptr<
+    PredictionSchemeEncoder<typename PredictionSchemeT::DataType,
+                            typename PredictionSchemeT::Transform>>
+CreateOrReusePredictionScheme(
+    std::unique_ptr<PredictionSchemeTypedEncoderInterface<
+        typename PredictionSchemeT::DataType>> *prev_scheme,
+    const Args &... args) {
+  typedef PredictionSchemeEncoder<typename PredictionSchemeT::DataType,
+                                  typename PredictionSchemeT::Transform>
+      BaseT;
+  if (prev_scheme != nullptr) {
+    PredictionSchemeT *const scheme =
+        dynamic_cast<PredictionSchemeT *>(prev_scheme->get());
+    if (scheme != nullptr) {
+      const PredictionSchemeT new_scheme(args...);
+      *scheme = new_scheme;
+      prev_scheme->release();
+      return std::unique_ptr<BaseT>(scheme);
+    }
+  }
+  return std::unique_ptr<BaseT>(new PredictionSchemeT(args...));
+}
+
+// Factory class for creating mesh prediction schemes. Schemes are created
+// using CreateOrReusePredictionScheme() so a previously created scheme can be
+// reused if it is provided in the constructor.
 template <typename DataTypeT>
 struct MeshPredictionSchemeEncoderFactory {
+  typedef std::unique_ptr<PredictionSchemeTypedEncoderInterface<DataTypeT>>
+      PrevSchemePtr;
+
+  MeshPredictionSchemeEncoderFactory() : prev_scheme(nullptr) {}
+  explicit MeshPredictionSchemeEncoderFactory(PrevSchemePtr *previous_scheme)
+      : prev_scheme(previous_scheme) {}
+
   template <class TransformT, class MeshDataT>
   std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>> operator()(
       PredictionSchemeMethod method, const PointAttribute *attribute,
       const TransformT &transform, const MeshDataT &mesh_data,
       uint16_t bitstream_version) {
     if (method == MESH_PREDICTION_PARALLELOGRAM) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
-                                                       MeshDataT>(
-              attribute, transform, mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
+                                                   MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
     } else if (method == MESH_PREDICTION_MULTI_PARALLELOGRAM) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeMultiParallelogramEncoder<
-              DataTypeT, TransformT, MeshDataT>(attribute, transform,
-                                                mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeMultiParallelogramEncoder<DataTypeT, TransformT,
+                                                        MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
     } else if (method == MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeConstrainedMultiParallelogramEncoder<
-              DataTypeT, TransformT, MeshDataT>(attribute, transform,
-                                                mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeConstrainedMultiParallelogramEncoder<
+              DataTypeT, TransformT, MeshDataT>>(prev_scheme, attribute,
+                                                 transform, mesh_data);
     } else if (method == MESH_PREDICTION_TEX_COORDS_DEPRECATED) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeTexCoordsEncoder<DataTypeT, TransformT,
-                                                   MeshDataT>(
-              attribute, transform, mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeTexCoordsEncoder<DataTypeT, TransformT,
+                                               MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
     } else if (method == MESH_PREDICTION_TEX_COORDS_PORTABLE) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeTexCoordsPortableEncoder<
-              DataTypeT, TransformT, MeshDataT>(attribute, transform,
-                                                mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeTexCoordsPortableEncoder<DataTypeT, TransformT,
+                                                       MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
     } else if (method == MESH_PREDICTION_GEOMETRIC_NORMAL) {
-      return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-          new MeshPredictionSchemeGeometricNormalEncoder<DataTypeT, TransformT,
-                                                         MeshDataT>(
-              attribute, transform, mesh_data));
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeGeometricNormalEncoder<DataTypeT, TransformT,
+                                                     MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
+    } else if (method == MESH_PREDICTION_TEMPORAL) {
+      return CreateOrReusePredictionScheme<
+          MeshPredictionSchemeTemporalEncoder<DataTypeT, TransformT,
+                                              MeshDataT>>(
+          prev_scheme, attribute, transform, mesh_data);
     }
     return nullptr;
   }
+
+  // Optional scheme that is reused when it has the requested type.
+  PrevSchemePtr *prev_scheme;
 };
 
 // Creates a prediction scheme for a given encoder and given prediction method.
 // The prediction schemes are automatically initialized with encoder specific
-// data if needed.
+// data if needed. When |prev_scheme| is not null and it holds a scheme of the
+// selected type, the scheme is re-initialized and returned instead of
+// allocating a new one (see CreateOrReusePredictionScheme()).
 template <typename DataTypeT, class TransformT>
 std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>
-CreatePredictionSchemeForEncoder(PredictionSchemeMethod method, int att_id,
-                                 const PointCloudEncoder *encoder,
-                                 const TransformT &transform) {
+CreatePredictionSchemeForEncoder(
+    PredictionSchemeMethod method, int att_id, const PointCloudEncoder *encoder,
+    const TransformT &transform,
+    std::unique_ptr<PredictionSchemeTypedEncoderInterface<DataTypeT>>
+        *prev_scheme) {
   const PointAttribute *const att = encoder->point_cloud()->attribute(att_id);
   if (method == PREDICTION_UNDEFINED) {
     method = SelectPredictionMethod(att_id, encoder);
@@ -104,14 +155,26 @@ CreatePredictionSchemeForEncoder(PredictionSchemeMethod method, int att_id,
     auto ret = CreateMeshPredictionScheme<
         MeshEncoder, PredictionSchemeEncoder<DataTypeT, TransformT>,
         MeshPredictionSchemeEncoderFactory<DataTypeT>>(
-        mesh_encoder, method, att_id, transform, kDracoBitstreamVersion);
+        mesh_encoder, method, att_id, transform, kDracoBitstreamVersion,
+        MeshPredictionSchemeEncoderFactory<DataTypeT>(prev_scheme));
     if (ret)
       return ret;
     // Otherwise try to create another prediction scheme.
   }
   // Create delta encoder.
-  return std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>(
-      new PredictionSchemeDeltaEncoder<DataTypeT, TransformT>(att, transform));
+  return CreateOrReusePredictionScheme<
+      PredictionSchemeDeltaEncoder<DataTypeT, TransformT>>(prev_scheme, att,
+                                                           transform);
+}
+
+// Same as above but a new prediction scheme is always created.
+template <typename DataTypeT, class TransformT>
+std::unique_ptr<PredictionSchemeEncoder<DataTypeT, TransformT>>
+CreatePredictionSchemeForEncoder(PredictionSchemeMethod method, int att_id,
+                                 const PointCloudEncoder *encoder,
+                                 const TransformT &transform) {
+  return CreatePredictionSchemeForEncoder<DataTypeT, TransformT>(
+      method, att_id, encoder, transform, nullptr);
 }
 
 // Create a prediction scheme using a default transform constructor.
@@ -29,12 +29,16 @@
 
 namespace draco {
 
+// Creates a mesh prediction scheme using |factory|. Returns nullptr when the
+// |method| is not a mesh prediction method or when the connectivity data of
+// the attribute is not available.
 template <class EncodingDataSourceT, class PredictionSchemeT,
           class MeshPredictionSchemeFactoryT>
 std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
     const EncodingDataSourceT *source, PredictionSchemeMethod method,
     int att_id, const typename PredictionSchemeT::Transform &transform,
-    uint16_t bitstream_version) {
+    uint16_t bitstream_version,
+    MeshPredictionSchemeFactoryT factory = MeshPredictionSchemeFactoryT()) {
   const PointAttribute *const att = source->point_cloud()->attribute(att_id);
   if (source->GetGeometryType() == TRIANGULAR_MESH &&
       (method == MESH_PREDICTION_PARALLELOGRAM ||
@@ -42,7 +46,8 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
        method == MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM ||
        method == MESH_PREDICTION_TEX_COORDS_PORTABLE ||
        method == MESH_PREDICTION_GEOMETRIC_NORMAL ||
-       method == MESH_PREDICTION_TEX_COORDS_DEPRECATED)) {
+       method == MESH_PREDICTION_TEX_COORDS_DEPRECATED ||
+       method == MESH_PREDICTION_TEMPORAL)) {
     const CornerTable *const ct = source->GetCornerTable();
     const MeshAttributeIndicesEncodingData *const encoding_data =
         source->GetAttributeEncodingData(att_id);
@@ -59,7 +64,6 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
       md.Set(source->mesh(), att_ct,
              &encoding_data->encoded_attribute_value_index_to_corner_map,
              &encoding_data->vertex_to_encoded_attribute_value_index_map);
-      MeshPredictionSchemeFactoryT factory;
       auto ret = factory(method, att, transform, md, bitstream_version);
       if (ret)
         return ret;
@@ -69,7 +73,6 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
       md.Set(source->mesh(), ct,
              &encoding_data->encoded_attribute_value_index_to_corner_map,
              &encoding_data->vertex_to_encoded_attribute_value_index_map);
-      MeshPredictionSchemeFactoryT factory;
       auto ret = factory(method, att, transform, md, bitstream_version);
       if (ret)
         return ret;
@@ -47,6 +47,17 @@ class PredictionSchemeInterface {
   // prediction scheme.
   virtual bool SetParentAttribute(const PointAttribute *att) = 0;
 
+  // Returns true when the prediction scheme uses values of the same attribute
+  // from a previously processed geometry (see SetReferenceAttribute()).
+  virtual bool UsesReferenceAttribute() const = 0;
+
+  // Sets the portable attribute of a previously processed geometry that is
+  // used as a reference for the prediction. |att| can be nullptr when no
+  // reference is available.
+  // Returns false if the attribute doesn't meet the requirements of the
+  // prediction scheme.
+  virtual bool SetReferenceAttribute(const PointAttribute *att) = 0;
+
   // Method should return true if the prediction scheme guarantees that all
   // correction values are always positive (or at least non-negative).
   virtual bool AreCorrectionsPositive() = 0;
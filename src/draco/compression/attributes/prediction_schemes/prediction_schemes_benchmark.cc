@@ -0,0 +1,155 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "benchmark/benchmark.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+namespace {
+
+const int kGridSize = 256;
+
+// Returns the id of the attribute of the benchmark grid mesh that can be
+// predicted by the prediction scheme |method|.
+int GetPredictedAttributeId(PredictionSchemeMethod method) {
+  if (method == MESH_PREDICTION_GEOMETRIC_NORMAL)
+    return 1;
+  if (method == MESH_PREDICTION_TEX_COORDS_PORTABLE)
+    return 2;
+  return 0;
+}
+
+// Creates options that encode the benchmark grid mesh with the standard
+// edgebreaker and with the prediction scheme |method| used for one of the
+// attributes. Prediction schemes of the remaining attributes are chosen by
+// the encoder.
+EncoderOptions CreatePredictionSchemeOptions(PredictionSchemeMethod method) {
+  EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  options.SetGlobalInt("edgebreaker_method",
+                       MESH_EDGEBREAKER_STANDARD_ENCODING);
+  options.SetAttributeInt(0, "quantization_bits", 14);
+  options.SetAttributeInt(1, "quantization_bits", 10);
+  options.SetAttributeInt(2, "quantization_bits", 12);
+  options.SetAttributeInt(GetPredictedAttributeId(method), "prediction_scheme",
+                          method);
+  if (method == MESH_PREDICTION_TEMPORAL) {
+    // Use the same quantization for all frames.
+    const float origin[3] = {0.f, 0.f, -1.f};
+    options.SetAttributeVector(0, "quantization_origin", 3, origin);
+    options.SetAttributeFloat(0, "quantization_range",
+                              static_cast<float>(kGridSize));
+    options.SetGlobalBool("store_reference_attributes", true);
+  }
+  return options;
+}
+
+DecoderOptions CreatePredictionSchemeDecoderOptions(
+    PredictionSchemeMethod method) {
+  DecoderOptions options;
+  if (method == MESH_PREDICTION_TEMPORAL)
+    options.SetGlobalBool("store_reference_attributes", true);
+  return options;
+}
+
+// The argument is the prediction scheme method. Temporal prediction predicts
+// each frame from the previously encoded copy of the same mesh.
+void BM_PredictionSchemeEncode(benchmark::State &state) {
+  const PredictionSchemeMethod method =
+      static_cast<PredictionSchemeMethod>(state.range(0));
+  const std::unique_ptr<Mesh> mesh = CreateBenchmarkGridMesh(kGridSize);
+  const EncoderOptions options = CreatePredictionSchemeOptions(method);
+  MeshEdgeBreakerEncoder encoder;
+  encoder.SetMesh(*mesh);
+  EncoderBuffer buffer;
+  if (method == MESH_PREDICTION_TEMPORAL &&
+      !encoder.Encode(options, &buffer).ok()) {
+    state.SkipWithError("Failed to encode the reference frame.");
+    return;
+  }
+  for (auto _ : state) {
+    buffer.Clear();
+    if (!encoder.Encode(options, &buffer).ok()) {
+      state.SkipWithError("Failed to encode the mesh.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_points());
+  state.counters["encoded_bytes"] = buffer.size();
+}
+
+void BM_PredictionSchemeDecode(benchmark::State &state) {
+  const PredictionSchemeMethod method =
+      static_cast<PredictionSchemeMethod>(state.range(0));
+  const std::unique_ptr<Mesh> mesh = CreateBenchmarkGridMesh(kGridSize);
+  const EncoderOptions options = CreatePredictionSchemeOptions(method);
+  const DecoderOptions dec_options =
+      CreatePredictionSchemeDecoderOptions(method);
+  MeshEdgeBreakerEncoder encoder;
+  encoder.SetMesh(*mesh);
+  MeshEdgeBreakerDecoder decoder;
+  EncoderBuffer buffer;
+  if (method == MESH_PREDICTION_TEMPORAL) {
+    // Encode and decode the reference frame.
+    if (!encoder.Encode(options, &buffer).ok()) {
+      state.SkipWithError("Failed to encode the reference frame.");
+      return;
+    }
+    Mesh reference_mesh;
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    if (!decoder.Decode(dec_options, &dec_buffer, &reference_mesh).ok()) {
+      state.SkipWithError("Failed to decode the reference frame.");
+      return;
+    }
+    buffer.Clear();
+  }
+  if (!encoder.Encode(options, &buffer).ok()) {
+    state.SkipWithError("Failed to encode the mesh.");
+    return;
+  }
+  for (auto _ : state) {
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Mesh decoded_mesh;
+    if (!decoder.Decode(dec_options, &dec_buffer, &decoded_mesh).ok()) {
+      state.SkipWithError("Failed to decode the mesh.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_points());
+}
+
+// MESH_PREDICTION_TEX_COORDS_DEPRECATED can't be used by the encoder anymore.
+void PredictionSchemeArguments(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("method");
+  benchmark->Arg(PREDICTION_DIFFERENCE);
+  benchmark->Arg(MESH_PREDICTION_PARALLELOGRAM);
+  benchmark->Arg(MESH_PREDICTION_MULTI_PARALLELOGRAM);
+  benchmark->Arg(MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+  benchmark->Arg(MESH_PREDICTION_TEX_COORDS_PORTABLE);
+  benchmark->Arg(MESH_PREDICTION_GEOMETRIC_NORMAL);
+  benchmark->Arg(MESH_PREDICTION_TEMPORAL);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PredictionSchemeEncode)->Apply(PredictionSchemeArguments);
+BENCHMARK(BM_PredictionSchemeDecode)->Apply(PredictionSchemeArguments);
+
+}  // namespace draco
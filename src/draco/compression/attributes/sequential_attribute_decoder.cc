@@ -17,7 +17,11 @@
 namespace draco {
 
 SequentialAttributeDecoder::SequentialAttributeDecoder()
-    : decoder_(nullptr), attribute_(nullptr), attribute_id_(-1) {}
+    : decoder_(nullptr),
+      attribute_(nullptr),
+      attribute_id_(-1),
+      output_data_(nullptr),
+      output_byte_stride_(0) {}
 
 bool SequentialAttributeDecoder::Initialize(PointCloudDecoder *decoder,
                                             int attribute_id) {
@@ -36,10 +40,12 @@ bool SequentialAttributeDecoder::InitializeStandalone(
 
 bool SequentialAttributeDecoder::DecodePortableAttribute(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
-  if (!attribute_->Reset(point_ids.size()))
+  if (!InitializeOutputValues(point_ids.size()))
     return false;
   if (!DecodeValues(point_ids, in_buffer))
     return false;
+  if (decoder_)
+    decoder_->OnAttributeDecoded();
   return true;
 }
 
@@ -68,6 +74,60 @@ const PointAttribute *SequentialAttributeDecoder::GetPortableAttribute() {
   return portable_attribute_.get();
 }
 
+bool SequentialAttributeDecoder::InitializeOutputValues(int num_values) {
+  output_data_ = nullptr;
+  output_value_to_point_map_.clear();
+  // External output is used only when the decoded values don't need to be
+  // accessed through the attribute, i.e., not for older files that use the
+  // final attribute values for predictions and not when the attribute
+  // transform is skipped. The value to point map is built only when the
+  // decoder actually provides an external buffer.
+  if (decoder_ &&
+      decoder_->bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0) &&
+      !(decoder_->options() &&
+        decoder_->options()->GetAttributeBool(attribute_->attribute_type(),
+                                              "skip_attribute_transform",
+                                              false)) &&
+      static_cast<PointIndex::ValueType>(num_values) ==
+          decoder_->point_cloud()->num_points()) {
+    output_data_ =
+        decoder_->GetAttributeOutputBuffer(attribute_id_, &output_byte_stride_);
+  }
+  if (output_data_) {
+    // All decoded values are referenced by the points, so when there are as
+    // many values as points the mapping can fail only for corrupted input.
+    if (!InitializeValueToPointMap(num_values))
+      return false;
+    return attribute_->Reset(0);
+  }
+  output_value_to_point_map_.clear();
+  if (!attribute_->Reset(num_values))
+    return false;
+  output_data_ = attribute_->buffer()->data();
+  output_byte_stride_ = attribute_->byte_stride();
+  return true;
+}
+
+bool SequentialAttributeDecoder::InitializeValueToPointMap(int num_values) {
+  const PointIndex::ValueType num_points =
+      decoder_->point_cloud()->num_points();
+  if (static_cast<PointIndex::ValueType>(num_values) != num_points)
+    return false;
+  if (attribute_->is_mapping_identity())
+    return true;  // No map is needed.
+  // Each attribute value must be mapped to exactly one point.
+  output_value_to_point_map_.assign(num_values, kInvalidPointIndex.value());
+  for (PointIndex i(0); i < num_points; ++i) {
+    const AttributeValueIndex::ValueType value_id =
+        attribute_->mapped_index(i).value();
+    if (value_id >= static_cast<AttributeValueIndex::ValueType>(num_values) ||
+        output_value_to_point_map_[value_id] != kInvalidPointIndex.value())
+      return false;
+    output_value_to_point_map_[value_id] = i.value();
+  }
+  return true;
+}
+
 bool SequentialAttributeDecoder::InitPredictionScheme(
     PredictionSchemeInterface *ps) {
   for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
@@ -83,7 +143,8 @@ bool SequentialAttributeDecoder::InitPredictionScheme(
     } else
 #endif
     {
-      if (!ps->SetParentAttribute(decoder_->GetPortableAttribute(att_id))) {
+      if (!ps->SetParentAttribute(
+              decoder_->GetParentPortableAttribute(att_id, attribute_id_))) {
         return false;
       }
     }
@@ -97,13 +158,11 @@ bool SequentialAttributeDecoder::DecodeValues(
   const int entry_size = attribute_->byte_stride();
   std::unique_ptr<uint8_t[]> value_data_ptr(new uint8_t[entry_size]);
   uint8_t *const value_data = value_data_ptr.get();
-  int out_byte_pos = 0;
   // Decode raw attribute values in their original format.
   for (int i = 0; i < num_values; ++i) {
     if (!in_buffer->Decode(value_data, entry_size))
       return false;
-    attribute_->buffer()->Write(out_byte_pos, value_data, entry_size);
-    out_byte_pos += entry_size;
+    StoreOutputValue(i, value_data, entry_size);
   }
   return true;
 }
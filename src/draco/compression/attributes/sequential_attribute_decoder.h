@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_ATTRIBUTE_DECODER_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_ATTRIBUTE_DECODER_H_
 
+#include <cstring>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_interface.h"
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
@@ -71,6 +73,35 @@ class SequentialAttributeDecoder {
 
   PointAttribute *portable_attribute() { return portable_attribute_.get(); }
 
+  // Prepares the storage for |num_values| final values of the attribute. The
+  // values are stored either in the attribute buffer or in external memory
+  // provided by PointCloudDecoder::GetAttributeOutputBuffer().
+  bool InitializeOutputValues(int num_values);
+
+  // Initializes |output_value_to_point_map_| used for storing the final values
+  // in the order of points. Returns false when the values can't be stored in
+  // that order because they are not mapped one-to-one to the points.
+  bool InitializeValueToPointMap(int num_values);
+
+  // Returns the memory where all final values of the attribute can be stored
+  // directly in the order of their ids when each value has |value_size| bytes
+  // or nullptr when the values must be stored using StoreOutputValue().
+  uint8_t *GetContiguousOutputData(int value_size) const {
+    if (!output_value_to_point_map_.empty() ||
+        output_byte_stride_ != value_size)
+      return nullptr;
+    return output_data_;
+  }
+
+  // Stores the final value |value_id| of the attribute. |value| must contain
+  // |value_size| bytes.
+  void StoreOutputValue(int value_id, const void *value, int value_size) {
+    const int64_t output_id = output_value_to_point_map_.empty()
+                                  ? value_id
+                                  : output_value_to_point_map_[value_id];
+    memcpy(output_data_ + output_id * output_byte_stride_, value, value_size);
+  }
+
  private:
   PointCloudDecoder *decoder_;
   PointAttribute *attribute_;
@@ -78,6 +109,13 @@ class SequentialAttributeDecoder {
 
   // Storage for decoded portable attribute (after lossless decoding).
   std::unique_ptr<PointAttribute> portable_attribute_;
+
+  // Memory where the final attribute values are stored.
+  uint8_t *output_data_;
+  int64_t output_byte_stride_;
+  // Optional map between attribute values and their position in
+  // |output_data_| used when the values are stored in the order of points.
+  std::vector<uint32_t> output_value_to_point_map_;
 };
 
 }  // namespace draco
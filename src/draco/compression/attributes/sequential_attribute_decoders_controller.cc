@@ -13,9 +13,13 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
+
+#include <algorithm>
+
 #include "draco/compression/attributes/sequential_normal_attribute_decoder.h"
 #include "draco/compression/attributes/sequential_quantization_attribute_decoder.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/varint_decoding.h"
 
 namespace draco {
 
@@ -59,8 +63,20 @@ bool SequentialAttributeDecodersController::DecodeAttributes(
   return AttributesDecoder::DecodeAttributes(buffer);
 }
 
+bool SequentialAttributeDecodersController::IsAttributeDecodedBefore(
+    int32_t parent_att_id, int32_t att_id) const {
+  const int32_t parent_loc_id = GetLocalIdForPointAttribute(parent_att_id);
+  const int32_t loc_id = GetLocalIdForPointAttribute(att_id);
+  if (parent_loc_id < 0 || loc_id < 0 ||
+      loc_id >= static_cast<int32_t>(levels_.size()))
+    return false;
+  return levels_[parent_loc_id] < levels_[loc_id];
+}
+
 bool SequentialAttributeDecodersController::DecodePortableAttributes(
     DecoderBuffer *in_buffer) {
+  if (GetDecoder()->has_attribute_offsets())
+    return DecodePortableAttributesFromOffsets(in_buffer);
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
     if (!sequential_decoders_[i]->DecodePortableAttribute(point_ids_,
@@ -70,6 +86,76 @@ bool SequentialAttributeDecodersController::DecodePortableAttributes(
   return true;
 }
 
+bool SequentialAttributeDecodersController::
+    DecodePortableAttributesFromOffsets(DecoderBuffer *in_buffer) {
+  // Each portable attribute is preceded by its level in the dependency graph
+  // of this controller and by its data size. Attributes of the same level can
+  // be decoded concurrently from separate buffers.
+  const int32_t num_attributes = GetNumAttributes();
+  levels_.assign(num_attributes, 0);
+  std::vector<uint32_t> data_sizes(num_attributes);
+  int num_levels = 0;
+  int64_t total_data_size = 0;
+  for (int i = 0; i < num_attributes; ++i) {
+    uint8_t level;
+    if (!in_buffer->Decode(&level))
+      return false;
+    if (!DecodeVarint(&data_sizes[i], in_buffer))
+      return false;
+    levels_[i] = level;
+    num_levels = std::max(num_levels, level + 1);
+    total_data_size += data_sizes[i];
+  }
+  if (total_data_size > in_buffer->remaining_size())
+    return false;
+  std::vector<DecoderBuffer> att_buffers(num_attributes);
+  const char *data = in_buffer->data_head();
+  for (int i = 0; i < num_attributes; ++i) {
+    att_buffers[i].Init(data, data_sizes[i], in_buffer->bitstream_version());
+    data += data_sizes[i];
+  }
+
+  // Attributes that are not requested are skipped unless they are on a lower
+  // dependency level than some requested attribute.
+  int max_requested_level = -1;
+  for (int i = 0; i < num_attributes; ++i) {
+    if (GetDecoder()->IsAttributeRequested(GetAttributeId(i)))
+      max_requested_level = std::max(max_requested_level, levels_[i]);
+  }
+
+  ThreadPool *const thread_pool = GetDecoder()->thread_pool();
+  std::vector<uint8_t> is_decoded(num_attributes, false);
+  std::vector<int> level_att_ids;
+  for (int level = 0; level < num_levels; ++level) {
+    level_att_ids.clear();
+    for (int i = 0; i < num_attributes; ++i) {
+      if (levels_[i] == level &&
+          (level < max_requested_level ||
+           GetDecoder()->IsAttributeRequested(GetAttributeId(i))))
+        level_att_ids.push_back(i);
+    }
+    const auto decode_attribute = [&](int i) {
+      const int att_id = level_att_ids[i];
+      is_decoded[att_id] =
+          sequential_decoders_[att_id]->DecodePortableAttribute(
+              point_ids_, &att_buffers[att_id]);
+    };
+    if (thread_pool) {
+      thread_pool->ParallelFor(0, level_att_ids.size(), decode_attribute);
+    } else {
+      for (int i = 0; i < static_cast<int>(level_att_ids.size()); ++i) {
+        decode_attribute(i);
+      }
+    }
+    for (int att_id : level_att_ids) {
+      if (!is_decoded[att_id])
+        return false;
+    }
+  }
+  in_buffer->Advance(total_data_size);
+  return true;
+}
+
 bool SequentialAttributeDecodersController::
     DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) {
   const int32_t num_attributes = GetNumAttributes();
@@ -85,6 +171,10 @@ bool SequentialAttributeDecodersController::
     TransformAttributesToOriginalFormat() {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
+    // Attributes that are not requested are removed from the decoded geometry
+    // and their values may not be decoded at all.
+    if (!GetDecoder()->IsAttributeRequested(GetAttributeId(i)))
+      continue;
     // Check whether the attribute transform should be skipped.
     if (GetDecoder()->options()) {
       const PointAttribute *const attribute =
@@ -41,6 +41,8 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
       return nullptr;
     return sequential_decoders_[loc_id]->GetPortableAttribute();
   }
+  bool IsAttributeDecodedBefore(int32_t parent_att_id,
+                                int32_t att_id) const override;
 
  protected:
   bool DecodePortableAttributes(DecoderBuffer *in_buffer) override;
@@ -50,9 +52,17 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
       uint8_t decoder_type);
 
  private:
+  // Decodes portable attributes stored together with their data sizes (see
+  // ATTRIBUTE_OFFSETS_FLAG_MASK). Independent attributes are decoded
+  // concurrently when the decoder provides a thread pool.
+  bool DecodePortableAttributesFromOffsets(DecoderBuffer *in_buffer);
+
   std::vector<std::unique_ptr<SequentialAttributeDecoder>> sequential_decoders_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
+  // Dependency levels of the attributes decoded by
+  // DecodePortableAttributesFromOffsets().
+  std::vector<int> levels_;
 };
 
 }  // namespace draco
@@ -62,7 +62,10 @@ bool SequentialAttributeEncoder::EncodeDataNeededByPortableTransform(
 bool SequentialAttributeEncoder::EncodeValues(
     const std::vector<PointIndex> &point_ids, EncoderBuffer *out_buffer) {
   PSY_DRACO_PROFILE_SECTION("EncodeValues (Raw format)");
-  const int entry_size = attribute_->byte_stride();
+  // The values may be interleaved with other data so the stride can't be
+  // used as the entry size.
+  const int entry_size =
+      attribute_->num_components() * DataTypeLength(attribute_->data_type());
   const std::unique_ptr<uint8_t[]> value_data_ptr(new uint8_t[entry_size]);
   uint8_t *const value_data = value_data_ptr.get();
   // TODO[nbc]: check identity mapping first for speeding up?
@@ -79,6 +82,11 @@ void SequentialAttributeEncoder::MarkParentAttribute() {
   is_parent_encoder_ = true;
 }
 
+void SequentialAttributeEncoder::Reset() {
+  parent_attributes_.clear();
+  is_parent_encoder_ = false;
+}
+
 bool SequentialAttributeEncoder::InitPredictionScheme(
     PredictionSchemeInterface *ps) {
   for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
@@ -71,6 +71,11 @@ class SequentialAttributeEncoder {
   // encoder.
   void MarkParentAttribute();
 
+  // Clears the parent attributes and the parent flag so that the encoder can
+  // be initialized again for a new attribute. The portable attribute is kept
+  // and its memory is reused by derived encoders when possible.
+  void Reset();
+
   virtual uint8_t GetUniqueId() const {
     return SEQUENTIAL_ATTRIBUTE_ENCODER_GENERIC;
   }
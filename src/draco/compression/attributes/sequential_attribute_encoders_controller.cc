@@ -13,9 +13,13 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
+
+#include <algorithm>
+
 #include "draco/compression/attributes/sequential_normal_attribute_encoder.h"
 #include "draco/compression/attributes/sequential_quantization_attribute_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
+#include "draco/core/varint_encoding.h"
 
 namespace draco {
 
@@ -27,6 +31,14 @@ SequentialAttributeEncodersController::SequentialAttributeEncodersController(
     std::unique_ptr<PointsSequencer> sequencer, int att_id)
     : AttributesEncoder(att_id), sequencer_(std::move(sequencer)) {}
 
+void SequentialAttributeEncodersController::Reset(
+    std::unique_ptr<PointsSequencer> sequencer, int att_id) {
+  ClearAttributeIds();
+  AddAttributeId(att_id);
+  sequencer_ = std::move(sequencer);
+  sequential_encoder_marked_as_parent_.clear();
+}
+
 bool SequentialAttributeEncodersController::Initialize(
     PointCloudEncoder *encoder, const PointCloud *pc) {
   if (!AttributesEncoder::Initialize(encoder, pc))
@@ -55,6 +67,9 @@ bool SequentialAttributeEncodersController::EncodeAttributesEncoderData(
 
 bool SequentialAttributeEncodersController::EncodeAttributes(
     EncoderBuffer *buffer) {
+  // The point ids may still hold the sequence of a previously encoded
+  // geometry.
+  point_ids_.clear();
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_))
     return false;
   return AttributesEncoder::EncodeAttributes(buffer);
@@ -72,6 +87,59 @@ bool SequentialAttributeEncodersController::
 
 bool SequentialAttributeEncodersController::EncodePortableAttributes(
     EncoderBuffer *out_buffer) {
+  ThreadPool *const thread_pool = encoder()->thread_pool();
+  const bool encode_offsets =
+      encoder()->options()->GetGlobalBool("encode_attribute_offsets", false);
+  if (encode_offsets || (thread_pool && sequential_encoders_.size() > 1)) {
+    // All portable attributes (including the parent attributes used for
+    // predictions) are already available at this point, so the attributes
+    // can be encoded concurrently into separate buffers that are appended to
+    // |out_buffer| in the original order.
+    const int num_encoders = sequential_encoders_.size();
+    std::vector<EncoderBuffer> encoder_buffers(num_encoders);
+    std::vector<uint8_t> is_encoded(num_encoders, false);
+    const auto encode_attribute = [&](int i) {
+      is_encoded[i] = sequential_encoders_[i]->EncodePortableAttribute(
+          point_ids_, &encoder_buffers[i]);
+    };
+    if (thread_pool) {
+      thread_pool->ParallelFor(0, num_encoders, encode_attribute);
+    } else {
+      for (int i = 0; i < num_encoders; ++i) {
+        encode_attribute(i);
+      }
+    }
+    if (encode_offsets) {
+      // Store the data size of each attribute together with its level in the
+      // dependency graph of this controller. The decoder can process
+      // attributes with the same level concurrently.
+      std::vector<int> levels(num_encoders, 0);
+      for (int i = 0; i < num_encoders; ++i) {
+        const SequentialAttributeEncoder *const att_enc =
+            sequential_encoders_[i].get();
+        for (int p = 0; p < att_enc->NumParentAttributes(); ++p) {
+          const int32_t parent_id =
+              GetLocalIdForPointAttribute(att_enc->GetParentAttributeId(p));
+          if (parent_id < 0)
+            continue;  // Parent attribute is encoded by another encoder.
+          if (parent_id >= i)
+            return false;  // Parent attribute must be encoded first.
+          levels[i] = std::max(levels[i], levels[parent_id] + 1);
+        }
+        out_buffer->Encode(static_cast<uint8_t>(levels[i]));
+        EncodeVarint(static_cast<uint32_t>(encoder_buffers[i].size()),
+                     out_buffer);
+      }
+    }
+    for (int i = 0; i < num_encoders; ++i) {
+      if (!is_encoded[i])
+        return false;
+      if (!out_buffer->Encode(encoder_buffers[i].data(),
+                              encoder_buffers[i].size()))
+        return false;
+    }
+    return true;
+  }
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
     if (!sequential_encoders_[i]->EncodePortableAttribute(point_ids_,
                                                           out_buffer))
@@ -93,7 +161,14 @@ bool SequentialAttributeEncodersController::
 bool SequentialAttributeEncodersController::CreateSequentialEncoders() {
   sequential_encoders_.resize(num_attributes());
   for (int i = 0; i < num_attributes(); ++i) {
-    sequential_encoders_[i] = CreateSequentialEncoder(i);
+    // Encoders of a previously encoded geometry are reused when they have the
+    // required type.
+    if (sequential_encoders_[i] != nullptr &&
+        sequential_encoders_[i]->GetUniqueId() == GetSequentialEncoderId(i)) {
+      sequential_encoders_[i]->Reset();
+    } else {
+      sequential_encoders_[i] = CreateSequentialEncoder(i);
+    }
     if (sequential_encoders_[i] == nullptr)
       return false;
     if (i < sequential_encoder_marked_as_parent_.size()) {
@@ -106,6 +181,28 @@ bool SequentialAttributeEncodersController::CreateSequentialEncoders() {
 
 std::unique_ptr<SequentialAttributeEncoder>
 SequentialAttributeEncodersController::CreateSequentialEncoder(int i) {
+  switch (GetSequentialEncoderId(i)) {
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_INTEGER:
+      return std::unique_ptr<SequentialAttributeEncoder>(
+          new SequentialIntegerAttributeEncoder());
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_QUANTIZATION:
+      return std::unique_ptr<SequentialAttributeEncoder>(
+          new SequentialQuantizationAttributeEncoder());
+    case SEQUENTIAL_ATTRIBUTE_ENCODER_NORMALS:
+      // We currently only support normals with float coordinates
+      // and must be quantized.
+      return std::unique_ptr<SequentialAttributeEncoder>(
+          new SequentialNormalAttributeEncoder());
+    default:
+      break;
+  }
+  // Return the default attribute encoder.
+  return std::unique_ptr<SequentialAttributeEncoder>(
+      new SequentialAttributeEncoder());
+}
+
+uint8_t SequentialAttributeEncodersController::GetSequentialEncoderId(
+    int i) const {
   const int32_t att_id = GetAttributeId(i);
   const PointAttribute *const att = encoder()->point_cloud()->attribute(att_id);
 
@@ -116,28 +213,21 @@ SequentialAttributeEncodersController::CreateSequentialEncoder(int i) {
     case DT_INT16:
     case DT_UINT32:
     case DT_INT32:
-      return std::unique_ptr<SequentialAttributeEncoder>(
-          new SequentialIntegerAttributeEncoder());
+      return SEQUENTIAL_ATTRIBUTE_ENCODER_INTEGER;
     case DT_FLOAT32:
       if (encoder()->options()->GetAttributeInt(att_id, "quantization_bits",
                                                 -1) > 0) {
         if (att->attribute_type() == GeometryAttribute::NORMAL) {
-          // We currently only support normals with float coordinates
-          // and must be quantized.
-          return std::unique_ptr<SequentialAttributeEncoder>(
-              new SequentialNormalAttributeEncoder());
+          return SEQUENTIAL_ATTRIBUTE_ENCODER_NORMALS;
         } else {
-          return std::unique_ptr<SequentialAttributeEncoder>(
-              new SequentialQuantizationAttributeEncoder());
+          return SEQUENTIAL_ATTRIBUTE_ENCODER_QUANTIZATION;
         }
       }
       break;
     default:
       break;
   }
-  // Return the default attribute encoder.
-  return std::unique_ptr<SequentialAttributeEncoder>(
-      new SequentialAttributeEncoder());
+  return SEQUENTIAL_ATTRIBUTE_ENCODER_GENERIC;
 }
 
 }  // namespace draco
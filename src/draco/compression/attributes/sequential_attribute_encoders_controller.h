@@ -40,6 +40,17 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   bool EncodeAttributes(EncoderBuffer *buffer) override;
   uint8_t GetUniqueId() const override { return BASIC_ATTRIBUTE_ENCODER; }
 
+  // Prepares the controller for encoding of a single attribute |att_id| of a
+  // new geometry using |sequencer|. Sequential encoders created for the
+  // previous geometry are kept and they are reused by Initialize() whenever
+  // the new attribute requires an encoder of the same type.
+  void Reset(std::unique_ptr<PointsSequencer> sequencer, int att_id);
+
+  // Releases the sequencer so that it can be reused (see Reset()).
+  std::unique_ptr<PointsSequencer> ReleaseSequencer() {
+    return std::move(sequencer_);
+  }
+
   int NumParentAttributes(int32_t point_attribute_id) const override {
     const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
     if (loc_id < 0)
@@ -95,6 +106,12 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   virtual std::unique_ptr<SequentialAttributeEncoder> CreateSequentialEncoder(
       int i);
 
+  // Returns the unique id of the sequential encoder created for the i-th
+  // attribute by CreateSequentialEncoder(). Derived classes that override
+  // CreateSequentialEncoder() should override this method as well so that
+  // the existing encoders are reused correctly.
+  virtual uint8_t GetSequentialEncoderId(int i) const;
+
  private:
   std::vector<std::unique_ptr<SequentialAttributeEncoder>> sequential_encoders_;
 
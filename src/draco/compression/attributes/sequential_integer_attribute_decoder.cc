@@ -136,6 +136,10 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
   if (prediction_scheme_) {
     if (!prediction_scheme_->DecodePredictionData(in_buffer))
       return false;
+    if (decoder() && prediction_scheme_->UsesReferenceAttribute()) {
+      prediction_scheme_->SetReferenceAttribute(
+          decoder()->GetReferencePortableAttribute(attribute_id()));
+    }
 
     if (num_values > 0) {
       if (!prediction_scheme_->ComputeOriginalValues(
@@ -145,6 +149,13 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
       }
     }
   }
+  if (decoder() &&
+      decoder()->options()->GetGlobalBool("store_reference_attributes",
+                                          false)) {
+    // Keep the portable data for prediction of the next decoded geometry.
+    decoder()->SetReferencePortableAttribute(attribute_id(),
+                                             *portable_attribute());
+  }
   return true;
 }
 
@@ -182,7 +193,6 @@ void SequentialIntegerAttributeDecoder::StoreTypedValues(uint32_t num_values) {
       new AttributeTypeT[num_components]);
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
   int val_id = 0;
-  int out_byte_pos = 0;
   for (uint32_t i = 0; i < num_values; ++i) {
     for (int c = 0; c < num_components; ++c) {
       const AttributeTypeT value =
@@ -190,8 +200,7 @@ void SequentialIntegerAttributeDecoder::StoreTypedValues(uint32_t num_values) {
       att_val[c] = value;
     }
     // Store the integer value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-    out_byte_pos += entry_size;
+    StoreOutputValue(i, att_val.get(), entry_size);
   }
 }
 
@@ -14,10 +14,11 @@
 //
 #include "draco/compression/attributes/sequential_integer_attribute_encoder.h"
 
+#include <algorithm>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_encoder_factory.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_encoding_transform.h"
 #include "draco/core/bit_utils.h"
-#include "draco/core/symbol_encoding.h"
 #include "draco/psy/psy_draco.h"
 
 namespace draco {
@@ -73,17 +74,16 @@ bool SequentialIntegerAttributeEncoder::TransformAttributeToPortableFormat(
     // (determined by the encoding order).
     const PointAttribute *const orig_att = attribute();
     PointAttribute *const portable_att = portable_attribute();
-    IndexTypeVector<AttributeValueIndex, AttributeValueIndex>
-        value_to_value_map(orig_att->size());
+    value_to_value_map_.assign(orig_att->size(), AttributeValueIndex());
     for (int i = 0; i < point_ids.size(); ++i) {
-      value_to_value_map[orig_att->mapped_index(point_ids[i])] =
+      value_to_value_map_[orig_att->mapped_index(point_ids[i])] =
           AttributeValueIndex(i);
     }
     // Go over all points of the original attribute and update the mapping in
     // the portable attribute.
     for (PointIndex i(0); i < encoder()->point_cloud()->num_points(); ++i) {
       portable_att->SetPointMapEntry(
-          i, value_to_value_map[orig_att->mapped_index(i)]);
+          i, value_to_value_map_[orig_att->mapped_index(i)]);
     }
   }
   return true;
@@ -94,7 +94,9 @@ SequentialIntegerAttributeEncoder::CreateIntPredictionScheme(
     PredictionSchemeMethod method) {
   return CreatePredictionSchemeForEncoder<
       int32_t, PredictionSchemeWrapEncodingTransform<int32_t>>(
-      method, attribute_id(), encoder());
+      method, attribute_id(), encoder(),
+      PredictionSchemeWrapEncodingTransform<int32_t>(),
+      prediction_scheme_owner());
 }
 
 bool SequentialIntegerAttributeEncoder::EncodeValues(
@@ -110,6 +112,10 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     if (!SetPredictionSchemeParentAttributes(prediction_scheme_.get())) {
       return false;
     }
+    if (encoder() && prediction_scheme_->UsesReferenceAttribute()) {
+      prediction_scheme_->SetReferenceAttribute(
+          encoder()->GetReferencePortableAttribute(attribute_id()));
+    }
     prediction_scheme_method =
         static_cast<int8_t>(prediction_scheme_->GetPredictionMethod());
   }
@@ -127,14 +133,14 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
   // result in changes of this data, e.g., by applying prediction schemes that
   // change the data in place. To preserve the portable data we store and
   // process all encoded data in a separate array.
-  std::vector<int32_t> encoded_data(num_values);
+  encoded_data_.resize(num_values);
 
   // All integer values are initialized. Process them using the prediction
   // scheme if we have one.
   if (prediction_scheme_) {
     PSY_DRACO_PROFILE_SECTION("ComputeCorrectionValues");
     prediction_scheme_->ComputeCorrectionValues(
-        portable_attribute_data, &encoded_data[0], num_values, num_components,
+        portable_attribute_data, &encoded_data_[0], num_values, num_components,
         point_ids.data());
   }
 
@@ -142,23 +148,35 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
       !prediction_scheme_->AreCorrectionsPositive()) {
     PSY_DRACO_PROFILE_SECTION("ConvertSignedIntsToSymbols");
     const int32_t *const input =
-        prediction_scheme_ ? encoded_data.data() : portable_attribute_data;
+        prediction_scheme_ ? encoded_data_.data() : portable_attribute_data;
     ConvertSignedIntsToSymbols(input, num_values,
-                               reinterpret_cast<uint32_t *>(&encoded_data[0]));
+                               reinterpret_cast<uint32_t *>(&encoded_data_[0]));
   }
 
   if (encoder() == nullptr || encoder()->options()->GetGlobalBool(
                                   "use_built_in_attribute_compression", true)) {
     PSY_DRACO_PROFILE_SECTION("EncodeSymbols");
     out_buffer->Encode(static_cast<uint8_t>(1));
-    Options symbol_encoding_options;
+    // The symbol encoding options are stored in a member so that the option
+    // entries are allocated only once. No options are used without encoder.
+    const Options *symbol_encoding_options = nullptr;
     if (encoder() != nullptr) {
-      SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
+      SetSymbolEncodingCompressionLevel(&symbol_encoding_options_,
                                         10 - encoder()->options()->GetSpeed());
+      const int num_interleaved_states = encoder()->options()->GetGlobalInt(
+          "symbol_encoding_num_interleaved_states", 1);
+      // A single state is equivalent to the option not being set, but the
+      // option must be overwritten because the options are reused.
+      if (!SetSymbolEncodingNumInterleavedStates(
+              &symbol_encoding_options_, std::max(1, num_interleaved_states))) {
+        return false;
+      }
+      symbol_encoding_options = &symbol_encoding_options_;
     }
-    if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
+    if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data_.data()),
                        point_ids.size() * num_components, num_components,
-                       &symbol_encoding_options, out_buffer)) {
+                       symbol_encoding_options, &symbol_encoding_buffers_,
+                       out_buffer)) {
       return false;
     }
   } else {
@@ -168,7 +186,7 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     // To compute the maximum bit-length, first OR all values.
     uint32_t masked_value = 0;
     for (uint32_t i = 0; i < num_values; ++i) {
-      masked_value |= encoded_data[i];
+      masked_value |= encoded_data_[i];
     }
     // Compute the msb of the ORed value.
     int value_msb_pos = 0;
@@ -181,16 +199,23 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     out_buffer->Encode(static_cast<uint8_t>(num_bytes));
 
     if (num_bytes == DataTypeLength(DT_INT32)) {
-      out_buffer->Encode(encoded_data.data(), sizeof(int32_t) * num_values);
+      out_buffer->Encode(encoded_data_.data(), sizeof(int32_t) * num_values);
     } else {
       for (uint32_t i = 0; i < num_values; ++i) {
-        out_buffer->Encode(encoded_data.data() + i, num_bytes);
+        out_buffer->Encode(encoded_data_.data() + i, num_bytes);
       }
     }
   }
   if (prediction_scheme_) {
     prediction_scheme_->EncodePredictionData(out_buffer);
   }
+  if (encoder() &&
+      encoder()->options()->GetGlobalBool("store_reference_attributes",
+                                          false)) {
+    // Keep the portable data for prediction of the next encoded geometry.
+    encoder()->SetReferencePortableAttribute(attribute_id(),
+                                             *portable_attribute());
+  }
   return true;
 }
 
@@ -215,14 +240,17 @@ bool SequentialIntegerAttributeEncoder::PrepareValues(
 
 void SequentialIntegerAttributeEncoder::PreparePortableAttribute(
     int num_entries, int num_components, int num_points) {
-  GeometryAttribute va;
-  va.Init(attribute()->attribute_type(), nullptr, num_components, DT_INT32,
-          false, num_components * DataTypeLength(DT_INT32), 0);
-  std::unique_ptr<PointAttribute> port_att(new PointAttribute(va));
+  // Reuse the portable attribute of the previously encoded attribute if any.
+  if (portable_attribute() == nullptr)
+    SetPortableAttribute(std::unique_ptr<PointAttribute>(new PointAttribute()));
+  PointAttribute *const port_att = portable_attribute();
+  port_att->Init(attribute()->attribute_type(), nullptr, num_components,
+                 DT_INT32, false, num_components * DataTypeLength(DT_INT32), 0);
   port_att->Reset(num_entries);
-  SetPortableAttribute(std::move(port_att));
+  // Drop any point mapping left from the previously encoded attribute.
+  port_att->SetIdentityMapping();
   if (num_points) {
-    portable_attribute()->SetExplicitMapping(num_points);
+    port_att->SetExplicitMapping(num_points);
   }
 }
 
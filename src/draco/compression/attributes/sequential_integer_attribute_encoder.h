@@ -17,6 +17,8 @@
 
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_encoder.h"
 #include "draco/compression/attributes/sequential_attribute_encoder.h"
+#include "draco/core/options.h"
+#include "draco/core/symbol_encoding.h"
 
 namespace draco {
 
@@ -39,10 +41,17 @@ class SequentialIntegerAttributeEncoder : public SequentialAttributeEncoder {
                     EncoderBuffer *out_buffer) override;
 
   // Returns a prediction scheme that should be used for encoding of the
-  // integer values.
+  // integer values. Implementations can pass prediction_scheme_owner() to
+  // CreatePredictionSchemeForEncoder() to reuse the scheme created for the
+  // previously encoded attribute.
   virtual std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
   CreateIntPredictionScheme(PredictionSchemeMethod method);
 
+  std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
+      *prediction_scheme_owner() {
+    return &prediction_scheme_;
+  }
+
   // Prepares the integer values that are going to be encoded.
   virtual bool PrepareValues(const std::vector<PointIndex> &point_ids,
                              int num_points);
@@ -60,6 +69,13 @@ class SequentialIntegerAttributeEncoder : public SequentialAttributeEncoder {
   // order to make them easier to compress.
   std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
       prediction_scheme_;
+
+  // Data used during the encoding that is kept between calls to avoid
+  // reallocations when the encoder is reused.
+  std::vector<int32_t> encoded_data_;
+  IndexTypeVector<AttributeValueIndex, AttributeValueIndex> value_to_value_map_;
+  Options symbol_encoding_options_;
+  SymbolEncodingBuffers symbol_encoding_buffers_;
 };
 
 }  // namespace draco
@@ -13,6 +13,9 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_normal_attribute_decoder.h"
+
+#include <algorithm>
+
 #include "draco/attributes/attribute_octahedron_transform.h"
 #include "draco/compression/attributes/normal_compression_utils.h"
 
@@ -58,6 +61,11 @@ bool SequentialNormalAttributeDecoder::DecodeDataNeededByPortableTransform(
     quantization_bits_ = quantization_bits;
   }
 
+  // The portable attribute is missing when the values of the attribute were
+  // skipped (see PointCloudDecoder::IsAttributeRequested()).
+  if (portable_attribute() == nullptr)
+    return true;
+
   // Store the decoded transform data in portable attribute.
   AttributeOctahedronTransform octahedral_transform;
   octahedral_transform.SetParameters(quantization_bits_);
@@ -68,18 +76,27 @@ bool SequentialNormalAttributeDecoder::StoreValues(uint32_t num_points) {
   // Convert all quantized values back to floats.
   const int num_components = attribute()->num_components();
   const int entry_size = sizeof(float) * num_components;
-  float att_val[3];
-  int quant_val_id = 0;
-  int out_byte_pos = 0;
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
   const OctahedronToolBox octahedron_tool_box(quantization_bits_);
-  for (uint32_t i = 0; i < num_points; ++i) {
-    const int32_t s = portable_attribute_data[quant_val_id++];
-    const int32_t t = portable_attribute_data[quant_val_id++];
-    octahedron_tool_box.QuantizedOctaherdalCoordsToUnitVector(s, t, att_val);
-    // Store the decoded floating point value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val, entry_size);
-    out_byte_pos += entry_size;
+  float *const output_data =
+      reinterpret_cast<float *>(GetContiguousOutputData(entry_size));
+  if (output_data) {
+    // Decode all normals directly into the output memory.
+    octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+        portable_attribute_data, num_points, output_data);
+    return true;
+  }
+  // Decode the normals in small batches and store them one by one.
+  const uint32_t kBatchSize = 256;
+  float att_vals[kBatchSize * 3];
+  for (uint32_t i = 0; i < num_points; i += kBatchSize) {
+    const uint32_t batch_size = std::min(kBatchSize, num_points - i);
+    octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+        portable_attribute_data + 2 * i, batch_size, att_vals);
+    for (uint32_t j = 0; j < batch_size; ++j) {
+      // Store the decoded floating point value into the attribute buffer.
+      StoreOutputValue(i + j, att_vals + 3 * j, entry_size);
+    }
   }
   return true;
 }
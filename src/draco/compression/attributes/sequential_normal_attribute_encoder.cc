@@ -41,9 +41,11 @@ bool SequentialNormalAttributeEncoder::EncodeDataNeededByPortableTransform(
 
 bool SequentialNormalAttributeEncoder::PrepareValues(
     const std::vector<PointIndex> &point_ids, int num_points) {
-  SetPortableAttribute(
-      attribute_octahedron_transform_.GeneratePortableAttribute(
-          *(attribute()), point_ids, num_points));
+  // Reuse the portable attribute of the previously encoded attribute if any.
+  if (portable_attribute() == nullptr)
+    SetPortableAttribute(std::unique_ptr<PointAttribute>(new PointAttribute()));
+  attribute_octahedron_transform_.GeneratePortableAttribute(
+      *(attribute()), point_ids, num_points, portable_attribute());
   return true;
 }
 
@@ -60,11 +60,12 @@ class SequentialNormalAttributeEncoder
     if (prediction_method == MESH_PREDICTION_GEOMETRIC_NORMAL) {
       return CreatePredictionSchemeForEncoder<int32_t, Transform>(
           MESH_PREDICTION_GEOMETRIC_NORMAL, attribute_id(), encoder(),
-          transform);
+          transform, prediction_scheme_owner());
     }
     if (prediction_method == PREDICTION_DIFFERENCE) {
       return CreatePredictionSchemeForEncoder<int32_t, Transform>(
-          PREDICTION_DIFFERENCE, attribute_id(), encoder(), transform);
+          PREDICTION_DIFFERENCE, attribute_id(), encoder(), transform,
+          prediction_scheme_owner());
     }
     DCHECK(false);  // Should never be reached.
     return nullptr;
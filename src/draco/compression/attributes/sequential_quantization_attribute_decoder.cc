@@ -14,6 +14,8 @@
 //
 #include "draco/compression/attributes/sequential_quantization_attribute_decoder.h"
 
+#include <algorithm>
+
 #include "draco/attributes/attribute_quantization_transform.h"
 #include "draco/core/quantization_utils.h"
 
@@ -38,7 +40,7 @@ bool SequentialQuantizationAttributeDecoder::DecodeIntegerValues(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder()->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0) &&
-      !DecodeQuantizedDataInfo())
+      !DecodeQuantizedDataInfo(in_buffer))
     return false;
 #endif
   return SequentialIntegerAttributeDecoder::DecodeIntegerValues(point_ids,
@@ -50,10 +52,15 @@ bool SequentialQuantizationAttributeDecoder::
         const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   if (decoder()->bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0)) {
     // Decode quantization data here only for files with bitstream version 2.0+
-    if (!DecodeQuantizedDataInfo())
+    if (!DecodeQuantizedDataInfo(in_buffer))
       return false;
   }
 
+  // The portable attribute is missing when the values of the attribute were
+  // skipped (see PointCloudDecoder::IsAttributeRequested()).
+  if (portable_attribute() == nullptr)
+    return true;
+
   // Store the decoded transform data in portable attribute;
   AttributeQuantizationTransform transform;
   transform.SetParameters(quantization_bits_, min_value_.get(),
@@ -65,17 +72,16 @@ bool SequentialQuantizationAttributeDecoder::StoreValues(uint32_t num_values) {
   return DequantizeValues(num_values);
 }
 
-bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
+bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo(
+    DecoderBuffer *in_buffer) {
   const int num_components = attribute()->num_components();
   min_value_ = std::unique_ptr<float[]>(new float[num_components]);
-  if (!decoder()->buffer()->Decode(min_value_.get(),
-                                   sizeof(float) * num_components))
+  if (!in_buffer->Decode(min_value_.get(), sizeof(float) * num_components))
     return false;
-  if (!decoder()->buffer()->Decode(&max_value_dif_))
+  if (!in_buffer->Decode(&max_value_dif_))
     return false;
   uint8_t quantization_bits;
-  if (!decoder()->buffer()->Decode(&quantization_bits) ||
-      quantization_bits > 31)
+  if (!in_buffer->Decode(&quantization_bits) || quantization_bits > 31)
     return false;
   quantization_bits_ = quantization_bits;
   return true;
@@ -88,23 +94,33 @@ bool SequentialQuantizationAttributeDecoder::DequantizeValues(
       (1u << static_cast<uint32_t>(quantization_bits_)) - 1;
   const int num_components = attribute()->num_components();
   const int entry_size = sizeof(float) * num_components;
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
-  int quant_val_id = 0;
-  int out_byte_pos = 0;
   Dequantizer dequantizer;
   if (!dequantizer.Init(max_value_dif_, max_quantized_value))
     return false;
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
-  for (uint32_t i = 0; i < num_values; ++i) {
-    for (int c = 0; c < num_components; ++c) {
-      float value =
-          dequantizer.DequantizeFloat(portable_attribute_data[quant_val_id++]);
-      value = value + min_value_[c];
-      att_val[c] = value;
+  float *const output_data =
+      reinterpret_cast<float *>(GetContiguousOutputData(entry_size));
+  if (output_data) {
+    // Dequantize all values directly into the output memory.
+    dequantizer.DequantizeFloats(portable_attribute_data,
+                                 num_values * num_components, num_components,
+                                 min_value_.get(), output_data);
+    return true;
+  }
+  // Dequantize the values in small batches and store them one by one.
+  const uint32_t kBatchSize = 256;
+  const std::unique_ptr<float[]> att_vals(
+      new float[kBatchSize * num_components]);
+  for (uint32_t i = 0; i < num_values; i += kBatchSize) {
+    const uint32_t batch_size = std::min(kBatchSize, num_values - i);
+    dequantizer.DequantizeFloats(
+        portable_attribute_data + i * num_components,
+        batch_size * num_components, num_components, min_value_.get(),
+        att_vals.get());
+    for (uint32_t j = 0; j < batch_size; ++j) {
+      // Store the floating point value into the attribute buffer.
+      StoreOutputValue(i + j, att_vals.get() + j * num_components, entry_size);
     }
-    // Store the floating point value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-    out_byte_pos += entry_size;
   }
   return true;
 }
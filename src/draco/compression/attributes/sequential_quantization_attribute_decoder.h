@@ -36,7 +36,7 @@ class SequentialQuantizationAttributeDecoder
   bool StoreValues(uint32_t num_points) override;
 
   // Decodes data necessary for dequantizing the encoded values.
-  virtual bool DecodeQuantizedDataInfo();
+  virtual bool DecodeQuantizedDataInfo(DecoderBuffer *in_buffer);
 
   // Dequantizes all values and stores them into the output attribute.
   virtual bool DequantizeValues(uint32_t num_values);
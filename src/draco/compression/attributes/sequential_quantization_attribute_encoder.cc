@@ -41,17 +41,19 @@ bool SequentialQuantizationAttributeEncoder::Initialize(
       encoder->options()->IsAttributeOptionSet(attribute_id,
                                                "quantization_range")) {
     // Quantization settings are explicitly specified in the provided options.
-    std::vector<float> quantization_origin(attribute->num_components());
+    quantization_origin_.resize(attribute->num_components());
     encoder->options()->GetAttributeVector(attribute_id, "quantization_origin",
                                            attribute->num_components(),
-                                           &quantization_origin[0]);
+                                           &quantization_origin_[0]);
     const float range = encoder->options()->GetAttributeFloat(
         attribute_id, "quantization_range", 1.f);
     attribute_quantization_transform_.SetParameters(
-        quantization_bits, quantization_origin.data(),
+        quantization_bits, quantization_origin_.data(),
         attribute->num_components(), range);
   } else {
-    // Compute quantization settings from the attribute values.
+    // Compute quantization settings from the attribute values. The transform
+    // may still hold parameters of a previously encoded attribute.
+    attribute_quantization_transform_.ClearParameters();
     attribute_quantization_transform_.ComputeParameters(*attribute,
                                                         quantization_bits);
   }
@@ -65,9 +67,11 @@ bool SequentialQuantizationAttributeEncoder::
 
 bool SequentialQuantizationAttributeEncoder::PrepareValues(
     const std::vector<PointIndex> &point_ids, int num_points) {
-  SetPortableAttribute(
-      attribute_quantization_transform_.GeneratePortableAttribute(
-          *(attribute()), point_ids, num_points));
+  // Reuse the portable attribute of the previously encoded attribute if any.
+  if (portable_attribute() == nullptr)
+    SetPortableAttribute(std::unique_ptr<PointAttribute>(new PointAttribute()));
+  attribute_quantization_transform_.GeneratePortableAttribute(
+      *(attribute()), point_ids, num_points, portable_attribute());
   return true;
 }
 
@@ -45,6 +45,9 @@ class SequentialQuantizationAttributeEncoder
  private:
   // Used for the quantization.
   AttributeQuantizationTransform attribute_quantization_transform_;
+
+  // Storage for the quantization origin read from the encoder options.
+  std::vector<float> quantization_origin_;
 };
 
 }  // namespace draco
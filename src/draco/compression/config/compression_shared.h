@@ -84,6 +84,9 @@ enum PredictionSchemeMethod {
   MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM = 4,
   MESH_PREDICTION_TEX_COORDS_PORTABLE = 5,
   MESH_PREDICTION_GEOMETRIC_NORMAL = 6,
+  // Predicts values from the previously encoded frame. Requires the same
+  // encoder and decoder instances to be reused for all frames of a sequence.
+  MESH_PREDICTION_TEMPORAL = 7,
   NUM_PREDICTION_SCHEMES
 };
 
@@ -138,12 +141,29 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Same as SYMBOL_CODING_RAW but the symbols are coded with multiple
+  // interleaved rANS states that can be decoded faster.
+  SYMBOL_CODING_RAW_INTERLEAVED = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
 // Mask for setting and getting the bit for metadata in |flags| of header.
 #define METADATA_FLAG_MASK 0x8000
 
+// Mask for the bit in |flags| of header that signals that the sizes of the
+// data of individual attribute decoders are stored in front of the attribute
+// data. This allows the attribute decoders to locate their data without
+// decoding the preceding attributes (e.g. to decode them in parallel).
+#define ATTRIBUTE_OFFSETS_FLAG_MASK 0x4000
+
+// Mask for the bit in |flags| of header that signals that the header is
+// followed by a summary of the encoded geometry: the number of points and
+// faces of the decoded geometry and the descriptors of all its attributes.
+// The summary is preceded by its byte size so decoders can skip it. It allows
+// the summary to be read without decoding the geometry (see
+// Decoder::GetEncodedGeometryInfo()).
+#define GEOMETRY_INFO_FLAG_MASK 0x2000
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_CONFIG_COMPRESSION_SHARED_H_
@@ -57,7 +57,13 @@ class DracoOptions {
   // an attribute specific storage, the implementation will return a global
   // option of the given name (if available). If the option is not found, the
   // provided default value |default_val| is returned instead.
+  // All getters can be also called with a C string |name| in which case they
+  // don't allocate any memory (see Options).
   int GetAttributeInt(const AttributeKey &att_key, const std::string &name,
+                      int default_val) const {
+    return GetAttributeInt(att_key, name.c_str(), default_val);
+  }
+  int GetAttributeInt(const AttributeKey &att_key, const char *name,
                       int default_val) const;
 
   // Sets an option for a specific attribute key.
@@ -65,39 +71,65 @@ class DracoOptions {
                        int val);
 
   float GetAttributeFloat(const AttributeKey &att_key, const std::string &name,
+                          float default_val) const {
+    return GetAttributeFloat(att_key, name.c_str(), default_val);
+  }
+  float GetAttributeFloat(const AttributeKey &att_key, const char *name,
                           float default_val) const;
   void SetAttributeFloat(const AttributeKey &att_key, const std::string &name,
                          float val);
   bool GetAttributeBool(const AttributeKey &att_key, const std::string &name,
+                        bool default_val) const {
+    return GetAttributeBool(att_key, name.c_str(), default_val);
+  }
+  bool GetAttributeBool(const AttributeKey &att_key, const char *name,
                         bool default_val) const;
   void SetAttributeBool(const AttributeKey &att_key, const std::string &name,
                         bool val);
   template <typename DataTypeT>
   bool GetAttributeVector(const AttributeKey &att_key, const std::string &name,
+                          int num_dims, DataTypeT *val) const {
+    return GetAttributeVector(att_key, name.c_str(), num_dims, val);
+  }
+  template <typename DataTypeT>
+  bool GetAttributeVector(const AttributeKey &att_key, const char *name,
                           int num_dims, DataTypeT *val) const;
   template <typename DataTypeT>
   void SetAttributeVector(const AttributeKey &att_key, const std::string &name,
                           int num_dims, const DataTypeT *val);
 
   bool IsAttributeOptionSet(const AttributeKey &att_key,
-                            const std::string &name) const;
+                            const std::string &name) const {
+    return IsAttributeOptionSet(att_key, name.c_str());
+  }
+  bool IsAttributeOptionSet(const AttributeKey &att_key,
+                            const char *name) const;
 
   // Gets/sets a global option that is not specific to any attribute.
   int GetGlobalInt(const std::string &name, int default_val) const {
     return global_options_.GetInt(name, default_val);
   }
+  int GetGlobalInt(const char *name, int default_val) const {
+    return global_options_.GetInt(name, default_val);
+  }
   void SetGlobalInt(const std::string &name, int val) {
     global_options_.SetInt(name, val);
   }
   float GetGlobalFloat(const std::string &name, float default_val) const {
     return global_options_.GetFloat(name, default_val);
   }
+  float GetGlobalFloat(const char *name, float default_val) const {
+    return global_options_.GetFloat(name, default_val);
+  }
   void SetGlobalFloat(const std::string &name, float val) {
     global_options_.SetFloat(name, val);
   }
   bool GetGlobalBool(const std::string &name, bool default_val) const {
     return global_options_.GetBool(name, default_val);
   }
+  bool GetGlobalBool(const char *name, bool default_val) const {
+    return global_options_.GetBool(name, default_val);
+  }
   void SetGlobalBool(const std::string &name, bool val) {
     global_options_.SetBool(name, val);
   }
@@ -107,6 +139,10 @@ class DracoOptions {
     return global_options_.GetVector(name, num_dims, val);
   }
   template <typename DataTypeT>
+  bool GetGlobalVector(const char *name, int num_dims, DataTypeT *val) const {
+    return global_options_.GetVector(name, num_dims, val);
+  }
+  template <typename DataTypeT>
   void SetGlobalVector(const std::string &name, int num_dims,
                        const DataTypeT *val) {
     global_options_.SetVector(name, val, num_dims);
@@ -114,6 +150,9 @@ class DracoOptions {
   bool IsGlobalOptionSet(const std::string &name) const {
     return global_options_.IsOptionSet(name);
   }
+  bool IsGlobalOptionSet(const char *name) const {
+    return global_options_.IsOptionSet(name);
+  }
 
   // Sets or replaces attribute options with the provided |options|.
   void SetAttributeOptions(const AttributeKey &att_key, const Options &options);
@@ -156,7 +195,7 @@ Options *DracoOptions<AttributeKeyT>::GetAttributeOptions(
 
 template <typename AttributeKeyT>
 int DracoOptions<AttributeKeyT>::GetAttributeInt(const AttributeKeyT &att_key,
-                                                 const std::string &name,
+                                                 const char *name,
                                                  int default_val) const {
   const Options *const att_options = FindAttributeOptions(att_key);
   if (att_options && att_options->IsOptionSet(name))
@@ -173,8 +212,7 @@ void DracoOptions<AttributeKeyT>::SetAttributeInt(const AttributeKeyT &att_key,
 
 template <typename AttributeKeyT>
 float DracoOptions<AttributeKeyT>::GetAttributeFloat(
-    const AttributeKeyT &att_key, const std::string &name,
-    float default_val) const {
+    const AttributeKeyT &att_key, const char *name, float default_val) const {
   const Options *const att_options = FindAttributeOptions(att_key);
   if (att_options && att_options->IsOptionSet(name))
     return att_options->GetFloat(name, default_val);
@@ -189,7 +227,7 @@ void DracoOptions<AttributeKeyT>::SetAttributeFloat(
 
 template <typename AttributeKeyT>
 bool DracoOptions<AttributeKeyT>::GetAttributeBool(const AttributeKeyT &att_key,
-                                                   const std::string &name,
+                                                   const char *name,
                                                    bool default_val) const {
   const Options *const att_options = FindAttributeOptions(att_key);
   if (att_options && att_options->IsOptionSet(name))
@@ -207,7 +245,7 @@ void DracoOptions<AttributeKeyT>::SetAttributeBool(const AttributeKeyT &att_key,
 template <typename AttributeKeyT>
 template <typename DataTypeT>
 bool DracoOptions<AttributeKeyT>::GetAttributeVector(
-    const AttributeKey &att_key, const std::string &name, int num_dims,
+    const AttributeKey &att_key, const char *name, int num_dims,
     DataTypeT *val) const {
   const Options *const att_options = FindAttributeOptions(att_key);
   if (att_options && att_options->IsOptionSet(name))
@@ -225,7 +263,7 @@ void DracoOptions<AttributeKeyT>::SetAttributeVector(
 
 template <typename AttributeKeyT>
 bool DracoOptions<AttributeKeyT>::IsAttributeOptionSet(
-    const AttributeKey &att_key, const std::string &name) const {
+    const AttributeKey &att_key, const char *name) const {
   const Options *const att_options = FindAttributeOptions(att_key);
   if (att_options)
     return att_options->IsOptionSet(name);
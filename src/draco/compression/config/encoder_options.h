@@ -73,6 +73,9 @@ class EncoderOptionsBase : public DracoOptions<AttributeKeyT> {
   bool IsFeatureSupported(const std::string &name) const {
     return feature_options_.GetBool(name);
   }
+  bool IsFeatureSupported(const char *name) const {
+    return feature_options_.GetBool(name);
+  }
 
   void SetFeatureOptions(const Options &options) { feature_options_ = options; }
   const Options &GetFeaturelOptions() const { return feature_options_; }
@@ -14,7 +14,11 @@
 //
 #include "draco/compression/decode.h"
 
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/varint_decoding.h"
+#include "draco/metadata/metadata_decoder.h"
 
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
 #include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
@@ -52,6 +56,8 @@ StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method) {
 }
 #endif
 
+Decoder::Decoder() : memory_arena_(nullptr) {}
+
 StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
     DecoderBuffer *in_buffer) {
   DecoderBuffer temp_buffer(*in_buffer);
@@ -60,10 +66,81 @@ StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
   return static_cast<EncodedGeometryType>(header.encoder_type);
 }
 
+StatusOr<std::unique_ptr<EncodedGeometryInfo>> Decoder::GetEncodedGeometryInfo(
+    DecoderBuffer *in_buffer) {
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  std::unique_ptr<EncodedGeometryInfo> info(new EncodedGeometryInfo());
+  info->geometry_type = static_cast<EncodedGeometryType>(header.encoder_type);
+  info->encoding_method = header.encoder_method;
+  info->version_major = header.version_major;
+  info->version_minor = header.version_minor;
+  const uint16_t version =
+      DRACO_BITSTREAM_VERSION(header.version_major, header.version_minor);
+  if (version > kDracoBitstreamVersion)
+    return Status(Status::UNKNOWN_VERSION, "Unknown version.");
+  temp_buffer.set_bitstream_version(version);
+
+  constexpr char kIoErrorMsg[] = "Failed to parse geometry info.";
+  if (version >= DRACO_BITSTREAM_VERSION(2, 2) &&
+      (header.flags & GEOMETRY_INFO_FLAG_MASK)) {
+    uint32_t info_size;
+    if (!DecodeVarint(&info_size, &temp_buffer) ||
+        info_size > temp_buffer.remaining_size())
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    DecoderBuffer info_buffer;
+    info_buffer.Init(temp_buffer.data_head(), info_size, version);
+    temp_buffer.Advance(info_size);
+    uint64_t num_points, num_faces;
+    uint32_t num_attributes;
+    if (!DecodeVarint(&num_points, &info_buffer) ||
+        !DecodeVarint(&num_faces, &info_buffer) ||
+        !DecodeVarint(&num_attributes, &info_buffer))
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    if (num_attributes > info_buffer.remaining_size())
+      return Status(Status::IO_ERROR, kIoErrorMsg);
+    info->num_points = num_points;
+    info->num_faces = num_faces;
+    for (uint32_t i = 0; i < num_attributes; ++i) {
+      uint8_t att_type, data_type, num_components, normalized;
+      uint32_t unique_id;
+      if (!info_buffer.Decode(&att_type) || !info_buffer.Decode(&data_type) ||
+          !info_buffer.Decode(&num_components) ||
+          !info_buffer.Decode(&normalized) ||
+          !DecodeVarint(&unique_id, &info_buffer))
+        return Status(Status::IO_ERROR, kIoErrorMsg);
+      if (data_type <= DT_INVALID || data_type >= DT_TYPES_COUNT)
+        return Status(Status::ERROR, "Invalid attribute data type.");
+      const DataType draco_dt = static_cast<DataType>(data_type);
+      GeometryAttribute att;
+      att.Init(static_cast<GeometryAttribute::Type>(att_type), nullptr,
+               num_components, draco_dt, normalized > 0,
+               DataTypeLength(draco_dt) * num_components, 0);
+      att.set_unique_id(unique_id);
+      info->attributes.push_back(att);
+    }
+    info->has_geometry_info = true;
+  }
+
+  if (version >= DRACO_BITSTREAM_VERSION(1, 3) &&
+      (header.flags & METADATA_FLAG_MASK)) {
+    std::unique_ptr<GeometryMetadata> metadata(new GeometryMetadata());
+    MetadataDecoder metadata_decoder;
+    if (!metadata_decoder.DecodeGeometryMetadata(&temp_buffer, metadata.get()))
+      return Status(Status::ERROR, "Failed to decode metadata.");
+    info->metadata = std::move(metadata);
+  }
+  return info;
+}
+
 StatusOr<std::unique_ptr<PointCloud>> Decoder::DecodePointCloudFromBuffer(
     DecoderBuffer *in_buffer) {
   DRACO_ASSIGN_OR_RETURN(EncodedGeometryType type,
                          GetEncodedGeometryType(in_buffer))
+  // The geometry is created within the arena scope so that all its data is
+  // allocated from the arena.
+  const ScopedMemoryArena arena_scope(memory_arena_);
   if (type == POINT_CLOUD) {
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
     std::unique_ptr<PointCloud> point_cloud(new PointCloud());
@@ -82,6 +159,7 @@ StatusOr<std::unique_ptr<PointCloud>> Decoder::DecodePointCloudFromBuffer(
 
 StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeMeshFromBuffer(
     DecoderBuffer *in_buffer) {
+  const ScopedMemoryArena arena_scope(memory_arena_);
   std::unique_ptr<Mesh> mesh(new Mesh());
   DRACO_RETURN_IF_ERROR(DecodeBufferToGeometry(in_buffer, mesh.get()))
   return std::move(mesh);
@@ -96,6 +174,7 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != POINT_CLOUD) {
     return Status(Status::ERROR, "Input is not a point cloud.");
   }
+  const ScopedMemoryArena arena_scope(memory_arena_);
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloudDecoder> decoder,
                          CreatePointCloudDecoder(header.encoder_method))
 
@@ -115,6 +194,7 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != TRIANGULAR_MESH) {
     return Status(Status::ERROR, "Input is not a mesh.");
   }
+  const ScopedMemoryArena arena_scope(memory_arena_);
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
                          CreateMeshDecoder(header.encoder_method))
 
@@ -129,4 +209,27 @@ void Decoder::SetSkipAttributeTransform(GeometryAttribute::Type att_type) {
   options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
 }
 
+void Decoder::AddAttributeTypeToDecode(GeometryAttribute::Type att_type) {
+  options_.SetGlobalBool("decode_selected_attributes", true);
+  options_.SetAttributeBool(att_type, "decode_attribute", true);
+}
+
+void Decoder::AddAttributeUniqueIdToDecode(uint32_t unique_id) {
+  options_.SetGlobalBool("decode_selected_attributes", true);
+  const int num_unique_ids =
+      options_.GetGlobalInt("num_attribute_unique_ids_to_decode", 0);
+  std::vector<uint32_t> unique_ids(num_unique_ids + 1);
+  options_.GetGlobalVector("attribute_unique_ids_to_decode", num_unique_ids,
+                           unique_ids.data());
+  unique_ids[num_unique_ids] = unique_id;
+  options_.SetGlobalVector("attribute_unique_ids_to_decode",
+                           num_unique_ids + 1, unique_ids.data());
+  options_.SetGlobalInt("num_attribute_unique_ids_to_decode",
+                        num_unique_ids + 1);
+}
+
+void Decoder::SetNumDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_decoding_threads", num_threads);
+}
+
 }  // namespace draco
@@ -18,15 +18,49 @@
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/decoder_buffer.h"
+#include "draco/core/memory_arena.h"
 #include "draco/core/statusor.h"
 #include "draco/mesh/mesh.h"
+#include "draco/metadata/geometry_metadata.h"
 
 namespace draco {
 
+// Summary of encoded geometry returned by Decoder::GetEncodedGeometryInfo().
+struct EncodedGeometryInfo {
+  EncodedGeometryInfo()
+      : geometry_type(INVALID_GEOMETRY_TYPE),
+        encoding_method(0),
+        version_major(0),
+        version_minor(0),
+        has_geometry_info(false),
+        num_points(0),
+        num_faces(0) {}
+
+  EncodedGeometryType geometry_type;
+  // One of the MeshEncoderMethod or PointCloudEncodingMethod values.
+  int encoding_method;
+  uint8_t version_major;
+  uint8_t version_minor;
+  // Set when the data was encoded with Encoder::SetEncodeGeometryInfo(). The
+  // number of points and faces and the attributes are available only in that
+  // case.
+  bool has_geometry_info;
+  // Number of points and faces of the decoded geometry.
+  int64_t num_points;
+  int64_t num_faces;
+  // Descriptors of the decoded attributes in the order of their attribute ids.
+  // The attributes don't contain any data.
+  std::vector<GeometryAttribute> attributes;
+  // Geometry metadata or nullptr when the data doesn't contain any metadata.
+  std::unique_ptr<GeometryMetadata> metadata;
+};
+
 // Class responsible for decoding of meshes and point clouds that were
 // compressed by a Draco encoder.
 class Decoder {
  public:
+  Decoder();
+
   // Returns the geometry type encoded in the input |in_buffer|.
   // The return value is one of POINT_CLOUD, MESH or INVALID_GEOMETRY in case
   // the input data is invalid.
@@ -35,6 +69,14 @@ class Decoder {
   static StatusOr<EncodedGeometryType> GetEncodedGeometryType(
       DecoderBuffer *in_buffer);
 
+  // Returns the summary of the geometry encoded in |in_buffer| without
+  // decoding the geometry. Only the header, the metadata and the optional
+  // geometry info (see Encoder::SetEncodeGeometryInfo()) are parsed, so the
+  // cost doesn't depend on the size of the geometry. |in_buffer| is not
+  // modified.
+  static StatusOr<std::unique_ptr<EncodedGeometryInfo>> GetEncodedGeometryInfo(
+      DecoderBuffer *in_buffer);
+
   // Decodes point cloud from the provided buffer. The buffer must be filled
   // with data that was encoded with either the EncodePointCloudToBuffer or
   // EncodeMeshToBuffer methods in encode.h. In case the input buffer contains
@@ -66,12 +108,44 @@ class Decoder {
   // transform manually.
   void SetSkipAttributeTransform(GeometryAttribute::Type att_type);
 
+  // Restricts decoding to attributes of type |att_type| and to attributes
+  // added by other calls of AddAttributeTypeToDecode() and
+  // AddAttributeUniqueIdToDecode(). All other attributes are removed from the
+  // decoded geometry. When the data was encoded with attribute offsets (see
+  // Encoder::SetEncodeAttributeOffsets()), the data of the removed attributes
+  // is skipped without being decoded, unless a requested attribute depends on
+  // it (e.g. positions are still decoded for normals predicted from the
+  // geometry). By default, all attributes are decoded.
+  void AddAttributeTypeToDecode(GeometryAttribute::Type att_type);
+
+  // Same as AddAttributeTypeToDecode() but selects the attribute by its unique
+  // id.
+  void AddAttributeUniqueIdToDecode(uint32_t unique_id);
+
+  // Sets the maximum number of threads that can be used to decode independent
+  // attributes concurrently. Only data encoded with stored attribute offsets
+  // (see Encoder::SetEncodeAttributeOffsets()) can be decoded in parallel,
+  // other data is always decoded on the calling thread. The decoded geometry
+  // is identical to the geometry produced by a single threaded decoder.
+  // Default: [1].
+  void SetNumDecodingThreads(int num_threads);
+
+  // Sets the memory arena used for all allocations of the decoder, including
+  // the data of the geometries returned by DecodePointCloudFromBuffer() and
+  // DecodeMeshFromBuffer(). Geometries passed to DecodeBufferToGeometry()
+  // should be created while the arena is made current by ScopedMemoryArena.
+  // All decoded geometries must be destroyed before MemoryArena::Reset() or
+  // MemoryArena::Release() is called to free their memory all at once.
+  // nullptr means that the heap is used. Default: [nullptr].
+  void SetMemoryArena(MemoryArena *arena) { memory_arena_ = arena; }
+
   // Returns the options instance used by the decoder that can be used by users
   // to control the decoding process.
   DecoderOptions *options() { return &options_; }
 
  private:
   DecoderOptions options_;
+  MemoryArena *memory_arena_;
 };
 
 }  // namespace draco
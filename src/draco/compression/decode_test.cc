@@ -14,18 +14,68 @@
 //
 #include "draco/compression/decode.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <fstream>
 #include <sstream>
 
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_sequential_decoder.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/varint_decoding.h"
 
 namespace {
 
+// Decoder that stores the decoded positions into an interleaved buffer with
+// a custom stride.
+class ExternalPositionsDecoder : public draco::MeshEdgeBreakerDecoder {
+ public:
+  static constexpr int kStride = 32;
+
+  uint8_t *GetAttributeOutputBuffer(int32_t att_id,
+                                    int64_t *out_byte_stride) override {
+    if (point_cloud()->attribute(att_id)->attribute_type() !=
+        draco::GeometryAttribute::POSITION)
+      return nullptr;
+    positions_.resize(point_cloud()->num_points() * kStride);
+    *out_byte_stride = kStride;
+    return positions_.data();
+  }
+
+  const std::vector<uint8_t> &positions() const { return positions_; }
+
+ private:
+  std::vector<uint8_t> positions_;
+};
+
 class DecodeTest : public ::testing::Test {
  protected:
   DecodeTest() {}
+
+  // Verifies that both meshes have the same faces and that all their
+  // attribute values are bitwise identical.
+  void VerifyMeshesAreIdentical(const draco::Mesh &mesh0,
+                                const draco::Mesh &mesh1) {
+    ASSERT_EQ(mesh0.num_faces(), mesh1.num_faces());
+    ASSERT_EQ(mesh0.num_points(), mesh1.num_points());
+    ASSERT_EQ(mesh0.num_attributes(), mesh1.num_attributes());
+    for (draco::FaceIndex f(0); f < mesh0.num_faces(); ++f) {
+      ASSERT_EQ(mesh0.face(f), mesh1.face(f));
+    }
+    for (int a = 0; a < mesh0.num_attributes(); ++a) {
+      const draco::PointAttribute *const att0 = mesh0.attribute(a);
+      const draco::PointAttribute *const att1 = mesh1.attribute(a);
+      ASSERT_EQ(att0->attribute_type(), att1->attribute_type());
+      ASSERT_EQ(att0->byte_stride(), att1->byte_stride());
+      for (draco::PointIndex p(0); p < mesh0.num_points(); ++p) {
+        ASSERT_EQ(0, memcmp(att0->GetAddressOfMappedIndex(p),
+                            att1->GetAddressOfMappedIndex(p),
+                            att0->byte_stride()));
+      }
+    }
+  }
 };
 
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -76,4 +126,418 @@ TEST_F(DecodeTest, TestSkipAttributeTransform) {
 }
 #endif
 
+TEST_F(DecodeTest, TestParallelDecoding) {
+  // Tests that data encoded with attribute offsets can be decoded on multiple
+  // threads and that the decoded meshes are the same as the meshes decoded
+  // from the regular data.
+  const std::string file_names[] = {"test_nm.obj", "cube_att.obj"};
+  const int encoding_methods[] = {draco::MESH_SEQUENTIAL_ENCODING,
+                                  draco::MESH_EDGEBREAKER_ENCODING};
+  for (const std::string &file_name : file_names) {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load " << file_name;
+    for (int method : encoding_methods) {
+      for (bool split_mesh_on_seams : {false, true}) {
+        draco::Encoder encoder;
+        encoder.SetEncodingMethod(method);
+        encoder.options().SetGlobalBool("split_mesh_on_seams",
+                                        split_mesh_on_seams);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION,
+                                         14);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                         12);
+        draco::EncoderBuffer regular_buffer;
+        ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &regular_buffer).ok());
+        encoder.SetEncodeAttributeOffsets(true);
+        draco::EncoderBuffer offsets_buffer;
+        ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &offsets_buffer).ok());
+
+        draco::DecoderBuffer buffer;
+        buffer.Init(regular_buffer.data(), regular_buffer.size());
+        draco::Decoder decoder;
+        std::unique_ptr<draco::Mesh> regular_mesh =
+            decoder.DecodeMeshFromBuffer(&buffer).value();
+        ASSERT_NE(regular_mesh, nullptr);
+
+        for (int num_threads : {1, 4}) {
+          buffer.Init(offsets_buffer.data(), offsets_buffer.size());
+          decoder.SetNumDecodingThreads(num_threads);
+          std::unique_ptr<draco::Mesh> decoded_mesh =
+              decoder.DecodeMeshFromBuffer(&buffer).value();
+          ASSERT_NE(decoded_mesh, nullptr)
+              << file_name << " method " << method << " threads "
+              << num_threads;
+          VerifyMeshesAreIdentical(*regular_mesh, *decoded_mesh);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestInvalidDependencyLevels) {
+  // Tests that data where a dependent attribute is not on a higher level than
+  // its parent attribute is rejected instead of decoding the attributes in a
+  // wrong order.
+  std::unique_ptr<draco::Mesh> mesh(
+      draco::ReadMeshFromTestFile("cube_att.obj"));
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_EDGEBREAKER_ENCODING);
+  // Low speeds select prediction schemes that depend on the positions.
+  encoder.SetSpeedOptions(3, 3);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+  draco::EncoderBuffer regular_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &regular_buffer).ok());
+  encoder.SetEncodeAttributeOffsets(true);
+  draco::EncoderBuffer offsets_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &offsets_buffer).ok());
+  std::vector<char> data(offsets_buffer.data(),
+                         offsets_buffer.data() + offsets_buffer.size());
+
+  // The level and the data size of each attribute decoder are stored in a
+  // table that is followed by the data of all decoders up to the end of the
+  // buffer. The table is missing in the regular data so it starts at or
+  // before the first byte that differs (the header flags are skipped).
+  size_t first_diff = 11;
+  while (regular_buffer.data()[first_diff] == data[first_diff]) {
+    ++first_diff;
+  }
+  std::vector<size_t> level_offsets;
+  for (size_t table_offset = first_diff; table_offset > 11; --table_offset) {
+    draco::DecoderBuffer table;
+    table.Init(data.data() + table_offset, data.size() - table_offset);
+    level_offsets.clear();
+    int64_t data_size = 0;
+    while (table_offset + table.decoded_size() + data_size < data.size()) {
+      level_offsets.push_back(table_offset + table.decoded_size());
+      uint8_t level;
+      uint32_t size;
+      if (!table.Decode(&level) || !draco::DecodeVarint(&size, &table))
+        break;
+      data_size += size;
+    }
+    if (table_offset + table.decoded_size() + data_size == data.size())
+      break;
+    level_offsets.clear();
+  }
+  ASSERT_GT(level_offsets.size(), 1u);
+
+  // Move all attribute decoders to the first level. The positions are used to
+  // predict the other attributes.
+  int max_level = 0;
+  for (size_t offset : level_offsets) {
+    max_level = std::max(max_level, static_cast<int>(data[offset]));
+    data[offset] = 0;
+  }
+  ASSERT_GT(max_level, 0);
+  {
+    // The unmodified data must decode on multiple threads.
+    draco::DecoderBuffer buffer;
+    buffer.Init(offsets_buffer.data(), offsets_buffer.size());
+    draco::Decoder decoder;
+    decoder.SetNumDecodingThreads(4);
+    ASSERT_TRUE(decoder.DecodeMeshFromBuffer(&buffer).ok());
+  }
+  for (int num_threads : {1, 4}) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    draco::Decoder decoder;
+    decoder.SetNumDecodingThreads(num_threads);
+    ASSERT_FALSE(decoder.DecodeMeshFromBuffer(&buffer).ok());
+  }
+}
+
+TEST_F(DecodeTest, TestMemoryArena) {
+  // Tests that meshes encoded and decoded with a memory arena are the same as
+  // meshes processed on the heap and that the arena can be reused after all
+  // decoded meshes are destroyed.
+  std::unique_ptr<draco::Mesh> mesh(
+      draco::ReadMeshFromTestFile("cube_att.obj"));
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetEncodeAttributeOffsets(true);
+  draco::EncoderBuffer heap_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &heap_buffer).ok());
+
+  draco::MemoryArena arena;
+  encoder.SetMemoryArena(&arena);
+  encoder.SetNumEncodingThreads(4);
+  draco::EncoderBuffer arena_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &arena_buffer).ok());
+  ASSERT_GT(arena.bytes_allocated(), 0);
+  ASSERT_EQ(heap_buffer.size(), arena_buffer.size());
+  ASSERT_EQ(0, memcmp(heap_buffer.data(), arena_buffer.data(),
+                      heap_buffer.size()));
+  arena.Reset();
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(heap_buffer.data(), heap_buffer.size());
+  draco::Decoder decoder;
+  std::unique_ptr<draco::Mesh> heap_mesh =
+      decoder.DecodeMeshFromBuffer(&buffer).value();
+  ASSERT_NE(heap_mesh, nullptr);
+  ASSERT_EQ(arena.bytes_allocated(), 0);
+
+  decoder.SetMemoryArena(&arena);
+  decoder.SetNumDecodingThreads(4);
+  for (int i = 0; i < 2; ++i) {
+    buffer.Init(heap_buffer.data(), heap_buffer.size());
+    std::unique_ptr<draco::Mesh> arena_mesh =
+        decoder.DecodeMeshFromBuffer(&buffer).value();
+    ASSERT_NE(arena_mesh, nullptr);
+    ASSERT_GT(arena.bytes_allocated(), 0);
+    VerifyMeshesAreIdentical(*heap_mesh, *arena_mesh);
+    arena_mesh.reset();
+    const size_t capacity = arena.capacity();
+    arena.Reset();
+    // All memory of the second decoding is served from the retained block.
+    ASSERT_EQ(arena.capacity(), capacity);
+  }
+}
+
+TEST_F(DecodeTest, TestAttributeOutputBuffer) {
+  // Tests that attribute values can be decoded directly into external memory.
+  std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile("test_nm.obj"));
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_EDGEBREAKER_ENCODING);
+  // External memory can be used only for attributes with identity mapping
+  // that is guaranteed when all attributes share the same connectivity.
+  encoder.options().SetGlobalBool("split_mesh_on_seams", true);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+  draco::EncoderBuffer encoder_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer).ok());
+
+  // Decode the reference mesh using the same decoder without any external
+  // memory (draco::Decoder would deduplicate the decoded point ids).
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  draco::DecoderOptions options;
+  draco::MeshEdgeBreakerDecoder regular_decoder;
+  std::unique_ptr<draco::Mesh> regular_mesh(new draco::Mesh());
+  ASSERT_TRUE(
+      regular_decoder.Decode(options, &buffer, regular_mesh.get()).ok());
+
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  ExternalPositionsDecoder external_decoder;
+  draco::Mesh external_mesh;
+  ASSERT_TRUE(external_decoder.Decode(options, &buffer, &external_mesh).ok());
+
+  // Positions are stored in the order of points.
+  const draco::PointAttribute *const pos_att =
+      regular_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  ASSERT_EQ(external_decoder.positions().size(),
+            regular_mesh->num_points() * ExternalPositionsDecoder::kStride);
+  for (draco::PointIndex i(0); i < regular_mesh->num_points(); ++i) {
+    ASSERT_EQ(0, memcmp(pos_att->GetAddressOfMappedIndex(i),
+                        external_decoder.positions().data() +
+                            i.value() * ExternalPositionsDecoder::kStride,
+                        pos_att->byte_stride()));
+  }
+  // Other attributes are decoded as usual.
+  const draco::PointAttribute *const norm_att =
+      external_mesh.GetNamedAttribute(draco::GeometryAttribute::NORMAL);
+  ASSERT_NE(norm_att, nullptr);
+  ASSERT_EQ(norm_att->size(),
+            regular_mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL)
+                ->size());
+}
+
+TEST_F(DecodeTest, TestPartialAttributeDecoding) {
+  // Tests that only the requested attributes are decoded and that their
+  // values are the same as when all attributes are decoded.
+  std::unique_ptr<draco::Mesh> mesh(
+      draco::ReadMeshFromTestFile("cube_att.obj"));
+  ASSERT_NE(mesh, nullptr);
+  const int encoding_methods[] = {draco::MESH_SEQUENTIAL_ENCODING,
+                                  draco::MESH_EDGEBREAKER_ENCODING};
+  for (int method : encoding_methods) {
+    for (bool encode_offsets : {false, true}) {
+      draco::Encoder encoder;
+      encoder.SetEncodingMethod(method);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                       12);
+      encoder.SetEncodeAttributeOffsets(encode_offsets);
+      draco::EncoderBuffer encoder_buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer).ok());
+
+      draco::DecoderBuffer buffer;
+      buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+      draco::Decoder decoder;
+      std::unique_ptr<draco::Mesh> full_mesh =
+          decoder.DecodeMeshFromBuffer(&buffer).value();
+      ASSERT_NE(full_mesh, nullptr);
+      ASSERT_EQ(full_mesh->num_attributes(), 3);
+
+      // Decode only positions.
+      buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+      draco::Decoder pos_decoder;
+      pos_decoder.AddAttributeTypeToDecode(draco::GeometryAttribute::POSITION);
+      std::unique_ptr<draco::Mesh> pos_mesh =
+          pos_decoder.DecodeMeshFromBuffer(&buffer).value();
+      ASSERT_NE(pos_mesh, nullptr);
+      ASSERT_EQ(pos_mesh->num_attributes(), 1);
+      ASSERT_EQ(pos_mesh->attribute(0)->attribute_type(),
+                draco::GeometryAttribute::POSITION);
+
+      // The values of the other attributes must be skipped when the data
+      // contains attribute offsets. Without the offsets, all attributes are
+      // still decoded.
+      std::unique_ptr<draco::MeshDecoder> mesh_decoder;
+      if (method == draco::MESH_SEQUENTIAL_ENCODING) {
+        mesh_decoder.reset(new draco::MeshSequentialDecoder());
+      } else {
+        mesh_decoder.reset(new draco::MeshEdgeBreakerDecoder());
+      }
+      draco::Mesh counted_mesh;
+      buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+      ASSERT_TRUE(
+          mesh_decoder->Decode(*pos_decoder.options(), &buffer, &counted_mesh)
+              .ok());
+      ASSERT_EQ(counted_mesh.num_attributes(), 1);
+      ASSERT_EQ(mesh_decoder->num_decoded_attributes(), encode_offsets ? 1 : 3);
+
+      // Decode texture coordinates selected by their unique id and normals.
+      // Both may be predicted from positions that are decoded but not
+      // returned.
+      const draco::PointAttribute *const full_tex_att =
+          full_mesh->GetNamedAttribute(draco::GeometryAttribute::TEX_COORD);
+      buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+      draco::Decoder tex_decoder;
+      tex_decoder.AddAttributeUniqueIdToDecode(full_tex_att->unique_id());
+      tex_decoder.AddAttributeTypeToDecode(draco::GeometryAttribute::NORMAL);
+      std::unique_ptr<draco::Mesh> tex_mesh =
+          tex_decoder.DecodeMeshFromBuffer(&buffer).value();
+      ASSERT_NE(tex_mesh, nullptr);
+      ASSERT_EQ(tex_mesh->num_attributes(), 2);
+      ASSERT_EQ(tex_mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION),
+                nullptr);
+
+      for (const draco::Mesh *partial_mesh : {pos_mesh.get(), tex_mesh.get()}) {
+        ASSERT_EQ(partial_mesh->num_faces(), full_mesh->num_faces());
+        ASSERT_EQ(partial_mesh->num_points(), full_mesh->num_points());
+        for (int a = 0; a < partial_mesh->num_attributes(); ++a) {
+          const draco::PointAttribute *const att = partial_mesh->attribute(a);
+          const draco::PointAttribute *const full_att =
+              full_mesh->GetAttributeByUniqueId(att->unique_id());
+          ASSERT_NE(full_att, nullptr);
+          for (draco::PointIndex p(0); p < full_mesh->num_points(); ++p) {
+            ASSERT_EQ(0, memcmp(att->GetAddressOfMappedIndex(p),
+                                full_att->GetAddressOfMappedIndex(p),
+                                att->byte_stride()));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestEncodedGeometryInfo) {
+  // Tests that the geometry info describes the decoded geometry.
+  const std::string file_names[] = {"test_nm.obj", "cube_att.obj",
+                                    "bun_zipper.ply", "sphere.obj"};
+  const int encoding_methods[] = {draco::MESH_SEQUENTIAL_ENCODING,
+                                  draco::MESH_EDGEBREAKER_ENCODING};
+  for (const std::string &file_name : file_names) {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load " << file_name;
+    for (int method : encoding_methods) {
+      for (bool split_mesh_on_seams : {false, true}) {
+        draco::Encoder encoder;
+        encoder.SetEncodingMethod(method);
+        encoder.options().SetGlobalBool("split_mesh_on_seams",
+                                        split_mesh_on_seams);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION,
+                                         14);
+        draco::EncoderBuffer regular_buffer;
+        ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &regular_buffer).ok());
+        encoder.SetEncodeGeometryInfo(true);
+        draco::EncoderBuffer info_buffer;
+        ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &info_buffer).ok());
+
+        draco::DecoderBuffer buffer;
+        buffer.Init(regular_buffer.data(), regular_buffer.size());
+        auto regular_info_or = draco::Decoder::GetEncodedGeometryInfo(&buffer);
+        ASSERT_TRUE(regular_info_or.ok());
+        ASSERT_FALSE(regular_info_or.value()->has_geometry_info);
+        draco::Decoder decoder;
+        std::unique_ptr<draco::Mesh> regular_mesh =
+            decoder.DecodeMeshFromBuffer(&buffer).value();
+        ASSERT_NE(regular_mesh, nullptr);
+
+        buffer.Init(info_buffer.data(), info_buffer.size());
+        auto info_or = draco::Decoder::GetEncodedGeometryInfo(&buffer);
+        ASSERT_TRUE(info_or.ok());
+        const draco::EncodedGeometryInfo &info = *info_or.value();
+        ASSERT_EQ(buffer.decoded_size(), 0);
+        ASSERT_EQ(info.geometry_type, draco::TRIANGULAR_MESH);
+        ASSERT_EQ(info.encoding_method, method);
+        ASSERT_TRUE(info.has_geometry_info);
+        ASSERT_EQ(info.metadata, nullptr);
+
+        // The geometry info must not change the decoded mesh.
+        std::unique_ptr<draco::Mesh> decoded_mesh =
+            decoder.DecodeMeshFromBuffer(&buffer).value();
+        ASSERT_NE(decoded_mesh, nullptr);
+        VerifyMeshesAreIdentical(*regular_mesh, *decoded_mesh);
+
+        ASSERT_EQ(info.num_points, decoded_mesh->num_points())
+            << file_name << " method " << method;
+        ASSERT_EQ(info.num_faces, decoded_mesh->num_faces());
+        ASSERT_EQ(info.attributes.size(), decoded_mesh->num_attributes());
+        for (int i = 0; i < decoded_mesh->num_attributes(); ++i) {
+          const draco::PointAttribute *const att = decoded_mesh->attribute(i);
+          ASSERT_EQ(info.attributes[i].attribute_type(), att->attribute_type());
+          ASSERT_EQ(info.attributes[i].data_type(), att->data_type());
+          ASSERT_EQ(info.attributes[i].num_components(), att->num_components());
+          ASSERT_EQ(info.attributes[i].unique_id(), att->unique_id());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestEncodedGeometryInfoMetadata) {
+  // Tests that the geometry info of point clouds contains the metadata.
+  std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile("sphere.obj"));
+  ASSERT_NE(mesh, nullptr);
+  std::unique_ptr<draco::GeometryMetadata> metadata(
+      new draco::GeometryMetadata());
+  metadata->AddEntryInt("level", 3);
+  mesh->AddMetadata(std::move(metadata));
+  draco::Encoder encoder;
+  encoder.SetEncodeGeometryInfo(true);
+  draco::EncoderBuffer encoder_buffer;
+  ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*mesh, &encoder_buffer).ok());
+
+  draco::DecoderBuffer buffer;
+  buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+  auto info_or = draco::Decoder::GetEncodedGeometryInfo(&buffer);
+  ASSERT_TRUE(info_or.ok());
+  const draco::EncodedGeometryInfo &info = *info_or.value();
+  ASSERT_EQ(info.geometry_type, draco::POINT_CLOUD);
+  ASSERT_TRUE(info.has_geometry_info);
+  ASSERT_EQ(info.num_points, mesh->num_points());
+  ASSERT_EQ(info.num_faces, 0);
+  ASSERT_EQ(info.attributes.size(), mesh->num_attributes());
+  ASSERT_NE(info.metadata, nullptr);
+  int32_t level;
+  ASSERT_TRUE(info.metadata->GetEntryInt("level", &level));
+  ASSERT_EQ(level, 3);
+
+  draco::Decoder decoder;
+  std::unique_ptr<draco::PointCloud> pc =
+      decoder.DecodePointCloudFromBuffer(&buffer).value();
+  ASSERT_NE(pc, nullptr);
+  ASSERT_EQ(pc->num_points(), info.num_points);
+  ASSERT_NE(pc->GetMetadata(), nullptr);
+}
+
 }  // namespace
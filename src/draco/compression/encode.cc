@@ -24,12 +24,14 @@ Status Encoder::EncodePointCloudToBuffer(const PointCloud &pc,
                                          EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(pc);
   encoder.Reset(CreateExpertEncoderOptions(pc));
+  encoder.SetMemoryArena(memory_arena());
   return encoder.EncodeToBuffer(out_buffer);
 }
 
 Status Encoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer) {
   ExpertEncoder encoder(m);
   encoder.Reset(CreateExpertEncoderOptions(m));
+  encoder.SetMemoryArena(memory_arena());
   return encoder.EncodeToBuffer(out_buffer);
 }
 
@@ -60,6 +62,22 @@ void Encoder::SetSpeedOptions(int encoding_speed, int decoding_speed) {
   Base::SetSpeedOptions(encoding_speed, decoding_speed);
 }
 
+void Encoder::SetNumEncodingThreads(int num_threads) {
+  Base::SetNumEncodingThreads(num_threads);
+}
+
+void Encoder::SetEncodeAttributeOffsets(bool flag) {
+  Base::SetEncodeAttributeOffsets(flag);
+}
+
+void Encoder::SetEncodeGeometryInfo(bool flag) {
+  Base::SetEncodeGeometryInfo(flag);
+}
+
+void Encoder::SetMemoryArena(MemoryArena *arena) {
+  Base::SetMemoryArena(arena);
+}
+
 void Encoder::SetAttributeQuantization(GeometryAttribute::Type type,
                                        int quantization_bits) {
   options().SetAttributeInt(type, "quantization_bits", quantization_bits);
@@ -17,6 +17,7 @@
 
 #include "draco/attributes/geometry_attribute.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/memory_arena.h"
 #include "draco/core/status.h"
 
 namespace draco {
@@ -29,10 +30,13 @@ class EncoderBase {
  public:
   typedef EncoderOptionsT OptionsType;
 
-  EncoderBase() : options_(EncoderOptionsT::CreateDefaultOptions()) {}
+  EncoderBase()
+      : options_(EncoderOptionsT::CreateDefaultOptions()),
+        memory_arena_(nullptr) {}
 
   const EncoderOptionsT &options() const { return options_; }
   EncoderOptionsT &options() { return options_; }
+  MemoryArena *memory_arena() const { return memory_arena_; }
 
  protected:
   void Reset(const EncoderOptionsT &options) { options_ = options; }
@@ -47,6 +51,20 @@ class EncoderBase {
     options_.SetGlobalInt("encoding_method", encoding_method);
   }
 
+  void SetNumEncodingThreads(int num_threads) {
+    options_.SetGlobalInt("num_encoding_threads", num_threads);
+  }
+
+  void SetEncodeAttributeOffsets(bool flag) {
+    options_.SetGlobalBool("encode_attribute_offsets", flag);
+  }
+
+  void SetEncodeGeometryInfo(bool flag) {
+    options_.SetGlobalBool("encode_geometry_info", flag);
+  }
+
+  void SetMemoryArena(MemoryArena *arena) { memory_arena_ = arena; }
+
   Status CheckPredictionScheme(GeometryAttribute::Type att_type,
                                int prediction_scheme) {
     if (prediction_scheme < 0)
@@ -71,6 +89,7 @@ class EncoderBase {
 
  private:
   EncoderOptionsT options_;
+  MemoryArena *memory_arena_;
 };
 
 }  // namespace draco
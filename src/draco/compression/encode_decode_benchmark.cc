@@ -0,0 +1,90 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+namespace {
+
+// Sets the quantization of all attributes to the defaults of draco_encoder.
+void SetDefaultQuantization(Encoder *encoder) {
+  encoder->SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+  encoder->SetAttributeQuantization(GeometryAttribute::TEX_COORD, 12);
+  encoder->SetAttributeQuantization(GeometryAttribute::NORMAL, 10);
+  encoder->SetAttributeQuantization(GeometryAttribute::GENERIC, 8);
+}
+
+// Encodes and decodes |mesh| with the Encoder and Decoder classes. The argument
+// is the encoding and decoding speed.
+void RunMeshRoundTrip(benchmark::State &state, const Mesh *mesh) {
+  if (mesh == nullptr) {
+    state.SkipWithError("Failed to load the mesh.");
+    return;
+  }
+  Encoder encoder;
+  SetDefaultQuantization(&encoder);
+  encoder.SetSpeedOptions(state.range(0), state.range(0));
+  Decoder decoder;
+  EncoderBuffer buffer;
+  for (auto _ : state) {
+    buffer.Clear();
+    if (!encoder.EncodeMeshToBuffer(*mesh, &buffer).ok()) {
+      state.SkipWithError("Failed to encode the mesh.");
+      break;
+    }
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    if (!decoder.DecodeMeshFromBuffer(&dec_buffer).ok()) {
+      state.SkipWithError("Failed to decode the mesh.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_faces());
+  state.counters["encoded_bytes"] = buffer.size();
+}
+
+void BM_MeshRoundTrip(benchmark::State &state, const std::string &file_name) {
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromBenchmarkFile(file_name);
+  RunMeshRoundTrip(state, mesh.get());
+}
+
+// Round trip of a synthetic mesh with positions, normals and texture
+// coordinates.
+void BM_GridMeshRoundTrip(benchmark::State &state) {
+  const std::unique_ptr<Mesh> mesh = CreateBenchmarkGridMesh(256);
+  RunMeshRoundTrip(state, mesh.get());
+}
+
+void SpeedArguments(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("speed")->Arg(0)->Arg(5)->Arg(10);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_MeshRoundTrip, bun_zipper, std::string("bun_zipper.ply"))
+    ->Apply(SpeedArguments);
+BENCHMARK_CAPTURE(BM_MeshRoundTrip, cube_att, std::string("cube_att.obj"))
+    ->Apply(SpeedArguments);
+BENCHMARK_CAPTURE(BM_MeshRoundTrip, test_nm, std::string("test_nm.obj"))
+    ->Apply(SpeedArguments);
+BENCHMARK(BM_GridMeshRoundTrip)->Apply(SpeedArguments);
+
+}  // namespace draco
@@ -143,4 +143,96 @@ TEST_F(EncodeTest, TestLinesObj) {
   ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*pc, &buffer).ok());
 }
 
+TEST_F(EncodeTest, TestMultiThreadedEncoding) {
+  // This test verifies that the multi-threaded encoder produces exactly the
+  // same data as the single threaded one.
+  const std::string file_names[] = {"test_nm.obj", "cube_att.obj"};
+  const int encoding_methods[] = {draco::MESH_SEQUENTIAL_ENCODING,
+                                  draco::MESH_EDGEBREAKER_ENCODING};
+  for (const std::string &file_name : file_names) {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load " << file_name;
+    for (int method : encoding_methods) {
+      for (int speed = 0; speed <= 10; speed += 5) {
+        draco::Encoder encoder;
+        encoder.SetEncodingMethod(method);
+        encoder.SetSpeedOptions(speed, speed);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION,
+                                         14);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                         12);
+        draco::EncoderBuffer single_threaded_buffer;
+        ASSERT_TRUE(
+            encoder.EncodeMeshToBuffer(*mesh, &single_threaded_buffer).ok());
+
+        encoder.SetNumEncodingThreads(4);
+        draco::EncoderBuffer multi_threaded_buffer;
+        ASSERT_TRUE(
+            encoder.EncodeMeshToBuffer(*mesh, &multi_threaded_buffer).ok());
+
+        ASSERT_EQ(single_threaded_buffer.size(), multi_threaded_buffer.size())
+            << file_name << " method " << method << " speed " << speed;
+        ASSERT_EQ(0, memcmp(single_threaded_buffer.data(),
+                            multi_threaded_buffer.data(),
+                            single_threaded_buffer.size()))
+            << file_name << " method " << method << " speed " << speed;
+      }
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestExternalAttributeValues) {
+  // This test verifies that attributes reading interleaved values from
+  // external memory are encoded the same way as attributes owning their
+  // values, and that the encoder doesn't copy the external values.
+  const std::string file_name = "cube_att.obj";
+  std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+  ASSERT_NE(mesh, nullptr) << "Failed to load " << file_name;
+  std::unique_ptr<draco::Mesh> external_mesh(
+      draco::ReadMeshFromTestFile(file_name));
+  ASSERT_NE(external_mesh, nullptr) << "Failed to load " << file_name;
+  // Copy values of each attribute into an array where the values are followed
+  // by four bytes of padding.
+  std::vector<std::vector<uint8_t>> external_values;
+  for (int a = 0; a < external_mesh->num_attributes(); ++a) {
+    draco::PointAttribute *const att = external_mesh->attribute(a);
+    const int entry_size = att->byte_stride();
+    const int stride = entry_size + 4;
+    external_values.push_back(std::vector<uint8_t>(att->size() * stride, 0xff));
+    for (draco::AttributeValueIndex i(0); i < att->size(); ++i) {
+      att->GetValue(i, &external_values.back()[i.value() * stride]);
+    }
+    ASSERT_TRUE(att->ResetExternal(external_values.back().data(), att->size(),
+                                   stride));
+  }
+
+  const int encoding_methods[] = {draco::MESH_SEQUENTIAL_ENCODING,
+                                  draco::MESH_EDGEBREAKER_ENCODING};
+  for (int method : encoding_methods) {
+    for (int quantization_bits = 0; quantization_bits <= 14;
+         quantization_bits += 14) {
+      draco::Encoder encoder;
+      encoder.SetEncodingMethod(method);
+      if (quantization_bits > 0) {
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION,
+                                         quantization_bits);
+      }
+      draco::EncoderBuffer buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+      draco::EncoderBuffer external_buffer;
+      ASSERT_TRUE(
+          encoder.EncodeMeshToBuffer(*external_mesh, &external_buffer).ok());
+      ASSERT_EQ(buffer.size(), external_buffer.size());
+      ASSERT_EQ(0,
+                memcmp(buffer.data(), external_buffer.data(), buffer.size()))
+          << "method " << method << " quantization bits "
+          << quantization_bits;
+    }
+  }
+  for (int a = 0; a < external_mesh->num_attributes(); ++a) {
+    ASSERT_TRUE(external_mesh->attribute(a)->is_external());
+  }
+}
+
 }  // namespace
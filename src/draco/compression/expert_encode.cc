@@ -30,6 +30,7 @@ ExpertEncoder::ExpertEncoder(const Mesh &mesh)
 Status ExpertEncoder::EncodeToBuffer(EncoderBuffer *out_buffer) {
   if (point_cloud_ == nullptr)
     return Status(Status::ERROR, "Invalid input geometry.");
+  const ScopedMemoryArena arena_scope(memory_arena());
   if (mesh_ == nullptr) {
     return EncodePointCloudToBuffer(*point_cloud_, out_buffer);
   }
@@ -121,6 +122,22 @@ void ExpertEncoder::SetSpeedOptions(int encoding_speed, int decoding_speed) {
   Base::SetSpeedOptions(encoding_speed, decoding_speed);
 }
 
+void ExpertEncoder::SetNumEncodingThreads(int num_threads) {
+  Base::SetNumEncodingThreads(num_threads);
+}
+
+void ExpertEncoder::SetEncodeAttributeOffsets(bool flag) {
+  Base::SetEncodeAttributeOffsets(flag);
+}
+
+void ExpertEncoder::SetEncodeGeometryInfo(bool flag) {
+  Base::SetEncodeGeometryInfo(flag);
+}
+
+void ExpertEncoder::SetMemoryArena(MemoryArena *arena) {
+  Base::SetMemoryArena(arena);
+}
+
 void ExpertEncoder::SetAttributeQuantization(int32_t attribute_id,
                                              int quantization_bits) {
   options().SetAttributeInt(attribute_id, "quantization_bits",
@@ -61,6 +61,34 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // given |decoding_speed|.
   void SetSpeedOptions(int encoding_speed, int decoding_speed);
 
+  // Sets the maximum number of threads that can be used to encode independent
+  // attributes concurrently and to compute the connectivity of meshes encoded
+  // with the edgebreaker method. The encoded data is identical to the data
+  // produced by a single threaded encoder. Default: [1].
+  void SetNumEncodingThreads(int num_threads);
+
+  // Sets whether the encoder should store the sizes of the data of individual
+  // attributes in the encoded stream. The sizes allow the decoder to decode
+  // independent attributes concurrently (see
+  // Decoder::SetNumDecodingThreads()) at the cost of a few extra bytes per
+  // attribute. Streams encoded with this option can't be decoded by decoders
+  // that don't support it. Default: [false].
+  void SetEncodeAttributeOffsets(bool flag);
+
+  // Sets whether the encoder should store a summary of the encoded geometry
+  // (the number of points and faces and the attribute descriptors) right
+  // after the header, so it can be read by Decoder::GetEncodedGeometryInfo()
+  // without decoding the geometry. Streams encoded with this option can't be
+  // decoded by decoders that don't support it. Default: [false].
+  void SetEncodeGeometryInfo(bool flag);
+
+  // Sets the memory arena used for the internal allocations of the encoder,
+  // such as the corner table and the portable attribute values. The memory is
+  // not returned to the heap until MemoryArena::Reset() or
+  // MemoryArena::Release() is called after the encoding has finished.
+  // nullptr means that the heap is used. Default: [nullptr].
+  void SetMemoryArena(MemoryArena *arena);
+
   // Sets the quantization compression options for a specific attribute. The
   // attribute values will be quantized in a box defined by the maximum extent
   // of the attribute values. I.e., the actual precision of this option depends
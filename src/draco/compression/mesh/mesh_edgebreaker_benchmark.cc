@@ -0,0 +1,105 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "benchmark/benchmark.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+namespace {
+
+// Returns the mesh used by the edgebreaker benchmarks. It has only the
+// position attribute so the timings are dominated by the connectivity coding.
+const Mesh *GetEdgebreakerBenchmarkMesh() {
+  static const std::unique_ptr<Mesh> mesh =
+      ReadMeshFromBenchmarkFile("bun_zipper.ply");
+  return mesh.get();
+}
+
+EncoderOptions CreateEdgebreakerOptions(int edgebreaker_method) {
+  EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  options.SetGlobalInt("edgebreaker_method", edgebreaker_method);
+  options.SetAttributeInt(0, "quantization_bits", 14);
+  return options;
+}
+
+// The argument is the edgebreaker method. The encoder object is reused for all
+// iterations, the same way as when encoding a sequence of frames.
+void BM_MeshEdgebreakerEncode(benchmark::State &state) {
+  const Mesh *const mesh = GetEdgebreakerBenchmarkMesh();
+  if (mesh == nullptr) {
+    state.SkipWithError("Failed to load the mesh.");
+    return;
+  }
+  const EncoderOptions options = CreateEdgebreakerOptions(state.range(0));
+  MeshEdgeBreakerEncoder encoder;
+  encoder.SetMesh(*mesh);
+  EncoderBuffer buffer;
+  for (auto _ : state) {
+    buffer.Clear();
+    if (!encoder.Encode(options, &buffer).ok()) {
+      state.SkipWithError("Failed to encode the mesh.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_faces());
+  state.counters["encoded_bytes"] = buffer.size();
+}
+
+void BM_MeshEdgebreakerDecode(benchmark::State &state) {
+  const Mesh *const mesh = GetEdgebreakerBenchmarkMesh();
+  if (mesh == nullptr) {
+    state.SkipWithError("Failed to load the mesh.");
+    return;
+  }
+  const EncoderOptions options = CreateEdgebreakerOptions(state.range(0));
+  MeshEdgeBreakerEncoder encoder;
+  encoder.SetMesh(*mesh);
+  EncoderBuffer buffer;
+  if (!encoder.Encode(options, &buffer).ok()) {
+    state.SkipWithError("Failed to encode the mesh.");
+    return;
+  }
+  const DecoderOptions dec_options;
+  MeshEdgeBreakerDecoder decoder;
+  for (auto _ : state) {
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Mesh decoded_mesh;
+    if (!decoder.Decode(dec_options, &dec_buffer, &decoded_mesh).ok()) {
+      state.SkipWithError("Failed to decode the mesh.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_faces());
+}
+
+// MESH_EDGEBREAKER_PREDICTIVE_ENCODING is deprecated and can't be produced by
+// the encoder anymore.
+void EdgebreakerArguments(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("method");
+  benchmark->Arg(MESH_EDGEBREAKER_STANDARD_ENCODING);
+  benchmark->Arg(MESH_EDGEBREAKER_VALENCE_ENCODING);
+}
+
+}  // namespace
+
+BENCHMARK(BM_MeshEdgebreakerEncode)->Apply(EdgebreakerArguments);
+BENCHMARK(BM_MeshEdgebreakerDecode)->Apply(EdgebreakerArguments);
+
+}  // namespace draco
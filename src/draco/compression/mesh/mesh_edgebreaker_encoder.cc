@@ -30,24 +30,40 @@ MeshEdgeBreakerEncoder::CloneEncoderImplState() {
   return nullptr;
 }
 
+bool MeshEdgeBreakerEncoder::CopyEncoderImplState(
+  MeshEdgeBreakerEncoderImplInterface& rEncoderState) {
+  if (!impl_) {
+    return false;
+  }
+  return impl_->CopyTo(rEncoderState);
+}
+
 void MeshEdgeBreakerEncoder::SetEncoderImplState(
   MeshEdgeBreakerEncoderImplInterface& rEncoderState) {
-  if (impl_) {
-      impl_.reset();
+  // Reuse the memory of the current implementation when possible.
+  if (!impl_ || !rEncoderState.CopyTo(*impl_)) {
+    impl_ = std::move(rEncoderState.Clone());
   }
-  impl_ = std::move(rEncoderState.Clone());
   if (impl_) {
     impl_->Init(this);
   }
 }
 
+template <class ImplT>
+void MeshEdgeBreakerEncoder::CreateOrReuseImpl() {
+  // Keep the implementation from previous runs if it has the requested type,
+  // so that its internal buffers don't need to be reallocated.
+  if (dynamic_cast<ImplT *>(impl_.get()) == nullptr) {
+    impl_ = std::unique_ptr<MeshEdgeBreakerEncoderImplInterface>(new ImplT());
+  }
+}
+
 bool MeshEdgeBreakerEncoder::InitializeEncoder() {
   const bool is_standard_edgebreaker_available =
       options()->IsFeatureSupported(features::kEdgebreaker);
   const bool is_predictive_edgebreaker_available =
       options()->IsFeatureSupported(features::kPredictiveEdgebreaker);
 
-  impl_ = nullptr;
   // For tiny meshes it's usually better to use the basic edgebreaker as the
   // overhead of the predictive one may turn out to be too big.
   // TODO(ostava): For now we have a set limit for forcing the basic edgebreaker
@@ -71,14 +87,17 @@ bool MeshEdgeBreakerEncoder::InitializeEncoder() {
     if (is_standard_edgebreaker_available) {
       buffer()->Encode(
           static_cast<uint8_t>(MESH_EDGEBREAKER_STANDARD_ENCODING));
-      impl_ = std::unique_ptr<MeshEdgeBreakerEncoderImplInterface>(
-          new MeshEdgeBreakerEncoderImpl<MeshEdgeBreakerTraversalEncoder>());
+      CreateOrReuseImpl<
+          MeshEdgeBreakerEncoderImpl<MeshEdgeBreakerTraversalEncoder>>();
+    } else {
+      impl_ = nullptr;
     }
   } else if (selected_edgebreaker_method == MESH_EDGEBREAKER_VALENCE_ENCODING) {
     buffer()->Encode(static_cast<uint8_t>(MESH_EDGEBREAKER_VALENCE_ENCODING));
-    impl_ = std::unique_ptr<MeshEdgeBreakerEncoderImplInterface>(
-        new MeshEdgeBreakerEncoderImpl<
-            MeshEdgeBreakerTraversalValenceEncoder>());
+    CreateOrReuseImpl<
+        MeshEdgeBreakerEncoderImpl<MeshEdgeBreakerTraversalValenceEncoder>>();
+  } else {
+    impl_ = nullptr;
   }
   if (!impl_)
     return false;
@@ -50,6 +50,10 @@ class MeshEdgeBreakerEncoder : public MeshEncoder {
   }
 
   std::unique_ptr<MeshEdgeBreakerEncoderImplInterface> CloneEncoderImplState();
+  // Same as CloneEncoderImplState() but the state is copied into an existing
+  // |rEncoderState| whose memory is reused. Returns false if the state can't be
+  // copied, e.g. when |rEncoderState| uses a different edgebreaker method.
+  bool CopyEncoderImplState(MeshEdgeBreakerEncoderImplInterface& rEncoderState);
   void SetEncoderImplState(MeshEdgeBreakerEncoderImplInterface& rEncoderState);
 
  protected:
@@ -59,6 +63,11 @@ class MeshEdgeBreakerEncoder : public MeshEncoder {
   bool EncodeAttributesEncoderIdentifier(int32_t att_encoder_id) override;
 
  private:
+  // Creates a new implementation of type |ImplT| unless |impl_| already holds
+  // one.
+  template <class ImplT>
+  void CreateOrReuseImpl();
+
   // The actual implementation of the edge breaker method. The implementations
   // are in general specializations of a template class
   // MeshEdgeBreakerEncoderImpl where the template arguments control encoding
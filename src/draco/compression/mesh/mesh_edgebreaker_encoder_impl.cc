@@ -49,15 +49,32 @@ MeshEdgeBreakerEncoderImpl<TraversalEncoder>::Clone()
 {
   auto impl = std::unique_ptr<MeshEdgeBreakerEncoderImplInterface>(
         new MeshEdgeBreakerEncoderImpl<TraversalEncoder>());
-  auto ptr = (MeshEdgeBreakerEncoderImpl<TraversalEncoder>*)impl.get();
+  CopyTo(*impl);
+  return impl;
+}
+
+template <class TraversalEncoder>
+bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::CopyTo(
+    MeshEdgeBreakerEncoderImplInterface &rOther)
+{
+  auto ptr = dynamic_cast<MeshEdgeBreakerEncoderImpl<TraversalEncoder>*>(&rOther);
+  if (ptr == nullptr)
+    return false;
   ptr->encoder_ = encoder_;
   ptr->mesh_ = mesh_;
-  ptr->corner_table_ = std::move(corner_table_->Clone());
+  if (!corner_table_) {
+    ptr->corner_table_ = nullptr;
+  } else if (ptr->corner_table_) {
+    *ptr->corner_table_ = *corner_table_;
+  } else {
+    ptr->corner_table_ = std::move(corner_table_->Clone());
+  }
   ptr->corner_traversal_stack_ = corner_traversal_stack_;
   ptr->visited_faces_ = visited_faces_;
   ptr->pos_encoding_data_ = pos_encoding_data_;
   ptr->pos_traversal_method_ = pos_traversal_method_;
   ptr->processed_connectivity_corners_ = processed_connectivity_corners_;
+  ptr->init_face_connectivity_corners_ = init_face_connectivity_corners_;
   ptr->visited_vertex_ids_ = visited_vertex_ids_;
   ptr->vertex_traversal_length_ = vertex_traversal_length_;
   ptr->topology_split_event_data_ = topology_split_event_data_;
@@ -70,7 +87,7 @@ MeshEdgeBreakerEncoderImpl<TraversalEncoder>::Clone()
   ptr->attribute_encoder_to_data_id_map_ = attribute_encoder_to_data_id_map_;
   traversal_encoder_.CopyTo(ptr->traversal_encoder_);
   ptr->use_single_connectivity_ = use_single_connectivity_;
-  return std::move(impl);
+  return true;
 }
 
 template <class TraversalEncoder>
@@ -123,24 +140,28 @@ MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GetAttributeEncodingData(
 template <class TraversalEncoder>
 template <class TraverserT>
 std::unique_ptr<PointsSequencer>
-MeshEdgeBreakerEncoderImpl<TraversalEncoder>::CreateVertexTraversalSequencer(
-    MeshAttributeIndicesEncodingData *encoding_data) {
+MeshEdgeBreakerEncoderImpl<TraversalEncoder>::CreateTraversalSequencer(
+    const typename TraverserT::CornerTable *corner_table,
+    MeshAttributeIndicesEncodingData *encoding_data,
+    std::unique_ptr<PointsSequencer> prev_sequencer) {
   typedef typename TraverserT::TraversalObserver AttObserver;
-  typedef typename TraverserT::TraversalProcessor AttProcessor;
-
-  std::unique_ptr<MeshTraversalSequencer<TraverserT>> traversal_sequencer(
-      new MeshTraversalSequencer<TraverserT>(mesh_, encoding_data));
-
-  AttProcessor att_processor;
-  AttObserver att_observer(corner_table_.get(), mesh_,
-                           traversal_sequencer.get(), encoding_data);
-  TraverserT att_traverser;
-
-  att_processor.ResetProcessor(corner_table_.get());
-  att_traverser.Init(std::move(att_processor), att_observer);
+  typedef MeshTraversalSequencer<TraverserT> AttSequencer;
+
+  std::unique_ptr<AttSequencer> traversal_sequencer;
+  if (dynamic_cast<AttSequencer *>(prev_sequencer.get()) != nullptr) {
+    // Reuse the sequencer (including the memory of its traverser) that was
+    // used for the previously encoded mesh.
+    traversal_sequencer.reset(
+        static_cast<AttSequencer *>(prev_sequencer.release()));
+    traversal_sequencer->Reset(mesh_, encoding_data);
+  } else {
+    traversal_sequencer.reset(new AttSequencer(mesh_, encoding_data));
+  }
 
+  AttObserver att_observer(corner_table, mesh_, traversal_sequencer.get(),
+                           encoding_data);
+  traversal_sequencer->traverser()->Reset(corner_table, att_observer);
   traversal_sequencer->SetCornerOrder(processed_connectivity_corners_);
-  traversal_sequencer->SetTraverser(att_traverser);
   return std::move(traversal_sequencer);
 }
 
@@ -168,6 +189,21 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GenerateAttributesEncoder(
       break;
     }
   }
+  // Reuse the attribute encoder that was created for the same encoder id
+  // during the previous encoding to avoid reallocating its memory.
+  std::unique_ptr<SequentialAttributeEncodersController> att_controller;
+  std::unique_ptr<AttributesEncoder> prev_att_encoder =
+      GetEncoder()->ReleasePreviousAttributesEncoder(
+          GetEncoder()->num_attributes_encoders());
+  if (dynamic_cast<SequentialAttributeEncodersController *>(
+          prev_att_encoder.get()) != nullptr) {
+    att_controller.reset(static_cast<SequentialAttributeEncodersController *>(
+        prev_att_encoder.release()));
+  }
+  std::unique_ptr<PointsSequencer> prev_sequencer;
+  if (att_controller)
+    prev_sequencer = att_controller->ReleaseSequencer();
+
   MeshTraversalMethod traversal_method = MESH_TRAVERSAL_DEPTH_FIRST;
   std::unique_ptr<PointsSequencer> sequencer;
   if (use_single_connectivity_ ||
@@ -204,12 +240,14 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GenerateAttributesEncoder(
       // Traverser that is used to generate the encoding order of each
       // attribute.
       typedef PredictionDegreeTraverser<AttProcessor, AttObserver> AttTraverser;
-      sequencer = CreateVertexTraversalSequencer<AttTraverser>(encoding_data);
+      sequencer = CreateTraversalSequencer<AttTraverser>(
+          corner_table_.get(), encoding_data, std::move(prev_sequencer));
     } else {
       // Traverser that is used to generate the encoding order of each
       // attribute.
       typedef EdgeBreakerTraverser<AttProcessor, AttObserver> AttTraverser;
-      sequencer = CreateVertexTraversalSequencer<AttTraverser>(encoding_data);
+      sequencer = CreateTraversalSequencer<AttTraverser>(
+          corner_table_.get(), encoding_data, std::move(prev_sequencer));
     }
   } else {
     // Else use a general per-corner encoder.
@@ -220,23 +258,9 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GenerateAttributesEncoder(
     // Traverser that is used to generate the encoding order of each attribute.
     typedef EdgeBreakerTraverser<AttProcessor, AttObserver> AttTraverser;
 
-    std::unique_ptr<MeshTraversalSequencer<AttTraverser>> traversal_sequencer(
-        new MeshTraversalSequencer<AttTraverser>(
-            mesh_, &attribute_data_[att_data_id].encoding_data));
-
-    AttProcessor att_processor;
-    AttObserver att_observer(&attribute_data_[att_data_id].connectivity_data,
-                             mesh_, traversal_sequencer.get(),
-                             &attribute_data_[att_data_id].encoding_data);
-    AttTraverser att_traverser;
-
-    att_processor.ResetProcessor(
-        &attribute_data_[att_data_id].connectivity_data);
-    att_traverser.Init(att_processor, att_observer);
-
-    traversal_sequencer->SetCornerOrder(processed_connectivity_corners_);
-    traversal_sequencer->SetTraverser(att_traverser);
-    sequencer = std::move(traversal_sequencer);
+    sequencer = CreateTraversalSequencer<AttTraverser>(
+        &attribute_data_[att_data_id].connectivity_data,
+        &attribute_data_[att_data_id].encoding_data, std::move(prev_sequencer));
   }
 
   if (!sequencer)
@@ -248,8 +272,12 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GenerateAttributesEncoder(
     attribute_data_[att_data_id].traversal_method = traversal_method;
   }
 
-  std::unique_ptr<SequentialAttributeEncodersController> att_controller(
-      new SequentialAttributeEncodersController(std::move(sequencer), att_id));
+  if (att_controller) {
+    att_controller->Reset(std::move(sequencer), att_id);
+  } else {
+    att_controller.reset(new SequentialAttributeEncodersController(
+        std::move(sequencer), att_id));
+  }
 
   // Update the mapping between the encoder id and the attribute data id.
   // This will be used by the decoder to select the appropriate attribute
@@ -299,15 +327,23 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // together, unless the option |use_single_connectivity_| is set in which case
   // we break the mesh along attribute seams and use the same connectivity for
   // all attributes.
+  // The corner table from previous runs is reused to avoid reallocations.
   PSY_DRACO_PROFILE_SECTION("CreateCornerTable");
+  if (!corner_table_) {
+    corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
+  }
+  bool is_corner_table_valid;
   if (use_single_connectivity_) {
     PSY_DRACO_PROFILE_SECTION("CreateCornerTableFromAllAttributes");
-    corner_table_ = CreateCornerTableFromAllAttributes(mesh_);
+    is_corner_table_valid = InitializeCornerTableFromAllAttributes(
+        mesh_, corner_table_.get(), encoder_->thread_pool());
   } else {
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    is_corner_table_valid = InitializeCornerTableFromPositionAttribute(
+        mesh_, corner_table_.get(), encoder_->thread_pool());
   }
-  if (corner_table_ == nullptr) {
+  if (!is_corner_table_valid) {
     // Failed to construct the corner table.
+    corner_table_ = nullptr;
     return false;
   }
 
@@ -338,7 +374,7 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   last_encoded_symbol_id_ = -1;
   num_split_symbols_ = 0;
   topology_split_event_data_.clear();
-  face_to_split_symbol_map_.clear();
+  face_to_split_symbol_map_.assign(mesh_->num_faces(), -1);
   visited_holes_.clear();
   vertex_hole_id_.assign(corner_table_->num_vertices(), -1);
   processed_connectivity_corners_.clear();
@@ -359,7 +395,7 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
 
   traversal_encoder_.Start();
 
-  std::vector<CornerIndex> init_face_connectivity_corners;
+  init_face_connectivity_corners_.clear();
   {
     PSY_DRACO_PROFILE_SECTION("Traverse the surface");
     // Traverse the surface starting from each unvisited corner.
@@ -398,7 +434,7 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
         // the first encoded corner corresponds to the tip corner of the regular
         // edgebreaker traversal (essentially the initial face can be then viewed
         // as a TOPOLOGY_C face).
-        init_face_connectivity_corners.push_back(
+        init_face_connectivity_corners_.push_back(
             corner_table_->Next(corner_index));
         const CornerIndex opp_id =
             corner_table_->Opposite(corner_table_->Next(corner_index));
@@ -426,8 +462,8 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // Append the init face connectivity corners (which are processed in order by
   // the decoder after the regular corners.
   processed_connectivity_corners_.insert(processed_connectivity_corners_.end(),
-                                         init_face_connectivity_corners.begin(),
-                                         init_face_connectivity_corners.end());
+                                         init_face_connectivity_corners_.begin(),
+                                         init_face_connectivity_corners_.end());
   // Encode connectivity for all non-position attributes.
   if (attribute_data_.size() > 0) {
     // Use the same order of corner that will be used by the decoder.
@@ -452,6 +488,11 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   encoder_->buffer()->Encode(traversal_encoder_.buffer().data(),
                              traversal_encoder_.buffer().size());
 
+  // The number of encoded points is needed only for the geometry info and
+  // computing it requires a pass over all corners.
+  if (encoder_->options()->GetGlobalBool("encode_geometry_info", false))
+    encoder_->set_num_encoded_points(ComputeNumEncodedPoints());
+  encoder_->set_num_encoded_faces(num_faces);
   return true;
 }
 
@@ -764,10 +805,10 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::FindHoles() {
 template <class TraversalEncoder>
 int MeshEdgeBreakerEncoderImpl<TraversalEncoder>::GetSplitSymbolIdOnFace(
     int face_id) const {
-  auto it = face_to_split_symbol_map_.find(face_id);
-  if (it == face_to_split_symbol_map_.end())
+  if (face_id < 0 ||
+      face_id >= static_cast<int>(face_to_split_symbol_map_.size()))
     return -1;
-  return it->second;
+  return face_to_split_symbol_map_[face_id];
 }
 
 template <class TraversalEncoder>
@@ -791,8 +832,11 @@ template <class TraversalEncoder>
 bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::InitAttributeData() {
   PSY_DRACO_PROFILE_SECTION("InitAttributeData");
 
-  if (use_single_connectivity_)
-    return true;  // All attributes use the same connectivity.
+  if (use_single_connectivity_) {
+    // All attributes use the same connectivity.
+    attribute_data_.clear();
+    return true;
+  }
 
   const int num_attributes = mesh_->num_attributes();
   // Ignore the position attribute. It's decoded separately.
@@ -826,6 +870,48 @@ bool MeshEdgeBreakerEncoderImpl<TraversalEncoder>::InitAttributeData() {
   return true;
 }
 
+template <class TraversalEncoder>
+int64_t MeshEdgeBreakerEncoderImpl<TraversalEncoder>::ComputeNumEncodedPoints()
+    const {
+  const int64_t num_vertices =
+      corner_table_->num_vertices() - corner_table_->NumIsolatedVertices();
+  if (attribute_data_.empty())
+    return num_vertices;
+  int64_t num_points = 0;
+  for (VertexIndex v(0); v < corner_table_->num_vertices(); ++v) {
+    const CornerIndex first_c = corner_table_->LeftMostCorner(v);
+    if (first_c == kInvalidCornerIndex)
+      continue;  // Isolated vertex.
+    // Count the attribute seams between consecutive corners around |v|. For
+    // closed fans this includes the seam between the last and the first
+    // corner.
+    int num_seams = 0;
+    CornerIndex prev_c = first_c;
+    CornerIndex c = corner_table_->SwingRight(first_c);
+    while (c != kInvalidCornerIndex) {
+      for (uint32_t i = 0; i < attribute_data_.size(); ++i) {
+        if (attribute_data_[i].connectivity_data.Vertex(c) !=
+            attribute_data_[i].connectivity_data.Vertex(prev_c)) {
+          ++num_seams;
+          break;
+        }
+      }
+      if (c == first_c)
+        break;
+      prev_c = c;
+      c = corner_table_->SwingRight(c);
+    }
+    if (corner_table_->IsOnBoundary(v)) {
+      // Points are created at the first corner and at every seam.
+      num_points += num_seams + 1;
+    } else {
+      // The fan is closed so the first corner lies on a seam if there is any.
+      num_points += std::max(num_seams, 1);
+    }
+  }
+  return num_points;
+}
+
 // TODO(ostava): Note that if the input mesh used the same attribute index on
 // multiple different vertices, such attribute will be duplicated using the
 // encoding below. Eventually, we may consider either using a different encoding
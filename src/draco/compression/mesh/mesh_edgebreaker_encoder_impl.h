@@ -15,7 +15,7 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 
-#include <unordered_map>
+#include <vector>
 
 #include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
 #include "draco/compression/attributes/mesh_traversal_sequencer.h"
@@ -56,16 +56,26 @@ class MeshEdgeBreakerEncoderImpl : public MeshEdgeBreakerEncoderImplInterface {
   MeshEdgeBreakerEncoder *GetEncoder() const override { return encoder_; }
 
   std::unique_ptr<MeshEdgeBreakerEncoderImplInterface> Clone() override;
+  bool CopyTo(MeshEdgeBreakerEncoderImplInterface &rOther) override;
 
  private:
   // Initializes data needed for encoding non-position attributes.
   // Returns false on error.
   bool InitAttributeData();
 
-  // Creates a vertex traversal sequencer for the specified |TraverserT| type.
+  // Returns the number of points of the decoded mesh. The decoder creates a
+  // new point for every attribute seam around each vertex (see
+  // MeshEdgeBreakerDecoderImpl::AssignPointsToCorners()).
+  int64_t ComputeNumEncodedPoints() const;
+
+  // Creates a traversal sequencer for the specified |TraverserT| type that
+  // traverses |corner_table|. |prev_sequencer| is re-initialized and returned
+  // instead of creating a new sequencer when it has the same type.
   template <class TraverserT>
-  std::unique_ptr<PointsSequencer> CreateVertexTraversalSequencer(
-      MeshAttributeIndicesEncodingData *encoding_data);
+  std::unique_ptr<PointsSequencer> CreateTraversalSequencer(
+      const typename TraverserT::CornerTable *corner_table,
+      MeshAttributeIndicesEncodingData *encoding_data,
+      std::unique_ptr<PointsSequencer> prev_sequencer);
 
   // Finds the configuration of the initial face that starts the traversal.
   // Configurations are determined by location of holes around the init face
@@ -154,6 +164,10 @@ class MeshEdgeBreakerEncoderImpl : public MeshEdgeBreakerEncoderImplInterface {
   // face).
   std::vector<CornerIndex> processed_connectivity_corners_;
 
+  // Array storing the connectivity corners of the initial faces of all
+  // traversals.
+  std::vector<CornerIndex> init_face_connectivity_corners_;
+
   // Array for storing visited vertex ids of all input vertices.
   std::vector<bool> visited_vertex_ids_;
 
@@ -162,9 +176,9 @@ class MeshEdgeBreakerEncoderImpl : public MeshEdgeBreakerEncoderImplInterface {
   // Array for storing all topology split events encountered during the mesh
   // traversal.
   std::vector<TopologySplitEventData> topology_split_event_data_;
-  // Map between face_id and symbol_id. Contains entries only for faces that
-  // were encoded with TOPOLOGY_S symbol.
-  std::unordered_map<int, int> face_to_split_symbol_map_;
+  // Map between face_id and symbol_id. Contains valid symbol ids only for
+  // faces that were encoded with TOPOLOGY_S symbol, all other entries are -1.
+  std::vector<int> face_to_split_symbol_map_;
 
   // Array for marking holes that has been reached during the traversal.
   std::vector<bool> visited_holes_;
@@ -52,6 +52,11 @@ class MeshEdgeBreakerEncoderImplInterface {
   virtual MeshEdgeBreakerEncoder *GetEncoder() const = 0;
 
   virtual std::unique_ptr<MeshEdgeBreakerEncoderImplInterface> Clone() = 0;
+
+  // Copies the state of this encoder into |rOther|, reusing any memory that
+  // |rOther| has already allocated. Returns false when |rOther| is not an
+  // implementation of the same type.
+  virtual bool CopyTo(MeshEdgeBreakerEncoderImplInterface &rOther) = 0;
 };
 
 }  // namespace draco
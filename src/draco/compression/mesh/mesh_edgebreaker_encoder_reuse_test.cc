@@ -0,0 +1,200 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+// This test is built into its own executable (draco_allocation_tests)
+// because it replaces the global allocation functions to count the
+// allocations made by the encoder. Counting is enabled only within the scope
+// of ScopedAllocationCounter.
+namespace {
+
+std::atomic<bool> g_count_allocations(false);
+std::atomic<int> g_num_allocations(0);
+
+}  // namespace
+
+void *operator new(size_t size) {
+  if (g_count_allocations)
+    ++g_num_allocations;
+  void *const ptr = malloc(size > 0 ? size : 1);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+namespace {
+
+using draco::CornerIndex;
+using draco::CornerTable;
+using draco::CreateAnimatedGridMesh;
+using draco::DecoderBuffer;
+using draco::DecoderOptions;
+using draco::EncoderBuffer;
+using draco::EncoderOptions;
+using draco::Mesh;
+using draco::MeshEdgeBreakerDecoder;
+using draco::MeshEdgeBreakerEncoder;
+using draco::PointIndex;
+using draco::VertexIndex;
+
+// Counts all allocations made during the lifetime of the object.
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter() {
+    g_num_allocations = 0;
+    g_count_allocations = true;
+  }
+  ~ScopedAllocationCounter() { g_count_allocations = false; }
+  int num_allocations() const { return g_num_allocations; }
+};
+
+class MeshEdgebreakerEncoderReuseTest : public ::testing::Test {
+ protected:
+  // Encodes a sequence of frames twice with a single encoder and verifies that
+  // the output always matches the output of a fresh encoder. The first pass
+  // warms up the encoder. Returns the number of allocations made by Encode()
+  // for each frame of the second pass.
+  std::vector<int> TestEncoderReuse(int edgebreaker_method) {
+    EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+    options.SetGlobalInt("edgebreaker_method", edgebreaker_method);
+    options.SetAttributeInt(0, "quantization_bits", 12);
+    MeshEdgeBreakerEncoder encoder;
+    EncoderBuffer buffer;
+    const int sizes[] = {40, 40, 40, 32, 40};
+    std::vector<int> num_allocations;
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int frame = 0; frame < 5; ++frame) {
+        const std::unique_ptr<Mesh> mesh =
+            CreateAnimatedGridMesh(sizes[frame], frame);
+        buffer.Clear();
+        encoder.SetMesh(*mesh);
+        {
+          ScopedAllocationCounter counter;
+          EXPECT_TRUE(encoder.Encode(options, &buffer).ok());
+          if (pass == 1)
+            num_allocations.push_back(counter.num_allocations());
+        }
+
+        // The output must be the same as the one of a fresh encoder.
+        MeshEdgeBreakerEncoder fresh_encoder;
+        EncoderBuffer fresh_buffer;
+        fresh_encoder.SetMesh(*mesh);
+        EXPECT_TRUE(fresh_encoder.Encode(options, &fresh_buffer).ok());
+        EXPECT_EQ(buffer.size(), fresh_buffer.size());
+        EXPECT_EQ(memcmp(buffer.data(), fresh_buffer.data(),
+                         std::min(buffer.size(), fresh_buffer.size())),
+                  0);
+
+        DecoderBuffer dec_buffer;
+        dec_buffer.Init(buffer.data(), buffer.size());
+        MeshEdgeBreakerDecoder decoder;
+        Mesh decoded_mesh;
+        DecoderOptions dec_options;
+        EXPECT_TRUE(
+            decoder.Decode(dec_options, &dec_buffer, &decoded_mesh).ok());
+        EXPECT_EQ(decoded_mesh.num_faces(), mesh->num_faces());
+      }
+    }
+    return num_allocations;
+  }
+};
+
+TEST_F(MeshEdgebreakerEncoderReuseTest, CornerTableReuse) {
+  const std::unique_ptr<Mesh> mesh = CreateAnimatedGridMesh(30, 0);
+  const std::unique_ptr<Mesh> small_mesh = CreateAnimatedGridMesh(20, 0);
+  CornerTable corner_table;
+  ASSERT_TRUE(draco::InitializeCornerTableFromPositionAttribute(
+      mesh.get(), &corner_table));
+  {
+    ScopedAllocationCounter counter;
+    ASSERT_TRUE(draco::InitializeCornerTableFromPositionAttribute(
+        mesh.get(), &corner_table));
+    ASSERT_TRUE(draco::InitializeCornerTableFromPositionAttribute(
+        small_mesh.get(), &corner_table));
+    ASSERT_EQ(counter.num_allocations(), 0);
+  }
+  // Compare the reused table with a newly created one.
+  const std::unique_ptr<CornerTable> ref_table =
+      draco::CreateCornerTableFromPositionAttribute(small_mesh.get());
+  ASSERT_NE(ref_table, nullptr);
+  ASSERT_EQ(corner_table.num_corners(), ref_table->num_corners());
+  ASSERT_EQ(corner_table.num_vertices(), ref_table->num_vertices());
+  for (CornerIndex c(0); c < ref_table->num_corners(); ++c) {
+    ASSERT_EQ(corner_table.Opposite(c), ref_table->Opposite(c));
+    ASSERT_EQ(corner_table.Vertex(c), ref_table->Vertex(c));
+  }
+  for (VertexIndex v(0); v < ref_table->num_vertices(); ++v) {
+    ASSERT_EQ(corner_table.LeftMostCorner(v), ref_table->LeftMostCorner(v));
+  }
+}
+
+TEST_F(MeshEdgebreakerEncoderReuseTest, BitEncodingReuse) {
+  EncoderBuffer buffer;
+  for (int i = 0; i < 3; ++i) {
+    ScopedAllocationCounter counter;
+    buffer.Clear();
+    ASSERT_TRUE(buffer.StartBitEncoding(1000, true));
+    for (int b = 0; b < 1000; ++b) {
+      buffer.EncodeLeastSignificantBits32(1, b & 1);
+    }
+    buffer.EndBitEncoding();
+    if (i > 0) {
+      ASSERT_EQ(counter.num_allocations(), 0);
+    }
+  }
+}
+
+TEST_F(MeshEdgebreakerEncoderReuseTest, StandardEdgebreakerReuse) {
+  // A warmed up standard edgebreaker encoder encodes the mesh without any
+  // memory allocations.
+  const std::vector<int> num_allocations =
+      TestEncoderReuse(draco::MESH_EDGEBREAKER_STANDARD_ENCODING);
+  for (int frame = 0; frame < static_cast<int>(num_allocations.size());
+       ++frame) {
+    EXPECT_EQ(num_allocations[frame], 0) << "Allocations in frame " << frame;
+  }
+}
+
+TEST_F(MeshEdgebreakerEncoderReuseTest, ValenceEdgebreakerReuse) {
+  // A warmed up valence edgebreaker encoder encodes the mesh without any
+  // memory allocations.
+  const std::vector<int> num_allocations =
+      TestEncoderReuse(draco::MESH_EDGEBREAKER_VALENCE_ENCODING);
+  for (int frame = 0; frame < static_cast<int>(num_allocations.size());
+       ++frame) {
+    EXPECT_EQ(num_allocations[frame], 0) << "Allocations in frame " << frame;
+  }
+}
+
+}  // namespace
@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_ENCODER_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_ENCODER_H_
 
+#include <vector>
+
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder_impl_interface.h"
 #include "draco/core/bit_coders/rans_bit_encoder.h"
@@ -31,9 +33,7 @@ typedef RAnsBitEncoder BinaryEncoder;
 class MeshEdgeBreakerTraversalEncoder {
  public:
   MeshEdgeBreakerTraversalEncoder()
-      : encoder_impl_(nullptr),
-        attribute_connectivity_encoders_(nullptr),
-        num_attribute_data_(0) {}
+      : encoder_impl_(nullptr), num_attribute_data_(0) {}
   bool Init(MeshEdgeBreakerEncoderImplInterface *encoder) {
     encoder_impl_ = encoder;
     return true;
@@ -43,17 +43,17 @@ class MeshEdgeBreakerTraversalEncoder {
   // the connectivity.
   void SetNumAttributeData(int num_data) { num_attribute_data_ = num_data; }
 
-  // Called before the traversal encoding is started.
+  // Called before the traversal encoding is started. Data from any previous
+  // traversal is discarded, but the allocated memory is reused.
   void Start() {
+    traversal_buffer_.Clear();
+    symbols_.clear();
     start_face_encoder_.StartEncoding();
-    if (num_attribute_data_ > 0) {
-      // Init and start arithmetic encoders for storing configuration types
-      // of non-position attributes.
-      attribute_connectivity_encoders_ = std::unique_ptr<BinaryEncoder[]>(
-          new BinaryEncoder[num_attribute_data_]);
-      for (int i = 0; i < num_attribute_data_; ++i) {
-        attribute_connectivity_encoders_[i].StartEncoding();
-      }
+    // Init and start arithmetic encoders for storing configuration types
+    // of non-position attributes.
+    attribute_connectivity_encoders_.resize(num_attribute_data_);
+    for (int i = 0; i < num_attribute_data_; ++i) {
+      attribute_connectivity_encoders_[i].StartEncoding();
     }
   }
 
@@ -97,13 +97,7 @@ class MeshEdgeBreakerTraversalEncoder {
     rOther.encoder_impl_ = encoder_impl_;
     rOther.symbols_ = symbols_;
     rOther.num_attribute_data_ = num_attribute_data_;
-    if (num_attribute_data_ > 0) {
-      rOther.attribute_connectivity_encoders_ = std::unique_ptr<BinaryEncoder[]>(
-        new BinaryEncoder[num_attribute_data_]);
-      for (int i = 0; i < num_attribute_data_; ++i) {
-        rOther.attribute_connectivity_encoders_[i] = attribute_connectivity_encoders_[i];
-      }
-    }
+    rOther.attribute_connectivity_encoders_ = attribute_connectivity_encoders_;
   }
 
   std::unique_ptr<MeshEdgeBreakerTraversalEncoder> Clone() {
@@ -132,10 +126,8 @@ class MeshEdgeBreakerTraversalEncoder {
   }
 
   void EncodeAttributeSeams() {
-    if (attribute_connectivity_encoders_ != nullptr) {
-      for (int i = 0; i < num_attribute_data_; ++i) {
-        attribute_connectivity_encoders_[i].EndEncoding(&traversal_buffer_);
-      }
+    for (int i = 0; i < num_attribute_data_; ++i) {
+      attribute_connectivity_encoders_[i].EndEncoding(&traversal_buffer_);
     }
   }
 
@@ -152,7 +144,7 @@ class MeshEdgeBreakerTraversalEncoder {
   std::vector<EdgeBreakerTopologyBitPattern> symbols_;
   // Arithmetic encoder for encoding attribute seams.
   // One context for each non-position attribute.
-  std::unique_ptr<BinaryEncoder[]> attribute_connectivity_encoders_;
+  std::vector<BinaryEncoder> attribute_connectivity_encoders_;
   int num_attribute_data_;
 };
 
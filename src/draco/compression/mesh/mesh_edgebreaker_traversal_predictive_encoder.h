@@ -47,6 +47,16 @@ class MeshEdgeBreakerTraversalPredictiveEncoder
     return true;
   }
 
+  // Called before the traversal encoding is started.
+  void Start() {
+    MeshEdgeBreakerTraversalEncoder::Start();
+    predictions_.clear();
+    prev_symbol_ = -1;
+    num_split_symbols_ = 0;
+    last_corner_ = kInvalidCornerIndex;
+    num_symbols_ = 0;
+  }
+
   inline void NewCornerReached(CornerIndex corner) { last_corner_ = corner; }
 
   inline int32_t ComputePredictedSymbol(VertexIndex pivot) {
@@ -45,19 +45,26 @@ class MeshEdgeBreakerTraversalValenceEncoder
         max_valence_(7) {}
 
   bool Init(MeshEdgeBreakerEncoderImplInterface *encoder) {
-
-    // psy_draco.h
-    PSY_DRACO_PROFILE_SECTION("MeshEdgeBreakerEncoderImplInterface::Init");
-
     if (!MeshEdgeBreakerTraversalEncoder::Init(encoder))
       return false;
-
     corner_table_ = encoder->GetCornerTable();
-    if (vertex_valences_.size() == corner_table_->num_vertices()) {
-      return true;
-    }
+    return true;
+  }
+
+  // Called before the traversal encoding is started. The valences are
+  // recomputed for the current corner table, reusing the memory of any
+  // previous traversal.
+  void Start() {
+
+    // psy_draco.h
+    PSY_DRACO_PROFILE_SECTION("MeshEdgeBreakerTraversalValenceEncoder::Start");
+
+    MeshEdgeBreakerTraversalEncoder::Start();
     min_valence_ = 2;
     max_valence_ = 7;
+    prev_symbol_ = -1;
+    last_corner_ = kInvalidCornerIndex;
+    num_symbols_ = 0;
 
     // Initialize valences of all vertices.
     vertex_valences_.resize(corner_table_->num_vertices());
@@ -75,7 +82,9 @@ class MeshEdgeBreakerTraversalValenceEncoder
     const int32_t num_unique_valences = max_valence_ - min_valence_ + 1;
 
     context_symbols_.resize(num_unique_valences);
-    return true;
+    for (auto &symbols : context_symbols_) {
+      symbols.clear();
+    }
   }
 
   inline void NewCornerReached(CornerIndex corner) { last_corner_ = corner; }
@@ -200,7 +209,7 @@ class MeshEdgeBreakerTraversalValenceEncoder
       EncodeVarint<uint32_t>(context_symbols_[i].size(), GetOutputBuffer());
       if (context_symbols_[i].size() > 0) {
         EncodeSymbols(context_symbols_[i].data(), context_symbols_[i].size(), 1,
-                      nullptr, GetOutputBuffer());
+                      nullptr, &symbol_encoding_buffers_, GetOutputBuffer());
       }
     }
   }
@@ -242,6 +251,8 @@ class MeshEdgeBreakerTraversalValenceEncoder
   int min_valence_;
   int max_valence_;
   std::vector<std::vector<uint32_t>> context_symbols_;
+  // Temporary memory of the symbol encoding that is reused by all frames.
+  SymbolEncodingBuffers symbol_encoding_buffers_;
 };
 
 }  // namespace draco
@@ -23,6 +23,7 @@ void MeshEncoder::SetMesh(const Mesh &m) {
 }
 
 bool MeshEncoder::EncodeGeometryData() {
+  set_num_encoded_faces(mesh_->num_faces());
   if (!EncodeConnectivity())
     return false;
   return true;
@@ -0,0 +1,446 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/progressive_mesh_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/core/symbol_coding_utils.h"
+#include "draco/core/symbol_decoding.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+namespace {
+
+// Decodes the quantization of all attributes.
+Status DecodeQuantization(DecoderBuffer *buffer,
+                          std::vector<int> *out_quantization_bits,
+                          std::vector<std::vector<float>> *out_origins,
+                          std::vector<float> *out_ranges) {
+  uint32_t num_attributes;
+  if (!DecodeVarint(&num_attributes, buffer))
+    return Status(Status::IO_ERROR, "Failed to decode the quantization.");
+  if (num_attributes > buffer->remaining_size())
+    return Status(Status::ERROR, "Invalid number of attributes.");
+  out_quantization_bits->resize(num_attributes);
+  out_origins->resize(num_attributes);
+  out_ranges->resize(num_attributes);
+  for (uint32_t i = 0; i < num_attributes; ++i) {
+    uint8_t quantization_bits;
+    if (!buffer->Decode(&quantization_bits))
+      return Status(Status::IO_ERROR, "Failed to decode the quantization.");
+    (*out_quantization_bits)[i] = quantization_bits;
+    if (quantization_bits == 0)
+      continue;
+    uint8_t num_components;
+    if (!buffer->Decode(&num_components))
+      return Status(Status::IO_ERROR, "Failed to decode the quantization.");
+    (*out_origins)[i].resize(num_components);
+    if (!buffer->Decode((*out_origins)[i].data(),
+                        sizeof(float) * num_components) ||
+        !buffer->Decode(&(*out_ranges)[i]))
+      return Status(Status::IO_ERROR, "Failed to decode the quantization.");
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+ProgressiveMeshDecoder::ProgressiveMeshDecoder()
+    : num_base_points_(0),
+      base_mesh_offset_(0),
+      num_decoded_levels_(0),
+      num_points_(0) {}
+
+Status ProgressiveMeshDecoder::DecodeHeader(DecoderBuffer *buffer) {
+  level_offsets_.clear();
+  num_decoded_levels_ = 0;
+  const int64_t start_offset = buffer->decoded_size();
+  char magic[kProgressiveMeshMagicLength];
+  if (!buffer->Decode(magic, kProgressiveMeshMagicLength) ||
+      memcmp(magic, kProgressiveMeshMagic, kProgressiveMeshMagicLength) != 0)
+    return Status(Status::ERROR, "Not a progressive Draco mesh.");
+  uint8_t version_major, version_minor;
+  if (!buffer->Decode(&version_major) || !buffer->Decode(&version_minor))
+    return Status(Status::IO_ERROR, "Failed to parse the header.");
+  if (version_major != kProgressiveMeshVersionMajor)
+    return Status(Status::UNKNOWN_VERSION, "Unknown version.");
+  uint32_t num_base_points, num_levels;
+  uint64_t base_mesh_size;
+  if (!DecodeVarint(&num_base_points, buffer) ||
+      !DecodeVarint(&num_levels, buffer) ||
+      !DecodeVarint(&base_mesh_size, buffer))
+    return Status(Status::IO_ERROR, "Failed to parse the header.");
+  if (num_levels > buffer->remaining_size())
+    return Status(Status::IO_ERROR, "Invalid number of refinement levels.");
+  if (num_base_points > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+    return Status(Status::ERROR, "Invalid number of base points.");
+  num_base_points_ = num_base_points;
+  std::vector<uint64_t> level_sizes(num_levels);
+  for (uint64_t &level_size : level_sizes) {
+    if (!DecodeVarint(&level_size, buffer))
+      return Status(Status::IO_ERROR, "Failed to parse the header.");
+  }
+  base_mesh_offset_ = buffer->decoded_size() - start_offset;
+
+  // The data of the base mesh and of the refinement levels may not be
+  // available yet, so the sizes are checked against |buffer| only when the
+  // data is decoded. Here, they are only checked so that the offsets don't
+  // overflow.
+  const int64_t max_offset = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> level_offsets;
+  level_offsets.reserve(num_levels + 1);
+  if (base_mesh_size > static_cast<uint64_t>(max_offset - base_mesh_offset_))
+    return Status(Status::ERROR, "Invalid base mesh size.");
+  level_offsets.push_back(base_mesh_offset_ + base_mesh_size);
+  for (const uint64_t level_size : level_sizes) {
+    if (level_size > static_cast<uint64_t>(max_offset - level_offsets.back()))
+      return Status(Status::ERROR, "Invalid refinement level size.");
+    level_offsets.push_back(level_offsets.back() + level_size);
+  }
+  level_offsets_ = std::move(level_offsets);
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::DecodeBaseMesh(DecoderBuffer *buffer) {
+  if (level_offsets_.empty())
+    return Status(Status::ERROR, "Missing header.");
+  const int64_t base_mesh_size = level_offsets_[0] - base_mesh_offset_;
+  if (base_mesh_size > buffer->remaining_size())
+    return Status(Status::IO_ERROR, "Missing base mesh data.");
+  DecoderBuffer base_buffer;
+  base_buffer.Init(buffer->data_head(), base_mesh_size);
+  std::vector<int> quantization_bits;
+  std::vector<std::vector<float>> origins;
+  std::vector<float> ranges;
+  DRACO_RETURN_IF_ERROR(
+      DecodeQuantization(&base_buffer, &quantization_bits, &origins, &ranges));
+  Decoder decoder;
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> base_mesh,
+                         decoder.DecodeMeshFromBuffer(&base_buffer));
+  const int num_attributes = base_mesh->num_attributes() - 1;
+  if (num_attributes != static_cast<int>(quantization_bits.size()))
+    return Status(Status::ERROR, "Invalid number of attributes.");
+  const PointAttribute *const id_att =
+      base_mesh->GetAttributeByUniqueId(num_attributes);
+  if (id_att == nullptr || id_att->data_type() != DT_UINT32 ||
+      id_att->num_components() != 1)
+    return Status(Status::ERROR, "Missing point ids.");
+  // Each base point is stored in the base mesh at least once. This also
+  // bounds the memory allocated for the base points by the size of the
+  // decoded data.
+  if (static_cast<int64_t>(num_base_points_) > base_mesh->num_points())
+    return Status(Status::ERROR, "Invalid number of base points.");
+
+  attribute_formats_.clear();
+  attribute_values_.clear();
+  converters_.assign(num_attributes, ProgressiveMeshValueConverter());
+  attribute_integers_.clear();
+  for (int i = 0; i < num_attributes; ++i) {
+    const PointAttribute *const att = base_mesh->GetAttributeByUniqueId(i);
+    if (att == nullptr)
+      return Status(Status::ERROR, "Missing attribute.");
+    if ((quantization_bits[i] > 0 &&
+         static_cast<int>(origins[i].size()) != att->num_components()) ||
+        !converters_[i].Init(att->data_type(), att->num_components(),
+                             quantization_bits[i], origins[i].data(),
+                             ranges[i]))
+      return Status(Status::ERROR, "Invalid attribute.");
+    GeometryAttribute va;
+    va.Init(att->attribute_type(), nullptr, att->num_components(),
+            att->data_type(), att->normalized(),
+            att->num_components() * DataTypeLength(att->data_type()), 0);
+    attribute_formats_.push_back(va);
+    attribute_values_.push_back(
+        std::vector<uint8_t>(num_base_points_ * va.byte_stride()));
+    attribute_integers_.push_back(std::vector<int64_t>(
+        static_cast<size_t>(num_base_points_) * att->num_components()));
+  }
+  num_points_ = num_base_points_;
+  DRACO_RETURN_IF_ERROR(CopyAttributeValues(*base_mesh, id_att));
+
+  // Base points may be duplicated by the mesh decoder so the faces use the
+  // point ids stored in the id attribute.
+  faces_.clear();
+  point_faces_.clear();
+  point_faces_.resize(num_base_points_);
+  for (FaceIndex f(0); f < base_mesh->num_faces(); ++f) {
+    Mesh::Face face;
+    for (int c = 0; c < 3; ++c) {
+      uint32_t id;
+      id_att->GetMappedValue(base_mesh->face(f)[c], &id);
+      if (id >= static_cast<uint32_t>(num_base_points_))
+        return Status(Status::ERROR, "Invalid point id.");
+      face[c] = PointIndex(id);
+      point_faces_[face[c]].push_back(FaceIndex(faces_.size()));
+    }
+    faces_.push_back(face);
+  }
+  buffer->Advance(base_mesh_size);
+  num_decoded_levels_ = 0;
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::DecodeNextRefinementLevel(
+    DecoderBuffer *buffer) {
+  if (num_decoded_levels_ >= num_refinement_levels())
+    return Status(Status::ERROR, "All refinement levels are decoded.");
+  const int64_t level_size = level_offsets_[num_decoded_levels_ + 1] -
+                             level_offsets_[num_decoded_levels_];
+  if (level_size > buffer->remaining_size())
+    return Status(Status::IO_ERROR, "Missing refinement level data.");
+  // The vertex splits are always encoded with the current version of the
+  // entropy coders.
+  DecoderBuffer level_buffer;
+  level_buffer.Init(buffer->data_head(), level_size, kDracoBitstreamVersion);
+
+  uint32_t num_batches;
+  if (!DecodeVarint(&num_batches, &level_buffer))
+    return Status(Status::IO_ERROR, "Failed to decode vertex splits.");
+  const PointIndex::ValueType first_new_point = num_points_;
+  new_point_neighbors_.clear();
+  for (uint32_t i = 0; i < num_batches; ++i) {
+    DRACO_RETURN_IF_ERROR(DecodeVertexSplits(&level_buffer));
+  }
+  const PointIndex::ValueType num_new_points =
+      point_faces_.size() - num_points_;
+  DRACO_RETURN_IF_ERROR(
+      DecodeAttributeValues(&level_buffer, first_new_point, num_new_points));
+  buffer->Advance(level_size);
+  ++num_decoded_levels_;
+  return OkStatus();
+}
+
+std::unique_ptr<Mesh> ProgressiveMeshDecoder::GetMesh() const {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->set_num_points(num_points_);
+  for (size_t i = 0; i < attribute_formats_.size(); ++i) {
+    PointAttribute *const att = mesh->attribute(
+        mesh->AddAttribute(attribute_formats_[i], true, num_points_));
+    const int64_t stride = attribute_formats_[i].byte_stride();
+    for (AttributeValueIndex avi(0); avi < num_points_; ++avi) {
+      att->SetAttributeValue(
+          avi, attribute_values_[i].data() + avi.value() * stride);
+    }
+  }
+  for (FaceIndex f(0); f < faces_.size(); ++f) {
+    mesh->AddFace(faces_[f]);
+  }
+  return mesh;
+}
+
+StatusOr<std::unique_ptr<Mesh>> ProgressiveMeshDecoder::DecodeMesh(
+    DecoderBuffer *buffer, int max_levels) {
+  DRACO_RETURN_IF_ERROR(DecodeHeader(buffer));
+  DRACO_RETURN_IF_ERROR(DecodeBaseMesh(buffer));
+  const int num_levels = max_levels < 0
+                             ? num_refinement_levels()
+                             : std::min(max_levels, num_refinement_levels());
+  while (num_decoded_levels_ < num_levels) {
+    const int64_t level_size = level_offsets_[num_decoded_levels_ + 1] -
+                               level_offsets_[num_decoded_levels_];
+    if (level_size > buffer->remaining_size())
+      break;  // Truncated data.
+    DRACO_RETURN_IF_ERROR(DecodeNextRefinementLevel(buffer));
+  }
+  return GetMesh();
+}
+
+Status ProgressiveMeshDecoder::DecodeVertexSplits(DecoderBuffer *buffer) {
+  uint32_t num_splits;
+  if (!DecodeVarint(&num_splits, buffer))
+    return Status(Status::IO_ERROR, "Failed to decode vertex splits.");
+  if (num_splits > buffer->remaining_size())
+    return Status(Status::ERROR, "Invalid number of vertex splits.");
+  std::vector<uint32_t> split_point_deltas(num_splits);
+  std::vector<uint32_t> neighbor_indices(2 * num_splits);
+  if (num_splits > 0) {
+    if (!DecodeSymbols(num_splits, 1, buffer, split_point_deltas.data()) ||
+        !DecodeSymbols(2 * num_splits, 1, buffer, neighbor_indices.data()))
+      return Status(Status::IO_ERROR, "Failed to decode vertex splits.");
+  }
+  RAnsBitDecoder bit_decoder;
+  if (!bit_decoder.StartDecoding(buffer))
+    return Status(Status::IO_ERROR, "Failed to decode vertex splits.");
+
+  // New points are not added to |num_points_| until their attribute values
+  // are decoded.
+  const PointIndex::ValueType first_new_point = point_faces_.size();
+  point_faces_.resize(first_new_point + num_splits);
+  uint32_t split_point = 0;
+  for (uint32_t i = 0; i < num_splits; ++i) {
+    if (i > 0 && split_point_deltas[i] == 0)
+      return Status(Status::ERROR, "Invalid vertex split.");
+    split_point += split_point_deltas[i];
+    if (split_point >= first_new_point)
+      return Status(Status::ERROR, "Invalid vertex split.");
+    DRACO_RETURN_IF_ERROR(ApplyVertexSplit(PointIndex(split_point),
+                                           PointIndex(first_new_point + i),
+                                           &neighbor_indices[2 * i],
+                                           &bit_decoder));
+  }
+  bit_decoder.EndDecoding();
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::ApplyVertexSplit(
+    PointIndex u, PointIndex v, const uint32_t *neighbor_indices,
+    RAnsBitDecoder *bit_decoder) {
+  // Sort faces of |u| by the ids of their other points.
+  std::vector<std::pair<std::pair<PointIndex, PointIndex>, FaceIndex>> faces;
+  std::vector<PointIndex> neighbors;
+  for (const FaceIndex &f : point_faces_[u]) {
+    PointIndex other[2];
+    int num_other = 0;
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[f][c] != u && num_other < 2)
+        other[num_other++] = faces_[f][c];
+    }
+    if (num_other != 2)
+      return Status(Status::ERROR, "Invalid vertex split.");
+    if (other[1] < other[0])
+      std::swap(other[0], other[1]);
+    faces.push_back(std::make_pair(std::make_pair(other[0], other[1]), f));
+    neighbors.push_back(other[0]);
+    neighbors.push_back(other[1]);
+  }
+  std::sort(faces.begin(), faces.end());
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+
+  bool is_flipped[2];
+  for (int i = 0; i < 2; ++i) {
+    is_flipped[i] = bit_decoder->DecodeNextBit();
+    if (neighbor_indices[i] >= neighbors.size())
+      return Status(Status::ERROR, "Invalid vertex split.");
+  }
+
+  // Move the selected faces to the new point.
+  for (const auto &face : faces) {
+    if (!bit_decoder->DecodeNextBit())
+      continue;
+    const FaceIndex f = face.second;
+    std::replace(faces_[f].begin(), faces_[f].end(), u, v);
+    std::vector<FaceIndex> &faces_u = point_faces_[u];
+    faces_u.erase(std::find(faces_u.begin(), faces_u.end(), f));
+    point_faces_[v].push_back(f);
+  }
+
+  // Add the faces between |u| and |v|.
+  for (int i = 0; i < 2; ++i) {
+    const PointIndex w = neighbors[neighbor_indices[i]];
+    Mesh::Face face;
+    face[0] = is_flipped[i] ? v : u;
+    face[1] = is_flipped[i] ? u : v;
+    face[2] = w;
+    const FaceIndex f(faces_.size());
+    for (int c = 0; c < 3; ++c) {
+      point_faces_[face[c]].push_back(f);
+    }
+    faces_.push_back(face);
+  }
+
+  std::vector<PointIndex> neighbors_v;
+  for (const FaceIndex &f : point_faces_[v]) {
+    for (int c = 0; c < 3; ++c) {
+      if (faces_[f][c] != v)
+        neighbors_v.push_back(faces_[f][c]);
+    }
+  }
+  std::sort(neighbors_v.begin(), neighbors_v.end());
+  neighbors_v.erase(std::unique(neighbors_v.begin(), neighbors_v.end()),
+                    neighbors_v.end());
+  new_point_neighbors_.push_back(std::move(neighbors_v));
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::CopyAttributeValues(
+    const Mesh &base_mesh, const PointAttribute *id_att) {
+  for (size_t i = 0; i < attribute_formats_.size(); ++i) {
+    const PointAttribute *const att = base_mesh.GetAttributeByUniqueId(i);
+    const GeometryAttribute &format = attribute_formats_[i];
+    const int64_t stride = format.byte_stride();
+    const int num_components = format.num_components();
+    for (PointIndex p(0); p < base_mesh.num_points(); ++p) {
+      uint32_t id;
+      id_att->GetMappedValue(p, &id);
+      if (id >= num_points_)
+        return Status(Status::ERROR, "Invalid point id.");
+      memcpy(attribute_values_[i].data() + id * stride,
+             att->GetAddressOfMappedIndex(p), stride);
+      converters_[i].ToIntegers(
+          att->GetAddressOfMappedIndex(p),
+          &attribute_integers_[i][static_cast<size_t>(id) * num_components]);
+    }
+  }
+  return OkStatus();
+}
+
+Status ProgressiveMeshDecoder::DecodeAttributeValues(
+    DecoderBuffer *buffer, PointIndex::ValueType first_new_point,
+    PointIndex::ValueType num_new_points) {
+  num_points_ += num_new_points;
+  for (size_t i = 0; i < attribute_formats_.size(); ++i) {
+    const int64_t stride = attribute_formats_[i].byte_stride();
+    const int num_components = attribute_formats_[i].num_components();
+    std::vector<int64_t> &integers = attribute_integers_[i];
+    attribute_values_[i].resize(num_points_ * stride);
+    integers.resize(static_cast<size_t>(num_points_) * num_components);
+    if (num_new_points == 0)
+      continue;
+    const uint32_t num_values = num_new_points * num_components;
+    std::vector<uint32_t> symbols(num_values, 0);
+    uint8_t is_entropy_coded;
+    if (!buffer->Decode(&is_entropy_coded))
+      return Status(Status::IO_ERROR, "Failed to decode attribute values.");
+    if (is_entropy_coded) {
+      if (!DecodeSymbols(num_values, num_components, buffer, symbols.data()))
+        return Status(Status::IO_ERROR, "Failed to decode attribute values.");
+    } else {
+      uint8_t num_bytes;
+      if (!buffer->Decode(&num_bytes) || num_bytes == 0 ||
+          num_bytes > sizeof(uint32_t) ||
+          static_cast<int64_t>(num_bytes) * num_values >
+              buffer->remaining_size())
+        return Status(Status::IO_ERROR, "Failed to decode attribute values.");
+      for (uint32_t &symbol : symbols) {
+        buffer->Decode(&symbol, num_bytes);
+      }
+    }
+    std::vector<int32_t> residuals(num_values);
+    ConvertSymbolsToSignedInts(symbols.data(), num_values, residuals.data());
+    for (PointIndex::ValueType j = 0; j < num_new_points; ++j) {
+      const PointIndex::ValueType v = first_new_point + j;
+      int64_t *const value =
+          &integers[static_cast<size_t>(v) * num_components];
+      PredictProgressiveMeshValue(integers, num_components,
+                                  new_point_neighbors_[j], value);
+      for (int c = 0; c < num_components; ++c) {
+        value[c] += residuals[j * num_components + c];
+      }
+      converters_[i].FromIntegers(value,
+                                  attribute_values_[i].data() + v * stride);
+    }
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
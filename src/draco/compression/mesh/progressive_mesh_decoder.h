@@ -0,0 +1,124 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/mesh/progressive_mesh_shared.h"
+#include "draco/core/bit_coders/rans_bit_decoder.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/core/statusor.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decoder of progressive meshes encoded by the ProgressiveMeshEncoder. The base
+// mesh is decoded first and the refinement levels can then be applied one by
+// one. The decoding can stop after any level, e.g., when only a prefix of the
+// encoded data has been received.
+//
+// Usage:
+//   ProgressiveMeshDecoder decoder;
+//   DRACO_RETURN_IF_ERROR(decoder.DecodeHeader(&buffer));
+//   // The first decoder.GetEncodedSize(n) bytes of the encoded data contain
+//   // the base mesh and the first n refinement levels.
+//   DRACO_RETURN_IF_ERROR(decoder.DecodeBaseMesh(&buffer));
+//   while (...) {
+//     DRACO_RETURN_IF_ERROR(decoder.DecodeNextRefinementLevel(&buffer));
+//   }
+//   std::unique_ptr<Mesh> mesh = decoder.GetMesh();
+class ProgressiveMeshDecoder {
+ public:
+  ProgressiveMeshDecoder();
+
+  // Decodes the header. |buffer| must point to the start of the encoded data.
+  Status DecodeHeader(DecoderBuffer *buffer);
+
+  int num_refinement_levels() const {
+    return static_cast<int>(level_offsets_.size()) - 1;
+  }
+  int num_decoded_refinement_levels() const { return num_decoded_levels_; }
+
+  // Returns the number of bytes from the start of the encoded data needed to
+  // decode the base mesh and the first |num_levels| refinement levels.
+  int64_t GetEncodedSize(int num_levels) const {
+    return level_offsets_[num_levels];
+  }
+
+  // Decodes the base mesh. |buffer| must point to the data after the header.
+  Status DecodeBaseMesh(DecoderBuffer *buffer);
+
+  // Decodes the next refinement level and applies it to the current mesh.
+  Status DecodeNextRefinementLevel(DecoderBuffer *buffer);
+
+  // Returns the mesh at the current level of detail.
+  std::unique_ptr<Mesh> GetMesh() const;
+
+  // Decodes the base mesh and at most |max_levels| refinement levels (all
+  // levels when |max_levels| is negative). Decoding stops early when |buffer|
+  // doesn't contain all data of the next level.
+  StatusOr<std::unique_ptr<Mesh>> DecodeMesh(DecoderBuffer *buffer,
+                                             int max_levels);
+
+  // Decodes all available levels from |buffer|.
+  StatusOr<std::unique_ptr<Mesh>> DecodeMesh(DecoderBuffer *buffer) {
+    return DecodeMesh(buffer, -1);
+  }
+
+ private:
+  // Decodes a batch of vertex splits and applies it to the current mesh.
+  Status DecodeVertexSplits(DecoderBuffer *buffer);
+  // Splits point |u| into |u| and the new point |v|. Neighbors of |v| are
+  // added to |new_point_neighbors_|.
+  Status ApplyVertexSplit(PointIndex u, PointIndex v,
+                          const uint32_t *neighbor_indices,
+                          RAnsBitDecoder *bit_decoder);
+  // Copies values of all attributes of |base_mesh| into the decoded
+  // attributes. Each point is stored at the point given by |id_att|.
+  Status CopyAttributeValues(const Mesh &base_mesh,
+                             const PointAttribute *id_att);
+  // Decodes attribute values of the |num_new_points| points starting at
+  // |first_new_point|.
+  Status DecodeAttributeValues(DecoderBuffer *buffer,
+                               PointIndex::ValueType first_new_point,
+                               PointIndex::ValueType num_new_points);
+
+  int num_base_points_;
+  int64_t base_mesh_offset_;
+  // Offsets of the ends of the base mesh and of all refinement levels.
+  std::vector<int64_t> level_offsets_;
+  int num_decoded_levels_;
+
+  // Current mesh. Attribute values are stored for each point.
+  std::vector<GeometryAttribute> attribute_formats_;
+  std::vector<std::vector<uint8_t>> attribute_values_;
+  // Converters of the values of each attribute and integer values of all
+  // points from which the values of new points are predicted.
+  std::vector<ProgressiveMeshValueConverter> converters_;
+  std::vector<std::vector<int64_t>> attribute_integers_;
+  PointIndex::ValueType num_points_;
+  IndexTypeVector<FaceIndex, Mesh::Face> faces_;
+  IndexTypeVector<PointIndex, std::vector<FaceIndex>> point_faces_;
+  // Neighbors of the new points of the current refinement level right after
+  // their vertex splits.
+  std::vector<std::vector<PointIndex>> new_point_neighbors_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_DECODER_H_
@@ -0,0 +1,725 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh/progressive_mesh_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "draco/compression/decode.h"
+#include "draco/core/bit_coders/rans_bit_encoder.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/symbol_coding_utils.h"
+#include "draco/core/symbol_encoding.h"
+#include "draco/core/varint_encoding.h"
+#include "draco/core/vector_d.h"
+
+namespace draco {
+
+namespace {
+
+// Returns the ids of the two points of |face| other than |p| in ascending
+// order.
+std::pair<PointIndex, PointIndex> GetOtherPoints(const Mesh::Face &face,
+                                                 PointIndex p) {
+  PointIndex other[2];
+  int num_other = 0;
+  for (int c = 0; c < 3 && num_other < 2; ++c) {
+    if (face[c] != p)
+      other[num_other++] = face[c];
+  }
+  return std::make_pair(std::min(other[0], other[1]),
+                        std::max(other[0], other[1]));
+}
+
+void RemoveFace(FaceIndex f, std::vector<FaceIndex> *faces) {
+  faces->erase(std::find(faces->begin(), faces->end(), f));
+}
+
+// Differences of attribute values with more bits are stored without entropy
+// coding, because the entropy coder allocates tables for all symbol values.
+constexpr int kMaxEntropyCodedBitLength = 18;
+
+// Computes the quantization box of all values of |atts|, i.e., the minimum of
+// each component and the maximum size over all components.
+void ComputeQuantizationBox(const std::vector<const PointAttribute *> &atts,
+                            std::vector<float> *out_origin, float *out_range) {
+  const int num_components = atts[0]->num_components();
+  std::vector<float> max_values(num_components);
+  std::vector<float> value(num_components);
+  atts[0]->GetValue(AttributeValueIndex(0), &value[0]);
+  *out_origin = value;
+  max_values = value;
+  for (const PointAttribute *const att : atts) {
+    for (AttributeValueIndex avi(0); avi < att->size(); ++avi) {
+      att->GetValue(avi, &value[0]);
+      for (int c = 0; c < num_components; ++c) {
+        (*out_origin)[c] = std::min((*out_origin)[c], value[c]);
+        max_values[c] = std::max(max_values[c], value[c]);
+      }
+    }
+  }
+  *out_range = 0.f;
+  for (int c = 0; c < num_components; ++c) {
+    *out_range = std::max(*out_range, max_values[c] - (*out_origin)[c]);
+  }
+}
+
+}  // namespace
+
+ProgressiveMeshEncoder::ProgressiveMeshEncoder()
+    : num_refinement_levels_(8),
+      level_of_detail_ratio_(2.f),
+      num_faces_(0) {}
+
+void ProgressiveMeshEncoder::SetNumRefinementLevels(int num_levels) {
+  num_refinement_levels_ = num_levels;
+}
+
+void ProgressiveMeshEncoder::SetLevelOfDetailRatio(float ratio) {
+  level_of_detail_ratio_ = ratio;
+}
+
+Status ProgressiveMeshEncoder::EncodeMeshToBuffer(const Mesh &mesh,
+                                                  EncoderBuffer *out_buffer) {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || pos_att->num_components() != 3)
+    return Status(Status::ERROR, "Mesh must have 3D positions.");
+
+  // Initialize the simplified mesh.
+  faces_.clear();
+  point_faces_.clear();
+  point_faces_.resize(mesh.num_points());
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const Mesh::Face &face = mesh.face(f);
+    if (face[0] == face[1] || face[0] == face[2] || face[1] == face[2])
+      continue;
+    for (int c = 0; c < 3; ++c) {
+      point_faces_[face[c]].push_back(FaceIndex(faces_.size()));
+    }
+    faces_.push_back(face);
+  }
+  if (faces_.size() == 0)
+    return Status(Status::ERROR, "Mesh has no faces.");
+  is_face_deleted_.assign(faces_.size(), false);
+  num_faces_ = faces_.size();
+  positions_.resize(mesh.num_points());
+  for (PointIndex p(0); p < mesh.num_points(); ++p) {
+    pos_att->ConvertValue<float, 3>(pos_att->mapped_index(p),
+                                    &positions_[p][0]);
+  }
+
+  // Each level of detail is created by collapsing batches until the number
+  // of faces drops by the requested ratio.
+  std::vector<std::vector<std::vector<VertexSplit>>> levels;
+  bool can_collapse = true;
+  while (can_collapse &&
+         static_cast<int>(levels.size()) < num_refinement_levels_) {
+    const float target_num_faces = num_faces_ / level_of_detail_ratio_;
+    std::vector<std::vector<VertexSplit>> batches;
+    while (num_faces_ > target_num_faces) {
+      std::vector<VertexSplit> splits;
+      if (!CollapseBatch(&splits)) {
+        can_collapse = false;
+        break;
+      }
+      batches.push_back(std::move(splits));
+    }
+    if (batches.empty())
+      break;
+    // Vertex splits are applied in the reverse order of the collapses.
+    std::reverse(batches.begin(), batches.end());
+    levels.push_back(std::move(batches));
+  }
+  std::reverse(levels.begin(), levels.end());
+
+  // All points that are still referenced by the simplified mesh belong to the
+  // base mesh.
+  point_ids_.assign(mesh.num_points(), kInvalidPointIndex);
+  int num_base_points = 0;
+  for (PointIndex p(0); p < mesh.num_points(); ++p) {
+    if (!point_faces_[p].empty())
+      point_ids_[p] = PointIndex(num_base_points++);
+  }
+  attribute_integers_.resize(mesh.num_attributes());
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    attribute_integers_[a].assign(
+        static_cast<size_t>(mesh.num_points()) *
+            mesh.attribute(a)->num_components(),
+        0);
+  }
+  EncoderBuffer base_buffer;
+  DRACO_RETURN_IF_ERROR(EncodeBaseMesh(mesh, num_base_points, &base_buffer));
+
+  std::vector<EncoderBuffer> level_buffers(levels.size());
+  for (size_t i = 0; i < levels.size(); ++i) {
+    DRACO_RETURN_IF_ERROR(
+        EncodeRefinementLevel(mesh, &levels[i], &level_buffers[i]));
+  }
+
+  out_buffer->Encode(kProgressiveMeshMagic, kProgressiveMeshMagicLength);
+  out_buffer->Encode(kProgressiveMeshVersionMajor);
+  out_buffer->Encode(kProgressiveMeshVersionMinor);
+  EncodeVarint(static_cast<uint32_t>(num_base_points), out_buffer);
+  EncodeVarint(static_cast<uint32_t>(levels.size()), out_buffer);
+  EncodeVarint(static_cast<uint64_t>(base_buffer.size()), out_buffer);
+  for (const EncoderBuffer &level_buffer : level_buffers) {
+    EncodeVarint(static_cast<uint64_t>(level_buffer.size()), out_buffer);
+  }
+  out_buffer->Encode(base_buffer.data(), base_buffer.size());
+  for (const EncoderBuffer &level_buffer : level_buffers) {
+    out_buffer->Encode(level_buffer.data(), level_buffer.size());
+  }
+  return OkStatus();
+}
+
+bool ProgressiveMeshEncoder::CollapseBatch(
+    std::vector<VertexSplit> *out_splits) {
+  // Find the shortest valid collapse for each point.
+  std::vector<std::pair<float, std::pair<PointIndex, PointIndex>>> candidates;
+  for (PointIndex v(0); v < point_faces_.size(); ++v) {
+    if (!IsInteriorPoint(v))
+      continue;
+    float best_cost = -1.f;
+    PointIndex best_u = kInvalidPointIndex;
+    for (const PointIndex &u : GetNeighbors(v)) {
+      const Vector3f pos_u(positions_[u][0], positions_[u][1],
+                           positions_[u][2]);
+      const Vector3f pos_v(positions_[v][0], positions_[v][1],
+                           positions_[v][2]);
+      const float cost = (pos_u - pos_v).SquaredNorm();
+      if (best_u != kInvalidPointIndex && cost >= best_cost)
+        continue;
+      if (!CanCollapse(v, u))
+        continue;
+      best_cost = cost;
+      best_u = u;
+    }
+    if (best_u != kInvalidPointIndex)
+      candidates.push_back(
+          std::make_pair(best_cost, std::make_pair(v, best_u)));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  // Greedily select collapses whose neighborhoods don't overlap, so that the
+  // vertex splits of the batch can be applied in any order.
+  std::vector<bool> is_locked(point_faces_.size(), false);
+  for (const auto &candidate : candidates) {
+    const PointIndex v = candidate.second.first;
+    const PointIndex u = candidate.second.second;
+    std::vector<PointIndex> region = GetNeighbors(v);
+    const std::vector<PointIndex> neighbors_u = GetNeighbors(u);
+    region.insert(region.end(), neighbors_u.begin(), neighbors_u.end());
+    bool is_free = true;
+    for (const PointIndex &p : region) {
+      if (is_locked[p.value()]) {
+        is_free = false;
+        break;
+      }
+    }
+    if (!is_free)
+      continue;
+    for (const PointIndex &p : region) {
+      is_locked[p.value()] = true;
+    }
+    out_splits->push_back(VertexSplit());
+    Collapse(v, u, &out_splits->back());
+  }
+  return !out_splits->empty();
+}
+
+bool ProgressiveMeshEncoder::CanCollapse(PointIndex v, PointIndex u) const {
+  // The edge <u, v> must be shared by exactly two faces and their opposite
+  // points must be the only common neighbors of |u| and |v|. Otherwise the
+  // collapse would create non-manifold edges.
+  std::vector<PointIndex> opposite_points;
+  for (const FaceIndex &f : point_faces_[v]) {
+    const std::pair<PointIndex, PointIndex> other =
+        GetOtherPoints(faces_[f], v);
+    if (other.first == u)
+      opposite_points.push_back(other.second);
+    else if (other.second == u)
+      opposite_points.push_back(other.first);
+  }
+  if (opposite_points.size() != 2 || opposite_points[0] == opposite_points[1])
+    return false;
+  std::vector<PointIndex> neighbors_v = GetNeighbors(v);
+  std::vector<PointIndex> neighbors_u = GetNeighbors(u);
+  std::vector<PointIndex> common_neighbors;
+  std::set_intersection(neighbors_v.begin(), neighbors_v.end(),
+                        neighbors_u.begin(), neighbors_u.end(),
+                        std::back_inserter(common_neighbors));
+  if (common_neighbors.size() != 2)
+    return false;
+
+  // All faces of |u| must stay unique and the faces moved from |v| to |u|
+  // must not flip.
+  std::vector<std::pair<PointIndex, PointIndex>> face_keys;
+  for (const FaceIndex &f : point_faces_[u]) {
+    const Mesh::Face &face = faces_[f];
+    if (std::find(face.begin(), face.end(), v) == face.end())
+      face_keys.push_back(GetOtherPoints(face, u));
+  }
+  for (const FaceIndex &f : point_faces_[v]) {
+    const Mesh::Face &face = faces_[f];
+    if (std::find(face.begin(), face.end(), u) != face.end())
+      continue;
+    face_keys.push_back(GetOtherPoints(face, v));
+    Vector3f pos[3];
+    for (int c = 0; c < 3; ++c) {
+      const std::array<float, 3> &p = positions_[face[c]];
+      pos[c] = Vector3f(p[0], p[1], p[2]);
+    }
+    const Vector3f old_normal = CrossProduct(pos[1] - pos[0], pos[2] - pos[0]);
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] == v) {
+        const std::array<float, 3> &p = positions_[u];
+        pos[c] = Vector3f(p[0], p[1], p[2]);
+      }
+    }
+    const Vector3f new_normal = CrossProduct(pos[1] - pos[0], pos[2] - pos[0]);
+    if (old_normal.Dot(new_normal) <= 0.f)
+      return false;
+  }
+  std::sort(face_keys.begin(), face_keys.end());
+  return std::adjacent_find(face_keys.begin(), face_keys.end()) ==
+         face_keys.end();
+}
+
+void ProgressiveMeshEncoder::Collapse(PointIndex v, PointIndex u,
+                                      VertexSplit *out_split) {
+  out_split->u = u;
+  out_split->v = v;
+  std::vector<FaceIndex> moved_faces;
+  int num_removed_faces = 0;
+  for (const FaceIndex &f : point_faces_[v]) {
+    Mesh::Face &face = faces_[f];
+    if (std::find(face.begin(), face.end(), u) != face.end()) {
+      out_split->removed_faces[num_removed_faces++] = face;
+      is_face_deleted_[f.value()] = true;
+      --num_faces_;
+      for (int c = 0; c < 3; ++c) {
+        if (face[c] != v)
+          RemoveFace(f, &point_faces_[face[c]]);
+      }
+    } else {
+      std::replace(face.begin(), face.end(), v, u);
+      point_faces_[u].push_back(f);
+      moved_faces.push_back(f);
+    }
+  }
+  point_faces_[v].clear();
+  for (const FaceIndex &f : point_faces_[u]) {
+    out_split->faces.push_back(faces_[f]);
+    out_split->moved_faces.push_back(
+        std::find(moved_faces.begin(), moved_faces.end(), f) !=
+        moved_faces.end());
+  }
+}
+
+std::vector<PointIndex> ProgressiveMeshEncoder::GetNeighbors(
+    PointIndex p) const {
+  std::vector<PointIndex> neighbors;
+  for (const FaceIndex &f : point_faces_[p]) {
+    const std::pair<PointIndex, PointIndex> other =
+        GetOtherPoints(faces_[f], p);
+    neighbors.push_back(other.first);
+    neighbors.push_back(other.second);
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+  return neighbors;
+}
+
+bool ProgressiveMeshEncoder::IsInteriorPoint(PointIndex p) const {
+  const std::vector<FaceIndex> &faces = point_faces_[p];
+  if (faces.size() < 3)
+    return false;
+  // Each face of the fan is represented by the edge opposite to |p|. The edges
+  // must form a single cycle.
+  std::vector<std::pair<PointIndex, PointIndex>> edges;
+  for (const FaceIndex &f : faces) {
+    const Mesh::Face &face = faces_[f];
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] == p) {
+        edges.push_back(std::make_pair(face[(c + 1) % 3], face[(c + 2) % 3]));
+        break;
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  for (size_t i = 1; i < edges.size(); ++i) {
+    if (edges[i].first == edges[i - 1].first)
+      return false;
+  }
+  const auto next_point = [&edges](PointIndex point) {
+    const auto it = std::lower_bound(
+        edges.begin(), edges.end(),
+        std::make_pair(point, PointIndex(0)));
+    if (it == edges.end() || it->first != point)
+      return kInvalidPointIndex;
+    return it->second;
+  };
+  PointIndex point = edges[0].first;
+  for (size_t i = 0; i < edges.size(); ++i) {
+    point = next_point(point);
+    if (point == kInvalidPointIndex)
+      return false;
+    if (point == edges[0].first)
+      return i + 1 == edges.size();
+  }
+  return false;
+}
+
+std::vector<PointIndex> ProgressiveMeshEncoder::GetNewPointNeighbors(
+    const VertexSplit &split) const {
+  std::vector<PointIndex> neighbors(1, split.u);
+  for (const Mesh::Face &face : split.removed_faces) {
+    for (int c = 0; c < 3; ++c) {
+      if (face[c] != split.u && face[c] != split.v)
+        neighbors.push_back(face[c]);
+    }
+  }
+  for (size_t i = 0; i < split.faces.size(); ++i) {
+    if (!split.moved_faces[i])
+      continue;
+    const std::pair<PointIndex, PointIndex> other =
+        GetOtherPoints(split.faces[i], split.u);
+    neighbors.push_back(other.first);
+    neighbors.push_back(other.second);
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+  return neighbors;
+}
+
+Status ProgressiveMeshEncoder::EncodeQuantization(const Mesh &mesh,
+                                                  Encoder *base_encoder,
+                                                  EncoderBuffer *out_buffer) {
+  const Encoder::OptionsType &options = encoder_.options();
+  converters_.assign(mesh.num_attributes(), ProgressiveMeshValueConverter());
+  EncodeVarint(static_cast<uint32_t>(mesh.num_attributes()), out_buffer);
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    const PointAttribute *const att = mesh.attribute(a);
+    const GeometryAttribute::Type type = att->attribute_type();
+    const int num_components = att->num_components();
+    int quantization_bits = 0;
+    if (att->data_type() == DT_FLOAT32)
+      quantization_bits =
+          std::max(options.GetAttributeInt(type, "quantization_bits", -1), 0);
+    std::vector<float> origin;
+    float range = 0.f;
+    if (quantization_bits > 0) {
+      // The quantization options are set for all attributes of one type, so
+      // they share the same box when they have the same number of components.
+      std::vector<const PointAttribute *> atts;
+      bool is_shared = true;
+      for (int i = 0; i < mesh.num_attributes(); ++i) {
+        const PointAttribute *const other_att = mesh.attribute(i);
+        if (other_att->attribute_type() != type ||
+            other_att->data_type() != DT_FLOAT32)
+          continue;
+        if (other_att->num_components() != num_components)
+          is_shared = false;
+        atts.push_back(other_att);
+      }
+      if (!is_shared)
+        atts.assign(1, att);
+      origin.resize(num_components);
+      if (options.IsAttributeOptionSet(type, "quantization_origin") &&
+          options.IsAttributeOptionSet(type, "quantization_range") &&
+          options.GetAttributeVector(type, "quantization_origin",
+                                     num_components, &origin[0])) {
+        range = options.GetAttributeFloat(type, "quantization_range", 1.f);
+      } else {
+        ComputeQuantizationBox(atts, &origin, &range);
+      }
+      if (!(range > 0.f))
+        range = 1.f;
+      if (is_shared) {
+        base_encoder->SetAttributeExplicitQuantization(
+            type, quantization_bits, num_components, origin.data(), range);
+        // The options store the box as text, so the refinement levels use the
+        // box parsed back from the options like the base mesh.
+        base_encoder->options().GetAttributeVector(
+            type, "quantization_origin", num_components, &origin[0]);
+        range = base_encoder->options().GetAttributeFloat(
+            type, "quantization_range", 0.f);
+        if (!(range > 0.f)) {
+          range = 1.f;
+          base_encoder->SetAttributeExplicitQuantization(
+              type, quantization_bits, num_components, origin.data(), range);
+        }
+      }
+    }
+    if (!converters_[a].Init(att->data_type(), num_components,
+                             quantization_bits, origin.data(), range))
+      return Status(Status::ERROR, "Unsupported attribute.");
+    out_buffer->Encode(static_cast<uint8_t>(quantization_bits));
+    if (quantization_bits > 0) {
+      out_buffer->Encode(static_cast<uint8_t>(num_components));
+      out_buffer->Encode(origin.data(), sizeof(float) * num_components);
+      out_buffer->Encode(range);
+    }
+  }
+  return OkStatus();
+}
+
+std::unique_ptr<Mesh> ProgressiveMeshEncoder::CreateBaseMesh(
+    const Mesh &mesh, int num_base_points) const {
+  std::unique_ptr<Mesh> base_mesh(new Mesh());
+  std::vector<PointIndex> points(num_base_points);
+  for (PointIndex p(0); p < point_ids_.size(); ++p) {
+    if (point_ids_[p] != kInvalidPointIndex &&
+        point_ids_[p] < num_base_points)
+      points[point_ids_[p].value()] = p;
+  }
+  CopyAttributes(mesh, points, base_mesh.get());
+  GeometryAttribute va;
+  va.Init(GeometryAttribute::GENERIC, nullptr, 1, DT_UINT32, false,
+          sizeof(uint32_t), 0);
+  PointAttribute *const id_att = base_mesh->attribute(
+      base_mesh->AddAttribute(va, true, num_base_points));
+  for (uint32_t i = 0; i < static_cast<uint32_t>(num_base_points); ++i) {
+    id_att->SetAttributeValue(AttributeValueIndex(i), &i);
+  }
+  for (FaceIndex f(0); f < faces_.size(); ++f) {
+    if (is_face_deleted_[f.value()])
+      continue;
+    Mesh::Face face;
+    for (int c = 0; c < 3; ++c) {
+      face[c] = point_ids_[faces_[f][c]];
+    }
+    base_mesh->AddFace(face);
+  }
+  return base_mesh;
+}
+
+Status ProgressiveMeshEncoder::EncodeBaseMesh(const Mesh &mesh,
+                                              int num_base_points,
+                                              EncoderBuffer *out_buffer) {
+  Encoder base_encoder = encoder_;
+  base_encoder.SetEncodingMethod(MESH_EDGEBREAKER_ENCODING);
+  DRACO_RETURN_IF_ERROR(EncodeQuantization(mesh, &base_encoder, out_buffer));
+  std::unique_ptr<Mesh> base_mesh = CreateBaseMesh(mesh, num_base_points);
+  EncoderBuffer buffer;
+  DRACO_RETURN_IF_ERROR(base_encoder.EncodeMeshToBuffer(*base_mesh, &buffer));
+
+  // Renumber the base points in the order in which they are decoded and
+  // encode the base mesh again with the new ids.
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> decoded_mesh,
+                         decoder.DecodeMeshFromBuffer(&dec_buffer));
+  const PointAttribute *const id_att =
+      decoded_mesh->GetAttributeByUniqueId(mesh.num_attributes());
+  if (id_att == nullptr)
+    return Status(Status::ERROR, "Failed to encode the base mesh.");
+  std::vector<PointIndex> base_points(num_base_points);
+  for (PointIndex p(0); p < point_ids_.size(); ++p) {
+    if (point_ids_[p] != kInvalidPointIndex)
+      base_points[point_ids_[p].value()] = p;
+  }
+  std::vector<PointIndex> new_ids(num_base_points, kInvalidPointIndex);
+  int num_new_ids = 0;
+  for (PointIndex p(0); p < decoded_mesh->num_points(); ++p) {
+    uint32_t id;
+    id_att->GetMappedValue(p, &id);
+    if (id >= static_cast<uint32_t>(num_base_points))
+      return Status(Status::ERROR, "Failed to encode the base mesh.");
+    if (new_ids[id] != kInvalidPointIndex)
+      continue;
+    new_ids[id] = PointIndex(num_new_ids++);
+    // Values of the new points are predicted from the decoded values of the
+    // base points.
+    for (int a = 0; a < mesh.num_attributes(); ++a) {
+      const PointAttribute *const att = decoded_mesh->GetAttributeByUniqueId(a);
+      if (att == nullptr)
+        return Status(Status::ERROR, "Failed to encode the base mesh.");
+      converters_[a].ToIntegers(
+          att->GetAddressOfMappedIndex(p),
+          &attribute_integers_[a][static_cast<size_t>(base_points[id].value()) *
+                                  att->num_components()]);
+    }
+  }
+  if (num_new_ids != num_base_points)
+    return Status(Status::ERROR, "Failed to encode the base mesh.");
+  for (PointIndex p(0); p < point_ids_.size(); ++p) {
+    if (point_ids_[p] != kInvalidPointIndex)
+      point_ids_[p] = new_ids[point_ids_[p].value()];
+  }
+  base_mesh = CreateBaseMesh(mesh, num_base_points);
+  return base_encoder.EncodeMeshToBuffer(*base_mesh, out_buffer);
+}
+
+Status ProgressiveMeshEncoder::EncodeRefinementLevel(
+    const Mesh &mesh, std::vector<std::vector<VertexSplit>> *batches,
+    EncoderBuffer *out_buffer) {
+  PointIndex::ValueType num_points = 0;
+  for (PointIndex p(0); p < point_ids_.size(); ++p) {
+    if (point_ids_[p] != kInvalidPointIndex)
+      num_points = std::max(num_points, point_ids_[p].value() + 1);
+  }
+  EncodeVarint(static_cast<uint32_t>(batches->size()), out_buffer);
+  std::vector<PointIndex> new_points;
+  std::vector<std::vector<PointIndex>> neighbors;
+  for (std::vector<VertexSplit> &splits : *batches) {
+    // Assign ids to the new points in the order of the split points.
+    std::sort(splits.begin(), splits.end(),
+              [this](const VertexSplit &a, const VertexSplit &b) {
+                return point_ids_[a.u] < point_ids_[b.u];
+              });
+    for (const VertexSplit &split : splits) {
+      point_ids_[split.v] = PointIndex(num_points++);
+      new_points.push_back(split.v);
+      neighbors.push_back(GetNewPointNeighbors(split));
+    }
+    DRACO_RETURN_IF_ERROR(EncodeVertexSplits(splits, out_buffer));
+  }
+  return EncodeAttributeValues(mesh, new_points, neighbors, out_buffer);
+}
+
+Status ProgressiveMeshEncoder::EncodeVertexSplits(
+    const std::vector<VertexSplit> &splits, EncoderBuffer *out_buffer) const {
+  std::vector<uint32_t> split_point_deltas;
+  std::vector<uint32_t> neighbor_indices;
+  RAnsBitEncoder bit_encoder;
+  bit_encoder.StartEncoding();
+  uint32_t last_split_point = 0;
+  for (const VertexSplit &split : splits) {
+    const uint32_t split_point = point_ids_[split.u].value();
+    split_point_deltas.push_back(split_point - last_split_point);
+    last_split_point = split_point;
+
+    // Sort faces of the split point by the ids of their other points.
+    std::vector<std::pair<std::pair<PointIndex, PointIndex>, bool>> faces;
+    std::vector<PointIndex> neighbors;
+    for (size_t i = 0; i < split.faces.size(); ++i) {
+      Mesh::Face face;
+      for (int c = 0; c < 3; ++c) {
+        face[c] = point_ids_[split.faces[i][c]];
+      }
+      const std::pair<PointIndex, PointIndex> other =
+          GetOtherPoints(face, point_ids_[split.u]);
+      faces.push_back(std::make_pair(other, split.moved_faces[i]));
+      neighbors.push_back(other.first);
+      neighbors.push_back(other.second);
+    }
+    std::sort(faces.begin(), faces.end());
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+
+    for (const Mesh::Face &face : split.removed_faces) {
+      const int c = std::find(face.begin(), face.end(), split.u) - face.begin();
+      const bool is_flipped = face[(c + 1) % 3] != split.v;
+      const PointIndex third_point =
+          point_ids_[is_flipped ? face[(c + 1) % 3] : face[(c + 2) % 3]];
+      bit_encoder.EncodeBit(is_flipped);
+      neighbor_indices.push_back(
+          std::lower_bound(neighbors.begin(), neighbors.end(), third_point) -
+          neighbors.begin());
+    }
+    for (const auto &face : faces) {
+      bit_encoder.EncodeBit(face.second);
+    }
+  }
+
+  EncodeVarint(static_cast<uint32_t>(splits.size()), out_buffer);
+  if (!EncodeSymbols(split_point_deltas.data(), split_point_deltas.size(), 1,
+                     nullptr, out_buffer))
+    return Status(Status::ERROR, "Failed to encode vertex splits.");
+  if (!EncodeSymbols(neighbor_indices.data(), neighbor_indices.size(), 1,
+                     nullptr, out_buffer))
+    return Status(Status::ERROR, "Failed to encode vertex splits.");
+  bit_encoder.EndEncoding(out_buffer);
+  return OkStatus();
+}
+
+Status ProgressiveMeshEncoder::EncodeAttributeValues(
+    const Mesh &mesh, const std::vector<PointIndex> &new_points,
+    const std::vector<std::vector<PointIndex>> &neighbors,
+    EncoderBuffer *out_buffer) {
+  if (new_points.empty())
+    return OkStatus();
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    const PointAttribute *const att = mesh.attribute(a);
+    const int num_components = att->num_components();
+    std::vector<int64_t> &integers = attribute_integers_[a];
+    std::vector<int32_t> residuals(new_points.size() * num_components);
+    std::vector<int64_t> prediction(num_components);
+    for (size_t i = 0; i < new_points.size(); ++i) {
+      int64_t *const value =
+          &integers[static_cast<size_t>(new_points[i].value()) *
+                    num_components];
+      converters_[a].ToIntegers(att->GetAddressOfMappedIndex(new_points[i]),
+                                value);
+      PredictProgressiveMeshValue(integers, num_components, neighbors[i],
+                                  &prediction[0]);
+      // The decoder reconstructs the values modulo 2^32.
+      for (int c = 0; c < num_components; ++c) {
+        residuals[i * num_components + c] = static_cast<int32_t>(
+            static_cast<uint32_t>(value[c] - prediction[c]));
+      }
+    }
+    std::vector<uint32_t> symbols(residuals.size());
+    ConvertSignedIntsToSymbols(residuals.data(), residuals.size(),
+                               symbols.data());
+    uint32_t masked_symbol = 0;
+    for (const uint32_t symbol : symbols) {
+      masked_symbol |= symbol;
+    }
+    const int msb_pos =
+        masked_symbol == 0 ? 0 : bits::MostSignificantBit(masked_symbol);
+    if (msb_pos < kMaxEntropyCodedBitLength) {
+      out_buffer->Encode(static_cast<uint8_t>(1));
+      if (!EncodeSymbols(symbols.data(), symbols.size(), num_components,
+                         nullptr, out_buffer))
+        return Status(Status::ERROR, "Failed to encode attribute values.");
+    } else {
+      const int num_bytes = 1 + msb_pos / 8;
+      out_buffer->Encode(static_cast<uint8_t>(0));
+      out_buffer->Encode(static_cast<uint8_t>(num_bytes));
+      for (const uint32_t symbol : symbols) {
+        out_buffer->Encode(&symbol, num_bytes);
+      }
+    }
+  }
+  return OkStatus();
+}
+
+void ProgressiveMeshEncoder::CopyAttributes(
+    const Mesh &mesh, const std::vector<PointIndex> &points,
+    PointCloud *pc) const {
+  pc->set_num_points(points.size());
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    const PointAttribute *const att = mesh.attribute(a);
+    GeometryAttribute va;
+    va.Init(att->attribute_type(), nullptr, att->num_components(),
+            att->data_type(), att->normalized(),
+            att->num_components() * DataTypeLength(att->data_type()), 0);
+    PointAttribute *const out_att =
+        pc->attribute(pc->AddAttribute(va, true, points.size()));
+    for (size_t i = 0; i < points.size(); ++i) {
+      out_att->SetAttributeValue(AttributeValueIndex(i),
+                                 att->GetAddressOfMappedIndex(points[i]));
+    }
+  }
+}
+
+}  // namespace draco
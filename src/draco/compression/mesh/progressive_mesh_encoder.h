@@ -0,0 +1,154 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/progressive_mesh_shared.h"
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Encoder of progressive meshes that can be decoded at multiple levels of
+// detail (see ProgressiveMeshDecoder). The input mesh is simplified by a
+// sequence of half-edge collapses that are grouped into batches of
+// independent collapses. The simplified base mesh is encoded with the
+// edgebreaker method and the refinement levels store batches of vertex splits
+// that invert the collapses. Attribute values of the points created by the
+// vertex splits are predicted from their neighbors. Floating point attributes
+// quantized by encoder() use one quantization box for the base mesh and all
+// refinement levels, computed from all values of the input mesh unless the
+// box is set explicitly.
+//
+// Only interior points whose faces form a single closed fan are removed by the
+// collapses. Such points are never on attribute seams, so the simplified meshes
+// don't contain any cracks. Degenerate faces of the input are not encoded.
+//
+// Usage:
+//   ProgressiveMeshEncoder encoder;
+//   encoder.encoder()->SetAttributeQuantization(GeometryAttribute::POSITION,
+//                                               14);
+//   encoder.SetNumRefinementLevels(6);
+//   EncoderBuffer buffer;
+//   DRACO_RETURN_IF_ERROR(encoder.EncodeMeshToBuffer(mesh, &buffer));
+class ProgressiveMeshEncoder {
+ public:
+  ProgressiveMeshEncoder();
+
+  // Sets the maximum number of refinement levels. The encoder creates fewer
+  // levels when the mesh can't be simplified any further. Default: [8].
+  void SetNumRefinementLevels(int num_levels);
+
+  // Sets the ratio between the numbers of faces of two consecutive levels of
+  // detail. Each refinement level contains as many batches of vertex splits
+  // as needed to reach the ratio. Default: [2].
+  void SetLevelOfDetailRatio(float ratio);
+
+  // Returns the encoder used for the base mesh. Its quantization options are
+  // also used for the attributes of the refinement levels. The encoding method
+  // is set by the progressive encoder.
+  Encoder *encoder() { return &encoder_; }
+
+  Status EncodeMeshToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer);
+
+ private:
+  // Collapse of point |v| into point |u| and the data needed to invert it.
+  struct VertexSplit {
+    PointIndex u;
+    PointIndex v;
+    // Faces of |u| after the collapse and whether they belonged to |v| before
+    // the collapse.
+    std::vector<Mesh::Face> faces;
+    std::vector<bool> moved_faces;
+    // Faces removed by the collapse.
+    std::array<Mesh::Face, 2> removed_faces;
+  };
+
+  // Simplifies the mesh stored in |faces_| by one batch of independent
+  // collapses. Returns false when no collapse was possible.
+  bool CollapseBatch(std::vector<VertexSplit> *out_splits);
+  // Returns true when point |v| can be collapsed into point |u|.
+  bool CanCollapse(PointIndex v, PointIndex u) const;
+  void Collapse(PointIndex v, PointIndex u, VertexSplit *out_split);
+
+  // Returns ids of all points that share a face with point |p|.
+  std::vector<PointIndex> GetNeighbors(PointIndex p) const;
+  // Returns true when the faces of point |p| form a single closed fan.
+  bool IsInteriorPoint(PointIndex p) const;
+
+  // Returns ids of all points that share a face with the new point of |split|
+  // right after the split.
+  std::vector<PointIndex> GetNewPointNeighbors(const VertexSplit &split) const;
+
+  // Computes the quantization of all attributes shared by the base mesh and
+  // the refinement levels, sets it to |base_encoder| and encodes it.
+  Status EncodeQuantization(const Mesh &mesh, Encoder *base_encoder,
+                            EncoderBuffer *out_buffer);
+  // Creates the base mesh from the simplified mesh. Points are ordered by
+  // their ids and their ids are stored in an additional attribute.
+  std::unique_ptr<Mesh> CreateBaseMesh(const Mesh &mesh,
+                                       int num_base_points) const;
+  // Encodes the base mesh. Ids of the base points are updated to match the
+  // order of the decoded points which makes the ids cheaper to encode.
+  // Integer values of the base points are set from the decoded values.
+  Status EncodeBaseMesh(const Mesh &mesh, int num_base_points,
+                        EncoderBuffer *out_buffer);
+  // Encodes batches of vertex splits of one refinement level. The batches
+  // must be in the order in which they are applied by the decoder.
+  Status EncodeRefinementLevel(const Mesh &mesh,
+                               std::vector<std::vector<VertexSplit>> *batches,
+                               EncoderBuffer *out_buffer);
+  Status EncodeVertexSplits(const std::vector<VertexSplit> &splits,
+                            EncoderBuffer *out_buffer) const;
+  // Encodes attribute values of |new_points| predicted from their
+  // |neighbors|.
+  Status EncodeAttributeValues(
+      const Mesh &mesh, const std::vector<PointIndex> &new_points,
+      const std::vector<std::vector<PointIndex>> &neighbors,
+      EncoderBuffer *out_buffer);
+  // Adds attribute values of |points| to |pc| in the format of |mesh|.
+  void CopyAttributes(const Mesh &mesh, const std::vector<PointIndex> &points,
+                      PointCloud *pc) const;
+
+  Encoder encoder_;
+  int num_refinement_levels_;
+  float level_of_detail_ratio_;
+
+  // Simplified mesh.
+  IndexTypeVector<FaceIndex, Mesh::Face> faces_;
+  std::vector<bool> is_face_deleted_;
+  int num_faces_;
+  IndexTypeVector<PointIndex, std::vector<FaceIndex>> point_faces_;
+  IndexTypeVector<PointIndex, std::array<float, 3>> positions_;
+
+  // Ids of the points in the progressive mesh.
+  IndexTypeVector<PointIndex, PointIndex> point_ids_;
+
+  // Converters of the values of each attribute and integer values of all
+  // points as they are decoded.
+  std::vector<ProgressiveMeshValueConverter> converters_;
+  std::vector<std::vector<int64_t>> attribute_integers_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_ENCODER_H_
@@ -0,0 +1,263 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/progressive_mesh_decoder.h"
+#include "draco/compression/mesh/progressive_mesh_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/varint_encoding.h"
+#include "draco/mesh/mesh_are_equivalent.h"
+#include "draco/mesh/mesh_cleanup.h"
+
+namespace draco {
+
+class ProgressiveMeshEncodingTest : public ::testing::Test {
+ protected:
+  // Encodes |file_name| without quantization, so the fully refined mesh must
+  // be equivalent to the input.
+  void TestFile(const std::string &file_name) {
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
+    ProgressiveMeshEncoder encoder;
+    EncoderBuffer buffer;
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    ProgressiveMeshDecoder decoder;
+    auto decoded_mesh_or = decoder.DecodeMesh(&dec_buffer);
+    ASSERT_TRUE(decoded_mesh_or.ok()) << decoded_mesh_or.status();
+    const std::unique_ptr<Mesh> decoded_mesh =
+        std::move(decoded_mesh_or).value();
+    ASSERT_EQ(decoder.num_decoded_refinement_levels(),
+              decoder.num_refinement_levels());
+    ASSERT_EQ(decoder.GetEncodedSize(decoder.num_refinement_levels()),
+              buffer.size());
+
+    const MeshCleanupOptions options;
+    MeshCleanup cleanup;
+    ASSERT_TRUE(cleanup(mesh.get(), options));
+    MeshAreEquivalent eq;
+    ASSERT_TRUE(eq(*mesh, *decoded_mesh))
+        << "Decoded mesh is not the same as the input";
+  }
+};
+
+TEST_F(ProgressiveMeshEncodingTest, TestSphere) { TestFile("sphere.obj"); }
+
+TEST_F(ProgressiveMeshEncodingTest, TestAttributeSeams) {
+  TestFile("cube_att.obj");
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestNonManifold) {
+  TestFile("test_nm.obj");
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestLevelsOfDetail) {
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("bun_zipper.ply"));
+  ASSERT_NE(mesh, nullptr);
+  ProgressiveMeshEncoder encoder;
+  encoder.encoder()->SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+  encoder.SetNumRefinementLevels(6);
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+
+  // Decode the mesh from truncated data and make sure that each refinement
+  // level adds more faces.
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveMeshDecoder header_decoder;
+  ASSERT_TRUE(header_decoder.DecodeHeader(&dec_buffer).ok());
+  ASSERT_EQ(header_decoder.num_refinement_levels(), 6);
+  int last_num_faces = 0;
+  for (int level = 0; level <= header_decoder.num_refinement_levels();
+       ++level) {
+    dec_buffer.Init(buffer.data(), header_decoder.GetEncodedSize(level));
+    ProgressiveMeshDecoder decoder;
+    auto decoded_mesh_or = decoder.DecodeMesh(&dec_buffer);
+    ASSERT_TRUE(decoded_mesh_or.ok()) << decoded_mesh_or.status();
+    ASSERT_EQ(decoder.num_decoded_refinement_levels(), level);
+    const Mesh &decoded_mesh = *decoded_mesh_or.value();
+    ASSERT_GT(decoded_mesh.num_faces(), last_num_faces);
+    last_num_faces = decoded_mesh.num_faces();
+  }
+  ASSERT_EQ(last_num_faces, mesh->num_faces());
+
+  // Decoding of the levels one by one must give the same result.
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveMeshDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeHeader(&dec_buffer).ok());
+  ASSERT_TRUE(decoder.DecodeBaseMesh(&dec_buffer).ok());
+  ASSERT_LT(decoder.GetMesh()->num_faces(), mesh->num_faces() / 2);
+  while (decoder.num_decoded_refinement_levels() <
+         decoder.num_refinement_levels()) {
+    ASSERT_TRUE(decoder.DecodeNextRefinementLevel(&dec_buffer).ok());
+  }
+  ASSERT_EQ(decoder.GetMesh()->num_faces(), mesh->num_faces());
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestSharedQuantization) {
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("bun_zipper.ply"));
+  ASSERT_NE(mesh, nullptr);
+  const int quantization_bits = 11;
+  ProgressiveMeshEncoder encoder;
+  encoder.encoder()->SetAttributeQuantization(GeometryAttribute::POSITION,
+                                              quantization_bits);
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveMeshDecoder decoder;
+  auto decoded_mesh_or = decoder.DecodeMesh(&dec_buffer);
+  ASSERT_TRUE(decoded_mesh_or.ok()) << decoded_mesh_or.status();
+  ASSERT_GT(decoder.num_decoded_refinement_levels(), 1);
+  const Mesh &decoded_mesh = *decoded_mesh_or.value();
+
+  // All levels are quantized in the box of the input positions, so the
+  // decoded positions must be the same as the positions of a single-rate mesh
+  // quantized in the same box.
+  const PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  std::array<float, 3> origin, max_values;
+  pos_att->GetValue(AttributeValueIndex(0), &origin[0]);
+  max_values = origin;
+  for (AttributeValueIndex avi(0); avi < pos_att->size(); ++avi) {
+    std::array<float, 3> pos;
+    pos_att->GetValue(avi, &pos[0]);
+    for (int c = 0; c < 3; ++c) {
+      origin[c] = std::min(origin[c], pos[c]);
+      max_values[c] = std::max(max_values[c], pos[c]);
+    }
+  }
+  float range = 0.f;
+  for (int c = 0; c < 3; ++c) {
+    range = std::max(range, max_values[c] - origin[c]);
+  }
+  Encoder single_rate_encoder;
+  single_rate_encoder.SetAttributeExplicitQuantization(
+      GeometryAttribute::POSITION, quantization_bits, 3, &origin[0], range);
+  EncoderBuffer single_rate_buffer;
+  ASSERT_TRUE(
+      single_rate_encoder.EncodeMeshToBuffer(*mesh, &single_rate_buffer).ok());
+  dec_buffer.Init(single_rate_buffer.data(), single_rate_buffer.size());
+  Decoder single_rate_decoder;
+  auto single_rate_mesh_or =
+      single_rate_decoder.DecodeMeshFromBuffer(&dec_buffer);
+  ASSERT_TRUE(single_rate_mesh_or.ok()) << single_rate_mesh_or.status();
+
+  // Returns sorted positions of all points of |m|.
+  const auto get_positions = [](const Mesh &m) {
+    const PointAttribute *const att =
+        m.GetNamedAttribute(GeometryAttribute::POSITION);
+    std::vector<std::array<float, 3>> positions(m.num_points());
+    for (PointIndex p(0); p < m.num_points(); ++p) {
+      att->GetMappedValue(p, &positions[p.value()][0]);
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()),
+                    positions.end());
+    return positions;
+  };
+  ASSERT_EQ(get_positions(decoded_mesh),
+            get_positions(*single_rate_mesh_or.value()));
+
+  // Values of the new points are predicted from their neighbors, so the
+  // progressive mesh must not be much larger than the single-rate mesh.
+  EXPECT_LT(buffer.size(), 3 * single_rate_buffer.size());
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestInvalidInput) {
+  const uint8_t data[] = "DRACO";
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(reinterpret_cast<const char *>(data), sizeof(data));
+  ProgressiveMeshDecoder decoder;
+  EXPECT_FALSE(decoder.DecodeMesh(&dec_buffer).ok());
+}
+
+TEST_F(ProgressiveMeshEncodingTest, TestInvalidHeader) {
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("sphere.obj"));
+  ASSERT_NE(mesh, nullptr);
+  ProgressiveMeshEncoder encoder;
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveMeshDecoder header_decoder;
+  ASSERT_TRUE(header_decoder.DecodeHeader(&dec_buffer).ok());
+  const int64_t header_size = dec_buffer.decoded_size();
+  std::vector<uint64_t> level_sizes;
+  for (int i = 0; i < header_decoder.num_refinement_levels(); ++i) {
+    level_sizes.push_back(header_decoder.GetEncodedSize(i + 1) -
+                          header_decoder.GetEncodedSize(i));
+  }
+  ASSERT_GT(level_sizes.size(), 0u);
+  const uint64_t base_mesh_size =
+      header_decoder.GetEncodedSize(0) - header_size;
+  ASSERT_TRUE(header_decoder.DecodeBaseMesh(&dec_buffer).ok());
+  const uint32_t num_base_points = header_decoder.GetMesh()->num_points();
+
+  // Returns the encoded mesh with a modified header.
+  const auto create_data = [&buffer, header_size](
+                               uint32_t num_points, uint64_t mesh_size,
+                               const std::vector<uint64_t> &sizes) {
+    EncoderBuffer data;
+    data.Encode(kProgressiveMeshMagic, kProgressiveMeshMagicLength);
+    data.Encode(kProgressiveMeshVersionMajor);
+    data.Encode(kProgressiveMeshVersionMinor);
+    EncodeVarint(num_points, &data);
+    EncodeVarint(static_cast<uint32_t>(sizes.size()), &data);
+    EncodeVarint(mesh_size, &data);
+    for (const uint64_t size : sizes) {
+      EncodeVarint(size, &data);
+    }
+    data.Encode(buffer.data() + header_size, buffer.size() - header_size);
+    return std::vector<char>(data.data(), data.data() + data.size());
+  };
+
+  // The unmodified header must be decodable.
+  std::vector<char> data =
+      create_data(num_base_points, base_mesh_size, level_sizes);
+  dec_buffer.Init(data.data(), data.size());
+  ProgressiveMeshDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeMesh(&dec_buffer).ok());
+
+  // Sizes whose sum overflows the offsets of the refinement levels.
+  std::vector<uint64_t> invalid_level_sizes = level_sizes;
+  invalid_level_sizes.back() = std::numeric_limits<int64_t>::max();
+  data = create_data(num_base_points, base_mesh_size, invalid_level_sizes);
+  dec_buffer.Init(data.data(), data.size());
+  EXPECT_FALSE(decoder.DecodeHeader(&dec_buffer).ok());
+  data = create_data(num_base_points, std::numeric_limits<uint64_t>::max(),
+                     level_sizes);
+  dec_buffer.Init(data.data(), data.size());
+  EXPECT_FALSE(decoder.DecodeHeader(&dec_buffer).ok());
+
+  // More base points than the base mesh contains.
+  data = create_data(1u << 30, base_mesh_size, level_sizes);
+  dec_buffer.Init(data.data(), data.size());
+  EXPECT_FALSE(decoder.DecodeMesh(&dec_buffer).ok());
+  data = create_data(std::numeric_limits<uint32_t>::max(), base_mesh_size,
+                     level_sizes);
+  dec_buffer.Init(data.data(), data.size());
+  EXPECT_FALSE(decoder.DecodeMesh(&dec_buffer).ok());
+}
+
+}  // namespace draco
@@ -0,0 +1,270 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
+#define DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
+
+#include <stdint.h>
+
+#include <cstring>
+#include <vector>
+
+#include "draco/attributes/geometry_indices.h"
+#include "draco/core/draco_types.h"
+#include "draco/core/quantization_utils.h"
+
+// Definitions shared by the ProgressiveMeshEncoder and the
+// ProgressiveMeshDecoder.
+//
+// Layout of the encoded data:
+//   Header:
+//     char[10]   "DRACOPMESH"
+//     uint8_t    Major version.
+//     uint8_t    Minor version.
+//     varint     Number of points of the base mesh.
+//     varint     Number of refinement levels.
+//     varint     Byte size of the base mesh.
+//     varint[]   Byte size of each refinement level.
+//   Base mesh:
+//     varint     Number of attributes.
+//     Quantization of each attribute:
+//       uint8_t    Number of quantization bits or 0 when the attribute is not
+//                  quantized.
+//       Only for quantized attributes:
+//       uint8_t    Number of components.
+//       float[]    Origin of the quantization box.
+//       float      Size of the quantization box.
+//     Draco mesh encoded with the edgebreaker method. Attributes are
+//     identified by their unique ids. The attribute with the unique id equal
+//     to the number of the other attributes is a GENERIC uint32 attribute
+//     that stores the id of each point in the progressive mesh.
+//   Refinement level (for each level):
+//     varint     Number of batches.
+//     Batch of vertex splits (for each batch):
+//       varint     Number of vertex splits.
+//       symbols    Ids of the split points, delta coded in ascending order.
+//       symbols    For each split, indices of the third vertices of the two
+//                  new faces in the sorted list of neighbors of the split
+//                  point.
+//       rANS bits  For each split, the orientation of the two new faces
+//                  followed by one bit for every face of the split point that
+//                  is moved to the new point. The faces are sorted by the ids
+//                  of their other two points.
+//     Attribute values of the new points of all batches (for each attribute
+//     except for the point ids):
+//       uint8_t    1 when the differences between the integer values of the
+//                  new points and their predictions are entropy coded.
+//       symbols    Entropy coded differences.
+//       or:
+//       uint8_t    Number of bytes of each difference.
+//       bytes[]    Differences stored without entropy coding.
+//
+// Values of all points are converted to integers by the
+// ProgressiveMeshValueConverter. The integer value of a new point |v| is
+// predicted by the average of the integer values of the neighbors of |v| right
+// after the vertex split that created it.
+//
+// A vertex split of point |u| creates a new point |v| whose id is equal to
+// the number of points before the split. The new points of one batch are
+// created in the order of their split points. All splits of one batch are
+// independent, i.e., they don't share any faces and they don't change the
+// neighbors of each other's split points.
+
+namespace draco {
+
+static const char kProgressiveMeshMagic[] = "DRACOPMESH";
+static const int kProgressiveMeshMagicLength = 10;
+static const uint8_t kProgressiveMeshVersionMajor = 2;
+static const uint8_t kProgressiveMeshVersionMinor = 0;
+
+// Converts attribute values to the integers used for the prediction of the
+// values of new points and back. Quantized floating point values are
+// converted to their quantized values, other floating point values to their
+// bits and integer values are used as they are.
+class ProgressiveMeshValueConverter {
+ public:
+  ProgressiveMeshValueConverter()
+      : data_type_(DT_INVALID), num_components_(0), quantization_bits_(0) {}
+
+  // Initializes the converter for values with |num_components| components of
+  // |data_type|. Floating point values are quantized to |quantization_bits|
+  // inside the box given by |origin| and |range| unless |quantization_bits|
+  // is 0. Returns false when the values can't be converted.
+  bool Init(DataType data_type, int num_components, int quantization_bits,
+            const float *origin, float range) {
+    data_type_ = data_type;
+    num_components_ = num_components;
+    quantization_bits_ = quantization_bits;
+    origin_.clear();
+    switch (data_type) {
+      case DT_INT8:
+      case DT_UINT8:
+      case DT_INT16:
+      case DT_UINT16:
+      case DT_INT32:
+      case DT_UINT32:
+      case DT_BOOL:
+        return quantization_bits == 0;
+      case DT_FLOAT32:
+        break;
+      default:
+        return false;
+    }
+    if (quantization_bits == 0)
+      return true;
+    if (quantization_bits < 0 || quantization_bits > 31 || !(range > 0.f))
+      return false;
+    const int32_t max_quantized_value =
+        static_cast<int32_t>((1u << quantization_bits) - 1);
+    quantizer_.Init(range, max_quantized_value);
+    if (!dequantizer_.Init(range, max_quantized_value))
+      return false;
+    origin_.assign(origin, origin + num_components);
+    return true;
+  }
+
+  int quantization_bits() const { return quantization_bits_; }
+
+  // Converts |value| to |num_components| integers.
+  void ToIntegers(const uint8_t *value, int64_t *out_integers) const {
+    switch (data_type_) {
+      case DT_INT8:
+        ToIntegers<int8_t>(value, out_integers);
+        break;
+      case DT_UINT8:
+      case DT_BOOL:
+        ToIntegers<uint8_t>(value, out_integers);
+        break;
+      case DT_INT16:
+        ToIntegers<int16_t>(value, out_integers);
+        break;
+      case DT_UINT16:
+        ToIntegers<uint16_t>(value, out_integers);
+        break;
+      case DT_INT32:
+        ToIntegers<int32_t>(value, out_integers);
+        break;
+      case DT_UINT32:
+        ToIntegers<uint32_t>(value, out_integers);
+        break;
+      case DT_FLOAT32:
+        if (quantization_bits_ == 0) {
+          ToIntegers<uint32_t>(value, out_integers);
+          break;
+        }
+        for (int c = 0; c < num_components_; ++c) {
+          float component;
+          memcpy(&component, value + c * sizeof(float), sizeof(float));
+          out_integers[c] = quantizer_.QuantizeFloat(component - origin_[c]);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Converts |integers| to |out_value|. The integers are only known modulo
+  // 2^32, so they are first wrapped into the range of the converted values.
+  void FromIntegers(int64_t *integers, uint8_t *out_value) const {
+    switch (data_type_) {
+      case DT_INT8:
+        FromIntegers<int8_t>(integers, out_value);
+        break;
+      case DT_UINT8:
+      case DT_BOOL:
+        FromIntegers<uint8_t>(integers, out_value);
+        break;
+      case DT_INT16:
+        FromIntegers<int16_t>(integers, out_value);
+        break;
+      case DT_UINT16:
+        FromIntegers<uint16_t>(integers, out_value);
+        break;
+      case DT_INT32:
+        FromIntegers<int32_t>(integers, out_value);
+        break;
+      case DT_UINT32:
+        FromIntegers<uint32_t>(integers, out_value);
+        break;
+      case DT_FLOAT32:
+        if (quantization_bits_ == 0) {
+          FromIntegers<uint32_t>(integers, out_value);
+          break;
+        }
+        for (int c = 0; c < num_components_; ++c) {
+          integers[c] = static_cast<int32_t>(integers[c]);
+          const float component =
+              dequantizer_.DequantizeFloat(static_cast<int32_t>(integers[c])) +
+              origin_[c];
+          memcpy(out_value + c * sizeof(float), &component, sizeof(float));
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+ private:
+  template <typename T>
+  void ToIntegers(const uint8_t *value, int64_t *out_integers) const {
+    for (int c = 0; c < num_components_; ++c) {
+      T component;
+      memcpy(&component, value + c * sizeof(T), sizeof(T));
+      out_integers[c] = component;
+    }
+  }
+
+  template <typename T>
+  void FromIntegers(int64_t *integers, uint8_t *out_value) const {
+    for (int c = 0; c < num_components_; ++c) {
+      const T component = static_cast<T>(integers[c]);
+      integers[c] = component;
+      memcpy(out_value + c * sizeof(T), &component, sizeof(T));
+    }
+  }
+
+  DataType data_type_;
+  int num_components_;
+  int quantization_bits_;
+  std::vector<float> origin_;
+  Quantizer quantizer_;
+  Dequantizer dequantizer_;
+};
+
+// Predicts the integer value of a new point by the average of the integer
+// values of its |neighbors|. |integers| contains |num_components| integers for
+// each point.
+inline void PredictProgressiveMeshValue(
+    const std::vector<int64_t> &integers, int num_components,
+    const std::vector<PointIndex> &neighbors, int64_t *out_prediction) {
+  for (int c = 0; c < num_components; ++c) {
+    out_prediction[c] = 0;
+  }
+  if (neighbors.empty())
+    return;
+  for (const PointIndex &p : neighbors) {
+    for (int c = 0; c < num_components; ++c) {
+      out_prediction[c] +=
+          integers[static_cast<size_t>(p.value()) * num_components + c];
+    }
+  }
+  const int64_t num_neighbors = neighbors.size();
+  for (int c = 0; c < num_components; ++c) {
+    out_prediction[c] /= num_neighbors;
+  }
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_PROGRESSIVE_MESH_SHARED_H_
@@ -0,0 +1,323 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// See progressive_integer_points_kd_tree_encoder.h for documentation.
+
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_DECODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_DECODER_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_decoder.h"
+#include "draco/compression/point_cloud/algorithms/progressive_integer_points_kd_tree_shared.h"
+#include "draco/compression/point_cloud/algorithms/queuing_policy.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+// Decodes a point cloud encoded by ProgressiveIntegerPointsKdTreeEncoder.
+// The levels of detail (LODs) can be decoded one by one and the current
+// approximation of the point cloud can be retrieved after each of them.
+//
+// Usage:
+//   ProgressiveIntegerPointsKdTreeDecoder<6> decoder(3);
+//   decoder.DecodeHeader(&buffer);
+//   // LOD data up to |decoder.GetEncodedSize(num_lods)| bytes from the start
+//   // of the encoded data are needed to decode the first |num_lods| LODs.
+//   for (int i = 0; i < num_lods; ++i) {
+//     decoder.DecodeNextLod(&buffer);
+//   }
+//   decoder.GetPoints(std::back_inserter(points));
+template <int compression_level_t>
+class ProgressiveIntegerPointsKdTreeDecoder {
+  static_assert(compression_level_t >= 0, "Compression level must in [0..6].");
+  static_assert(compression_level_t <= 6, "Compression level must in [0..6].");
+  typedef DynamicIntegerPointsKdTreeDecoderCompressionPolicy<
+      compression_level_t>
+      Policy;
+  typedef typename Policy::NumbersDecoder NumbersDecoder;
+  typedef typename Policy::HalfDecoder HalfDecoder;
+  typedef typename Policy::RemainingBitsDecoder RemainingBitsDecoder;
+  typedef std::vector<uint32_t> VectorUint32;
+
+ public:
+  explicit ProgressiveIntegerPointsKdTreeDecoder(uint32_t dimension)
+      : bit_length_(0),
+        num_points_(0),
+        dimension_(dimension),
+        header_size_(0),
+        num_decoded_lods_(0) {}
+
+  // Decodes the header with the sizes of all LODs. On success, |buffer| is
+  // positioned at the data of the first LOD.
+  bool DecodeHeader(DecoderBuffer *buffer);
+
+  // Decodes the next LOD from |buffer|. Returns false when the data of the
+  // LOD is missing or invalid.
+  bool DecodeNextLod(DecoderBuffer *buffer);
+
+  // Outputs the current approximation of the point cloud. Points in cells that
+  // were not fully refined yet are represented by the centers of the cells.
+  // Once all LODs are decoded, the output contains all encoded points.
+  template <class OutputIteratorT>
+  void GetPoints(OutputIteratorT oit) const;
+
+  // Decodes at most |max_lods| LODs from |buffer| and outputs the resulting
+  // points. Decoding stops early when the data of the next LOD is not
+  // available in |buffer|, which allows decoding of truncated data. Negative
+  // |max_lods| decodes all available LODs.
+  template <class OutputIteratorT>
+  bool DecodePoints(DecoderBuffer *buffer, int max_lods, OutputIteratorT oit);
+
+  // Decodes all LODs from |buffer|.
+  template <class OutputIteratorT>
+  bool DecodePoints(DecoderBuffer *buffer, OutputIteratorT oit) {
+    return DecodePoints(buffer, -1, oit);
+  }
+
+  // Returns the number of bytes from the start of the encoded data needed to
+  // decode the first |num_lods| LODs. Can be used only after DecodeHeader().
+  int64_t GetEncodedSize(int num_lods) const {
+    return header_size_ + lod_offsets_[num_lods];
+  }
+
+  int num_lods() const { return static_cast<int>(lod_offsets_.size()) - 1; }
+  int num_decoded_lods() const { return num_decoded_lods_; }
+  uint32_t num_points() const { return num_points_; }
+  uint32_t dimension() const { return dimension_; }
+
+ private:
+  // Cell of the kd-tree that still contains more than one point.
+  struct Cell {
+    Cell(uint32_t num_points_, const VectorUint32 &base_)
+        : num_points(num_points_), base(base_) {}
+
+    uint32_t num_points;
+    VectorUint32 base;
+  };
+
+  bool DecodeLod(uint32_t num_remaining_bits);
+
+  uint32_t bit_length_;
+  uint32_t num_points_;
+  uint32_t dimension_;
+  int64_t header_size_;
+  // Offsets of the LODs relative to the end of the header. The last entry
+  // stores the total size of all LODs.
+  std::vector<int64_t> lod_offsets_;
+  int num_decoded_lods_;
+  NumbersDecoder numbers_decoder_;
+  RemainingBitsDecoder remaining_bits_decoder_;
+  HalfDecoder half_decoder_;
+  // Points that are already decoded with full precision.
+  std::vector<VectorUint32> finished_points_;
+  Queue<Cell> cells_;
+};
+
+template <int compression_level_t>
+bool ProgressiveIntegerPointsKdTreeDecoder<compression_level_t>::DecodeHeader(
+    DecoderBuffer *buffer) {
+  const int64_t start_offset = buffer->decoded_size();
+  finished_points_.clear();
+  cells_ = Queue<Cell>();
+  lod_offsets_.clear();
+  num_decoded_lods_ = 0;
+  if (!buffer->Decode(&bit_length_) || !buffer->Decode(&num_points_))
+    return false;
+  if (bit_length_ > 32)
+    return false;
+  // The kd-tree can't store more points than the number of its cells times
+  // the maximum number of duplicates in each cell.
+  if (num_points_ > ProgressiveKdTreeMaxNumPoints(bit_length_, dimension_))
+    return false;
+  uint32_t num_lods;
+  if (!DecodeVarint(&num_lods, buffer))
+    return false;
+  if (num_lods > bit_length_)
+    return false;
+  lod_offsets_.push_back(0);
+  for (uint32_t i = 0; i < num_lods; ++i) {
+    uint64_t lod_size;
+    if (!DecodeVarint(&lod_size, buffer))
+      return false;
+    // The LOD data may not be available yet, so the sizes can't be checked
+    // against the size of |buffer|. But the end of each LOD must still be
+    // representable as an offset into the buffer.
+    const uint64_t max_lod_size = std::numeric_limits<int64_t>::max() -
+                                  buffer->decoded_size() - lod_offsets_.back();
+    if (lod_size > max_lod_size)
+      return false;
+    lod_offsets_.push_back(lod_offsets_.back() + lod_size);
+  }
+  header_size_ = buffer->decoded_size() - start_offset;
+  if (num_points_ > 0)
+    cells_.push(Cell(num_points_, VectorUint32(dimension_, 0)));
+  return true;
+}
+
+template <int compression_level_t>
+bool ProgressiveIntegerPointsKdTreeDecoder<compression_level_t>::DecodeNextLod(
+    DecoderBuffer *buffer) {
+  if (num_decoded_lods_ >= num_lods())
+    return false;
+  const int64_t lod_size = lod_offsets_[num_decoded_lods_ + 1] -
+                           lod_offsets_[num_decoded_lods_];
+  if (lod_size > buffer->remaining_size())
+    return false;
+  // The LODs are always encoded with the current version of the entropy
+  // coders.
+  DecoderBuffer lod_buffer;
+  lod_buffer.Init(buffer->data_head(), lod_size, kDracoBitstreamVersion);
+  if (!numbers_decoder_.StartDecoding(&lod_buffer))
+    return false;
+  if (!remaining_bits_decoder_.StartDecoding(&lod_buffer))
+    return false;
+  if (!half_decoder_.StartDecoding(&lod_buffer))
+    return false;
+  if (!DecodeLod(bit_length_ - num_decoded_lods_))
+    return false;
+  numbers_decoder_.EndDecoding();
+  remaining_bits_decoder_.EndDecoding();
+  half_decoder_.EndDecoding();
+  buffer->Advance(lod_size);
+  ++num_decoded_lods_;
+  return true;
+}
+
+template <int compression_level_t>
+bool ProgressiveIntegerPointsKdTreeDecoder<compression_level_t>::DecodeLod(
+    uint32_t num_remaining_bits) {
+  const uint32_t modifier = 1 << (num_remaining_bits - 1);
+  Queue<Cell> next_cells;
+  std::vector<Cell> parts, split_parts;
+  while (!cells_.empty()) {
+    const Cell cell = cells_.front();
+    cells_.pop();
+
+    if (cell.num_points == 1) {
+      VectorUint32 p(dimension_, 0);
+      for (uint32_t axis = 0; axis < dimension_; ++axis) {
+        remaining_bits_decoder_.DecodeLeastSignificantBits32(num_remaining_bits,
+                                                             &p[axis]);
+        p[axis] |= cell.base[axis];
+      }
+      finished_points_.push_back(p);
+      continue;
+    }
+
+    parts.clear();
+    parts.push_back(cell);
+    for (uint32_t axis = 0; axis < dimension_; ++axis) {
+      split_parts.clear();
+      for (const Cell &part : parts) {
+        const int incoming_bits = bits::MostSignificantBit(part.num_points);
+        uint32_t number = 0;
+        if (incoming_bits > 0)
+          numbers_decoder_.DecodeLeastSignificantBits32(incoming_bits, &number);
+        if (number > part.num_points / 2)
+          return false;
+        uint32_t first_half = part.num_points / 2 - number;
+        uint32_t second_half = part.num_points - first_half;
+        if (first_half != second_half)
+          if (!half_decoder_.DecodeNextBit())
+            std::swap(first_half, second_half);
+
+        if (first_half)
+          split_parts.push_back(Cell(first_half, part.base));
+        if (second_half) {
+          split_parts.push_back(Cell(second_half, part.base));
+          split_parts.back().base[axis] += modifier;
+        }
+      }
+      std::swap(parts, split_parts);
+    }
+
+    for (Cell &part : parts) {
+      if (num_remaining_bits > 1) {
+        next_cells.push(std::move(part));
+      } else {
+        // All bits are used up, the cell stores copies of the same point.
+        if (part.num_points > kProgressiveKdTreeMaxDuplicatePoints)
+          return false;
+        for (uint32_t i = 0; i < part.num_points; ++i) {
+          finished_points_.push_back(part.base);
+        }
+      }
+    }
+  }
+  std::swap(cells_, next_cells);
+  return true;
+}
+
+template <int compression_level_t>
+template <class OutputIteratorT>
+void ProgressiveIntegerPointsKdTreeDecoder<compression_level_t>::GetPoints(
+    OutputIteratorT oit) const {
+  for (const VectorUint32 &p : finished_points_) {
+    *oit++ = p;
+  }
+  // Iterate over a copy of the pending cells to keep the decoder intact.
+  Queue<Cell> cells = cells_;
+  const uint32_t num_remaining_bits = bit_length_ - num_decoded_lods_;
+  while (!cells.empty()) {
+    const Cell &cell = cells.front();
+    if (num_remaining_bits == 0) {
+      // Only possible for zero |bit_length_| where all points are the same.
+      for (uint32_t i = 0; i < cell.num_points; ++i) {
+        *oit++ = cell.base;
+      }
+    } else {
+      VectorUint32 center = cell.base;
+      for (uint32_t axis = 0; axis < dimension_; ++axis) {
+        center[axis] += 1 << (num_remaining_bits - 1);
+      }
+      *oit++ = center;
+    }
+    cells.pop();
+  }
+}
+
+template <int compression_level_t>
+template <class OutputIteratorT>
+bool ProgressiveIntegerPointsKdTreeDecoder<compression_level_t>::DecodePoints(
+    DecoderBuffer *buffer, int max_lods, OutputIteratorT oit) {
+  if (!DecodeHeader(buffer))
+    return false;
+  const int lods_to_decode =
+      max_lods < 0 ? num_lods() : std::min(max_lods, num_lods());
+  while (num_decoded_lods_ < lods_to_decode) {
+    const int64_t lod_size = lod_offsets_[num_decoded_lods_ + 1] -
+                             lod_offsets_[num_decoded_lods_];
+    if (lod_size > buffer->remaining_size())
+      break;  // Truncated data.
+    if (!DecodeNextLod(buffer))
+      return false;
+  }
+  GetPoints(oit);
+  return true;
+}
+
+extern template class ProgressiveIntegerPointsKdTreeDecoder<0>;
+extern template class ProgressiveIntegerPointsKdTreeDecoder<2>;
+extern template class ProgressiveIntegerPointsKdTreeDecoder<4>;
+extern template class ProgressiveIntegerPointsKdTreeDecoder<6>;
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_DECODER_H_
@@ -0,0 +1,252 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_ENCODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_ENCODER_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "draco/compression/point_cloud/algorithms/dynamic_integer_points_kd_tree_encoder.h"
+#include "draco/compression/point_cloud/algorithms/progressive_integer_points_kd_tree_shared.h"
+#include "draco/compression/point_cloud/algorithms/queuing_policy.h"
+#include "draco/core/bit_utils.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+// Progressive (level of detail) variant of DynamicIntegerPointsKdTreeEncoder.
+// The kd-tree is traversed breadth-first and the axes are always split in a
+// fixed order, so one level of detail (LOD) corresponds to splitting all cells
+// of the previous level into 2^dimension equal child cells, i.e., LOD |i|
+// describes the occupancy of an octree of depth |i + 1| (in 3D).
+//
+// The data of each LOD is encoded into a separate chunk and the header stores
+// the byte size of each chunk. A decoder can therefore stop after any prefix
+// of the LODs (e.g. after receiving only the first bytes of a file) and it
+// gets a uniformly subsampled point cloud with one point per occupied cell.
+// Cells that contain a single point are refined to the full precision right
+// away, so sparse regions are exact early on.
+//
+// Encoded data:
+//   uint32: bit_length
+//   uint32: num_points
+//   varint: num_lods
+//   varint: encoded size of each LOD
+//   LOD data
+//
+// The compression rate is slightly lower compared to the
+// DynamicIntegerPointsKdTreeEncoder because the LODs can't select the best
+// splitting axis and the entropy coders are restarted for each LOD.
+// The algorithm does not preserve the order of points. At most
+// |kProgressiveKdTreeMaxDuplicatePoints| copies of the same point can be
+// encoded.
+//
+// The coder is a standalone algorithm, it is not selectable through the
+// Encoder and ExpertEncoder classes and the Draco bitstream is unchanged.
+template <int compression_level_t>
+class ProgressiveIntegerPointsKdTreeEncoder {
+  static_assert(compression_level_t >= 0, "Compression level must in [0..6].");
+  static_assert(compression_level_t <= 6, "Compression level must in [0..6].");
+  typedef DynamicIntegerPointsKdTreeEncoderCompressionPolicy<
+      compression_level_t>
+      Policy;
+  typedef typename Policy::NumbersEncoder NumbersEncoder;
+  typedef typename Policy::HalfEncoder HalfEncoder;
+  typedef typename Policy::RemainingBitsEncoder RemainingBitsEncoder;
+  typedef std::vector<uint32_t> VectorUint32;
+
+ public:
+  explicit ProgressiveIntegerPointsKdTreeEncoder(uint32_t dimension)
+      : bit_length_(0), dimension_(dimension) {}
+
+  // Encodes an integer point cloud given by [begin,end) into buffer.
+  // |bit_length| gives the highest bit used for all coordinates.
+  // Returns false when the input contains too many duplicate points.
+  template <class RandomAccessIteratorT>
+  bool EncodePoints(RandomAccessIteratorT begin, RandomAccessIteratorT end,
+                    const uint32_t &bit_length, EncoderBuffer *buffer);
+
+  // Encodes an integer point cloud given by [begin,end) into buffer.
+  template <class RandomAccessIteratorT>
+  bool EncodePoints(RandomAccessIteratorT begin, RandomAccessIteratorT end,
+                    EncoderBuffer *buffer) {
+    return EncodePoints(begin, end, 32, buffer);
+  }
+
+  uint32_t dimension() const { return dimension_; }
+
+ private:
+  // Cell of the kd-tree that still contains more than one point.
+  template <class RandomAccessIteratorT>
+  struct Cell {
+    Cell(RandomAccessIteratorT begin_, RandomAccessIteratorT end_,
+         const VectorUint32 &base_)
+        : begin(begin_), end(end_), base(base_) {}
+
+    RandomAccessIteratorT begin;
+    RandomAccessIteratorT end;
+    VectorUint32 base;
+  };
+
+  // Encodes one LOD, i.e., splits all |cells| along all axes. Child cells that
+  // need to be refined further are stored in |next_cells|. Returns false when
+  // a finished cell contains too many copies of the same point.
+  template <class RandomAccessIteratorT>
+  bool EncodeLod(uint32_t num_remaining_bits,
+                 Queue<Cell<RandomAccessIteratorT>> *cells,
+                 Queue<Cell<RandomAccessIteratorT>> *next_cells);
+
+  class Splitter {
+   public:
+    Splitter(uint32_t axis, uint32_t value) : axis_(axis), value_(value) {}
+    template <class PointT>
+    bool operator()(const PointT &a) const {
+      return a[axis_] < value_;
+    }
+
+   private:
+    uint32_t axis_;
+    uint32_t value_;
+  };
+
+  uint32_t bit_length_;
+  uint32_t dimension_;
+  NumbersEncoder numbers_encoder_;
+  RemainingBitsEncoder remaining_bits_encoder_;
+  HalfEncoder half_encoder_;
+};
+
+template <int compression_level_t>
+template <class RandomAccessIteratorT>
+bool ProgressiveIntegerPointsKdTreeEncoder<compression_level_t>::EncodePoints(
+    RandomAccessIteratorT begin, RandomAccessIteratorT end,
+    const uint32_t &bit_length, EncoderBuffer *buffer) {
+  if (bit_length > 32)
+    return false;
+  bit_length_ = bit_length;
+  const uint32_t num_points = end - begin;
+  if (num_points > ProgressiveKdTreeMaxNumPoints(bit_length_, dimension_))
+    return false;
+
+  // Encode all LODs into separate buffers first so that their sizes can be
+  // stored in the header.
+  std::vector<EncoderBuffer> lod_buffers;
+  Queue<Cell<RandomAccessIteratorT>> cells, next_cells;
+  if (num_points > 0)
+    cells.push(Cell<RandomAccessIteratorT>(begin, end,
+                                           VectorUint32(dimension_, 0)));
+  for (uint32_t lod = 0; lod < bit_length_ && !cells.empty(); ++lod) {
+    numbers_encoder_.StartEncoding();
+    remaining_bits_encoder_.StartEncoding();
+    half_encoder_.StartEncoding();
+    if (!EncodeLod(bit_length_ - lod, &cells, &next_cells))
+      return false;
+    lod_buffers.emplace_back();
+    numbers_encoder_.EndEncoding(&lod_buffers.back());
+    remaining_bits_encoder_.EndEncoding(&lod_buffers.back());
+    half_encoder_.EndEncoding(&lod_buffers.back());
+    std::swap(cells, next_cells);
+  }
+
+  buffer->Encode(bit_length_);
+  buffer->Encode(num_points);
+  EncodeVarint(static_cast<uint32_t>(lod_buffers.size()), buffer);
+  for (const EncoderBuffer &lod_buffer : lod_buffers) {
+    EncodeVarint(static_cast<uint64_t>(lod_buffer.size()), buffer);
+  }
+  for (const EncoderBuffer &lod_buffer : lod_buffers) {
+    buffer->Encode(lod_buffer.data(), lod_buffer.size());
+  }
+  return true;
+}
+
+template <int compression_level_t>
+template <class RandomAccessIteratorT>
+bool ProgressiveIntegerPointsKdTreeEncoder<compression_level_t>::EncodeLod(
+    uint32_t num_remaining_bits, Queue<Cell<RandomAccessIteratorT>> *cells,
+    Queue<Cell<RandomAccessIteratorT>> *next_cells) {
+  typedef Cell<RandomAccessIteratorT> CellT;
+  const uint32_t modifier = 1 << (num_remaining_bits - 1);
+  std::vector<CellT> parts, split_parts;
+  while (!cells->empty()) {
+    const CellT cell = cells->front();
+    cells->pop();
+
+    // Cells with a single point are finished by encoding the remaining bits.
+    if (cell.end - cell.begin == 1) {
+      const auto &p = *cell.begin;
+      for (uint32_t axis = 0; axis < dimension_; ++axis) {
+        remaining_bits_encoder_.EncodeLeastSignificantBits32(num_remaining_bits,
+                                                             p[axis]);
+      }
+      continue;
+    }
+
+    // Split the cell in the middle of all axes.
+    parts.clear();
+    parts.push_back(cell);
+    for (uint32_t axis = 0; axis < dimension_; ++axis) {
+      split_parts.clear();
+      for (const CellT &part : parts) {
+        const uint32_t split_value = part.base[axis] + modifier;
+        const RandomAccessIteratorT split = std::partition(
+            part.begin, part.end, Splitter(axis, split_value));
+
+        // Encode number of points in first and second half.
+        const uint32_t num_part_points = part.end - part.begin;
+        const int required_bits = bits::MostSignificantBit(num_part_points);
+        const uint32_t first_half = split - part.begin;
+        const uint32_t second_half = part.end - split;
+        const bool left = first_half < second_half;
+        if (first_half != second_half)
+          half_encoder_.EncodeBit(left);
+        if (required_bits > 0) {
+          numbers_encoder_.EncodeLeastSignificantBits32(
+              required_bits,
+              num_part_points / 2 - std::min(first_half, second_half));
+        }
+
+        if (first_half)
+          split_parts.push_back(CellT(part.begin, split, part.base));
+        if (second_half) {
+          split_parts.push_back(CellT(split, part.end, part.base));
+          split_parts.back().base[axis] = split_value;
+        }
+      }
+      std::swap(parts, split_parts);
+    }
+
+    // Once all bits are used up the child cells are fully determined.
+    for (CellT &part : parts) {
+      if (num_remaining_bits > 1) {
+        next_cells->push(std::move(part));
+      } else if (static_cast<uint32_t>(part.end - part.begin) >
+                 kProgressiveKdTreeMaxDuplicatePoints) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+extern template class ProgressiveIntegerPointsKdTreeEncoder<0>;
+extern template class ProgressiveIntegerPointsKdTreeEncoder<2>;
+extern template class ProgressiveIntegerPointsKdTreeEncoder<4>;
+extern template class ProgressiveIntegerPointsKdTreeEncoder<6>;
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_ENCODER_H_
@@ -0,0 +1,48 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_SHARED_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_SHARED_H_
+
+#include <stdint.h>
+
+#include <limits>
+
+// Definitions shared by the ProgressiveIntegerPointsKdTreeEncoder and the
+// ProgressiveIntegerPointsKdTreeDecoder.
+
+namespace draco {
+
+// Maximum number of identical points in a single leaf of the kd-tree. Copies
+// of the same point are encoded with only a few bits, so without a limit a
+// tiny input could expand into billions of decoded points.
+static constexpr uint32_t kProgressiveKdTreeMaxDuplicatePoints = 1 << 16;
+
+// Returns the maximum number of points that can be stored in a kd-tree with
+// |bit_length| bits for each of the |dimension| coordinates.
+inline uint32_t ProgressiveKdTreeMaxNumPoints(uint32_t bit_length,
+                                              uint32_t dimension) {
+  const uint64_t num_cell_bits = static_cast<uint64_t>(bit_length) * dimension;
+  if (num_cell_bits >= 32)
+    return std::numeric_limits<uint32_t>::max();
+  const uint64_t max_num_points =
+      (uint64_t(1) << num_cell_bits) * kProgressiveKdTreeMaxDuplicatePoints;
+  if (max_num_points > std::numeric_limits<uint32_t>::max())
+    return std::numeric_limits<uint32_t>::max();
+  return static_cast<uint32_t>(max_num_points);
+}
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_ALGORITHMS_PROGRESSIVE_INTEGER_POINTS_KD_TREE_SHARED_H_
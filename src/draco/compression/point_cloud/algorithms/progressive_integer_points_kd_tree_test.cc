@@ -0,0 +1,207 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <random>
+
+#include "draco/compression/point_cloud/algorithms/progressive_integer_points_kd_tree_decoder.h"
+#include "draco/compression/point_cloud/algorithms/progressive_integer_points_kd_tree_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+class ProgressiveIntegerPointsKdTreeTest : public ::testing::Test {
+ protected:
+  typedef std::vector<uint32_t> Point;
+
+  // Generates clustered random points with coordinates of |bit_length| bits.
+  std::vector<Point> GeneratePoints(int num_points, uint32_t bit_length) const {
+    std::mt19937 generator(13);
+    const uint32_t max_value =
+        bit_length == 32 ? 0xffffffffu : (1u << bit_length) - 1;
+    std::uniform_int_distribution<uint32_t> distribution(0, max_value);
+    std::vector<Point> points;
+    for (int i = 0; i < num_points; ++i) {
+      Point p(3);
+      for (int c = 0; c < 3; ++c) {
+        p[c] = distribution(generator);
+        if (i % 2)
+          p[c] /= 16;
+      }
+      points.push_back(p);
+      // Add some duplicate points.
+      if (i % 10 == 0)
+        points.push_back(p);
+    }
+    return points;
+  }
+
+  template <int compression_level_t>
+  void TestEncoding(const std::vector<Point> &points, uint32_t bit_length) {
+    std::vector<Point> input = points;
+    ProgressiveIntegerPointsKdTreeEncoder<compression_level_t> encoder(3);
+    EncoderBuffer buffer;
+    ASSERT_TRUE(
+        encoder.EncodePoints(input.begin(), input.end(), bit_length, &buffer));
+
+    // Decoding of all LODs must return the input points.
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    ProgressiveIntegerPointsKdTreeDecoder<compression_level_t> decoder(3);
+    std::vector<Point> decoded_points;
+    ASSERT_TRUE(
+        decoder.DecodePoints(&dec_buffer, std::back_inserter(decoded_points)));
+    ASSERT_EQ(decoder.num_decoded_lods(), decoder.num_lods());
+    ASSERT_EQ(decoder.GetEncodedSize(decoder.num_lods()), buffer.size());
+    std::vector<Point> sorted_points = points;
+    std::sort(sorted_points.begin(), sorted_points.end());
+    std::sort(decoded_points.begin(), decoded_points.end());
+    ASSERT_EQ(decoded_points, sorted_points);
+
+    // Every prefix of the LODs must be decodable from truncated data and it
+    // must refine the previous LOD.
+    size_t last_num_points = 0;
+    for (int lod = 0; lod <= decoder.num_lods(); ++lod) {
+      dec_buffer.Init(buffer.data(), decoder.GetEncodedSize(lod));
+      ProgressiveIntegerPointsKdTreeDecoder<compression_level_t> lod_decoder(3);
+      std::vector<Point> lod_points;
+      ASSERT_TRUE(lod_decoder.DecodePoints(&dec_buffer,
+                                           std::back_inserter(lod_points)));
+      ASSERT_EQ(lod_decoder.num_decoded_lods(), lod);
+      ASSERT_GE(lod_points.size(), last_num_points);
+      ASSERT_LE(lod_points.size(), points.size());
+      last_num_points = lod_points.size();
+
+      // Each point must be within the cell of one of the input points.
+      const uint32_t cell_bits = bit_length - lod;
+      const auto get_cell = [cell_bits](const Point &p) {
+        Point cell(3);
+        for (int c = 0; c < 3; ++c) {
+          cell[c] = cell_bits == 32 ? 0 : p[c] >> cell_bits;
+        }
+        return cell;
+      };
+      std::vector<Point> input_cells;
+      for (const Point &p : sorted_points) {
+        input_cells.push_back(get_cell(p));
+      }
+      std::sort(input_cells.begin(), input_cells.end());
+      for (const Point &p : lod_points) {
+        ASSERT_TRUE(std::binary_search(input_cells.begin(), input_cells.end(),
+                                       get_cell(p)));
+      }
+    }
+    ASSERT_EQ(last_num_points, points.size());
+  }
+};
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestCompressionLevels) {
+  const std::vector<Point> points = GeneratePoints(1000, 12);
+  TestEncoding<0>(points, 12);
+  TestEncoding<2>(points, 12);
+  TestEncoding<4>(points, 12);
+  TestEncoding<6>(points, 12);
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestBitLengths) {
+  for (uint32_t bit_length : {1, 5, 16, 31, 32}) {
+    TestEncoding<6>(GeneratePoints(200, bit_length), bit_length);
+  }
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestSpecialCases) {
+  // No points.
+  TestEncoding<6>(std::vector<Point>(), 10);
+  // Single point.
+  TestEncoding<6>(std::vector<Point>(1, Point{1, 2, 3}), 10);
+  // Identical points with zero bit length.
+  TestEncoding<6>(std::vector<Point>(5, Point{0, 0, 0}), 0);
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestIncrementalDecoding) {
+  std::vector<Point> points = GeneratePoints(500, 10);
+  ProgressiveIntegerPointsKdTreeEncoder<6> encoder(3);
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodePoints(points.begin(), points.end(), 10, &buffer));
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveIntegerPointsKdTreeDecoder<6> decoder(3);
+  ASSERT_TRUE(decoder.DecodeHeader(&dec_buffer));
+  ASSERT_GT(decoder.num_lods(), 1);
+  for (int lod = 0; lod < decoder.num_lods(); ++lod) {
+    ASSERT_EQ(dec_buffer.decoded_size(), decoder.GetEncodedSize(lod));
+    ASSERT_TRUE(decoder.DecodeNextLod(&dec_buffer));
+  }
+  ASSERT_FALSE(decoder.DecodeNextLod(&dec_buffer));
+  std::vector<Point> decoded_points;
+  decoder.GetPoints(std::back_inserter(decoded_points));
+  ASSERT_EQ(decoded_points.size(), points.size());
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestInvalidLodSizes) {
+  // Header with LOD sizes whose sum overflows the offsets of the LODs.
+  const uint64_t lod_sizes[] = {16, std::numeric_limits<int64_t>::max() - 8,
+                                16};
+  EncoderBuffer buffer;
+  buffer.Encode(static_cast<uint32_t>(10));  // Bit length.
+  buffer.Encode(static_cast<uint32_t>(5));   // Number of points.
+  EncodeVarint(static_cast<uint32_t>(3), &buffer);
+  for (const uint64_t lod_size : lod_sizes) {
+    EncodeVarint(lod_size, &buffer);
+  }
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveIntegerPointsKdTreeDecoder<6> decoder(3);
+  ASSERT_FALSE(decoder.DecodeHeader(&dec_buffer));
+  std::vector<Point> decoded_points;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ASSERT_FALSE(
+      decoder.DecodePoints(&dec_buffer, std::back_inserter(decoded_points)));
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestTooManyDuplicatePoints) {
+  // The maximum number of copies of the same point can be encoded.
+  std::vector<Point> points(kProgressiveKdTreeMaxDuplicatePoints,
+                            Point{1, 2, 3});
+  TestEncoding<6>(points, 2);
+
+  // One more copy is rejected.
+  points.push_back(Point{1, 2, 3});
+  ProgressiveIntegerPointsKdTreeEncoder<6> encoder(3);
+  EncoderBuffer buffer;
+  ASSERT_FALSE(encoder.EncodePoints(points.begin(), points.end(), 2, &buffer));
+  ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST_F(ProgressiveIntegerPointsKdTreeTest, TestInvalidNumberOfPoints) {
+  // Header with more points than can be stored in a kd-tree with 1 bit per
+  // coordinate, i.e., 8 cells with the maximum number of duplicates each.
+  const uint32_t num_points = 8 * kProgressiveKdTreeMaxDuplicatePoints + 1;
+  EncoderBuffer buffer;
+  buffer.Encode(static_cast<uint32_t>(1));  // Bit length.
+  buffer.Encode(num_points);
+  EncodeVarint(static_cast<uint32_t>(0), &buffer);
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  ProgressiveIntegerPointsKdTreeDecoder<6> decoder(3);
+  ASSERT_FALSE(decoder.DecodeHeader(&dec_buffer));
+}
+
+}  // namespace draco
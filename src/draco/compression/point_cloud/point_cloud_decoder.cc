@@ -14,6 +14,9 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+
+#include "draco/core/varint_decoding.h"
 #include "draco/metadata/metadata_decoder.h"
 
 #include "draco/psy/psy_draco.h"
@@ -25,7 +28,10 @@ PointCloudDecoder::PointCloudDecoder()
       buffer_(nullptr),
       version_major_(0),
       version_minor_(0),
-      options_(nullptr) {}
+      options_(nullptr),
+      has_attribute_offsets_(false),
+      decode_selected_attributes_(false),
+      num_decoded_attributes_(0) {}
 
 Status PointCloudDecoder::DecodeHeader(DecoderBuffer *buffer,
                                        DracoHeader *out_header) {
@@ -84,19 +90,66 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   buffer_->set_bitstream_version(
       DRACO_BITSTREAM_VERSION(version_major_, version_minor_));
 
+  if (bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 2) &&
+      (header.flags & GEOMETRY_INFO_FLAG_MASK)) {
+    // The geometry summary is not needed for decoding.
+    uint32_t info_size;
+    if (!DecodeVarint(&info_size, buffer_) ||
+        info_size > buffer_->remaining_size())
+      return Status(Status::IO_ERROR, "Failed to parse geometry info.");
+    buffer_->Advance(info_size);
+  }
   if (bitstream_version() >= DRACO_BITSTREAM_VERSION(1, 3) &&
       (header.flags & METADATA_FLAG_MASK)) {
     DRACO_RETURN_IF_ERROR(DecodeMetadata())
   }
+  has_attribute_offsets_ =
+      bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 2) &&
+      (header.flags & ATTRIBUTE_OFFSETS_FLAG_MASK);
+
+  num_decoded_attributes_ = 0;
+  decode_selected_attributes_ =
+      options.GetGlobalBool("decode_selected_attributes", false);
+  requested_unique_ids_.assign(
+      options.GetGlobalInt("num_attribute_unique_ids_to_decode", 0), 0);
+  options.GetGlobalVector("attribute_unique_ids_to_decode",
+                          requested_unique_ids_.size(),
+                          requested_unique_ids_.data());
+
+  const int num_threads = options.GetGlobalInt("num_decoding_threads", 1);
+  if (num_threads > 1) {
+    if (!thread_pool_ || thread_pool_->num_threads() != num_threads)
+      thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool(num_threads));
+  } else {
+    thread_pool_ = nullptr;
+  }
   if (!InitializeDecoder())
     return Status(Status::ERROR, "Failed to initialize the decoder.");
   if (!DecodeGeometryData())
     return Status(Status::ERROR, "Failed to decode geometry data.");
   if (!DecodePointAttributes())
     return Status(Status::ERROR, "Failed to decode point attributes.");
+  if (decode_selected_attributes_) {
+    for (int att_id = point_cloud_->num_attributes() - 1; att_id >= 0;
+         --att_id) {
+      if (!IsAttributeRequested(att_id))
+        point_cloud_->DeleteAttribute(att_id);
+    }
+  }
   return OkStatus();
 }
 
+bool PointCloudDecoder::IsAttributeRequested(int32_t att_id) const {
+  if (!decode_selected_attributes_)
+    return true;
+  const PointAttribute *const att = point_cloud_->attribute(att_id);
+  if (options_->GetAttributeBool(att->attribute_type(), "decode_attribute",
+                                 false))
+    return true;
+  return std::find(requested_unique_ids_.begin(), requested_unique_ids_.end(),
+                   att->unique_id()) != requested_unique_ids_.end();
+}
+
 bool PointCloudDecoder::DecodePointAttributes() {
   PSY_DRACO_PROFILE_SECTION("DecodePointAttributes");
   uint8_t num_attributes_decoders;
@@ -134,6 +187,11 @@ bool PointCloudDecoder::DecodePointAttributes() {
     }
   }
 
+  // Make sure there is a slot for each attribute so that the references can be
+  // stored safely even when the attributes are decoded in parallel.
+  if (reference_portable_attributes_.size() < attribute_to_decoder_map_.size())
+    reference_portable_attributes_.resize(attribute_to_decoder_map_.size());
+
   // Decode the actual attributes using the created attribute decoders.
   if (!DecodeAllAttributes())
     return false;
@@ -144,6 +202,8 @@ bool PointCloudDecoder::DecodePointAttributes() {
 }
 
 bool PointCloudDecoder::DecodeAllAttributes() {
+  if (has_attribute_offsets_)
+    return DecodeAllAttributesFromOffsets();
   for (auto &att_dec : attributes_decoders_) {
     if (!att_dec->DecodeAttributes(buffer_))
       return false;
@@ -151,6 +211,78 @@ bool PointCloudDecoder::DecodeAllAttributes() {
   return true;
 }
 
+bool PointCloudDecoder::DecodeAllAttributesFromOffsets() {
+  // Decode the dependency level and the data size of every attribute decoder
+  // and set up a separate buffer for each of them.
+  const int num_decoders = attributes_decoders_.size();
+  decoder_levels_.assign(num_decoders, 0);
+  std::vector<uint32_t> data_sizes(num_decoders);
+  int num_levels = 0;
+  int64_t total_data_size = 0;
+  for (int i = 0; i < num_decoders; ++i) {
+    uint8_t level;
+    if (!buffer_->Decode(&level))
+      return false;
+    if (!DecodeVarint(&data_sizes[i], buffer_))
+      return false;
+    decoder_levels_[i] = level;
+    num_levels = std::max(num_levels, level + 1);
+    total_data_size += data_sizes[i];
+  }
+  if (total_data_size > buffer_->remaining_size())
+    return false;
+  std::vector<DecoderBuffer> decoder_buffers(num_decoders);
+  const char *data = buffer_->data_head();
+  for (int i = 0; i < num_decoders; ++i) {
+    decoder_buffers[i].Init(data, data_sizes[i], buffer_->bitstream_version());
+    data += data_sizes[i];
+  }
+
+  // Attribute decoders without any requested attribute are skipped unless
+  // they are on a lower dependency level than some requested attribute.
+  std::vector<uint8_t> is_requested(num_decoders, false);
+  int max_requested_level = -1;
+  for (int i = 0; i < num_decoders; ++i) {
+    const int num_attributes = attributes_decoders_[i]->GetNumAttributes();
+    for (int j = 0; j < num_attributes; ++j) {
+      if (IsAttributeRequested(attributes_decoders_[i]->GetAttributeId(j)))
+        is_requested[i] = true;
+    }
+    if (is_requested[i])
+      max_requested_level = std::max(max_requested_level, decoder_levels_[i]);
+  }
+
+  std::vector<uint8_t> is_decoded(num_decoders, false);
+  std::vector<int> level_decoder_ids;
+  for (int level = 0; level < num_levels; ++level) {
+    level_decoder_ids.clear();
+    for (int i = 0; i < num_decoders; ++i) {
+      if (decoder_levels_[i] == level &&
+          (is_requested[i] || level < max_requested_level))
+        level_decoder_ids.push_back(i);
+    }
+    const auto decode_attributes = [&](int i) {
+      const int att_decoder_id = level_decoder_ids[i];
+      is_decoded[att_decoder_id] =
+          attributes_decoders_[att_decoder_id]->DecodeAttributes(
+              &decoder_buffers[att_decoder_id]);
+    };
+    if (thread_pool_) {
+      thread_pool_->ParallelFor(0, level_decoder_ids.size(), decode_attributes);
+    } else {
+      for (int i = 0; i < static_cast<int>(level_decoder_ids.size()); ++i) {
+        decode_attributes(i);
+      }
+    }
+    for (int att_decoder_id : level_decoder_ids) {
+      if (!is_decoded[att_decoder_id])
+        return false;
+    }
+  }
+  buffer_->Advance(total_data_size);
+  return true;
+}
+
 const PointAttribute *PointCloudDecoder::GetPortableAttribute(
     int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes())
@@ -161,4 +293,49 @@ const PointAttribute *PointCloudDecoder::GetPortableAttribute(
       parent_att_id);
 }
 
+const PointAttribute *PointCloudDecoder::GetParentPortableAttribute(
+    int32_t parent_att_id, int32_t att_id) {
+  if (has_attribute_offsets_) {
+    const int32_t map_size = attribute_to_decoder_map_.size();
+    if (parent_att_id < 0 || parent_att_id >= map_size || att_id < 0 ||
+        att_id >= map_size)
+      return nullptr;
+    const int32_t parent_att_decoder_id =
+        attribute_to_decoder_map_[parent_att_id];
+    const int32_t att_decoder_id = attribute_to_decoder_map_[att_id];
+    if (parent_att_decoder_id == att_decoder_id) {
+      if (!attributes_decoders_[att_decoder_id]->IsAttributeDecodedBefore(
+              parent_att_id, att_id))
+        return nullptr;
+    } else if (decoder_levels_[parent_att_decoder_id] >=
+               decoder_levels_[att_decoder_id]) {
+      // The parent would be decoded concurrently with or after |att_id|.
+      return nullptr;
+    }
+  }
+  return GetPortableAttribute(parent_att_id);
+}
+
+const PointAttribute *PointCloudDecoder::GetReferencePortableAttribute(
+    int32_t point_attribute_id) const {
+  if (point_attribute_id < 0 ||
+      point_attribute_id >=
+          static_cast<int32_t>(reference_portable_attributes_.size()))
+    return nullptr;
+  return reference_portable_attributes_[point_attribute_id].get();
+}
+
+void PointCloudDecoder::SetReferencePortableAttribute(
+    int32_t point_attribute_id, const PointAttribute &att) {
+  if (point_attribute_id < 0 ||
+      point_attribute_id >=
+          static_cast<int32_t>(reference_portable_attributes_.size()))
+    return;
+  std::unique_ptr<PointAttribute> &ref =
+      reference_portable_attributes_[point_attribute_id];
+  if (ref == nullptr)
+    ref = std::unique_ptr<PointAttribute>(new PointAttribute());
+  ref->CopyFrom(att);
+}
+
 }  // namespace draco
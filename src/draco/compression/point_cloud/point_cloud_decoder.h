@@ -15,10 +15,13 @@
 #ifndef DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 
+#include <atomic>
+
 #include "draco/compression/attributes/attributes_decoder_interface.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/point_cloud/point_cloud.h"
 
 namespace draco {
@@ -58,6 +61,27 @@ class PointCloudDecoder {
   // that contains the quantized values (before the dequantization step).
   const PointAttribute *GetPortableAttribute(int32_t point_attribute_id);
 
+  // Returns the portable attribute |parent_att_id| needed to decode the
+  // attribute |att_id|. Returns nullptr when the parent attribute is not
+  // decoded before |att_id|, i.e., when the dependency levels stored with the
+  // attribute data (see has_attribute_offsets()) don't respect the actual
+  // dependency.
+  const PointAttribute *GetParentPortableAttribute(int32_t parent_att_id,
+                                                   int32_t att_id);
+
+  // Returns the portable attribute that was stored for a given attribute id
+  // during the previous call of the Decode() method or nullptr when no such
+  // attribute exists. The reference attributes are stored only when the
+  // "store_reference_attributes" option is set. See
+  // PointCloudEncoder::GetReferencePortableAttribute() for more details.
+  const PointAttribute *GetReferencePortableAttribute(
+      int32_t point_attribute_id) const;
+
+  // Stores a copy of the portable attribute |att| as the reference for the
+  // next call of the Decode() method.
+  void SetReferencePortableAttribute(int32_t point_attribute_id,
+                                     const PointAttribute &att);
+
   uint16_t bitstream_version() const {
     return DRACO_BITSTREAM_VERSION(version_major_, version_minor_);
   }
@@ -77,6 +101,45 @@ class PointCloudDecoder {
   DecoderBuffer *buffer() { return buffer_; }
   const DecoderOptions *options() const { return options_; }
 
+  // Returns true when the input data contains sizes of the data of individual
+  // attributes (see ATTRIBUTE_OFFSETS_FLAG_MASK).
+  bool has_attribute_offsets() const { return has_attribute_offsets_; }
+
+  // Can be implemented by derived classes to provide external memory where
+  // the decoder stores the final values of the attribute |att_id| instead of
+  // the attribute's own buffer. The values are stored in the order of points,
+  // i.e., the value of point |p| is stored at |p * *out_byte_stride| bytes
+  // from the returned address, so the memory must be large enough for all
+  // points of the decoded point cloud. The attribute in the decoded geometry
+  // is left without any values in this case.
+  // Called only for attributes where each attribute value belongs to exactly
+  // one point, possibly concurrently for different attributes.
+  // Returns nullptr when the values should be stored in the attribute.
+  virtual uint8_t *GetAttributeOutputBuffer(int32_t /* att_id */,
+                                            int64_t * /* out_byte_stride */) {
+    return nullptr;
+  }
+
+  // Returns true when the attribute |att_id| is requested by the decoder
+  // options (see Decoder::AddAttributeTypeToDecode()). Attributes that are not
+  // requested are removed from the decoded geometry and their data doesn't
+  // need to be decoded unless other attributes depend on them.
+  bool IsAttributeRequested(int32_t att_id) const;
+
+  // Returns the number of attributes whose values were decoded by sequential
+  // attribute decoders during the last Decode() call. Attributes whose data
+  // was skipped because they were not requested are not counted.
+  int num_decoded_attributes() const { return num_decoded_attributes_; }
+
+  // Called by the attribute decoders after the values of an attribute are
+  // decoded. Can be called concurrently for different attributes.
+  void OnAttributeDecoded() { ++num_decoded_attributes_; }
+
+  // Returns the thread pool that can be used to decode independent data in
+  // parallel or nullptr when the decoding should be single threaded. The pool
+  // is created when the "num_decoding_threads" option is greater than 1.
+  ThreadPool *thread_pool() const { return thread_pool_.get(); }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the decoder. Called in the Decode() method.
@@ -88,6 +151,11 @@ class PointCloudDecoder {
   virtual bool DecodePointAttributes();
 
   virtual bool DecodeAllAttributes();
+
+  // Decodes all attributes using the stored sizes of the attribute decoders
+  // data. Attribute decoders of the same dependency level are processed
+  // concurrently when the thread pool is available.
+  bool DecodeAllAttributesFromOffsets();
   virtual bool OnAttributesDecoded() { return true; }
 
   Status DecodeMetadata();
@@ -109,6 +177,26 @@ class PointCloudDecoder {
   uint8_t version_minor_;
 
   const DecoderOptions *options_;
+
+  // Set when the attribute data is preceded by the sizes of the data of the
+  // individual attribute decoders.
+  bool has_attribute_offsets_;
+  // Dependency levels of the attribute decoders when the attribute data is
+  // decoded from offsets.
+  std::vector<int> decoder_levels_;
+
+  // Set when only the attributes requested by the options are decoded.
+  bool decode_selected_attributes_;
+  // Unique ids of the requested attributes.
+  std::vector<uint32_t> requested_unique_ids_;
+  std::atomic<int> num_decoded_attributes_;
+
+  // Pool of worker threads reused between Decode() calls.
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  // Portable attributes of the previously decoded geometry indexed by the
+  // attribute id.
+  std::vector<std::unique_ptr<PointAttribute>> reference_portable_attributes_;
 };
 
 }  // namespace draco
@@ -14,6 +14,9 @@
 //
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
 
+#include <algorithm>
+
+#include "draco/core/varint_encoding.h"
 #include "draco/metadata/metadata_encoder.h"
 
 #include "draco/psy/psy_draco.h"
@@ -21,7 +24,10 @@
 namespace draco {
 
 PointCloudEncoder::PointCloudEncoder()
-    : point_cloud_(nullptr), buffer_(nullptr) {}
+    : point_cloud_(nullptr),
+      buffer_(nullptr),
+      num_encoded_points_(0),
+      num_encoded_faces_(0) {}
 
 void PointCloudEncoder::SetPointCloud(const PointCloud &pc) {
   point_cloud_ = &pc;
@@ -32,14 +38,27 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
   options_ = &options;
   buffer_ = out_buffer;
 
-  // Cleanup from previous runs.
+  // Cleanup from previous runs. The attribute encoders are kept aside so that
+  // they can be reused by GenerateAttributesEncoder().
+  previous_attributes_encoders_.swap(attributes_encoders_);
   attributes_encoders_.clear();
   attribute_to_encoder_map_.clear();
   attributes_encoder_ids_order_.clear();
 
+  const int num_threads = options.GetGlobalInt("num_encoding_threads", 1);
+  if (num_threads > 1) {
+    if (!thread_pool_ || thread_pool_->num_threads() != num_threads)
+      thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool(num_threads));
+  } else {
+    thread_pool_ = nullptr;
+  }
+
   if (!point_cloud_)
     return Status(Status::ERROR, "Invalid input geometry.");
   DRACO_RETURN_IF_ERROR(EncodeHeader())
+  const size_t geometry_info_offset = buffer_->size();
+  num_encoded_points_ = point_cloud_->num_points();
+  num_encoded_faces_ = 0;
   DRACO_RETURN_IF_ERROR(EncodeMetadata())
   if (!InitializeEncoder())
     return Status(Status::ERROR, "Failed to initialize encoder.");
@@ -49,6 +68,8 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options,
     return Status(Status::ERROR, "Failed to encode geometry data.");
   if (!EncodePointAttributes())
     return Status(Status::ERROR, "Failed to encode point attributes.");
+  if (options_->GetGlobalBool("encode_geometry_info", false))
+    DRACO_RETURN_IF_ERROR(EncodeGeometryInfo(geometry_info_offset))
   return OkStatus();
 }
 
@@ -72,6 +93,12 @@ Status PointCloudEncoder::EncodeHeader() {
   if (point_cloud_->GetMetadata()) {
     flags |= METADATA_FLAG_MASK;
   }
+  if (options_->GetGlobalBool("encode_attribute_offsets", false)) {
+    flags |= ATTRIBUTE_OFFSETS_FLAG_MASK;
+  }
+  if (options_->GetGlobalBool("encode_geometry_info", false)) {
+    flags |= GEOMETRY_INFO_FLAG_MASK;
+  }
   buffer_->Encode(flags);
   return OkStatus();
 }
@@ -88,12 +115,51 @@ Status PointCloudEncoder::EncodeMetadata() {
   return OkStatus();
 }
 
+Status PointCloudEncoder::EncodeGeometryInfo(size_t offset) {
+  EncoderBuffer info_buffer;
+  EncodeVarint(static_cast<uint64_t>(num_encoded_points_), &info_buffer);
+  EncodeVarint(static_cast<uint64_t>(num_encoded_faces_), &info_buffer);
+  EncodeVarint(static_cast<uint32_t>(point_cloud_->num_attributes()),
+               &info_buffer);
+  // Attributes are stored in the order in which they are created by the
+  // decoder.
+  for (int att_encoder_id : attributes_encoder_ids_order_) {
+    const AttributesEncoder *const att_enc =
+        attributes_encoders_[att_encoder_id].get();
+    for (uint32_t i = 0; i < att_enc->num_attributes(); ++i) {
+      const PointAttribute *const att =
+          point_cloud_->attribute(att_enc->GetAttributeId(i));
+      info_buffer.Encode(static_cast<uint8_t>(att->attribute_type()));
+      info_buffer.Encode(static_cast<uint8_t>(att->data_type()));
+      info_buffer.Encode(static_cast<uint8_t>(att->num_components()));
+      info_buffer.Encode(static_cast<uint8_t>(att->normalized()));
+      EncodeVarint(att->unique_id(), &info_buffer);
+    }
+  }
+  EncoderBuffer size_buffer;
+  EncodeVarint(static_cast<uint32_t>(info_buffer.size()), &size_buffer);
+  if (offset > buffer_->size())
+    return Status(Status::ERROR, "Failed to encode geometry info.");
+  std::vector<char> *const data = buffer_->buffer();
+  data->insert(data->begin() + offset, info_buffer.data(),
+               info_buffer.data() + info_buffer.size());
+  data->insert(data->begin() + offset, size_buffer.data(),
+               size_buffer.data() + size_buffer.size());
+  return OkStatus();
+}
+
 bool PointCloudEncoder::EncodePointAttributes() {
   PSY_DRACO_PROFILE_SECTION("EncodePointAttributes");
 
   if (!GenerateAttributesEncoders())
     return false;
 
+  // Make sure there is a slot for each attribute so that the references can be
+  // stored safely even when the attributes are encoded in parallel.
+  if (static_cast<int32_t>(reference_portable_attributes_.size()) <
+      point_cloud_->num_attributes())
+    reference_portable_attributes_.resize(point_cloud_->num_attributes());
+
   // Encode the number of attribute encoders.
   buffer_->Encode(static_cast<uint8_t>(attributes_encoders_.size()));
 
@@ -144,6 +210,9 @@ bool PointCloudEncoder::GenerateAttributesEncoders() {
 }
 
 bool PointCloudEncoder::EncodeAllAttributes() {
+  if (options_->GetGlobalBool("encode_attribute_offsets", false) ||
+      (thread_pool_ && attributes_encoders_.size() > 1))
+    return EncodeAllAttributesSeparately();
   for (int att_encoder_id : attributes_encoder_ids_order_) {
     if (!attributes_encoders_[att_encoder_id]->EncodeAttributes(buffer_))
       return false;
@@ -151,6 +220,88 @@ bool PointCloudEncoder::EncodeAllAttributes() {
   return true;
 }
 
+bool PointCloudEncoder::EncodeAllAttributesSeparately() {
+  // Assign each attribute encoder to a level such that all encoders of its
+  // parent attributes belong to lower levels. Encoders within a single level
+  // are independent and they can be processed concurrently. The encoding order
+  // already respects the dependencies so the parent levels are always known.
+  const int num_encoders = attributes_encoders_.size();
+  std::vector<int> encoder_levels(num_encoders, 0);
+  int num_levels = 0;
+  for (int att_encoder_id : attributes_encoder_ids_order_) {
+    const AttributesEncoder *const att_enc =
+        attributes_encoders_[att_encoder_id].get();
+    int level = 0;
+    for (uint32_t i = 0; i < att_enc->num_attributes(); ++i) {
+      const int32_t att_id = att_enc->GetAttributeId(i);
+      for (int p = 0; p < att_enc->NumParentAttributes(att_id); ++p) {
+        const int32_t parent_encoder_id =
+            attribute_to_encoder_map_[att_enc->GetParentAttributeId(att_id, p)];
+        if (parent_encoder_id != att_encoder_id)
+          level = std::max(level, encoder_levels[parent_encoder_id] + 1);
+      }
+    }
+    encoder_levels[att_encoder_id] = level;
+    num_levels = std::max(num_levels, level + 1);
+  }
+
+  // Each encoder writes its data into a separate buffer.
+  std::vector<EncoderBuffer> encoder_buffers(num_encoders);
+  std::vector<uint8_t> is_encoded(num_encoders, false);
+  std::vector<int> level_encoder_ids;
+  for (int level = 0; level < num_levels; ++level) {
+    level_encoder_ids.clear();
+    for (int att_encoder_id : attributes_encoder_ids_order_) {
+      if (encoder_levels[att_encoder_id] == level)
+        level_encoder_ids.push_back(att_encoder_id);
+    }
+    const auto encode_attributes = [&](int i) {
+      const int att_encoder_id = level_encoder_ids[i];
+      is_encoded[att_encoder_id] =
+          attributes_encoders_[att_encoder_id]->EncodeAttributes(
+              &encoder_buffers[att_encoder_id]);
+    };
+    if (thread_pool_) {
+      thread_pool_->ParallelFor(0, level_encoder_ids.size(), encode_attributes);
+    } else {
+      for (int i = 0; i < static_cast<int>(level_encoder_ids.size()); ++i) {
+        encode_attributes(i);
+      }
+    }
+    for (int att_encoder_id : level_encoder_ids) {
+      if (!is_encoded[att_encoder_id])
+        return false;
+    }
+  }
+
+  if (options_->GetGlobalBool("encode_attribute_offsets", false)) {
+    // Store the level and the data size of each attribute encoder so that the
+    // decoder can locate and decode independent attributes concurrently.
+    for (int att_encoder_id : attributes_encoder_ids_order_) {
+      buffer_->Encode(static_cast<uint8_t>(encoder_levels[att_encoder_id]));
+      EncodeVarint(static_cast<uint32_t>(encoder_buffers[att_encoder_id].size()),
+                   buffer_);
+    }
+  }
+
+  // Join the encoded data in the same order as the single threaded encoder.
+  for (int att_encoder_id : attributes_encoder_ids_order_) {
+    const EncoderBuffer &att_buffer = encoder_buffers[att_encoder_id];
+    if (!buffer_->Encode(att_buffer.data(), att_buffer.size()))
+      return false;
+  }
+  return true;
+}
+
+std::unique_ptr<AttributesEncoder>
+PointCloudEncoder::ReleasePreviousAttributesEncoder(int att_encoder_id) {
+  if (att_encoder_id < 0 ||
+      att_encoder_id >=
+          static_cast<int>(previous_attributes_encoders_.size()))
+    return nullptr;
+  return std::move(previous_attributes_encoders_[att_encoder_id]);
+}
+
 bool PointCloudEncoder::MarkParentAttribute(int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes())
     return false;
@@ -172,6 +323,28 @@ const PointAttribute *PointCloudEncoder::GetPortableAttribute(
       parent_att_id);
 }
 
+const PointAttribute *PointCloudEncoder::GetReferencePortableAttribute(
+    int32_t point_attribute_id) const {
+  if (point_attribute_id < 0 ||
+      point_attribute_id >=
+          static_cast<int32_t>(reference_portable_attributes_.size()))
+    return nullptr;
+  return reference_portable_attributes_[point_attribute_id].get();
+}
+
+void PointCloudEncoder::SetReferencePortableAttribute(
+    int32_t point_attribute_id, const PointAttribute &att) {
+  if (point_attribute_id < 0 ||
+      point_attribute_id >=
+          static_cast<int32_t>(reference_portable_attributes_.size()))
+    return;
+  std::unique_ptr<PointAttribute> &ref =
+      reference_portable_attributes_[point_attribute_id];
+  if (ref == nullptr)
+    ref = std::unique_ptr<PointAttribute>(new PointAttribute());
+  ref->CopyFrom(att);
+}
+
 bool PointCloudEncoder::RearrangeAttributesEncoders() {
   // Find the encoding order of the attribute encoders that is determined by
   // the parent dependencies between individual encoders. Instead of traversing
@@ -186,13 +359,13 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
   // can be lifted for encoders that can encode individual attributes separately
   // but it will require changes in the current API.
   attributes_encoder_ids_order_.resize(attributes_encoders_.size());
-  std::vector<bool> is_encoder_processed(attributes_encoders_.size(), false);
+  is_encoder_processed_.assign(attributes_encoders_.size(), false);
   uint32_t num_processed_encoders = 0;
   while (num_processed_encoders < attributes_encoders_.size()) {
     // Flagged when any of the encoder get processed.
     bool encoder_processed = false;
     for (uint32_t i = 0; i < attributes_encoders_.size(); ++i) {
-      if (is_encoder_processed[i])
+      if (is_encoder_processed_[i])
         continue;  // Encoder already processed.
       // Check if all parent encoders are already processed.
       bool can_be_processed = true;
@@ -204,7 +377,7 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
               attributes_encoders_[i]->GetParentAttributeId(att_id, ap);
           const int32_t parent_encoder_id =
               attribute_to_encoder_map_[parent_att_id];
-          if (parent_att_id != i && !is_encoder_processed[parent_encoder_id]) {
+          if (parent_att_id != i && !is_encoder_processed_[parent_encoder_id]) {
             can_be_processed = false;
             break;
           }
@@ -214,7 +387,7 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
         continue;  // Try to process the encoder in the next iteration.
       // Encoder can be processed. Update the encoding order.
       attributes_encoder_ids_order_[num_processed_encoders++] = i;
-      is_encoder_processed[i] = true;
+      is_encoder_processed_[i] = true;
       encoder_processed = true;
     }
     if (!encoder_processed &&
@@ -228,9 +401,7 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
   // Now for every encoder, reorder the attributes to satisfy their
   // dependencies (an attribute may still depend on other attributes within an
   // encoder).
-  std::vector<int32_t> attribute_encoding_order;
-  std::vector<bool> is_attribute_processed(point_cloud_->num_attributes(),
-                                           false);
+  is_attribute_processed_.assign(point_cloud_->num_attributes(), false);
   int num_processed_attributes;
   for (uint32_t ae_order = 0; ae_order < attributes_encoders_.size();
        ++ae_order) {
@@ -240,13 +411,13 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
     if (num_encoder_attributes < 2)
       continue;  // No need to resolve dependencies for a single attribute.
     num_processed_attributes = 0;
-    attribute_encoding_order.resize(num_encoder_attributes);
+    attribute_encoding_order_.resize(num_encoder_attributes);
     while (num_processed_attributes < num_encoder_attributes) {
       // Flagged when any of the attributes get processed.
       bool attribute_processed = false;
       for (int i = 0; i < num_encoder_attributes; ++i) {
         const int32_t att_id = attributes_encoders_[ae]->GetAttributeId(i);
-        if (is_attribute_processed[i])
+        if (is_attribute_processed_[i])
           continue;  // Attribute already processed.
         // Check if all parent attributes are already processed.
         bool can_be_processed = true;
@@ -254,7 +425,7 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
              p < attributes_encoders_[ae]->NumParentAttributes(att_id); ++p) {
           const int32_t parent_att_id =
               attributes_encoders_[ae]->GetParentAttributeId(att_id, p);
-          if (!is_attribute_processed[parent_att_id]) {
+          if (!is_attribute_processed_[parent_att_id]) {
             can_be_processed = false;
             break;
           }
@@ -262,8 +433,8 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
         if (!can_be_processed)
           continue;  // Try to process the attribute in the next iteration.
         // Attribute can be processed. Update the encoding order.
-        attribute_encoding_order[num_processed_attributes++] = i;
-        is_attribute_processed[i] = true;
+        attribute_encoding_order_[num_processed_attributes++] = i;
+        is_attribute_processed_[i] = true;
         attribute_processed = true;
       }
       if (!attribute_processed &&
@@ -274,7 +445,7 @@ bool PointCloudEncoder::RearrangeAttributesEncoders() {
       }
     }
     // Update the order of the attributes within the encoder.
-    attributes_encoders_[ae]->SetAttributeIds(attribute_encoding_order);
+    attributes_encoders_[ae]->SetAttributeIds(attribute_encoding_order_);
   }
   return true;
 }
@@ -20,6 +20,7 @@
 #include "draco/compression/config/encoder_options.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/point_cloud/point_cloud.h"
 
 namespace draco {
@@ -55,6 +56,14 @@ class PointCloudEncoder {
     return attributes_encoders_.size() - 1;
   }
 
+  // Returns the attribute encoder that was created with id |att_encoder_id|
+  // during the previous call of the Encode() method or nullptr when no such
+  // encoder exists (or when it was already released). Derived classes can use
+  // it in GenerateAttributesEncoder() to reuse memory allocated by the encoder
+  // when the same geometry type is encoded repeatedly.
+  std::unique_ptr<AttributesEncoder> ReleasePreviousAttributesEncoder(
+      int att_encoder_id);
+
   // Marks one attribute as a parent of another attribute. Must be called after
   // all attribute encoders are created (usually in the
   // AttributeEncoder::Initialize() method).
@@ -65,10 +74,44 @@ class PointCloudEncoder {
   // as predictor for other attributes.
   const PointAttribute *GetPortableAttribute(int32_t point_attribute_id);
 
+  // Returns the portable attribute that was stored for a given attribute id
+  // during the previous call of the Encode() method or nullptr when no such
+  // attribute exists. The reference attributes are stored only when the
+  // "store_reference_attributes" option is set and they can be used by
+  // prediction schemes that exploit similarity between consecutive geometries
+  // (such as frames of an animated mesh).
+  const PointAttribute *GetReferencePortableAttribute(
+      int32_t point_attribute_id) const;
+
+  // Stores a copy of the portable attribute |att| as the reference for the
+  // next call of the Encode() method. Memory allocated for the previously
+  // stored reference is reused when possible.
+  void SetReferencePortableAttribute(int32_t point_attribute_id,
+                                     const PointAttribute &att);
+
   EncoderBuffer *buffer() { return buffer_; }
   const EncoderOptions *options() const { return options_; }
   const PointCloud *point_cloud() const { return point_cloud_; }
 
+  // Returns the number of points and faces of the geometry that is going to
+  // be produced by the decoder. Valid after Encode() succeeds. Encoders that
+  // change the number of points or faces (e.g. by splitting non-manifold
+  // vertices) update the values during the encoding. The number of points of
+  // such encoders is exact only with the "encode_geometry_info" option.
+  int64_t num_encoded_points() const { return num_encoded_points_; }
+  int64_t num_encoded_faces() const { return num_encoded_faces_; }
+  void set_num_encoded_points(int64_t num_points) {
+    num_encoded_points_ = num_points;
+  }
+  void set_num_encoded_faces(int64_t num_faces) {
+    num_encoded_faces_ = num_faces;
+  }
+
+  // Returns the thread pool that can be used to encode independent data in
+  // parallel or nullptr when the encoding should be single threaded. The pool
+  // is created when the "num_encoding_threads" option is greater than 1.
+  ThreadPool *thread_pool() const { return thread_pool_.get(); }
+
  protected:
   // Can be implemented by derived classes to perform any custom initialization
   // of the encoder. Called in the Encode() method.
@@ -115,14 +158,30 @@ class PointCloudEncoder {
   // Encode metadata.
   Status EncodeMetadata();
 
+  // Encodes the summary of the encoded geometry (see GEOMETRY_INFO_FLAG_MASK)
+  // and inserts it at |offset| in |buffer_|. Must be called after all other
+  // data is encoded.
+  Status EncodeGeometryInfo(size_t offset);
+
   // Rearranges attribute encoders and their attributes to reflect the
   // underlying attribute dependencies. This ensures that the attributes are
   // encoded in the correct order (parent attributes before their children).
   bool RearrangeAttributesEncoders();
 
+  // Version of EncodeAllAttributes() that encodes each attribute encoder into
+  // a separate buffer. Attribute encoders that do not depend on each other are
+  // encoded concurrently when the thread pool is available. The buffers are
+  // appended to |buffer_| in the regular encoding order, optionally preceded
+  // by their sizes when the "encode_attribute_offsets" option is set.
+  bool EncodeAllAttributesSeparately();
+
   const PointCloud *point_cloud_;
   std::vector<std::unique_ptr<AttributesEncoder>> attributes_encoders_;
 
+  // Attribute encoders created during the previous call of the Encode()
+  // method. See ReleasePreviousAttributesEncoder().
+  std::vector<std::unique_ptr<AttributesEncoder>> previous_attributes_encoders_;
+
   // Map between attribute id and encoder id.
   std::vector<int32_t> attribute_to_encoder_map_;
 
@@ -131,10 +190,26 @@ class PointCloudEncoder {
   // in which they were created because of attribute dependencies.
   std::vector<int32_t> attributes_encoder_ids_order_;
 
+  // Scratch data used by RearrangeAttributesEncoders() that is kept between
+  // Encode() calls to avoid reallocations.
+  std::vector<bool> is_encoder_processed_;
+  std::vector<bool> is_attribute_processed_;
+  std::vector<int32_t> attribute_encoding_order_;
+
   // This buffer holds the final encoded data.
   EncoderBuffer *buffer_;
 
   const EncoderOptions *options_;
+
+  int64_t num_encoded_points_;
+  int64_t num_encoded_faces_;
+
+  // Pool of worker threads reused between Encode() calls.
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  // Portable attributes of the previously encoded geometry indexed by the
+  // attribute id.
+  std::vector<std::unique_ptr<PointAttribute>> reference_portable_attributes_;
 };
 
 }  // namespace draco
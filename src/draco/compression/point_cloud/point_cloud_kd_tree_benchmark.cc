@@ -0,0 +1,106 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "benchmark/benchmark.h"
+#include "draco/compression/point_cloud/point_cloud_kd_tree_decoder.h"
+#include "draco/compression/point_cloud/point_cloud_kd_tree_encoder.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/io/point_cloud_io.h"
+
+namespace draco {
+
+namespace {
+
+const PointCloud *GetKdTreeBenchmarkPointCloud() {
+  static const std::unique_ptr<PointCloud> pc = []() {
+    auto pc_or =
+        ReadPointCloudFromFile(GetBenchmarkFileFullPath("bun_zipper.ply"));
+    return pc_or.ok() ? std::move(pc_or).value() : nullptr;
+  }();
+  return pc.get();
+}
+
+// The argument is the encoding speed, which selects the compression level of
+// the kd-tree coder.
+EncoderOptions CreateKdTreeOptions(int speed) {
+  EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+  options.SetGlobalInt("quantization_bits", 14);
+  options.SetSpeed(speed, speed);
+  return options;
+}
+
+void BM_PointCloudKdTreeEncode(benchmark::State &state) {
+  const PointCloud *const pc = GetKdTreeBenchmarkPointCloud();
+  if (pc == nullptr) {
+    state.SkipWithError("Failed to load the point cloud.");
+    return;
+  }
+  const EncoderOptions options = CreateKdTreeOptions(state.range(0));
+  PointCloudKdTreeEncoder encoder;
+  encoder.SetPointCloud(*pc);
+  EncoderBuffer buffer;
+  for (auto _ : state) {
+    buffer.Clear();
+    if (!encoder.Encode(options, &buffer).ok()) {
+      state.SkipWithError("Failed to encode the point cloud.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pc->num_points());
+  state.counters["encoded_bytes"] = buffer.size();
+}
+
+void BM_PointCloudKdTreeDecode(benchmark::State &state) {
+  const PointCloud *const pc = GetKdTreeBenchmarkPointCloud();
+  if (pc == nullptr) {
+    state.SkipWithError("Failed to load the point cloud.");
+    return;
+  }
+  const EncoderOptions options = CreateKdTreeOptions(state.range(0));
+  PointCloudKdTreeEncoder encoder;
+  encoder.SetPointCloud(*pc);
+  EncoderBuffer buffer;
+  if (!encoder.Encode(options, &buffer).ok()) {
+    state.SkipWithError("Failed to encode the point cloud.");
+    return;
+  }
+  const DecoderOptions dec_options;
+  PointCloudKdTreeDecoder decoder;
+  for (auto _ : state) {
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    PointCloud decoded_pc;
+    if (!decoder.Decode(dec_options, &dec_buffer, &decoded_pc).ok()) {
+      state.SkipWithError("Failed to decode the point cloud.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pc->num_points());
+}
+
+}  // namespace
+
+BENCHMARK(BM_PointCloudKdTreeEncode)
+    ->ArgName("speed")
+    ->Arg(0)
+    ->Arg(5)
+    ->Arg(10);
+BENCHMARK(BM_PointCloudKdTreeDecode)
+    ->ArgName("speed")
+    ->Arg(0)
+    ->Arg(5)
+    ->Arg(10);
+
+}  // namespace draco
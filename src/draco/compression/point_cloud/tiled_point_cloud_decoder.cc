@@ -0,0 +1,209 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/point_cloud/tiled_point_cloud_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "draco/compression/decode.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+TiledPointCloudDecoder::TiledPointCloudDecoder()
+    : quantization_bits_(0), grid_range_(0.f), data_offset_(0) {
+  std::fill(grid_origin_, grid_origin_ + 3, 0.f);
+}
+
+Status TiledPointCloudDecoder::DecodeIndex(DecoderBuffer *buffer) {
+  tiles_.clear();
+  const int64_t start_offset = buffer->decoded_size();
+  char magic[kTiledPointCloudMagicLength];
+  if (!buffer->Decode(magic, kTiledPointCloudMagicLength) ||
+      memcmp(magic, kTiledPointCloudMagic, kTiledPointCloudMagicLength) != 0)
+    return Status(Status::ERROR, "Not a tiled Draco point cloud.");
+  uint8_t version_major, version_minor;
+  if (!buffer->Decode(&version_major) || !buffer->Decode(&version_minor))
+    return Status(Status::IO_ERROR, "Failed to parse the header.");
+  if (version_major != kTiledPointCloudVersionMajor)
+    return Status(Status::UNKNOWN_VERSION, "Unknown version.");
+  uint8_t quantization_bits;
+  if (!buffer->Decode(&quantization_bits) ||
+      !buffer->Decode(grid_origin_, sizeof(grid_origin_)) ||
+      !buffer->Decode(&grid_range_))
+    return Status(Status::IO_ERROR, "Failed to parse the header.");
+  if (quantization_bits < 1 || quantization_bits > 30)
+    return Status(Status::ERROR, "Invalid quantization bits.");
+  quantization_bits_ = quantization_bits;
+  if (!dequantizer_.Init(grid_range_, (1u << quantization_bits_) - 1))
+    return Status(Status::ERROR, "Invalid grid range.");
+  uint32_t num_tiles;
+  if (!DecodeVarint(&num_tiles, buffer))
+    return Status(Status::IO_ERROR, "Failed to parse the header.");
+  if (num_tiles > buffer->remaining_size())
+    return Status(Status::IO_ERROR, "Invalid number of tiles.");
+  tiles_.resize(num_tiles);
+  uint64_t expected_offset = 0;
+  for (PointCloudTile &tile : tiles_) {
+    bool ok = DecodeVarint(&tile.num_points, buffer) &&
+              DecodeVarint(&tile.data_offset, buffer) &&
+              DecodeVarint(&tile.data_size, buffer);
+    for (int c = 0; c < 3; ++c) {
+      ok = ok && DecodeVarint(&tile.quantized_min[c], buffer);
+    }
+    for (int c = 0; c < 3; ++c) {
+      ok = ok && DecodeVarint(&tile.quantized_max[c], buffer);
+    }
+    if (!ok) {
+      tiles_.clear();
+      return Status(Status::IO_ERROR, "Failed to parse the tile index.");
+    }
+    // Tiles are stored one after another.
+    if (tile.data_offset != expected_offset) {
+      tiles_.clear();
+      return Status(Status::ERROR, "Invalid tile index.");
+    }
+    expected_offset += tile.data_size;
+  }
+  data_offset_ = buffer->decoded_size() - start_offset;
+  return OkStatus();
+}
+
+void TiledPointCloudDecoder::GetTileBounds(int tile_id, float *out_min,
+                                           float *out_max) const {
+  const PointCloudTile &t = tiles_[tile_id];
+  for (int c = 0; c < 3; ++c) {
+    out_min[c] = DequantizeCoordinate(c, t.quantized_min[c]);
+    out_max[c] = DequantizeCoordinate(c, t.quantized_max[c]);
+  }
+}
+
+std::vector<int> TiledPointCloudDecoder::FindTiles(
+    const float *box_min, const float *box_max) const {
+  std::vector<int> tile_ids;
+  for (int i = 0; i < num_tiles(); ++i) {
+    float tile_min[3], tile_max[3];
+    GetTileBounds(i, tile_min, tile_max);
+    bool intersects = true;
+    for (int c = 0; c < 3; ++c) {
+      if (tile_max[c] < box_min[c] || tile_min[c] > box_max[c])
+        intersects = false;
+    }
+    if (intersects)
+      tile_ids.push_back(i);
+  }
+  return tile_ids;
+}
+
+StatusOr<std::unique_ptr<PointCloud>> TiledPointCloudDecoder::DecodeTile(
+    int tile_id, DecoderBuffer *tile_buffer) const {
+  if (tile_id < 0 || tile_id >= num_tiles())
+    return Status(Status::INVALID_PARAMETER, "Invalid tile id.");
+  const PointCloudTile &t = tiles_[tile_id];
+  Decoder decoder;
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> pc,
+                         decoder.DecodePointCloudFromBuffer(tile_buffer));
+  if (pc->num_points() != t.num_points)
+    return Status(Status::ERROR, "Invalid number of points in a tile.");
+  const int pos_att_id = pc->GetNamedAttributeId(GeometryAttribute::POSITION);
+  if (pos_att_id < 0)
+    return Status(Status::ERROR, "Missing tile positions.");
+  PointAttribute *const pos_att = pc->attribute(pos_att_id);
+  if (pos_att->data_type() != DT_UINT32 || pos_att->num_components() != 3)
+    return Status(Status::ERROR, "Invalid tile positions.");
+
+  // Convert the quantized positions into floats. Both types have the same
+  // size so the attribute can be converted in place.
+  const size_t num_values = pos_att->size();
+  std::vector<uint32_t> quantized_values(3 * num_values);
+  for (AttributeValueIndex i(0); i < num_values; ++i) {
+    pos_att->GetValue(i, &quantized_values[3 * i.value()]);
+  }
+  pos_att->Init(GeometryAttribute::POSITION, nullptr, 3, DT_FLOAT32, false,
+                sizeof(float) * 3, 0);
+  pos_att->Reset(num_values);
+  for (AttributeValueIndex i(0); i < num_values; ++i) {
+    float pos[3];
+    for (int c = 0; c < 3; ++c) {
+      const uint32_t q =
+          quantized_values[3 * i.value() + c] + t.quantized_min[c];
+      pos[c] = grid_origin_[c] + dequantizer_(static_cast<int32_t>(q));
+    }
+    pos_att->SetAttributeValue(i, pos);
+  }
+  return pc;
+}
+
+StatusOr<std::unique_ptr<PointCloud>> TiledPointCloudDecoder::DecodePointCloud(
+    DecoderBuffer *buffer) {
+  DRACO_RETURN_IF_ERROR(DecodeIndex(buffer));
+  uint32_t num_points = 0;
+  for (const PointCloudTile &tile : tiles_) {
+    if (tile.num_points > std::numeric_limits<uint32_t>::max() - num_points)
+      return Status(Status::ERROR, "Invalid number of points.");
+    num_points += tile.num_points;
+  }
+  std::unique_ptr<PointCloud> out_pc(new PointCloud());
+  out_pc->set_num_points(num_points);
+  PointIndex::ValueType first_point = 0;
+  for (int t = 0; t < num_tiles(); ++t) {
+    DecoderBuffer tile_buffer;
+    const uint64_t remaining_size = buffer->remaining_size();
+    if (tiles_[t].data_size > remaining_size ||
+        tiles_[t].data_offset > remaining_size - tiles_[t].data_size)
+      return Status(Status::IO_ERROR, "Missing tile data.");
+    tile_buffer.Init(buffer->data_head() + tiles_[t].data_offset,
+                     tiles_[t].data_size);
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> tile_pc,
+                           DecodeTile(t, &tile_buffer));
+    if (t == 0) {
+      // All tiles have the same attributes.
+      for (int a = 0; a < tile_pc->num_attributes(); ++a) {
+        const PointAttribute *const att = tile_pc->attribute(a);
+        GeometryAttribute va;
+        va.Init(att->attribute_type(), nullptr, att->num_components(),
+                att->data_type(), att->normalized(),
+                att->num_components() * DataTypeLength(att->data_type()), 0);
+        out_pc->AddAttribute(va, true, num_points);
+      }
+    }
+    if (tile_pc->num_attributes() != out_pc->num_attributes())
+      return Status(Status::ERROR, "Tiles have different attributes.");
+    for (int a = 0; a < tile_pc->num_attributes(); ++a) {
+      const PointAttribute *const src_att = tile_pc->attribute(a);
+      PointAttribute *const dst_att = out_pc->attribute(a);
+      if (src_att->byte_stride() != dst_att->byte_stride())
+        return Status(Status::ERROR, "Tiles have different attributes.");
+      for (PointIndex i(0); i < tile_pc->num_points(); ++i) {
+        dst_att->SetAttributeValue(
+            AttributeValueIndex(first_point + i.value()),
+            src_att->GetAddressOfMappedIndex(i));
+      }
+    }
+    first_point += tile_pc->num_points();
+  }
+  buffer->Advance(buffer->remaining_size());
+  return out_pc;
+}
+
+float TiledPointCloudDecoder::DequantizeCoordinate(
+    int component, uint32_t quantized_value) const {
+  return grid_origin_[component] +
+         dequantizer_(static_cast<int32_t>(quantized_value));
+}
+
+}  // namespace draco
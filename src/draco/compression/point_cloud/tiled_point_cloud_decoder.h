@@ -0,0 +1,97 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_DECODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/point_cloud/tiled_point_cloud_shared.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/core/statusor.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Decoder of point clouds encoded by the TiledPointCloudEncoder. The tile
+// index is decoded first and the individual tiles can then be decoded on
+// demand, e.g., after fetching only the byte ranges of the visible tiles.
+//
+// Usage:
+//   TiledPointCloudDecoder decoder;
+//   DRACO_RETURN_IF_ERROR(decoder.DecodeIndex(&header_buffer));
+//   for (int tile_id : decoder.FindTiles(view_min, view_max)) {
+//     // Data of the tile are stored at bytes
+//     // <decoder.data_offset() + tile.data_offset,
+//     //  decoder.data_offset() + tile.data_offset + tile.data_size).
+//     DecoderBuffer tile_buffer;
+//     ...
+//     DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloud> pc,
+//                            decoder.DecodeTile(tile_id, &tile_buffer));
+//   }
+class TiledPointCloudDecoder {
+ public:
+  TiledPointCloudDecoder();
+
+  // Decodes the header and the tile index. |buffer| must point to the start
+  // of the encoded data but it doesn't need to contain the data of the tiles.
+  Status DecodeIndex(DecoderBuffer *buffer);
+
+  int num_tiles() const { return tiles_.size(); }
+  const PointCloudTile &tile(int tile_id) const { return tiles_[tile_id]; }
+
+  // Number of bytes occupied by the header and the tile index, i.e., the
+  // offset of the data of the first tile in the encoded data.
+  int64_t data_offset() const { return data_offset_; }
+
+  // Returns the bounding box of a tile in the coordinates of the input point
+  // cloud.
+  void GetTileBounds(int tile_id, float *out_min, float *out_max) const;
+
+  // Returns ids of all tiles whose bounding boxes intersect the box
+  // <box_min, box_max>.
+  std::vector<int> FindTiles(const float *box_min, const float *box_max) const;
+
+  // Decodes a single tile. |tile_buffer| must contain the data of the tile
+  // |tile_id|. The positions of the returned point cloud are dequantized into
+  // the coordinate system of the input point cloud.
+  StatusOr<std::unique_ptr<PointCloud>> DecodeTile(
+      int tile_id, DecoderBuffer *tile_buffer) const;
+
+  // Decodes all tiles into a single point cloud. |buffer| must contain all of
+  // the encoded data.
+  StatusOr<std::unique_ptr<PointCloud>> DecodePointCloud(
+      DecoderBuffer *buffer);
+
+  int quantization_bits() const { return quantization_bits_; }
+  const float *grid_origin() const { return grid_origin_; }
+  float grid_range() const { return grid_range_; }
+
+ private:
+  float DequantizeCoordinate(int component, uint32_t quantized_value) const;
+
+  int quantization_bits_;
+  float grid_origin_[3];
+  float grid_range_;
+  // Dequantizer of the positions, initialized from the decoded header.
+  Dequantizer dequantizer_;
+  int64_t data_offset_;
+  std::vector<PointCloudTile> tiles_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_DECODER_H_
@@ -0,0 +1,438 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/point_cloud/tiled_point_cloud_encoder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "draco/core/quantization_utils.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+// Temporary file storing point records of a fixed size. The file is deleted
+// automatically when the instance is destroyed.
+class TiledPointCloudEncoder::PointRecordFile {
+ public:
+  ~PointRecordFile() {
+    if (file_ != nullptr)
+      fclose(file_);
+  }
+
+  // Returns nullptr when the temporary file can't be created.
+  static std::unique_ptr<PointRecordFile> Create(int record_size) {
+    std::unique_ptr<PointRecordFile> file(new PointRecordFile(record_size));
+    if (file->file_ == nullptr)
+      return nullptr;
+    return file;
+  }
+
+  int64_t num_records() const { return num_records_; }
+
+  bool Append(const uint8_t *records, int64_t num_records) {
+    if (num_records == 0)
+      return true;
+    if (fwrite(records, record_size_, num_records, file_) !=
+        static_cast<size_t>(num_records))
+      return false;
+    num_records_ += num_records;
+    return true;
+  }
+
+  // Moves the read position to the first record.
+  bool Rewind() { return fseek(file_, 0, SEEK_SET) == 0; }
+
+  // Reads up to |max_records| records into |out_records|. Returns the number
+  // of read records.
+  int64_t Read(uint8_t *out_records, int64_t max_records) {
+    return fread(out_records, record_size_, max_records, file_);
+  }
+
+ private:
+  explicit PointRecordFile(int record_size)
+      : file_(std::tmpfile()), record_size_(record_size), num_records_(0) {}
+
+  FILE *file_;
+  int record_size_;
+  int64_t num_records_;
+};
+
+namespace {
+
+// Number of point records processed at once when the records are streamed
+// between temporary files.
+constexpr int64_t kRecordChunkSize = 1 << 14;
+constexpr int kPositionSize = 3 * sizeof(float);
+
+}  // namespace
+
+TiledPointCloudEncoder::TiledPointCloudEncoder()
+    : quantization_bits_(14),
+      explicit_grid_(false),
+      grid_range_(0.f),
+      max_points_per_tile_(1 << 16),
+      record_size_(0) {
+  std::fill(grid_origin_, grid_origin_ + 3, 0.f);
+  ResetInput();
+}
+
+TiledPointCloudEncoder::~TiledPointCloudEncoder() = default;
+
+void TiledPointCloudEncoder::SetPositionQuantizationBits(
+    int quantization_bits) {
+  quantization_bits_ = quantization_bits;
+}
+
+void TiledPointCloudEncoder::SetPositionQuantizationGrid(const float *origin,
+                                                         float range) {
+  explicit_grid_ = true;
+  std::copy(origin, origin + 3, grid_origin_);
+  grid_range_ = range;
+}
+
+void TiledPointCloudEncoder::SetMaxPointsPerTile(int max_points_per_tile) {
+  max_points_per_tile_ = max_points_per_tile;
+}
+
+Status TiledPointCloudEncoder::AddPoints(const PointCloud &pc) {
+  const PointAttribute *const pos_att =
+      pc.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || pos_att->data_type() != DT_FLOAT32 ||
+      pos_att->num_components() != 3)
+    return Status(Status::INVALID_PARAMETER,
+                  "Point cloud must contain float32 positions.");
+  std::vector<const PointAttribute *> attributes;
+  std::vector<AttributeFormat> formats;
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const PointAttribute *const att = pc.attribute(i);
+    if (att == pos_att)
+      continue;
+    AttributeFormat format;
+    format.attribute_type = att->attribute_type();
+    format.num_components = att->num_components();
+    format.data_type = att->data_type();
+    format.normalized = att->normalized();
+    format.num_bytes = att->num_components() * DataTypeLength(att->data_type());
+    formats.push_back(format);
+    attributes.push_back(att);
+  }
+
+  if (input_points_ == nullptr) {
+    attribute_formats_ = formats;
+    record_size_ = kPositionSize;
+    for (const AttributeFormat &format : attribute_formats_) {
+      record_size_ += format.num_bytes;
+    }
+    input_points_ = PointRecordFile::Create(record_size_);
+    if (input_points_ == nullptr)
+      return Status(Status::IO_ERROR, "Failed to create a temporary file.");
+  } else {
+    bool formats_match = formats.size() == attribute_formats_.size();
+    for (size_t i = 0; formats_match && i < formats.size(); ++i) {
+      const AttributeFormat &a = formats[i];
+      const AttributeFormat &b = attribute_formats_[i];
+      formats_match = a.attribute_type == b.attribute_type &&
+                      a.num_components == b.num_components &&
+                      a.data_type == b.data_type &&
+                      a.normalized == b.normalized;
+    }
+    if (!formats_match)
+      return Status(Status::INVALID_PARAMETER,
+                    "All point batches must have the same attributes.");
+  }
+
+  // Convert the points into records and store them in the temporary file.
+  std::vector<uint8_t> records(kRecordChunkSize * record_size_);
+  for (PointIndex::ValueType first_point = 0; first_point < pc.num_points();
+       first_point += kRecordChunkSize) {
+    const PointIndex::ValueType num_chunk_points =
+        std::min<int64_t>(kRecordChunkSize, pc.num_points() - first_point);
+    uint8_t *record = records.data();
+    for (PointIndex::ValueType j = 0; j < num_chunk_points; ++j) {
+      const PointIndex i(first_point + j);
+      float pos[3];
+      pos_att->GetMappedValue(i, pos);
+      for (int c = 0; c < 3; ++c) {
+        min_position_[c] = std::min(min_position_[c], pos[c]);
+        max_position_[c] = std::max(max_position_[c], pos[c]);
+      }
+      memcpy(record, pos, kPositionSize);
+      record += kPositionSize;
+      for (size_t a = 0; a < attributes.size(); ++a) {
+        memcpy(record, attributes[a]->GetAddressOfMappedIndex(i),
+               attribute_formats_[a].num_bytes);
+        record += attribute_formats_[a].num_bytes;
+      }
+    }
+    if (!input_points_->Append(records.data(), num_chunk_points))
+      return Status(Status::IO_ERROR, "Failed to write a temporary file.");
+  }
+  return OkStatus();
+}
+
+Status TiledPointCloudEncoder::Finish(EncoderBuffer *out_buffer) {
+  if (quantization_bits_ < 1 || quantization_bits_ > 30)
+    return Status(Status::INVALID_PARAMETER, "Invalid quantization bits.");
+  if (max_points_per_tile_ < 1)
+    return Status(Status::INVALID_PARAMETER, "Invalid maximum tile size.");
+  // Numbers of points are stored as uint32_t in the tile index and the sum
+  // of all of them must not overflow when the tiles are decoded together.
+  if (input_points_ != nullptr &&
+      input_points_->num_records() > std::numeric_limits<uint32_t>::max())
+    return Status(Status::INVALID_PARAMETER, "Too many points.");
+  tiles_.clear();
+  // The tiles are encoded directly into |out_buffer|. The header with the tile
+  // index is inserted in front of them once the sizes of all tiles are known.
+  const size_t data_start = out_buffer->size();
+  const Status status = EncodeTiles(data_start, out_buffer);
+  if (!status.ok()) {
+    out_buffer->Resize(data_start);
+    return status;
+  }
+
+  EncoderBuffer header;
+  header.Encode(kTiledPointCloudMagic, kTiledPointCloudMagicLength);
+  header.Encode(kTiledPointCloudVersionMajor);
+  header.Encode(kTiledPointCloudVersionMinor);
+  header.Encode(static_cast<uint8_t>(quantization_bits_));
+  header.Encode(grid_origin_, sizeof(grid_origin_));
+  header.Encode(grid_range_);
+  EncodeVarint(static_cast<uint32_t>(tiles_.size()), &header);
+  for (const PointCloudTile &tile : tiles_) {
+    EncodeVarint(tile.num_points, &header);
+    EncodeVarint(tile.data_offset, &header);
+    EncodeVarint(tile.data_size, &header);
+    for (int c = 0; c < 3; ++c) {
+      EncodeVarint(tile.quantized_min[c], &header);
+    }
+    for (int c = 0; c < 3; ++c) {
+      EncodeVarint(tile.quantized_max[c], &header);
+    }
+  }
+  std::vector<char> *const data = out_buffer->buffer();
+  data->insert(data->begin() + data_start, header.data(),
+               header.data() + header.size());
+  ResetInput();
+  return OkStatus();
+}
+
+Status TiledPointCloudEncoder::EncodePointCloudToBuffer(
+    const PointCloud &pc, EncoderBuffer *out_buffer) {
+  ResetInput();
+  DRACO_RETURN_IF_ERROR(AddPoints(pc));
+  return Finish(out_buffer);
+}
+
+Status TiledPointCloudEncoder::QuantizePoints(
+    std::unique_ptr<PointRecordFile> *out_points) {
+  *out_points = PointRecordFile::Create(record_size_);
+  if (*out_points == nullptr || !input_points_->Rewind())
+    return Status(Status::IO_ERROR, "Failed to create a temporary file.");
+  const uint32_t max_quantized_value = (1u << quantization_bits_) - 1;
+  Quantizer quantizer;
+  quantizer.Init(grid_range_, max_quantized_value);
+  std::vector<uint8_t> records(kRecordChunkSize * record_size_);
+  int64_t num_records;
+  while ((num_records = input_points_->Read(records.data(),
+                                            kRecordChunkSize)) > 0) {
+    for (int64_t i = 0; i < num_records; ++i) {
+      uint8_t *const record = records.data() + i * record_size_;
+      float pos[3];
+      uint32_t quantized_pos[3];
+      memcpy(pos, record, kPositionSize);
+      for (int c = 0; c < 3; ++c) {
+        const int32_t q = quantizer(pos[c] - grid_origin_[c]);
+        quantized_pos[c] = static_cast<uint32_t>(
+            std::max<int32_t>(0, std::min<int32_t>(q, max_quantized_value)));
+      }
+      memcpy(record, quantized_pos, kPositionSize);
+    }
+    if (!(*out_points)->Append(records.data(), num_records))
+      return Status(Status::IO_ERROR, "Failed to write a temporary file.");
+  }
+  if ((*out_points)->num_records() != input_points_->num_records())
+    return Status(Status::IO_ERROR, "Failed to read a temporary file.");
+  return OkStatus();
+}
+
+Status TiledPointCloudEncoder::SplitPoints(
+    PointRecordFile *points, int level_bits,
+    std::unique_ptr<PointRecordFile> *out_children) {
+  for (int i = 0; i < 8; ++i) {
+    out_children[i] = PointRecordFile::Create(record_size_);
+    if (out_children[i] == nullptr)
+      return Status(Status::IO_ERROR, "Failed to create a temporary file.");
+  }
+  if (!points->Rewind())
+    return Status(Status::IO_ERROR, "Failed to read a temporary file.");
+  const int shift = level_bits - 1;
+  std::vector<uint8_t> records(kRecordChunkSize * record_size_);
+  std::vector<uint8_t> child_records[8];
+  int64_t num_records;
+  int64_t num_split_records = 0;
+  while ((num_records = points->Read(records.data(), kRecordChunkSize)) > 0) {
+    for (int64_t i = 0; i < num_records; ++i) {
+      const uint8_t *const record = records.data() + i * record_size_;
+      uint32_t quantized_pos[3];
+      memcpy(quantized_pos, record, kPositionSize);
+      const int child = ((quantized_pos[0] >> shift) & 1) |
+                        (((quantized_pos[1] >> shift) & 1) << 1) |
+                        (((quantized_pos[2] >> shift) & 1) << 2);
+      child_records[child].insert(child_records[child].end(), record,
+                                  record + record_size_);
+    }
+    for (int c = 0; c < 8; ++c) {
+      if (!out_children[c]->Append(child_records[c].data(),
+                                   child_records[c].size() / record_size_))
+        return Status(Status::IO_ERROR, "Failed to write a temporary file.");
+      child_records[c].clear();
+    }
+    num_split_records += num_records;
+  }
+  if (num_split_records != points->num_records())
+    return Status(Status::IO_ERROR, "Failed to read a temporary file.");
+  return OkStatus();
+}
+
+Status TiledPointCloudEncoder::EncodeTiles(size_t data_start,
+                                          EncoderBuffer *out_buffer) {
+  if (input_points_ == nullptr || input_points_->num_records() == 0)
+    return OkStatus();
+  if (!explicit_grid_) {
+    // Use the bounding box of all points (same as the quantization transform
+    // of attributes).
+    grid_range_ = 0.f;
+    for (int c = 0; c < 3; ++c) {
+      grid_origin_[c] = min_position_[c];
+      grid_range_ = std::max(grid_range_, max_position_[c] - min_position_[c]);
+    }
+  }
+  if (grid_range_ <= 0.f)
+    grid_range_ = 1.f;
+
+  // Build the octree in depth first order. Nodes are stored in separate
+  // temporary files and each node is split by streaming its points into the
+  // files of its children.
+  struct OctreeNode {
+    std::unique_ptr<PointRecordFile> points;
+    // Number of low bits of the quantized coordinates that are not
+    // determined by the location of the node.
+    int level_bits;
+  };
+  std::vector<OctreeNode> stack(1);
+  DRACO_RETURN_IF_ERROR(QuantizePoints(&stack[0].points));
+  stack[0].level_bits = quantization_bits_;
+  input_points_ = nullptr;
+  while (!stack.empty()) {
+    OctreeNode node = std::move(stack.back());
+    stack.pop_back();
+    if (node.points->num_records() <= max_points_per_tile_ ||
+        node.level_bits == 0) {
+      DRACO_RETURN_IF_ERROR(
+          EncodeTile(node.points.get(), data_start, out_buffer));
+      continue;
+    }
+    std::unique_ptr<PointRecordFile> children[8];
+    DRACO_RETURN_IF_ERROR(
+        SplitPoints(node.points.get(), node.level_bits, children));
+    node.points = nullptr;
+    // Push the children in reverse order so they are encoded in Morton order.
+    for (int i = 7; i >= 0; --i) {
+      if (children[i]->num_records() == 0)
+        continue;
+      stack.push_back(OctreeNode());
+      stack.back().points = std::move(children[i]);
+      stack.back().level_bits = node.level_bits - 1;
+    }
+  }
+  return OkStatus();
+}
+
+Status TiledPointCloudEncoder::EncodeTile(PointRecordFile *points,
+                                         size_t data_start,
+                                         EncoderBuffer *out_buffer) {
+  const int64_t num_points = points->num_records();
+  std::vector<uint8_t> records(num_points * record_size_);
+  if (!points->Rewind() ||
+      points->Read(records.data(), num_points) != num_points)
+    return Status(Status::IO_ERROR, "Failed to read a temporary file.");
+
+  PointCloudTile tile;
+  tile.num_points = static_cast<uint32_t>(num_points);
+  for (int c = 0; c < 3; ++c) {
+    tile.quantized_min[c] = std::numeric_limits<uint32_t>::max();
+    tile.quantized_max[c] = 0;
+  }
+  for (int64_t i = 0; i < num_points; ++i) {
+    uint32_t quantized_pos[3];
+    memcpy(quantized_pos, records.data() + i * record_size_, kPositionSize);
+    for (int c = 0; c < 3; ++c) {
+      tile.quantized_min[c] = std::min(tile.quantized_min[c], quantized_pos[c]);
+      tile.quantized_max[c] = std::max(tile.quantized_max[c], quantized_pos[c]);
+    }
+  }
+
+  // Store the positions relative to the tile bounds. Smaller values are
+  // encoded more efficiently by the kD-tree encoder.
+  PointCloud pc;
+  pc.set_num_points(tile.num_points);
+  GeometryAttribute va;
+  va.Init(GeometryAttribute::POSITION, nullptr, 3, DT_UINT32, false,
+          kPositionSize, 0);
+  const int pos_att_id = pc.AddAttribute(va, true, tile.num_points);
+  std::vector<int> att_ids;
+  for (const AttributeFormat &format : attribute_formats_) {
+    va.Init(format.attribute_type, nullptr, format.num_components,
+            format.data_type, format.normalized, format.num_bytes, 0);
+    att_ids.push_back(pc.AddAttribute(va, true, tile.num_points));
+  }
+  for (int64_t i = 0; i < num_points; ++i) {
+    const uint8_t *record = records.data() + i * record_size_;
+    const AttributeValueIndex avi(static_cast<uint32_t>(i));
+    uint32_t quantized_pos[3];
+    memcpy(quantized_pos, record, kPositionSize);
+    for (int c = 0; c < 3; ++c) {
+      quantized_pos[c] -= tile.quantized_min[c];
+    }
+    pc.attribute(pos_att_id)->SetAttributeValue(avi, quantized_pos);
+    record += kPositionSize;
+    for (size_t a = 0; a < att_ids.size(); ++a) {
+      pc.attribute(att_ids[a])->SetAttributeValue(avi, record);
+      record += attribute_formats_[a].num_bytes;
+    }
+  }
+
+  const size_t tile_start = out_buffer->size();
+  DRACO_RETURN_IF_ERROR(
+      tile_encoder_.EncodePointCloudToBuffer(pc, out_buffer));
+  tile.data_offset = tile_start - data_start;
+  tile.data_size = out_buffer->size() - tile_start;
+  tiles_.push_back(tile);
+  return OkStatus();
+}
+
+void TiledPointCloudEncoder::ResetInput() {
+  attribute_formats_.clear();
+  record_size_ = 0;
+  input_points_ = nullptr;
+  for (int c = 0; c < 3; ++c) {
+    min_position_[c] = std::numeric_limits<float>::max();
+    max_position_[c] = std::numeric_limits<float>::lowest();
+  }
+}
+
+}  // namespace draco
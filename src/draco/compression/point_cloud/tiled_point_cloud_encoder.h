@@ -0,0 +1,134 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_ENCODER_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_ENCODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/encode.h"
+#include "draco/compression/point_cloud/tiled_point_cloud_shared.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Encoder that splits a point cloud into spatial tiles that can be decoded
+// independently (see TiledPointCloudDecoder). The point cloud is partitioned
+// by an octree until each tile contains at most max_points_per_tile() points.
+// Positions of all tiles are quantized on a shared grid so the decoded tiles
+// fit together without cracks. Each tile is encoded as a separate Draco point
+// cloud and a tile index stores bounds, byte offset and size, and number of
+// points of each tile, so clients can download and decode only the tiles they
+// need.
+//
+// The input points can be provided in batches using AddPoints(). The points
+// are stored in temporary files until Finish() is called, which keeps the
+// memory usage bounded by the batch and tile sizes rather than by the size of
+// the whole point cloud.
+//
+// Usage:
+//   TiledPointCloudEncoder encoder;
+//   encoder.SetPositionQuantizationBits(16);
+//   while (...) {
+//     DRACO_RETURN_IF_ERROR(encoder.AddPoints(batch));
+//   }
+//   EncoderBuffer buffer;
+//   DRACO_RETURN_IF_ERROR(encoder.Finish(&buffer));
+class TiledPointCloudEncoder {
+ public:
+  TiledPointCloudEncoder();
+  ~TiledPointCloudEncoder();
+
+  // Sets the number of quantization bits of the shared position grid.
+  // Default: [14].
+  void SetPositionQuantizationBits(int quantization_bits);
+
+  // Sets the shared position grid explicitly. All input positions should be
+  // within <origin, origin + range>, positions outside of the grid are
+  // clamped. By default, the grid is computed from the bounds of all points
+  // added to the encoder.
+  void SetPositionQuantizationGrid(const float *origin, float range);
+
+  // Sets the maximum number of points stored in a single tile. Tiles can
+  // contain more points only when all of them share the same quantized
+  // position. Default: [65536].
+  void SetMaxPointsPerTile(int max_points_per_tile);
+
+  // Returns the encoder used to compress the individual tiles. It can be used
+  // to set the speed options or the quantization of non-position attributes.
+  Encoder *tile_encoder() { return &tile_encoder_; }
+
+  // Adds all points of |pc| to the encoded point cloud. The point cloud must
+  // contain a float32 position attribute with three components. All batches
+  // must have the same attributes.
+  Status AddPoints(const PointCloud &pc);
+
+  // Partitions and encodes all added points into |out_buffer|. The encoder can
+  // be used to encode another point cloud afterwards.
+  Status Finish(EncoderBuffer *out_buffer);
+
+  // Encodes a point cloud stored in memory. Equivalent to AddPoints(pc)
+  // followed by Finish(out_buffer).
+  Status EncodePointCloudToBuffer(const PointCloud &pc,
+                                  EncoderBuffer *out_buffer);
+
+ private:
+  // Temporary file storing the point records (see attribute_formats_).
+  class PointRecordFile;
+
+  // Format of a non-position attribute.
+  struct AttributeFormat {
+    GeometryAttribute::Type attribute_type;
+    int8_t num_components;
+    DataType data_type;
+    bool normalized;
+    int num_bytes;
+  };
+
+  // Converts the input points into points on the quantization grid.
+  Status QuantizePoints(std::unique_ptr<PointRecordFile> *out_points);
+  // Splits points of an octree node into the eight child nodes.
+  Status SplitPoints(PointRecordFile *points, int level_bits,
+                     std::unique_ptr<PointRecordFile> *out_children);
+  // Partitions the input points into tiles and appends the encoded tiles to
+  // |out_buffer|. Offsets of the tiles are relative to |data_start|.
+  Status EncodeTiles(size_t data_start, EncoderBuffer *out_buffer);
+  Status EncodeTile(PointRecordFile *points, size_t data_start,
+                    EncoderBuffer *out_buffer);
+  void ResetInput();
+
+  Encoder tile_encoder_;
+  int quantization_bits_;
+  bool explicit_grid_;
+  float grid_origin_[3];
+  float grid_range_;
+  int max_points_per_tile_;
+
+  // Formats of attributes stored in the input point records. Each record
+  // starts with three position coordinates followed by values of all other
+  // attributes.
+  std::vector<AttributeFormat> attribute_formats_;
+  int record_size_;
+  std::unique_ptr<PointRecordFile> input_points_;
+  float min_position_[3];
+  float max_position_[3];
+  std::vector<PointCloudTile> tiles_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_ENCODER_H_
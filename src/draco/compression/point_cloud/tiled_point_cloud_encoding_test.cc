@@ -0,0 +1,269 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "draco/compression/point_cloud/tiled_point_cloud_decoder.h"
+#include "draco/compression/point_cloud/tiled_point_cloud_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/quantization_utils.h"
+#include "draco/point_cloud/point_cloud_builder.h"
+
+namespace draco {
+
+class TiledPointCloudEncodingTest : public ::testing::Test {
+ protected:
+  // Position followed by a color.
+  typedef std::array<float, 7> PointValue;
+
+  // Creates a point cloud with |num_points| random points. The points are
+  // clustered so the octree is not balanced.
+  std::unique_ptr<PointCloud> CreatePointCloud(int num_points,
+                                               bool with_colors) const {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> distribution(-5.f, 10.f);
+    std::uniform_int_distribution<int> color_distribution(0, 255);
+    PointCloudBuilder builder;
+    builder.Start(num_points);
+    const int pos_att_id =
+        builder.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    const int color_att_id =
+        with_colors
+            ? builder.AddAttribute(GeometryAttribute::COLOR, 4, DT_UINT8)
+            : -1;
+    for (PointIndex i(0); i < num_points; ++i) {
+      float pos[3];
+      for (int c = 0; c < 3; ++c) {
+        pos[c] = distribution(generator);
+        if (i.value() % 3 == 0)
+          pos[c] *= 0.01f;
+      }
+      builder.SetAttributeValueForPoint(pos_att_id, i, pos);
+      if (with_colors) {
+        uint8_t color[4];
+        for (int c = 0; c < 4; ++c) {
+          color[c] = color_distribution(generator);
+        }
+        builder.SetAttributeValueForPoint(color_att_id, i, color);
+      }
+    }
+    return builder.Finalize(false);
+  }
+
+  // Returns sorted values of all points of |pc|. When |decoder| is set, the
+  // positions are quantized on the grid used by the decoder.
+  std::vector<PointValue> GetPointValues(
+      const PointCloud &pc, const TiledPointCloudDecoder *decoder) const {
+    Quantizer quantizer;
+    Dequantizer dequantizer;
+    if (decoder) {
+      const int32_t max_quantized_value =
+          (1 << decoder->quantization_bits()) - 1;
+      quantizer.Init(decoder->grid_range(), max_quantized_value);
+      dequantizer.Init(decoder->grid_range(), max_quantized_value);
+    }
+    const PointAttribute *const pos_att =
+        pc.GetNamedAttribute(GeometryAttribute::POSITION);
+    const PointAttribute *const color_att =
+        pc.GetNamedAttribute(GeometryAttribute::COLOR);
+    std::vector<PointValue> values(pc.num_points());
+    for (PointIndex i(0); i < pc.num_points(); ++i) {
+      PointValue &value = values[i.value()];
+      value.fill(0.f);
+      pos_att->GetMappedValue(i, &value[0]);
+      if (decoder) {
+        for (int c = 0; c < 3; ++c) {
+          const float origin = decoder->grid_origin()[c];
+          value[c] = origin + dequantizer(quantizer(value[c] - origin));
+        }
+      }
+      if (color_att) {
+        uint8_t color[4];
+        color_att->GetMappedValue(i, color);
+        std::copy(color, color + 4, value.begin() + 3);
+      }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+
+  void TestTiledEncoding(bool with_colors) {
+    const int num_points = 20000;
+    const int max_points_per_tile = 1000;
+    const std::unique_ptr<PointCloud> pc =
+        CreatePointCloud(num_points, with_colors);
+    TiledPointCloudEncoder encoder;
+    encoder.SetPositionQuantizationBits(12);
+    encoder.SetMaxPointsPerTile(max_points_per_tile);
+    EncoderBuffer buffer;
+    ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*pc, &buffer).ok());
+
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    TiledPointCloudDecoder decoder;
+    ASSERT_TRUE(decoder.DecodeIndex(&dec_buffer).ok());
+    ASSERT_GT(decoder.num_tiles(), num_points / max_points_per_tile);
+    int64_t total_points = 0;
+    for (int t = 0; t < decoder.num_tiles(); ++t) {
+      const PointCloudTile &tile = decoder.tile(t);
+      ASSERT_GT(tile.num_points, 0);
+      ASSERT_LE(tile.num_points, max_points_per_tile);
+      total_points += tile.num_points;
+
+      // Decode the tile on its own and check that it fits its bounds.
+      DecoderBuffer tile_buffer;
+      tile_buffer.Init(buffer.data() + decoder.data_offset() + tile.data_offset,
+                       tile.data_size);
+      auto tile_pc_or = decoder.DecodeTile(t, &tile_buffer);
+      ASSERT_TRUE(tile_pc_or.ok()) << tile_pc_or.status();
+      const std::unique_ptr<PointCloud> tile_pc =
+          std::move(tile_pc_or).value();
+      ASSERT_EQ(tile_pc->num_points(), tile.num_points);
+      float tile_min[3], tile_max[3];
+      decoder.GetTileBounds(t, tile_min, tile_max);
+      const PointAttribute *const pos_att =
+          tile_pc->GetNamedAttribute(GeometryAttribute::POSITION);
+      ASSERT_EQ(pos_att->data_type(), DT_FLOAT32);
+      for (PointIndex i(0); i < tile_pc->num_points(); ++i) {
+        float pos[3];
+        pos_att->GetMappedValue(i, pos);
+        for (int c = 0; c < 3; ++c) {
+          ASSERT_GE(pos[c], tile_min[c]);
+          ASSERT_LE(pos[c], tile_max[c]);
+        }
+      }
+    }
+    ASSERT_EQ(total_points, num_points);
+
+    // All decoded points must match the quantized input points.
+    dec_buffer.Init(buffer.data(), buffer.size());
+    TiledPointCloudDecoder full_decoder;
+    auto decoded_pc_or = full_decoder.DecodePointCloud(&dec_buffer);
+    ASSERT_TRUE(decoded_pc_or.ok()) << decoded_pc_or.status();
+    const std::unique_ptr<PointCloud> decoded_pc =
+        std::move(decoded_pc_or).value();
+    ASSERT_EQ(decoded_pc->num_attributes(), pc->num_attributes());
+    ASSERT_EQ(GetPointValues(*pc, &full_decoder),
+              GetPointValues(*decoded_pc, nullptr));
+  }
+};
+
+TEST_F(TiledPointCloudEncodingTest, TestPositions) { TestTiledEncoding(false); }
+
+TEST_F(TiledPointCloudEncodingTest, TestPositionsAndColors) {
+  TestTiledEncoding(true);
+}
+
+TEST_F(TiledPointCloudEncodingTest, TestBatches) {
+  // Encoding of the point cloud in batches must produce the same data as
+  // encoding of the whole point cloud at once.
+  const int num_points = 5000;
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(num_points, true);
+  TiledPointCloudEncoder encoder;
+  encoder.SetMaxPointsPerTile(500);
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*pc, &buffer).ok());
+
+  const int batch_size = 700;
+  for (int first_point = 0; first_point < num_points;
+       first_point += batch_size) {
+    const int num_batch_points = std::min(batch_size, num_points - first_point);
+    PointCloudBuilder builder;
+    builder.Start(num_batch_points);
+    for (int a = 0; a < pc->num_attributes(); ++a) {
+      const PointAttribute *const att = pc->attribute(a);
+      builder.AddAttribute(att->attribute_type(), att->num_components(),
+                           att->data_type());
+      for (PointIndex i(0); i < num_batch_points; ++i) {
+        builder.SetAttributeValueForPoint(
+            a, i, att->GetAddressOfMappedIndex(i + first_point));
+      }
+    }
+    const std::unique_ptr<PointCloud> batch = builder.Finalize(false);
+    ASSERT_TRUE(encoder.AddPoints(*batch).ok());
+  }
+  EncoderBuffer batch_buffer;
+  ASSERT_TRUE(encoder.Finish(&batch_buffer).ok());
+  ASSERT_EQ(buffer.size(), batch_buffer.size());
+  ASSERT_TRUE(std::equal(buffer.data(), buffer.data() + buffer.size(),
+                         batch_buffer.data()));
+}
+
+TEST_F(TiledPointCloudEncodingTest, TestFindTiles) {
+  const std::unique_ptr<PointCloud> pc = CreatePointCloud(10000, false);
+  TiledPointCloudEncoder encoder;
+  encoder.SetMaxPointsPerTile(200);
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*pc, &buffer).ok());
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  TiledPointCloudDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeIndex(&dec_buffer).ok());
+
+  // Decode only tiles within a box and verify that no point within the box
+  // is missing.
+  const float box_min[3] = {2.f, -1.f, 0.f};
+  const float box_max[3] = {6.f, 4.f, 8.f};
+  const std::vector<int> tile_ids = decoder.FindTiles(box_min, box_max);
+  ASSERT_GT(tile_ids.size(), 0);
+  ASSERT_LT(tile_ids.size(), decoder.num_tiles());
+  const auto is_in_box = [&](const float *pos) {
+    for (int c = 0; c < 3; ++c) {
+      if (pos[c] < box_min[c] || pos[c] > box_max[c])
+        return false;
+    }
+    return true;
+  };
+  int num_decoded_points_in_box = 0;
+  for (const int tile_id : tile_ids) {
+    const PointCloudTile &tile = decoder.tile(tile_id);
+    DecoderBuffer tile_buffer;
+    tile_buffer.Init(buffer.data() + decoder.data_offset() + tile.data_offset,
+                     tile.data_size);
+    auto tile_pc_or = decoder.DecodeTile(tile_id, &tile_buffer);
+    ASSERT_TRUE(tile_pc_or.ok());
+    const PointCloud &tile_pc = *tile_pc_or.value();
+    for (PointIndex i(0); i < tile_pc.num_points(); ++i) {
+      float pos[3];
+      tile_pc.attribute(0)->GetMappedValue(i, pos);
+      if (is_in_box(pos))
+        ++num_decoded_points_in_box;
+    }
+  }
+  int num_points_in_box = 0;
+  for (const PointValue &value : GetPointValues(*pc, &decoder)) {
+    if (is_in_box(&value[0]))
+      ++num_points_in_box;
+  }
+  ASSERT_GT(num_points_in_box, 0);
+  ASSERT_EQ(num_decoded_points_in_box, num_points_in_box);
+}
+
+TEST_F(TiledPointCloudEncodingTest, TestInvalidInput) {
+  TiledPointCloudEncoder encoder;
+  PointCloudBuilder builder;
+  builder.Start(10);
+  builder.AddAttribute(GeometryAttribute::POSITION, 2, DT_FLOAT32);
+  EXPECT_FALSE(encoder.AddPoints(*builder.Finalize(false)).ok());
+
+  const uint8_t data[] = "DRACO";
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(reinterpret_cast<const char *>(data), sizeof(data));
+  TiledPointCloudDecoder decoder;
+  EXPECT_FALSE(decoder.DecodeIndex(&dec_buffer).ok());
+}
+
+}  // namespace draco
@@ -0,0 +1,62 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_SHARED_H_
+#define DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_SHARED_H_
+
+#include <stdint.h>
+
+// Definitions shared by the TiledPointCloudEncoder and the
+// TiledPointCloudDecoder.
+//
+// Layout of the encoded data:
+//   Header:
+//     char[10]   "DRACOTILES"
+//     uint8_t    Major version.
+//     uint8_t    Minor version.
+//     uint8_t    Number of quantization bits of the position grid.
+//     float[3]   Origin of the position grid.
+//     float      Range of the position grid.
+//     varint     Number of tiles.
+//   Tile index (for each tile):
+//     varint     Number of points.
+//     varint     Byte offset of the tile data from the end of the index.
+//     varint     Byte size of the tile data.
+//     varint[3]  Minimum quantized position of the tile points.
+//     varint[3]  Maximum quantized position of the tile points.
+//   Tile data:
+//     Independent Draco point clouds. The positions are stored as uint32
+//     values relative to the minimum quantized position of the tile.
+
+namespace draco {
+
+static const char kTiledPointCloudMagic[] = "DRACOTILES";
+static const int kTiledPointCloudMagicLength = 10;
+static const uint8_t kTiledPointCloudVersionMajor = 1;
+static const uint8_t kTiledPointCloudVersionMinor = 0;
+
+// Description of a single tile stored in the tile index.
+struct PointCloudTile {
+  uint32_t num_points;
+  // Location of the encoded tile relative to the end of the tile index.
+  uint64_t data_offset;
+  uint64_t data_size;
+  // Bounding box of the tile points on the quantization grid.
+  uint32_t quantized_min[3];
+  uint32_t quantized_max[3];
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_POINT_CLOUD_TILED_POINT_CLOUD_SHARED_H_
@@ -338,60 +338,89 @@ struct rans_sym {
 // The max number of precision bits is currently 19. The actual number of
 // symbols in the input alphabet should be (much) smaller than that, otherwise
 // the compression rate may suffer.
-template <int rans_precision_bits_t>
+// When |num_states_t| is larger than one, the encoder uses interleaved rANS:
+// consecutive symbols are coded with different states that share the same
+// output buffer, which allows the decoder to overlap the decoding of several
+// symbols. The i-th decoded symbol is always coded by the state i %
+// |num_states_t|. With a single state the output is the same as the output of
+// the non-interleaved coder.
+template <int rans_precision_bits_t, int num_states_t = 1>
 class RAnsEncoder {
  public:
-  RAnsEncoder() {}
+  RAnsEncoder() : buf_(nullptr), buf_offset_(0), next_state_(0) {}
 
   // Provides the input buffer where the data is going to be stored.
   inline void write_init(uint8_t *const buf) {
-    ans_.buf = buf;
-    ans_.buf_offset = 0;
-    ans_.state = l_rans_base;
+    buf_ = buf;
+    buf_offset_ = 0;
+    for (int i = 0; i < num_states_t; ++i) {
+      states_[i] = l_rans_base;
+    }
+    next_state_ = 0;
   }
 
   // Needs to be called after all symbols are encoded.
   inline int write_end() {
-    uint32_t state;
-    DCHECK_GE(ans_.state, l_rans_base);
-    DCHECK_LT(ans_.state, l_rans_base * io_base);
-    state = ans_.state - l_rans_base;
-    if (state < (1 << 6)) {
-      ans_.buf[ans_.buf_offset] = (0x00 << 6) + state;
-      return ans_.buf_offset + 1;
-    } else if (state < (1 << 14)) {
-      mem_put_le16(ans_.buf + ans_.buf_offset, (0x01 << 14) + state);
-      return ans_.buf_offset + 2;
-    } else if (state < (1 << 22)) {
-      mem_put_le24(ans_.buf + ans_.buf_offset, (0x02 << 22) + state);
-      return ans_.buf_offset + 3;
-    } else if (state < (1 << 30)) {
-      mem_put_le32(ans_.buf + ans_.buf_offset, (0x03 << 30) + state);
-      return ans_.buf_offset + 4;
-    } else {
-      DCHECK(0 && "State is too large to be serialized");
-      return ans_.buf_offset;
+    // The symbols are encoded in the reverse order so the last used state
+    // codes the first decoded symbol. The states are stored such that the
+    // decoder reads them in the order in which it uses them.
+    for (int i = num_states_t - 1; i >= 0; --i) {
+      const int state_id =
+          (next_state_ + 2 * num_states_t - 1 - i) % num_states_t;
+      if (!write_state(states_[state_id]))
+        return buf_offset_;
     }
+    return buf_offset_;
   }
 
   // rANS with normalization
   // sym->prob takes the place of l_s from the paper
   // rans_precision is m
   inline void rans_write(const struct rans_sym *const sym) {
+    uint32_t &state = states_[next_state_];
+    next_state_ = (next_state_ + 1) % num_states_t;
     const uint32_t p = sym->prob;
-    while (ans_.state >= l_rans_base / rans_precision * io_base * p) {
-      ans_.buf[ans_.buf_offset++] = ans_.state % io_base;
-      ans_.state /= io_base;
+    while (state >= l_rans_base / rans_precision * io_base * p) {
+      buf_[buf_offset_++] = state % io_base;
+      state /= io_base;
     }
     // TODO(ostava): The division and multiplication should be optimized.
-    ans_.state =
-        (ans_.state / p) * rans_precision + ans_.state % p + sym->cum_prob;
+    state = (state / p) * rans_precision + state % p + sym->cum_prob;
   }
 
  private:
+  // Serializes |state| at the current buffer offset. Returns false if the
+  // state is out of the valid range.
+  inline bool write_state(uint32_t state) {
+    DCHECK_GE(state, l_rans_base);
+    DCHECK_LT(state, l_rans_base * io_base);
+    state -= l_rans_base;
+    if (state < (1 << 6)) {
+      buf_[buf_offset_] = (0x00 << 6) + state;
+      buf_offset_ += 1;
+    } else if (state < (1 << 14)) {
+      mem_put_le16(buf_ + buf_offset_, (0x01 << 14) + state);
+      buf_offset_ += 2;
+    } else if (state < (1 << 22)) {
+      mem_put_le24(buf_ + buf_offset_, (0x02 << 22) + state);
+      buf_offset_ += 3;
+    } else if (state < (1 << 30)) {
+      mem_put_le32(buf_ + buf_offset_, (0x03 << 30) + state);
+      buf_offset_ += 4;
+    } else {
+      DCHECK(0 && "State is too large to be serialized");
+      return false;
+    }
+    return true;
+  }
+
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
-  AnsCoder ans_;
+  uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
+  // State used for the next encoded symbol.
+  int next_state_;
 };
 
 struct rans_dec_sym {
@@ -400,87 +429,132 @@ struct rans_dec_sym {
   uint32_t cum_prob;  // not-inclusive
 };
 
+// Entry of the packed rANS lookup table. Each slot of the table stores the
+// decoded symbol together with everything that is needed to update the state,
+// so decoding a symbol requires a single memory load.
+struct rans_packed_dec_sym {
+  uint32_t val;
+  uint16_t prob;
+  uint16_t offset;  // Offset of the slot from the start of the symbol range.
+};
+
+// Maximum number of precision bits for which the packed lookup table can be
+// used. Larger tables would not fit into the CPU caches.
+static constexpr int kRAnsMaxPackedLookupTablePrecisionBits = 14;
+
+// Types of lookup tables used by RAnsDecoder to find decoded symbols.
+enum RAnsLookupTableType {
+  // Each slot stores a symbol id that is used to look up the probability of
+  // the symbol in a separate table.
+  RANS_LOOKUP_TABLE_SYMBOL_ID = 0,
+  // Each slot stores a rans_packed_dec_sym entry. Used only for precisions up
+  // to kRAnsMaxPackedLookupTablePrecisionBits, larger precisions fall back to
+  // RANS_LOOKUP_TABLE_SYMBOL_ID.
+  RANS_LOOKUP_TABLE_PACKED,
+};
+
 // Class for performing rANS decoding using a desired number of precision bits.
-// The number of precision bits needs to be the same as with the RAnsEncoder
-// that was used to encode the input data.
-template <int rans_precision_bits_t>
+// The number of precision bits and the number of states needs to be the same
+// as with the RAnsEncoder that was used to encode the input data.
+template <int rans_precision_bits_t, int num_states_t = 1>
 class RAnsDecoder {
  public:
-  RAnsDecoder() {}
+  RAnsDecoder()
+      : lookup_table_type_(RANS_LOOKUP_TABLE_PACKED),
+        buf_(nullptr),
+        buf_offset_(0),
+        next_state_(0) {}
 
   // Initializes the decoder from the input buffer. The |offset| specifies the
   // number of bytes encoded by the encoder. A non zero return value is an
   // error.
   inline int read_init(const uint8_t *const buf, int offset) {
-    unsigned x;
-    if (offset < 1)
-      return 1;
-    ans_.buf = buf;
-    x = buf[offset - 1] >> 6;
-    if (x == 0) {
-      ans_.buf_offset = offset - 1;
-      ans_.state = buf[offset - 1] & 0x3F;
-    } else if (x == 1) {
-      if (offset < 2)
+    buf_ = buf;
+    buf_offset_ = offset;
+    for (int i = 0; i < num_states_t; ++i) {
+      if (!read_state(&states_[i]))
         return 1;
-      ans_.buf_offset = offset - 2;
-      ans_.state = mem_get_le16(buf + offset - 2) & 0x3FFF;
-    } else if (x == 2) {
-      if (offset < 3)
-        return 1;
-      ans_.buf_offset = offset - 3;
-      ans_.state = mem_get_le24(buf + offset - 3) & 0x3FFFFF;
-    } else if (x == 3) {
-      ans_.buf_offset = offset - 4;
-      ans_.state = mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
-    } else {
-      return 1;
     }
-    ans_.state += l_rans_base;
-    if (ans_.state >= l_rans_base * io_base)
-      return 1;
+    next_state_ = 0;
     return 0;
   }
 
-  inline int read_end() { return ans_.state == l_rans_base; }
+  inline int read_end() {
+    for (int i = 0; i < num_states_t; ++i) {
+      if (states_[i] != l_rans_base)
+        return 0;
+    }
+    return 1;
+  }
 
   inline int reader_has_error() {
-    return ans_.state < l_rans_base && ans_.buf_offset == 0;
+    return states_[next_state_] < l_rans_base && buf_offset_ == 0;
   }
 
   inline int rans_read() {
-    unsigned rem;
-    unsigned quo;
-    struct rans_dec_sym sym;
-    while (ans_.state < l_rans_base && ans_.buf_offset > 0) {
-      ans_.state = ans_.state * io_base + ans_.buf[--ans_.buf_offset];
+    uint32_t &state = states_[next_state_];
+    next_state_ = (next_state_ + 1) % num_states_t;
+    if (lookup_table_type_ == RANS_LOOKUP_TABLE_PACKED)
+      return rans_read_state<RANS_LOOKUP_TABLE_PACKED>(&state);
+    return rans_read_state<RANS_LOOKUP_TABLE_SYMBOL_ID>(&state);
+  }
+
+  // Decodes |num_symbols| symbols into |out_symbols|. The result is the same
+  // as when rans_read() is called |num_symbols| times, but all states are
+  // processed in each iteration of the main loop so that the decoding of
+  // independent states can be overlapped by the CPU.
+  inline void rans_read_symbols(uint32_t *out_symbols, uint32_t num_symbols) {
+    if (lookup_table_type_ == RANS_LOOKUP_TABLE_PACKED) {
+      rans_read_symbols_impl<RANS_LOOKUP_TABLE_PACKED>(out_symbols,
+                                                       num_symbols);
+    } else {
+      rans_read_symbols_impl<RANS_LOOKUP_TABLE_SYMBOL_ID>(out_symbols,
+                                                          num_symbols);
     }
-    // |rans_precision| is a power of two compile time constant, and the below
-    // division and modulo are going to be optimized by the compiler.
-    quo = ans_.state / rans_precision;
-    rem = ans_.state % rans_precision;
-    fetch_sym(&sym, rem);
-    ans_.state = quo * sym.prob + rem - sym.cum_prob;
-    return sym.val;
+  }
+
+  // Sets the type of the lookup table built by rans_build_look_up_table().
+  // The packed table is used by default when the precision allows it.
+  inline void set_lookup_table_type(RAnsLookupTableType type) {
+    lookup_table_type_ = type;
+  }
+  inline RAnsLookupTableType lookup_table_type() const {
+    return lookup_table_type_;
   }
 
   // Construct a lookup table with |rans_precision| number of entries.
   // Returns false if the table couldn't be built (because of wrong input data).
   inline bool rans_build_look_up_table(const uint32_t token_probs[],
                                        uint32_t num_symbols) {
-    lut_table_.resize(rans_precision);
-    probability_table_.resize(num_symbols);
+    if (rans_precision_bits_t > kRAnsMaxPackedLookupTablePrecisionBits)
+      lookup_table_type_ = RANS_LOOKUP_TABLE_SYMBOL_ID;
+    if (lookup_table_type_ == RANS_LOOKUP_TABLE_PACKED) {
+      packed_lut_table_.resize(rans_precision);
+    } else {
+      lut_table_.resize(rans_precision);
+      probability_table_.resize(num_symbols);
+    }
     uint32_t cum_prob = 0;
     uint32_t act_prob = 0;
     for (uint32_t i = 0; i < num_symbols; ++i) {
-      probability_table_[i].prob = token_probs[i];
-      probability_table_[i].cum_prob = cum_prob;
-      cum_prob += token_probs[i];
+      const uint32_t prob = token_probs[i];
+      cum_prob += prob;
       if (cum_prob > rans_precision) {
         return false;
       }
-      for (uint32_t j = act_prob; j < cum_prob; ++j) {
-        lut_table_[j] = i;
+      if (lookup_table_type_ == RANS_LOOKUP_TABLE_PACKED) {
+        for (uint32_t j = act_prob; j < cum_prob; ++j) {
+          rans_packed_dec_sym &entry = packed_lut_table_[j];
+          entry.val = i;
+          entry.prob = static_cast<uint16_t>(prob);
+          entry.offset = static_cast<uint16_t>(j - act_prob);
+        }
+      } else {
+        probability_table_[i].prob = prob;
+        probability_table_[i].cum_prob = act_prob;
+        for (uint32_t j = act_prob; j < cum_prob; ++j) {
+          lut_table_[j] = i;
+        }
       }
       act_prob = cum_prob;
     }
@@ -491,6 +565,96 @@ class RAnsDecoder {
   }
 
  private:
+  // Deserializes a state stored in front of the current buffer offset.
+  // Returns false on error.
+  inline bool read_state(uint32_t *out_state) {
+    if (buf_offset_ < 1)
+      return false;
+    uint32_t state;
+    const unsigned x = buf_[buf_offset_ - 1] >> 6;
+    if (x == 0) {
+      buf_offset_ -= 1;
+      state = buf_[buf_offset_] & 0x3F;
+    } else if (x == 1) {
+      if (buf_offset_ < 2)
+        return false;
+      buf_offset_ -= 2;
+      state = mem_get_le16(buf_ + buf_offset_) & 0x3FFF;
+    } else if (x == 2) {
+      if (buf_offset_ < 3)
+        return false;
+      buf_offset_ -= 3;
+      state = mem_get_le24(buf_ + buf_offset_) & 0x3FFFFF;
+    } else {
+      if (buf_offset_ < 4)
+        return false;
+      buf_offset_ -= 4;
+      state = mem_get_le32(buf_ + buf_offset_) & 0x3FFFFFFF;
+    }
+    state += l_rans_base;
+    if (state >= l_rans_base * io_base)
+      return false;
+    *out_state = state;
+    return true;
+  }
+
+  template <RAnsLookupTableType lookup_table_type_t>
+  inline void rans_read_symbols_impl(uint32_t *out_symbols,
+                                     uint32_t num_symbols) {
+    uint32_t i = 0;
+    // Align the decoding with the first state. With a single state, the
+    // decoding is always aligned and all symbols are read by the main loop
+    // below, so the alignment and the tail loops are skipped.
+    if (num_states_t > 1) {
+      for (; i < num_symbols && next_state_ != 0; ++i) {
+        out_symbols[i] =
+            rans_read_state<lookup_table_type_t>(&states_[next_state_]);
+        next_state_ = (next_state_ + 1) % num_states_t;
+      }
+    }
+    uint32_t states[num_states_t];
+    for (int s = 0; s < num_states_t; ++s) {
+      states[s] = states_[s];
+    }
+    for (; i + num_states_t <= num_symbols; i += num_states_t) {
+      for (int s = 0; s < num_states_t; ++s) {
+        out_symbols[i + s] = rans_read_state<lookup_table_type_t>(&states[s]);
+      }
+    }
+    for (int s = 0; s < num_states_t; ++s) {
+      states_[s] = states[s];
+    }
+    if (num_states_t > 1) {
+      for (; i < num_symbols; ++i) {
+        out_symbols[i] =
+            rans_read_state<lookup_table_type_t>(&states_[next_state_]);
+        next_state_ = (next_state_ + 1) % num_states_t;
+      }
+    }
+  }
+
+  template <RAnsLookupTableType lookup_table_type_t>
+  inline int rans_read_state(uint32_t *state) {
+    unsigned rem;
+    unsigned quo;
+    while (*state < l_rans_base && buf_offset_ > 0) {
+      *state = *state * io_base + buf_[--buf_offset_];
+    }
+    // |rans_precision| is a power of two compile time constant, and the below
+    // division and modulo are going to be optimized by the compiler.
+    quo = *state / rans_precision;
+    rem = *state % rans_precision;
+    if (lookup_table_type_t == RANS_LOOKUP_TABLE_PACKED) {
+      const rans_packed_dec_sym &entry = packed_lut_table_[rem];
+      *state = quo * entry.prob + entry.offset;
+      return entry.val;
+    }
+    struct rans_dec_sym sym;
+    fetch_sym(&sym, rem);
+    *state = quo * sym.prob + rem - sym.cum_prob;
+    return sym.val;
+  }
+
   inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) {
     uint32_t symbol = lut_table_[rem];
     out->val = symbol;
@@ -500,9 +664,15 @@ class RAnsDecoder {
 
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
+  RAnsLookupTableType lookup_table_type_;
   std::vector<uint32_t> lut_table_;
   std::vector<rans_sym> probability_table_;
-  AnsDecoder ans_;
+  std::vector<rans_packed_dec_sym> packed_lut_table_;
+  const uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
+  // State used for the next decoded symbol.
+  int next_state_;
 };
 
 #undef ANS_DIVREM
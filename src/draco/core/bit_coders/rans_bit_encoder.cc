@@ -89,9 +89,9 @@ void RAnsBitEncoder::EndEncoding(EncoderBuffer *target_buffer) {
   zero_prob += (zero_prob == 0);
 
   // Space for 32 bit integer and some extra space.
-  std::vector<uint8_t> buffer((bits_.size() + 8) * 8);
+  ans_buffer_.resize((bits_.size() + 8) * 8);
   AnsCoder ans_coder;
-  ans_write_init(&ans_coder, buffer.data());
+  ans_write_init(&ans_coder, ans_buffer_.data());
 
   for (int i = num_local_bits_ - 1; i >= 0; --i) {
     const uint8_t bit = (local_bits_ >> i) & 1;
@@ -108,7 +108,7 @@ void RAnsBitEncoder::EndEncoding(EncoderBuffer *target_buffer) {
   const int size_in_bytes = ans_write_end(&ans_coder);
   target_buffer->Encode(zero_prob);
   EncodeVarint(static_cast<uint32_t>(size_in_bytes), target_buffer);
-  target_buffer->Encode(buffer.data(), size_in_bytes);
+  target_buffer->Encode(ans_buffer_.data(), size_in_bytes);
 
   Clear();
 }
@@ -50,6 +50,9 @@ class RAnsBitEncoder {
   std::vector<uint32_t> bits_;
   uint32_t local_bits_;
   uint32_t num_local_bits_;
+  // Output of the ans coder. Stored as member variable to prevent frequent
+  // memory reallocations when the encoder is reused.
+  std::vector<uint8_t> ans_buffer_;
 };
 
 }  // namespace draco
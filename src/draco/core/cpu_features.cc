@@ -0,0 +1,56 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/cpu_features.h"
+
+#if defined(DRACO_AVX2_SUPPORTED) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace draco {
+
+namespace {
+
+bool DetectAvx2() {
+#if !defined(DRACO_AVX2_SUPPORTED)
+  return false;
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  // The OS must support saving of the AVX registers (OSXSAVE + AVX bits).
+  const int kOsxsaveAndAvx = (1 << 27) | (1 << 28);
+  if ((info[2] & kOsxsaveAndAvx) != kOsxsaveAndAvx)
+    return false;
+  if ((_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+}  // namespace
+
+bool CpuSupportsAvx2() {
+  static const bool supported = DetectAvx2();
+  return supported;
+}
+
+}  // namespace draco
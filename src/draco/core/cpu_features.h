@@ -0,0 +1,53 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Helpers for selecting SIMD implementations of performance critical loops.
+// SSE2 kernels are used whenever the target architecture guarantees SSE2
+// support. AVX2 kernels are compiled for all x86 targets using function
+// specific target attributes and they are selected at runtime only on CPUs
+// that support them, so no special compiler flags are needed.
+#ifndef DRACO_CORE_CPU_FEATURES_H_
+#define DRACO_CORE_CPU_FEATURES_H_
+
+#if !defined(DRACO_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DRACO_SSE2_SUPPORTED
+#endif
+#if defined(DRACO_SSE2_SUPPORTED) && \
+    (defined(_MSC_VER) ||            \
+     (defined(__GNUC__) &&           \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     defined(__clang__))
+#define DRACO_AVX2_SUPPORTED
+#endif
+#endif  // !defined(DRACO_DISABLE_SIMD)
+
+// Marks functions that use AVX2 intrinsics. Such functions must be called
+// only when CpuSupportsAvx2() returns true.
+#if defined(DRACO_AVX2_SUPPORTED) && !defined(_MSC_VER)
+#define DRACO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DRACO_TARGET_AVX2
+#endif
+
+namespace draco {
+
+// Returns true when the AVX2 kernels can be executed on the current CPU. The
+// result is computed only once.
+bool CpuSupportsAvx2();
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_CPU_FEATURES_H_
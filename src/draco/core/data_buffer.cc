@@ -16,7 +16,14 @@
 
 namespace draco {
 
-DataBuffer::DataBuffer() {}
+DataBuffer::DataBuffer() : external_data_(nullptr), external_size_(0) {}
+
+void DataBuffer::SetExternalData(const void *data, int64_t size) {
+  data_.clear();
+  external_data_ = static_cast<const uint8_t *>(data);
+  external_size_ = size;
+  descriptor_.buffer_update_count++;
+}
 
 bool DataBuffer::Update(const void *data, int64_t size) {
   if (size < 0)
@@ -24,16 +31,20 @@ bool DataBuffer::Update(const void *data, int64_t size) {
 
   if (data == nullptr) {
     // If no data is provided, just resize the buffer.
+    CopyExternalData();
     data_.resize(size);
   } else {
     const uint8_t *const byte_data = static_cast<const uint8_t *>(data);
     data_.assign(byte_data, byte_data + size);
+    external_data_ = nullptr;
+    external_size_ = 0;
   }
   descriptor_.buffer_update_count++;
   return true;
 }
 
 bool DataBuffer::Update(const void *data, int64_t size, int64_t offset) {
+  CopyExternalData();
   if (data == nullptr) {
     if (size + offset < 0)
       return false;
@@ -52,14 +63,23 @@ bool DataBuffer::Update(const void *data, int64_t size, int64_t offset) {
 }
 
 void DataBuffer::Resize(int64_t size) {
+  CopyExternalData();
   data_.resize(size);
   descriptor_.buffer_update_count++;
 }
 
-void DataBuffer::WriteDataToStream(std::ostream &stream) {
-  if (data_.size() == 0)
+void DataBuffer::WriteDataToStream(std::ostream &stream) const {
+  if (data_size() == 0)
+    return;
+  stream.write(reinterpret_cast<const char *>(data()), data_size());
+}
+
+void DataBuffer::CopyExternalData() {
+  if (!is_external())
     return;
-  stream.write(reinterpret_cast<char *>(data_.data()), data_.size());
+  data_.assign(external_data_, external_data_ + external_size_);
+  external_data_ = nullptr;
+  external_size_ = 0;
 }
 
 }  // namespace draco
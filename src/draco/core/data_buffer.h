@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "draco/core/draco_types.h"
+#include "draco/core/memory_arena.h"
 
 namespace draco {
 
@@ -32,10 +33,29 @@ struct DataBufferDescriptor {
   int64_t buffer_update_count;
 };
 
-// Class used for storing raw buffer data.
+// Class used for storing raw buffer data. The data is allocated from the
+// memory arena that was current when the buffer was created (if any).
+//
+// The buffer can also reference external read-only memory that is not owned
+// by the buffer (see SetExternalData()). Such data is copied into the buffer's
+// own storage before the first modification of the buffer (copy-on-write).
 class DataBuffer {
  public:
   DataBuffer();
+
+  // Makes the buffer reference |size| bytes of external |data| without copying
+  // them. The memory must remain valid and unchanged for as long as the buffer
+  // references it, i.e., until the buffer is destroyed or modified.
+  void SetExternalData(const void *data, int64_t size);
+
+  // Returns true when the buffer references external memory.
+  bool is_external() const { return external_data_ != nullptr; }
+
+  // Copies the referenced external data (if any) into the buffer's own
+  // storage. Non-const accessors do this lazily, so it must be called before
+  // the buffer is accessed from multiple threads.
+  void CopyExternalData();
+
   bool Update(const void *data, int64_t size);
   // TODO(zhafang): The two update functions should be combined. I will
   // leave for now in case it breaks any geometry compression tools.
@@ -43,7 +63,7 @@ class DataBuffer {
 
   // Reallocate the buffer storage to a new size keeping the data unchanged.
   void Resize(int64_t new_size);
-  void WriteDataToStream(std::ostream &stream);
+  void WriteDataToStream(std::ostream &stream) const;
   // Reads data from the buffer. Potentially unsafe, called needs to ensure
   // the accessed memory is valid.
   void Read(int64_t byte_pos, void *out_data, size_t data_size) const {
@@ -53,28 +73,38 @@ class DataBuffer {
   // Writes data to the buffer. Unsafe, caller must ensure the accessed memory
   // is valid.
   void Write(int64_t byte_pos, const void *in_data, size_t data_size) {
-    memcpy(const_cast<uint8_t *>(data()) + byte_pos, in_data, data_size);
+    memcpy(data() + byte_pos, in_data, data_size);
   }
 
   // Copies data from another buffer to this buffer.
   void Copy(int64_t dst_offset, const DataBuffer *src_buf, int64_t src_offset,
             int64_t size) {
-    memcpy(const_cast<uint8_t *>(data()) + dst_offset,
-           src_buf->data() + src_offset, size);
+    memcpy(data() + dst_offset, src_buf->data() + src_offset, size);
   }
 
   void set_update_count(int64_t buffer_update_count) {
     descriptor_.buffer_update_count = buffer_update_count;
   }
   int64_t update_count() const { return descriptor_.buffer_update_count; }
-  size_t data_size() const { return data_.size(); }
-  const uint8_t *data() const { return data_.data(); }
-  uint8_t *data() { return &data_[0]; }
+  size_t data_size() const {
+    return is_external() ? external_size_ : data_.size();
+  }
+  const uint8_t *data() const {
+    return is_external() ? external_data_ : data_.data();
+  }
+  // Returns writable data. External data is copied into the buffer first.
+  uint8_t *data() {
+    CopyExternalData();
+    return &data_[0];
+  }
   int64_t buffer_id() const { return descriptor_.buffer_id; }
   void set_buffer_id(int64_t buffer_id) { descriptor_.buffer_id = buffer_id; }
 
  private:
-  std::vector<uint8_t> data_;
+  std::vector<uint8_t, ArenaAllocator<uint8_t>> data_;
+  // External data used instead of |data_| when not nullptr.
+  const uint8_t *external_data_;
+  size_t external_size_;
   // Counter incremented by Update() calls.
   DataBufferDescriptor descriptor_;
 };
@@ -0,0 +1,88 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/draco_benchmark_utils.h"
+
+#include <cmath>
+
+#include "draco/core/vector_d.h"
+#include "draco/io/mesh_io.h"
+#include "testing/draco_test_config.h"
+
+namespace draco {
+
+namespace {
+static constexpr char kTestDataDir[] = DRACO_TEST_DATA_DIR;
+}  // namespace
+
+std::string GetBenchmarkFileFullPath(const std::string &file_name) {
+  return std::string(kTestDataDir) + std::string("/") + file_name;
+}
+
+std::unique_ptr<Mesh> ReadMeshFromBenchmarkFile(const std::string &file_name) {
+  auto mesh_or = ReadMeshFromFile(GetBenchmarkFileFullPath(file_name));
+  if (!mesh_or.ok())
+    return nullptr;
+  return std::move(mesh_or).value();
+}
+
+std::unique_ptr<Mesh> CreateBenchmarkGridMesh(int grid_size) {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  const int num_points = grid_size * grid_size;
+  mesh->set_num_points(num_points);
+  for (int y = 0; y + 1 < grid_size; ++y) {
+    for (int x = 0; x + 1 < grid_size; ++x) {
+      const int v = y * grid_size + x;
+      mesh->AddFace({{PointIndex(v), PointIndex(v + 1),
+                      PointIndex(v + grid_size)}});
+      mesh->AddFace({{PointIndex(v + 1), PointIndex(v + grid_size + 1),
+                      PointIndex(v + grid_size)}});
+    }
+  }
+
+  GeometryAttribute pos_att;
+  pos_att.Init(GeometryAttribute::POSITION, nullptr, 3, DT_FLOAT32, false,
+               sizeof(float) * 3, 0);
+  GeometryAttribute normal_att;
+  normal_att.Init(GeometryAttribute::NORMAL, nullptr, 3, DT_FLOAT32, false,
+                  sizeof(float) * 3, 0);
+  GeometryAttribute tex_att;
+  tex_att.Init(GeometryAttribute::TEX_COORD, nullptr, 2, DT_FLOAT32, false,
+               sizeof(float) * 2, 0);
+  PointAttribute *const pos =
+      mesh->attribute(mesh->AddAttribute(pos_att, true, num_points));
+  PointAttribute *const normal =
+      mesh->attribute(mesh->AddAttribute(normal_att, true, num_points));
+  PointAttribute *const tex =
+      mesh->attribute(mesh->AddAttribute(tex_att, true, num_points));
+  // The surface is a height field z = sin(x / 4) * cos(y / 8).
+  for (int y = 0; y < grid_size; ++y) {
+    for (int x = 0; x < grid_size; ++x) {
+      const AttributeValueIndex avi(y * grid_size + x);
+      const float fx = static_cast<float>(x);
+      const float fy = static_cast<float>(y);
+      Vector3f position(fx, fy, std::sin(fx / 4) * std::cos(fy / 8));
+      pos->SetAttributeValue(avi, position.data());
+      Vector3f normal_value(-std::cos(fx / 4) * std::cos(fy / 8) / 4,
+                            std::sin(fx / 4) * std::sin(fy / 8) / 8, 1.f);
+      normal_value.Normalize();
+      normal->SetAttributeValue(avi, normal_value.data());
+      Vector2f tex_coord(fx / grid_size, fy / grid_size);
+      tex->SetAttributeValue(avi, tex_coord.data());
+    }
+  }
+  return mesh;
+}
+
+}  // namespace draco
@@ -0,0 +1,38 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_DRACO_BENCHMARK_UTILS_H_
+#define DRACO_CORE_DRACO_BENCHMARK_UTILS_H_
+
+#include <memory>
+#include <string>
+
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Returns the full path to a given file in the test data directory.
+std::string GetBenchmarkFileFullPath(const std::string &file_name);
+
+// Loads a mesh from the test data directory. Returns nullptr on error.
+std::unique_ptr<Mesh> ReadMeshFromBenchmarkFile(const std::string &file_name);
+
+// Creates a wavy grid mesh with |grid_size| x |grid_size| vertices and
+// per-vertex positions, normals and texture coordinates. Attribute ids of the
+// attributes are 0, 1 and 2, respectively.
+std::unique_ptr<Mesh> CreateBenchmarkGridMesh(int grid_size);
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_DRACO_BENCHMARK_UTILS_H_
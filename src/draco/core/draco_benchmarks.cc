@@ -0,0 +1,38 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// Runs all registered benchmarks. The results are reported in JSON format
+// unless a different format is requested with --benchmark_format.
+int main(int argc, char *argv[]) {
+  std::vector<char *> args(argv, argv + argc);
+  bool has_format = false;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--benchmark_format", 18) == 0)
+      has_format = true;
+  }
+  char json_format[] = "--benchmark_format=json";
+  if (!has_format)
+    args.push_back(json_format);
+  int num_args = static_cast<int>(args.size());
+  ::benchmark::Initialize(&num_args, args.data());
+  if (::benchmark::ReportUnrecognizedArguments(num_args, args.data()))
+    return 1;
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
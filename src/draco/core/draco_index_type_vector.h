@@ -19,20 +19,23 @@
 #include <vector>
 
 #include "draco/core/draco_index_type.h"
+#include "draco/core/memory_arena.h"
 
 namespace draco {
 
 // A wrapper around the standard std::vector that supports indexing of the
 // vector entries using the strongly typed indices as defined in
-// draco_index_type.h .
+// draco_index_type.h . The entries are allocated from the memory arena that was
+// current when the vector was created (if any).
 // TODO(ostava): Make the interface more complete. It's currently missing
 // features such as iterators.
 // TODO(scottgodfrey): Make unit tests for this class.
 template <class IndexTypeT, class ValueTypeT>
 class IndexTypeVector {
  public:
-  typedef typename std::vector<ValueTypeT>::const_reference const_reference;
-  typedef typename std::vector<ValueTypeT>::reference reference;
+  typedef std::vector<ValueTypeT, ArenaAllocator<ValueTypeT>> VectorType;
+  typedef typename VectorType::const_reference const_reference;
+  typedef typename VectorType::reference reference;
 
   IndexTypeVector() {}
   explicit IndexTypeVector(size_t size) : vector_(size) {}
@@ -68,7 +71,7 @@ class IndexTypeVector {
   const ValueTypeT *data() const { return vector_.data(); }
 
  private:
-  std::vector<ValueTypeT> vector_;
+  VectorType vector_;
 };
 
 }  // namespace draco
@@ -14,6 +14,7 @@
 //
 #include "draco/core/draco_test_utils.h"
 
+#include <cmath>
 #include <fstream>
 
 #include "draco/core/macros.h"
@@ -75,4 +76,38 @@ bool CompareGoldenFile(const std::string &golden_file_name, const void *data,
   return true;
 }
 
+std::unique_ptr<Mesh> CreateAnimatedGridMesh(int size, int frame) {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  const int num_points = size * size;
+  GeometryAttribute pos_att;
+  pos_att.Init(GeometryAttribute::POSITION, nullptr, 3, DT_FLOAT32, false,
+               sizeof(float) * 3, 0);
+  const int pos_att_id = mesh->AddAttribute(pos_att, true, num_points);
+  GeometryAttribute color_att;
+  color_att.Init(GeometryAttribute::COLOR, nullptr, 3, DT_UINT8, true, 3, 0);
+  const int color_att_id = mesh->AddAttribute(color_att, true, num_points);
+  mesh->set_num_points(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    const float pos[3] = {static_cast<float>(i % size),
+                          static_cast<float>(i / size),
+                          std::sin(0.3f * i + 0.05f * frame)};
+    mesh->attribute(pos_att_id)->SetAttributeValue(AttributeValueIndex(i), pos);
+    const uint8_t color[3] = {static_cast<uint8_t>(i * 7),
+                              static_cast<uint8_t>(i * 13 + frame),
+                              static_cast<uint8_t>(i / size)};
+    mesh->attribute(color_att_id)
+        ->SetAttributeValue(AttributeValueIndex(i), color);
+  }
+  for (int y = 0; y < size - 1; ++y) {
+    for (int x = 0; x < size - 1; ++x) {
+      const int v = y * size + x;
+      mesh->AddFace(
+          {{PointIndex(v), PointIndex(v + 1), PointIndex(v + size)}});
+      mesh->AddFace({{PointIndex(v + 1), PointIndex(v + size + 1),
+                      PointIndex(v + size)}});
+    }
+  }
+  return mesh;
+}
+
 }  // namespace draco
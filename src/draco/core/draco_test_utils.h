@@ -55,6 +55,11 @@ inline std::unique_ptr<PointCloud> ReadPointCloudFromTestFile(
   return ReadPointCloudFromFile(path).value();
 }
 
+// Creates a regular grid mesh with |size| x |size| vertices that has position
+// and color attributes. The positions and colors are slightly animated by
+// |frame| while the connectivity is the same for all frames.
+std::unique_ptr<Mesh> CreateAnimatedGridMesh(int size, int frame);
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_DRACO_TEST_UTILS_H_
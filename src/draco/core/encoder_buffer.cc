@@ -48,8 +48,12 @@ bool EncoderBuffer::StartBitEncoding(int64_t required_bits, bool encode_size) {
   buffer_.resize(buffer_start_size + required_bytes);
   // Get the buffer data pointer for the bit encoder.
   const char *const data = buffer_.data() + buffer_start_size;
-  bit_encoder_ =
-      std::unique_ptr<BitEncoder>(new BitEncoder(const_cast<char *>(data)));
+  if (bit_encoder_) {
+    bit_encoder_->Reset(const_cast<char *>(data));
+  } else {
+    bit_encoder_ =
+        std::unique_ptr<BitEncoder>(new BitEncoder(const_cast<char *>(data)));
+  }
   return true;
 }
 
@@ -67,7 +71,7 @@ void EncoderBuffer::EndBitEncoding() {
     // Make the out_mem point to the memory reserved for storing the size.
     out_mem = out_mem - (bit_encoder_reserved_bytes_ + sizeof(uint64_t));
 
-    EncoderBuffer var_size_buffer;
+    FixedVarintBuffer var_size_buffer;
     EncodeVarint(encoded_bytes, &var_size_buffer);
     const uint32_t size_len = var_size_buffer.size();
     char *const dst = out_mem + size_len;
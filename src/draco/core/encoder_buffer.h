@@ -99,6 +99,12 @@ class EncoderBuffer {
     // |data| is the buffer to write the bits into.
     explicit BitEncoder(char *data) : bit_buffer_(data), bit_offset_(0) {}
 
+    // Restarts the encoding into a new buffer |data|.
+    void Reset(char *data) {
+      bit_buffer_ = data;
+      bit_offset_ = 0;
+    }
+
     // Write |nbits| of |data| into the bit buffer.
     void PutBits(uint32_t data, int32_t nbits) {
       DCHECK_GE(nbits, 0);
@@ -142,11 +148,8 @@ class EncoderBuffer {
   // All data is stored in this vector.
   std::vector<char> buffer_;
 
-  // Bit encoder is used when encoding variable-length bit data.
-  // TODO(ostava): Currently encoder needs to be recreated each time
-  // StartBitEncoding method is called. This is not necessary if BitEncoder
-  // supported reset function which can easily added but let's leave that for
-  // later.
+  // Bit encoder is used when encoding variable-length bit data. It is created
+  // on the first call to StartBitEncoding() and reused afterwards.
   std::unique_ptr<BitEncoder> bit_encoder_;
 
   // The number of bytes reserved for bit encoder.
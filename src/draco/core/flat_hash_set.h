@@ -0,0 +1,241 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_FLAT_HASH_SET_H_
+#define DRACO_CORE_FLAT_HASH_SET_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+// Mixes the bits of |hash| so that all bits of the result depend on all bits
+// of the input (finalizer of the MurmurHash3 function).
+inline uint64_t MixHashBits(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Hash set that stores all keys in a single array and resolves collisions by
+// linear probing. Compared to std::unordered_set it doesn't allocate memory
+// for individual entries, which makes it much faster for large numbers of
+// small keys. Keys can't be removed from the set.
+template <class KeyT, class HashT = std::hash<KeyT>,
+          class KeyEqualT = std::equal_to<KeyT>>
+class FlatHashSet {
+ public:
+  explicit FlatHashSet(size_t expected_size = 0, const HashT &hash = HashT(),
+                       const KeyEqualT &key_equal = KeyEqualT())
+      : hash_(hash), key_equal_(key_equal), size_(0) {
+    Reserve(expected_size);
+  }
+
+  // Inserts |key| unless an equal key is already in the set. Returns the key
+  // stored in the set and whether |key| was inserted.
+  std::pair<const KeyT *, bool> Insert(const KeyT &key) {
+    if (2 * (size_ + 1) > slots_.size())
+      Rehash(std::max<size_t>(2 * slots_.size(), kMinNumSlots));
+    const uint64_t hash = MixHashBits(hash_(key));
+    const uint32_t tag = Tag(hash);
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      Slot &slot = slots_[i];
+      if (slot.tag == 0) {
+        slot.tag = tag;
+        slot.key = key;
+        ++size_;
+        return std::make_pair(&slot.key, true);
+      }
+      if (slot.tag == tag && key_equal_(slot.key, key))
+        return std::make_pair(&slot.key, false);
+    }
+  }
+
+  // Returns the key equal to |key| or nullptr when there is no such key.
+  const KeyT *Find(const KeyT &key) const {
+    if (size_ == 0)
+      return nullptr;
+    const uint64_t hash = MixHashBits(hash_(key));
+    const uint32_t tag = Tag(hash);
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Slot &slot = slots_[i];
+      if (slot.tag == 0)
+        return nullptr;
+      if (slot.tag == tag && key_equal_(slot.key, key))
+        return &slot.key;
+    }
+  }
+
+  // Makes sure that |size| keys can be inserted without rehashing.
+  void Reserve(size_t size) {
+    size_t num_slots = kMinNumSlots;
+    while (num_slots < 2 * size) {
+      num_slots *= 2;
+    }
+    if (num_slots > slots_.size())
+      Rehash(num_slots);
+  }
+
+  void Clear() {
+    slots_.assign(slots_.size(), Slot());
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Slot {
+    Slot() : tag(0), key() {}
+    // Upper bits of the key hash used to skip most of the key comparisons. Zero
+    // marks an empty slot.
+    uint32_t tag;
+    KeyT key;
+  };
+
+  static constexpr size_t kMinNumSlots = 16;
+
+  static uint32_t Tag(uint64_t hash) {
+    return static_cast<uint32_t>(hash >> 32) | 1;
+  }
+
+  void Rehash(size_t num_slots) {
+    std::vector<Slot> old_slots(num_slots);
+    old_slots.swap(slots_);
+    const size_t mask = num_slots - 1;
+    for (const Slot &old_slot : old_slots) {
+      if (old_slot.tag == 0)
+        continue;
+      size_t i = MixHashBits(hash_(old_slot.key)) & mask;
+      while (slots_[i].tag != 0) {
+        i = (i + 1) & mask;
+      }
+      slots_[i] = old_slot;
+    }
+  }
+
+  HashT hash_;
+  KeyEqualT key_equal_;
+  std::vector<Slot> slots_;
+  size_t size_;
+};
+
+template <class KeyT, class HashT, class KeyEqualT>
+constexpr size_t FlatHashSet<KeyT, HashT, KeyEqualT>::kMinNumSlots;
+
+// Finds duplicates among |num_keys| keys. |get_key(i)| must return the i-th
+// key, which is then hashed by |key_hash| and compared by |key_equal|. For each
+// key, the index of the first key equal to it is stored in |out_first_indices|.
+// The keys are copied into the hash tables, so small keys such as attribute
+// values can be compared without accessing the source data. When
+// |thread_pool| is not nullptr, the keys are partitioned by their hashes and
+// each partition is processed by a different thread. The result doesn't depend
+// on the number of threads.
+template <class KeyT, class GetKeyT, class KeyHashT, class KeyEqualT>
+void FindDuplicateKeys(int num_keys, const GetKeyT &get_key,
+                       const KeyHashT &key_hash, const KeyEqualT &key_equal,
+                       ThreadPool *thread_pool,
+                       std::vector<int> *out_first_indices) {
+  // Entry of the hash tables storing a key and its index.
+  struct Entry {
+    KeyT key;
+    int index;
+  };
+  const auto entry_hash = [&key_hash](const Entry &entry) {
+    return key_hash(entry.key);
+  };
+  const auto entry_equal = [&key_equal](const Entry &e0, const Entry &e1) {
+    return key_equal(e0.key, e1.key);
+  };
+  typedef FlatHashSet<Entry, decltype(entry_hash), decltype(entry_equal)>
+      EntrySet;
+
+  out_first_indices->resize(num_keys);
+  std::vector<int> &first_indices = *out_first_indices;
+  if (thread_pool == nullptr || thread_pool->num_threads() == 1) {
+    // The tables grow with the number of unique keys, which is often much
+    // smaller than |num_keys|.
+    EntrySet entries(0, entry_hash, entry_equal);
+    for (int i = 0; i < num_keys; ++i) {
+      const Entry entry = {get_key(i), i};
+      first_indices[i] = entries.Insert(entry).first->index;
+    }
+    return;
+  }
+
+  // Compute the partitions of all keys and count the number of keys that fall
+  // into each partition within each range of the keys.
+  const int num_partitions = thread_pool->num_threads();
+  std::vector<int> range_starts(num_partitions + 1);
+  for (int r = 0; r <= num_partitions; ++r) {
+    range_starts[r] =
+        static_cast<int>(static_cast<int64_t>(num_keys) * r / num_partitions);
+  }
+  std::vector<int> partitions(num_keys);
+  std::vector<int> offsets(num_partitions * num_partitions, 0);
+  thread_pool->ParallelFor(0, num_partitions, [&](int r) {
+    int *const counts = &offsets[r * num_partitions];
+    for (int i = range_starts[r]; i < range_starts[r + 1]; ++i) {
+      const uint64_t hash = MixHashBits(key_hash(get_key(i)));
+      partitions[i] = static_cast<int>((hash >> 32) % num_partitions);
+      ++counts[partitions[i]];
+    }
+  });
+
+  // Store the indices of the keys of each partition in one continuous block,
+  // preserving the order of the keys.
+  std::vector<int> partition_starts(num_partitions + 1);
+  int offset = 0;
+  for (int p = 0; p < num_partitions; ++p) {
+    partition_starts[p] = offset;
+    for (int r = 0; r < num_partitions; ++r) {
+      const int count = offsets[r * num_partitions + p];
+      offsets[r * num_partitions + p] = offset;
+      offset += count;
+    }
+  }
+  partition_starts[num_partitions] = offset;
+  std::vector<int> partition_keys(num_keys);
+  thread_pool->ParallelFor(0, num_partitions, [&](int r) {
+    int *const partition_offsets = &offsets[r * num_partitions];
+    for (int i = range_starts[r]; i < range_starts[r + 1]; ++i) {
+      partition_keys[partition_offsets[partitions[i]]++] = i;
+    }
+  });
+
+  // Equal keys always fall into the same partition so the partitions can be
+  // processed independently.
+  thread_pool->ParallelFor(0, num_partitions, [&](int p) {
+    EntrySet entries(0, entry_hash, entry_equal);
+    for (int k = partition_starts[p]; k < partition_starts[p + 1]; ++k) {
+      const int i = partition_keys[k];
+      const Entry entry = {get_key(i), i};
+      first_indices[i] = entries.Insert(entry).first->index;
+    }
+  });
+}
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_FLAT_HASH_SET_H_
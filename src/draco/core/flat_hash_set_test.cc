@@ -0,0 +1,83 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/flat_hash_set.h"
+
+#include <random>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class FlatHashSetTest : public ::testing::Test {
+ protected:
+  FlatHashSetTest() {}
+};
+
+TEST_F(FlatHashSetTest, TestInsertAndFind) {
+  draco::FlatHashSet<int> set;
+  for (int i = 0; i < 1000; ++i) {
+    const auto result = set.Insert(3 * i);
+    ASSERT_TRUE(result.second);
+    ASSERT_EQ(*result.first, 3 * i);
+  }
+  ASSERT_EQ(set.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_FALSE(set.Insert(3 * i).second);
+    ASSERT_NE(set.Find(3 * i), nullptr);
+    ASSERT_EQ(set.Find(3 * i + 1), nullptr);
+  }
+  ASSERT_EQ(set.size(), 1000u);
+  set.Clear();
+  ASSERT_EQ(set.size(), 0u);
+  ASSERT_EQ(set.Find(0), nullptr);
+}
+
+TEST_F(FlatHashSetTest, TestFindDuplicateKeys) {
+  // Tests that the duplicates found on multiple threads are the same as the
+  // duplicates found on a single thread.
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> distribution(0, 5000);
+  std::vector<int> values(20000);
+  for (int &value : values) {
+    value = distribution(generator);
+  }
+  const auto get_value = [&values](int i) { return values[i]; };
+  // Use a poor hash function to test collisions of different values.
+  const auto value_hash = [](int value) { return value / 4; };
+  const auto value_equal = [](int value0, int value1) {
+    return value0 == value1;
+  };
+  std::vector<int> first_indices;
+  draco::FindDuplicateKeys<int>(values.size(), get_value, value_hash,
+                                value_equal, nullptr, &first_indices);
+  ASSERT_EQ(first_indices.size(), values.size());
+  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+    const int first = first_indices[i];
+    ASSERT_LE(first, i);
+    ASSERT_EQ(values[first], values[i]);
+    ASSERT_EQ(first_indices[first], first);
+  }
+
+  for (int num_threads = 2; num_threads <= 8; num_threads *= 2) {
+    draco::ThreadPool thread_pool(num_threads);
+    std::vector<int> parallel_first_indices;
+    draco::FindDuplicateKeys<int>(values.size(), get_value, value_hash,
+                                  value_equal, &thread_pool,
+                                  &parallel_first_indices);
+    ASSERT_EQ(first_indices, parallel_first_indices);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,169 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/memory_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace draco {
+
+namespace {
+// Arena used by the current thread.
+thread_local MemoryArena *current_arena = nullptr;
+
+// Part of an arena block that is used exclusively by the current thread.
+struct ThreadChunk {
+  uint64_t arena_id;
+  char *pos;
+  char *end;
+};
+thread_local ThreadChunk thread_chunk = {0, nullptr, nullptr};
+
+// Source of the arena ids. Zero is never used so that the initial thread chunk
+// doesn't belong to any arena.
+std::atomic<uint64_t> next_arena_id(1);
+
+uint64_t GenerateArenaId() { return next_arena_id.fetch_add(1); }
+
+// Returns the number of bytes needed to align |ptr| to |alignment|.
+size_t GetPadding(const char *ptr, size_t alignment) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  return (alignment - address % alignment) % alignment;
+}
+}  // namespace
+
+MemoryArena::MemoryArena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 1)),
+      // Each block can be shared by up to 16 threads.
+      chunk_size_(std::max<size_t>(block_size_ / 16, 1)),
+      block_pos_(0),
+      bytes_allocated_(0),
+      id_(GenerateArenaId()) {}
+
+MemoryArena::~MemoryArena() { FreeBlocks(); }
+
+void *MemoryArena::Allocate(size_t size, size_t alignment) {
+  ThreadChunk &chunk = thread_chunk;
+  if (chunk.arena_id == id_.load(std::memory_order_relaxed)) {
+    const size_t padding = GetPadding(chunk.pos, alignment);
+    if (padding + size <= static_cast<size_t>(chunk.end - chunk.pos)) {
+      chunk.pos += padding + size;
+      bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+      return chunk.pos - size;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+  if (size > chunk_size_) {
+    // Large allocations would waste most of the thread chunks.
+    return AllocateFromBlock(size, alignment);
+  }
+  FetchThreadChunk(size, alignment);
+  chunk.pos += GetPadding(chunk.pos, alignment) + size;
+  return chunk.pos - size;
+}
+
+void *MemoryArena::AllocateFromBlock(size_t size, size_t alignment) {
+  if (!blocks_.empty()) {
+    const Block &block = blocks_.back();
+    const size_t padding = GetPadding(block.data + block_pos_, alignment);
+    if (block_pos_ + padding + size <= block.size) {
+      block_pos_ += padding + size;
+      return block.data + block_pos_ - size;
+    }
+  }
+  // The new block is aligned for any type, padding is not needed.
+  AddBlock(size);
+  block_pos_ = size;
+  return blocks_.back().data;
+}
+
+void MemoryArena::FetchThreadChunk(size_t size, size_t alignment) {
+  ThreadChunk &chunk = thread_chunk;
+  chunk.arena_id = id_.load(std::memory_order_relaxed);
+  if (!blocks_.empty()) {
+    const Block &block = blocks_.back();
+    const size_t chunk_size = std::min(chunk_size_, block.size - block_pos_);
+    chunk.pos = block.data + block_pos_;
+    if (GetPadding(chunk.pos, alignment) + size <= chunk_size) {
+      chunk.end = chunk.pos + chunk_size;
+      block_pos_ += chunk_size;
+      return;
+    }
+  }
+  AddBlock(chunk_size_);
+  chunk.pos = blocks_.back().data;
+  chunk.end = chunk.pos + chunk_size_;
+  block_pos_ = chunk_size_;
+}
+
+void MemoryArena::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (blocks_.size() > 1) {
+    size_t total_size = 0;
+    for (const Block &block : blocks_) {
+      total_size += block.size;
+    }
+    FreeBlocks();
+    AddBlock(total_size);
+  }
+  block_pos_ = 0;
+  bytes_allocated_ = 0;
+  id_ = GenerateArenaId();
+}
+
+void MemoryArena::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FreeBlocks();
+  block_pos_ = 0;
+  bytes_allocated_ = 0;
+  id_ = GenerateArenaId();
+}
+
+size_t MemoryArena::bytes_allocated() const { return bytes_allocated_; }
+
+size_t MemoryArena::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t total_size = 0;
+  for (const Block &block : blocks_) {
+    total_size += block.size;
+  }
+  return total_size;
+}
+
+MemoryArena *MemoryArena::current() { return current_arena; }
+
+void MemoryArena::AddBlock(size_t min_size) {
+  Block block;
+  block.size = std::max(min_size, block_size_);
+  block.data = static_cast<char *>(::operator new(block.size));
+  blocks_.push_back(block);
+}
+
+void MemoryArena::FreeBlocks() {
+  for (const Block &block : blocks_) {
+    ::operator delete(block.data);
+  }
+  blocks_.clear();
+}
+
+ScopedMemoryArena::ScopedMemoryArena(MemoryArena *arena)
+    : previous_arena_(current_arena) {
+  current_arena = arena;
+}
+
+ScopedMemoryArena::~ScopedMemoryArena() { current_arena = previous_arena_; }
+
+}  // namespace draco
@@ -0,0 +1,169 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_MEMORY_ARENA_H_
+#define DRACO_CORE_MEMORY_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace draco {
+
+// Arena that serves memory allocations from large blocks using a simple bump
+// pointer. Individual allocations are never freed. Instead, all memory is
+// released at once by Reset() or Release(). This avoids the cost of many small
+// heap allocations (and the contention of the heap allocator when many
+// geometries are processed concurrently) when the lifetime of all allocated
+// objects is known to end at the same time.
+//
+// The arena is used through ScopedMemoryArena, which makes it the current
+// arena of the calling thread. Draco containers (DataBuffer and
+// IndexTypeVector) created while an arena is current take all their memory
+// from it. All such containers must be destroyed before the arena is reset.
+//
+// The arena is thread safe, i.e., it can be shared by multiple threads. Each
+// thread serves small allocations from its own chunk of the current block
+// without locking. The lock is taken only to fetch a new chunk and for
+// allocations that are larger than a chunk.
+class MemoryArena {
+ public:
+  // Creates an arena that allocates memory from the heap in blocks of at least
+  // |block_size| bytes.
+  explicit MemoryArena(size_t block_size = 64 * 1024);
+  ~MemoryArena();
+
+  // Returns a pointer to |size| bytes aligned to |alignment|, which must be a
+  // power of two.
+  void *Allocate(size_t size, size_t alignment);
+
+  // Invalidates all allocations made from the arena but keeps the allocated
+  // memory for the future allocations. If the memory was spread over multiple
+  // blocks, it is replaced by a single block of the same total size.
+  void Reset();
+
+  // Invalidates all allocations and returns all memory back to the heap.
+  void Release();
+
+  // Returns the number of bytes allocated since the last Reset() or Release().
+  size_t bytes_allocated() const;
+
+  // Returns the total size of all blocks owned by the arena.
+  size_t capacity() const;
+
+  // Returns the arena used by the calling thread or nullptr when no arena is
+  // set.
+  static MemoryArena *current();
+
+ private:
+  struct Block {
+    char *data;
+    size_t size;
+  };
+
+  // Allocates |size| bytes directly from the last block. Must be called with
+  // |mutex_| held.
+  void *AllocateFromBlock(size_t size, size_t alignment);
+
+  // Replaces the chunk of the calling thread with a new one that has space for
+  // |size| bytes aligned to |alignment|. Must be called with |mutex_| held.
+  void FetchThreadChunk(size_t size, size_t alignment);
+
+  // Adds a new block that has space for at least |min_size| bytes.
+  void AddBlock(size_t min_size);
+  void FreeBlocks();
+
+  const size_t block_size_;
+  // Size of the chunks taken by individual threads from the blocks.
+  const size_t chunk_size_;
+  std::vector<Block> blocks_;
+  // Position of the next allocation in the last block.
+  size_t block_pos_;
+  std::atomic<size_t> bytes_allocated_;
+  // Unique id of the arena that is changed whenever the allocations are
+  // invalidated. The thread chunks of other ids are not used.
+  std::atomic<uint64_t> id_;
+  mutable std::mutex mutex_;
+};
+
+// Makes |arena| the current arena of the calling thread for the lifetime of
+// the object. The previous arena is restored on destruction. |arena| can be
+// nullptr in which case the heap is used.
+class ScopedMemoryArena {
+ public:
+  explicit ScopedMemoryArena(MemoryArena *arena);
+  ~ScopedMemoryArena();
+
+ private:
+  ScopedMemoryArena(const ScopedMemoryArena &) = delete;
+  ScopedMemoryArena &operator=(const ScopedMemoryArena &) = delete;
+
+  MemoryArena *const previous_arena_;
+};
+
+// Standard allocator that takes memory from the arena that was current when
+// the allocator was created. When there was no arena, the memory is allocated
+// on the heap. The arena is inherited by moved and swapped containers, but
+// copies of containers use the arena that is current at the time of the copy.
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() : arena_(MemoryArena::current()) {}
+  explicit ArenaAllocator(MemoryArena *arena) : arena_(arena) {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    if (arena_ == nullptr)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t /* n */) {
+    // Memory taken from the arena is released by the arena itself.
+    if (arena_ == nullptr)
+      ::operator delete(p);
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  MemoryArena *arena() const { return arena_; }
+
+ private:
+  MemoryArena *arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() == b.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_MEMORY_ARENA_H_
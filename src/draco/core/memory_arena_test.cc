@@ -0,0 +1,137 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/memory_arena.h"
+
+#include <cstdint>
+
+#include "draco/core/data_buffer.h"
+#include "draco/core/draco_index_type_vector.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/thread_pool.h"
+
+namespace {
+
+struct TestIndexTag {};
+typedef draco::IndexType<uint32_t, TestIndexTag> TestIndex;
+
+class MemoryArenaTest : public ::testing::Test {
+ protected:
+  MemoryArenaTest() {}
+};
+
+TEST_F(MemoryArenaTest, TestAllocate) {
+  draco::MemoryArena arena(256);
+  char *const a = static_cast<char *>(arena.Allocate(3, 1));
+  int64_t *const b = static_cast<int64_t *>(arena.Allocate(8, 8));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0);
+  ASSERT_GE(reinterpret_cast<char *>(b), a + 3);
+  ASSERT_EQ(arena.bytes_allocated(), 11);
+  ASSERT_EQ(arena.capacity(), 256);
+
+  // Allocations that don't fit into the block create new blocks.
+  ASSERT_NE(arena.Allocate(1000, 4), nullptr);
+  ASSERT_NE(arena.Allocate(200, 4), nullptr);
+  ASSERT_EQ(arena.capacity(), 256 + 1000 + 256);
+
+  // Reset() merges all blocks into one that can hold all the allocations.
+  arena.Reset();
+  ASSERT_EQ(arena.bytes_allocated(), 0);
+  ASSERT_EQ(arena.capacity(), 256 + 1000 + 256);
+  ASSERT_NE(arena.Allocate(1200, 4), nullptr);
+  ASSERT_EQ(arena.capacity(), 256 + 1000 + 256);
+
+  arena.Release();
+  ASSERT_EQ(arena.capacity(), 0);
+}
+
+TEST_F(MemoryArenaTest, TestScopedArena) {
+  draco::MemoryArena arena;
+  draco::MemoryArena other_arena;
+  ASSERT_EQ(draco::MemoryArena::current(), nullptr);
+  {
+    const draco::ScopedMemoryArena scope(&arena);
+    ASSERT_EQ(draco::MemoryArena::current(), &arena);
+    {
+      const draco::ScopedMemoryArena inner_scope(&other_arena);
+      ASSERT_EQ(draco::MemoryArena::current(), &other_arena);
+    }
+    ASSERT_EQ(draco::MemoryArena::current(), &arena);
+  }
+  ASSERT_EQ(draco::MemoryArena::current(), nullptr);
+}
+
+TEST_F(MemoryArenaTest, TestContainers) {
+  // Tests that the draco containers created in the arena scope take their
+  // memory from the arena.
+  draco::MemoryArena arena;
+  {
+    const draco::ScopedMemoryArena scope(&arena);
+    draco::DataBuffer buffer;
+    const uint8_t data[] = {1, 2, 3, 4};
+    ASSERT_TRUE(buffer.Update(data, sizeof(data)));
+    ASSERT_EQ(arena.bytes_allocated(), sizeof(data));
+    ASSERT_EQ(buffer.data()[3], 4);
+
+    draco::IndexTypeVector<TestIndex, uint32_t> vec(100, 7);
+    ASSERT_EQ(arena.bytes_allocated(), sizeof(data) + 100 * sizeof(uint32_t));
+
+    // Copies created outside of the scope use the heap.
+    const size_t bytes_allocated = arena.bytes_allocated();
+    const draco::ScopedMemoryArena heap_scope(nullptr);
+    const draco::IndexTypeVector<TestIndex, uint32_t> vec_copy(vec);
+    ASSERT_EQ(vec_copy[TestIndex(99)], 7);
+    ASSERT_EQ(arena.bytes_allocated(), bytes_allocated);
+  }
+  arena.Reset();
+  ASSERT_EQ(arena.bytes_allocated(), 0);
+}
+
+TEST_F(MemoryArenaTest, TestThreadPool) {
+  // Tests that tasks of a thread pool use the arena of the calling thread.
+  draco::MemoryArena arena;
+  draco::ThreadPool pool(4);
+  const draco::ScopedMemoryArena scope(&arena);
+  std::vector<draco::DataBuffer> buffers(64);
+  pool.ParallelFor(0, buffers.size(), [&buffers, &arena](int i) {
+    ASSERT_EQ(draco::MemoryArena::current(), &arena);
+    buffers[i].Resize(i + 1);
+  });
+  ASSERT_EQ(arena.bytes_allocated(), 64 * 65 / 2);
+}
+
+TEST_F(MemoryArenaTest, TestThreadChunks) {
+  // Tests that small allocations of concurrent threads don't overlap.
+  draco::MemoryArena arena(1024);
+  draco::ThreadPool pool(4);
+  std::vector<uint8_t *> values(1000);
+  pool.ParallelFor(0, values.size(), [&values, &arena](int i) {
+    values[i] = static_cast<uint8_t *>(arena.Allocate(i % 7 + 1, 1));
+    for (int j = 0; j <= i % 7; ++j) {
+      values[i][j] = static_cast<uint8_t>(i);
+    }
+  });
+  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+    for (int j = 0; j <= i % 7; ++j) {
+      ASSERT_EQ(values[i][j], static_cast<uint8_t>(i));
+    }
+  }
+
+  // Chunks of released memory must not be used by the following allocations.
+  arena.Release();
+  ASSERT_NE(arena.Allocate(1, 1), nullptr);
+  ASSERT_EQ(arena.capacity(), 1024);
+}
+
+}  // namespace
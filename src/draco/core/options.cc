@@ -25,6 +25,16 @@ void Options::SetInt(const std::string &name, int val) {
   options_[name] = std::to_string(val);
 }
 
+void Options::SetInt(const char *name, int val) {
+  std::string *const option = FindOption(name);
+  if (option == nullptr) {
+    options_[name] = std::to_string(val);
+    return;
+  }
+  // The short value string fits into the existing storage of |option|.
+  *option = std::to_string(val);
+}
+
 void Options::SetFloat(const std::string &name, float val) {
   options_[name] = std::to_string(val);
 }
@@ -40,10 +50,16 @@ void Options::SetString(const std::string &name, const std::string &val) {
 int Options::GetInt(const std::string &name) const { return GetInt(name, -1); }
 
 int Options::GetInt(const std::string &name, int default_val) const {
-  const auto it = options_.find(name);
-  if (it == options_.end())
+  return GetInt(name.c_str(), default_val);
+}
+
+int Options::GetInt(const char *name) const { return GetInt(name, -1); }
+
+int Options::GetInt(const char *name, int default_val) const {
+  const std::string *const option = FindOption(name);
+  if (option == nullptr)
     return default_val;
-  return std::atoi(it->second.c_str());
+  return std::atoi(option->c_str());
 }
 
 float Options::GetFloat(const std::string &name) const {
@@ -51,10 +67,16 @@ float Options::GetFloat(const std::string &name) const {
 }
 
 float Options::GetFloat(const std::string &name, float default_val) const {
-  const auto it = options_.find(name);
-  if (it == options_.end())
+  return GetFloat(name.c_str(), default_val);
+}
+
+float Options::GetFloat(const char *name) const { return GetFloat(name, -1); }
+
+float Options::GetFloat(const char *name, float default_val) const {
+  const std::string *const option = FindOption(name);
+  if (option == nullptr)
     return default_val;
-  return std::atof(it->second.c_str());
+  return std::atof(option->c_str());
 }
 
 bool Options::GetBool(const std::string &name) const {
@@ -62,6 +84,12 @@ bool Options::GetBool(const std::string &name) const {
 }
 
 bool Options::GetBool(const std::string &name, bool default_val) const {
+  return GetBool(name.c_str(), default_val);
+}
+
+bool Options::GetBool(const char *name) const { return GetBool(name, false); }
+
+bool Options::GetBool(const char *name, bool default_val) const {
   const int ret = GetInt(name, -1);
   if (ret == -1)
     return default_val;
@@ -80,4 +108,23 @@ std::string Options::GetString(const std::string &name,
   return it->second;
 }
 
+const std::string *Options::FindOption(const char *name) const {
+  // Compare the names in place to avoid creating a temporary std::string for
+  // |name|. The entries are sorted by their names so the search can stop at
+  // the first greater name.
+  for (const auto &option : options_) {
+    const int cmp = option.first.compare(name);
+    if (cmp == 0)
+      return &option.second;
+    if (cmp > 0)
+      break;
+  }
+  return nullptr;
+}
+
+std::string *Options::FindOption(const char *name) {
+  return const_cast<std::string *>(
+      static_cast<const Options *>(this)->FindOption(name));
+}
+
 }  // namespace draco
@@ -40,10 +40,16 @@ namespace draco {
 // The API provides helper methods for directly storing values of various types
 // such as ints and bools. One named option should be set with only a single
 // data type.
+//
+// All getters and SetInt() can also be called with a C string name. These
+// versions don't allocate any memory when the option already exists (or when
+// it is not found by a getter), so they can be used on code paths that must
+// not allocate, such as the encoding of a frame by a warmed up encoder.
 class Options {
  public:
   Options();
   void SetInt(const std::string &name, int val);
+  void SetInt(const char *name, int val);
   void SetFloat(const std::string &name, float val);
   void SetBool(const std::string &name, bool val);
   void SetString(const std::string &name, const std::string &val);
@@ -58,10 +64,16 @@ class Options {
   // value can be specified in the overloaded version of each function.
   int GetInt(const std::string &name) const;
   int GetInt(const std::string &name, int default_val) const;
+  int GetInt(const char *name) const;
+  int GetInt(const char *name, int default_val) const;
   float GetFloat(const std::string &name) const;
   float GetFloat(const std::string &name, float default_val) const;
+  float GetFloat(const char *name) const;
+  float GetFloat(const char *name, float default_val) const;
   bool GetBool(const std::string &name) const;
   bool GetBool(const std::string &name, bool default_val) const;
+  bool GetBool(const char *name) const;
+  bool GetBool(const char *name, bool default_val) const;
   std::string GetString(const std::string &name) const;
   std::string GetString(const std::string &name,
                         const std::string &default_val) const;
@@ -72,13 +84,24 @@ class Options {
   // default value is needed, it can be set in |out_val|.
   template <typename DataTypeT>
   bool GetVector(const std::string &name, int num_dims,
-                 DataTypeT *out_val) const;
+                 DataTypeT *out_val) const {
+    return GetVector(name.c_str(), num_dims, out_val);
+  }
+  template <typename DataTypeT>
+  bool GetVector(const char *name, int num_dims, DataTypeT *out_val) const;
 
   bool IsOptionSet(const std::string &name) const {
     return options_.count(name) > 0;
   }
+  bool IsOptionSet(const char *name) const {
+    return FindOption(name) != nullptr;
+  }
 
  private:
+  // Returns the value of option |name| or nullptr if the option is not set.
+  const std::string *FindOption(const char *name) const;
+  std::string *FindOption(const char *name);
+
   // All entries are internally stored as strings and converted to the desired
   // return type based on the used Get* method.
   // TODO(ostava): Consider adding type safety mechanism that would prevent
@@ -114,12 +137,12 @@ VectorT Options::GetVector(const std::string &name,
 }
 
 template <typename DataTypeT>
-bool Options::GetVector(const std::string &name, int num_dims,
+bool Options::GetVector(const char *name, int num_dims,
                         DataTypeT *out_val) const {
-  const auto it = options_.find(name);
-  if (it == options_.end())
+  const std::string *const option = FindOption(name);
+  if (option == nullptr)
     return false;
-  const std::string value = it->second;
+  const std::string &value = *option;
   if (value.length() == 0)
     return true;  // Option set but no data is present
   const char *act_str = value.c_str();
@@ -14,8 +14,79 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <cstdint>
+#include <limits>
+
+#include "draco/core/cpu_features.h"
+
+#ifdef DRACO_SSE2_SUPPORTED
+#include <emmintrin.h>
+#endif
+#ifdef DRACO_AVX2_SUPPORTED
+#include <immintrin.h>
+#endif
+
 namespace draco {
 
+namespace {
+
+// The kernels process blocks of |num_components| vectors so that each vector
+// lane always corresponds to the same component. |offsets| contains the
+// offsets of all values of one block.
+// Note that the multiplication by the factor and by the range must not be
+// fused or reordered, otherwise the results would differ from
+// Dequantizer::DequantizeFloat().
+
+#ifdef DRACO_SSE2_SUPPORTED
+// Maximum number of values in one block processed by the vector kernels, i.e.
+// eight lanes for each of the at most 127 components of an attribute value
+// (the number of components is stored as int8_t).
+constexpr int kMaxBlockSize = 8 * std::numeric_limits<int8_t>::max();
+
+void DequantizeBlocksSse2(const int32_t *in_values, int num_blocks,
+                          int num_components, const float *offsets,
+                          float factor, float range, float *out_values) {
+  const __m128 factor_v = _mm_set1_ps(factor);
+  const __m128 range_v = _mm_set1_ps(range);
+  for (int b = 0; b < num_blocks; ++b) {
+    for (int c = 0; c < num_components; ++c) {
+      const __m128i ints = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(in_values));
+      __m128 values = _mm_mul_ps(_mm_cvtepi32_ps(ints), factor_v);
+      values = _mm_mul_ps(values, range_v);
+      values = _mm_add_ps(values, _mm_loadu_ps(offsets + 4 * c));
+      _mm_storeu_ps(out_values, values);
+      in_values += 4;
+      out_values += 4;
+    }
+  }
+}
+#endif
+
+#ifdef DRACO_AVX2_SUPPORTED
+DRACO_TARGET_AVX2 void DequantizeBlocksAvx2(const int32_t *in_values,
+                                            int num_blocks, int num_components,
+                                            const float *offsets, float factor,
+                                            float range, float *out_values) {
+  const __m256 factor_v = _mm256_set1_ps(factor);
+  const __m256 range_v = _mm256_set1_ps(range);
+  for (int b = 0; b < num_blocks; ++b) {
+    for (int c = 0; c < num_components; ++c) {
+      const __m256i ints = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(in_values));
+      __m256 values = _mm256_mul_ps(_mm256_cvtepi32_ps(ints), factor_v);
+      values = _mm256_mul_ps(values, range_v);
+      values = _mm256_add_ps(values, _mm256_loadu_ps(offsets + 8 * c));
+      _mm256_storeu_ps(out_values, values);
+      in_values += 8;
+      out_values += 8;
+    }
+  }
+}
+#endif
+
+}  // namespace
+
 Quantizer::Quantizer() : range_(1.f), max_quantized_value_(1) {}
 
 void Quantizer::Init(float range, int32_t max_quantized_value) {
@@ -33,4 +104,46 @@ bool Dequantizer::Init(float range, int32_t max_quantized_value) {
   return true;
 }
 
+void Dequantizer::DequantizeFloats(const int32_t *in_values, int num_values,
+                                   int num_components, const float *offsets,
+                                   float *out_values) const {
+  if (num_components <= 0)
+    return;
+  int num_processed_values = 0;
+#ifdef DRACO_SSE2_SUPPORTED
+  // AVX2 support implies SSE2 support.
+  int num_lanes = 4;
+#ifdef DRACO_AVX2_SUPPORTED
+  if (CpuSupportsAvx2())
+    num_lanes = 8;
+#endif
+  const int block_size = num_lanes * num_components;
+  const int num_blocks = num_values / block_size;
+  if (num_blocks > 0 && block_size <= kMaxBlockSize) {
+    float block_offsets[kMaxBlockSize];
+    for (int i = 0; i < block_size; ++i) {
+      block_offsets[i] = offsets[i % num_components];
+    }
+#ifdef DRACO_AVX2_SUPPORTED
+    if (num_lanes == 8) {
+      DequantizeBlocksAvx2(in_values, num_blocks, num_components,
+                           block_offsets, max_quantized_value_factor_, range_,
+                           out_values);
+    }
+#endif
+    if (num_lanes == 4) {
+      DequantizeBlocksSse2(in_values, num_blocks, num_components,
+                           block_offsets, max_quantized_value_factor_, range_,
+                           out_values);
+    }
+    num_processed_values = num_blocks * block_size;
+  }
+#endif
+  // Process the remaining values.
+  for (int i = num_processed_values; i < num_values; ++i) {
+    out_values[i] =
+        DequantizeFloat(in_values[i]) + offsets[i % num_components];
+  }
+}
+
 }  // namespace draco
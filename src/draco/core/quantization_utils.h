@@ -76,6 +76,17 @@ class Dequantizer {
   }
   inline float operator()(int32_t val) const { return DequantizeFloat(val); }
 
+  // Dequantizes |num_values| values stored in |in_values| and adds
+  // |offsets| to them. The values are interleaved components of entries with
+  // |num_components| components each (|num_values| must be a multiple of
+  // |num_components|) and the offset of each component is stored in
+  // |offsets|. The results are the same as when DequantizeFloat() is called
+  // for each value separately, but the processing uses SIMD instructions when
+  // they are supported by the CPU.
+  void DequantizeFloats(const int32_t *in_values, int num_values,
+                        int num_components, const float *offsets,
+                        float *out_values) const;
+
  private:
   float range_;
   // Distance between two normalized dequantized values.
@@ -14,6 +14,8 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 
 namespace draco {
@@ -53,4 +55,29 @@ TEST_F(QuantizationUtilsTest, TestDequantizer) {
   ASSERT_FALSE(dequantizer.Init(1.f, -4));
 }
 
+TEST_F(QuantizationUtilsTest, TestDequantizeFloats) {
+  // Batch dequantization must produce exactly the same values as
+  // DequantizeFloat() for any number of components and values.
+  Dequantizer dequantizer;
+  ASSERT_TRUE(dequantizer.Init(7.3f, (1 << 14) - 1));
+  const float offsets[4] = {-1.5f, 0.25f, 100.f, -3.75f};
+  std::vector<int32_t> in_values(4 * 37);
+  for (int i = 0; i < static_cast<int>(in_values.size()); ++i) {
+    in_values[i] = (i * 7919) % (1 << 14) - (i % 5 == 0 ? (1 << 13) : 0);
+  }
+  for (int num_components = 1; num_components <= 4; ++num_components) {
+    for (int num_entries = 0; num_entries <= 37; ++num_entries) {
+      const int num_values = num_entries * num_components;
+      std::vector<float> out_values(num_values);
+      dequantizer.DequantizeFloats(in_values.data(), num_values,
+                                   num_components, offsets, out_values.data());
+      for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(out_values[i],
+                  dequantizer.DequantizeFloat(in_values[i]) +
+                      offsets[i % num_components]);
+      }
+    }
+  }
+}
+
 }  // namespace draco
@@ -25,12 +25,19 @@ namespace draco {
 // A helper class for decoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to decode the probability table and the data encoded
 // by the RAnsSymbolEncoder. |unique_symbols_bit_length_t| must be the same as
-// the one used for the corresponding RAnsSymbolEncoder.
-template <int unique_symbols_bit_length_t>
+// the one used for the corresponding RAnsSymbolEncoder. The same holds for the
+// number of interleaved states |num_states_t|.
+template <int unique_symbols_bit_length_t, int num_states_t = 1>
 class RAnsSymbolDecoder {
  public:
   RAnsSymbolDecoder() : num_symbols_(0) {}
 
+  // Selects the lookup table used for decoding the symbols (see ans.h). Must
+  // be called before Create().
+  void SetLookupTableType(RAnsLookupTableType type) {
+    ans_.set_lookup_table_type(type);
+  }
+
   // Initialize the decoder and decode the probability table.
   bool Create(DecoderBuffer *buffer);
 
@@ -40,6 +47,10 @@ class RAnsSymbolDecoder {
   // encoded data after this call.
   bool StartDecoding(DecoderBuffer *buffer);
   uint32_t DecodeSymbol() { return ans_.rans_read(); }
+  // Decodes |num_symbols| symbols at once into |out_symbols|.
+  void DecodeSymbols(uint32_t *out_symbols, uint32_t num_symbols) {
+    ans_.rans_read_symbols(out_symbols, num_symbols);
+  }
   void EndDecoding();
 
  private:
@@ -50,11 +61,11 @@ class RAnsSymbolDecoder {
 
   std::vector<uint32_t> probability_table_;
   uint32_t num_symbols_;
-  RAnsDecoder<rans_precision_bits_> ans_;
+  RAnsDecoder<rans_precision_bits_, num_states_t> ans_;
 };
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoder<unique_symbols_bit_length_t, num_states_t>::Create(
     DecoderBuffer *buffer) {
   // Check that the DecoderBuffer version is set.
   if (buffer->bitstream_version() == 0)
@@ -113,8 +124,8 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoder<unique_symbols_bit_length_t, num_states_t>::StartDecoding(
     DecoderBuffer *buffer) {
   uint64_t bytes_encoded;
   // Decode the number of bytes encoded by the encoder.
@@ -139,8 +150,8 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolDecoder<unique_symbols_bit_length_t>::EndDecoding() {
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolDecoder<unique_symbols_bit_length_t, num_states_t>::EndDecoding() {
   ans_.read_end();
 }
 
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 #include "draco/core/ans.h"
 #include "draco/core/encoder_buffer.h"
@@ -26,14 +27,30 @@
 
 namespace draco {
 
+// Memory used by RAnsSymbolEncoder to compute its probability table. One
+// instance can be shared by consecutive encoders so that the table doesn't
+// need to be allocated for each of them.
+struct RAnsSymbolEncoderBuffers {
+  std::vector<rans_sym> probability_table;
+  std::vector<int> sorted_probabilities;
+};
+
 // A helper class for encoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to initialize and encode probability table needed by
 // rANS, and to perform encoding of symbols into the provided EncoderBuffer.
-template <int unique_symbols_bit_length_t>
+// |num_states_t| is the number of interleaved rANS states (see ans.h).
+template <int unique_symbols_bit_length_t, int num_states_t = 1>
 class RAnsSymbolEncoder {
  public:
-  RAnsSymbolEncoder()
-      : num_symbols_(0), num_expected_bits_(0), buffer_offset_(0) {}
+  RAnsSymbolEncoder() : RAnsSymbolEncoder(nullptr) {}
+  // Creates an encoder that keeps its probability table in |buffers|. When
+  // |buffers| is nullptr, the encoder uses its own memory.
+  explicit RAnsSymbolEncoder(RAnsSymbolEncoderBuffers *buffers)
+      : buffers_(buffers ? buffers : &own_buffers_),
+        probability_table_(nullptr),
+        num_symbols_(0),
+        num_expected_bits_(0),
+        buffer_offset_(0) {}
 
   // Creates a probability table needed by the rANS library and encode it into
   // the provided buffer.
@@ -50,18 +67,21 @@ class RAnsSymbolEncoder {
   static constexpr bool needs_reverse_encoding() { return true; }
 
  private:
+  // The encoder can't be copied because it may point to its own buffers.
+  RAnsSymbolEncoder(const RAnsSymbolEncoder &) = delete;
+  RAnsSymbolEncoder &operator=(const RAnsSymbolEncoder &) = delete;
+
   // Functor used for sorting symbol ids according to their probabilities.
   // The functor sorts symbol indices that index an underlying map between
   // symbol ids and their probabilities. We don't sort the probability table
   // directly, because that would require an additional indirection during the
   // EncodeSymbol() function.
   struct ProbabilityLess {
-    explicit ProbabilityLess(const std::vector<rans_sym> *probs)
-        : probabilities(probs) {}
+    explicit ProbabilityLess(const rans_sym *probs) : probabilities(probs) {}
     bool operator()(int i, int j) const {
-      return probabilities->at(i).prob < probabilities->at(j).prob;
+      return probabilities[i].prob < probabilities[j].prob;
     }
-    const std::vector<rans_sym> *probabilities;
+    const rans_sym *probabilities;
   };
 
   // Encodes the probability table into the output buffer.
@@ -72,19 +92,22 @@ class RAnsSymbolEncoder {
           unique_symbols_bit_length_t);
   static constexpr int rans_precision_ = 1 << rans_precision_bits_;
 
-  std::vector<rans_sym> probability_table_;
+  RAnsSymbolEncoderBuffers own_buffers_;
+  RAnsSymbolEncoderBuffers *const buffers_;
+  // Points to the probability table stored in |buffers_|.
+  rans_sym *probability_table_;
   // The number of symbols in the input alphabet.
   uint32_t num_symbols_;
   // Expected number of bits that is needed to encode the input.
   uint64_t num_expected_bits_;
 
-  RAnsEncoder<rans_precision_bits_> ans_;
+  RAnsEncoder<rans_precision_bits_, num_states_t> ans_;
   // Initial offset of the encoder buffer before any ans data was encoded.
   uint64_t buffer_offset_;
 };
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::Create(
     const uint64_t *frequencies, int num_symbols, EncoderBuffer *buffer) {
   // Compute the total of the input frequencies.
   uint64_t total_freq = 0;
@@ -96,7 +119,8 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
   }
   num_symbols = max_valid_symbol + 1;
   num_symbols_ = num_symbols;
-  probability_table_.resize(num_symbols);
+  buffers_->probability_table.resize(num_symbols);
+  probability_table_ = buffers_->probability_table.data();
   const double total_freq_d = static_cast<double>(total_freq);
   const double rans_precision_d = static_cast<double>(rans_precision_);
   // Compute probabilities by rescaling the normalized frequencies into interval
@@ -119,12 +143,13 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
   // Because of rounding errors, the total precision may not be exactly accurate
   // and we may need to adjust the entries a little bit.
   if (total_rans_prob != rans_precision_) {
-    std::vector<int> sorted_probabilities(num_symbols);
+    std::vector<int> &sorted_probabilities = buffers_->sorted_probabilities;
+    sorted_probabilities.resize(num_symbols);
     for (int i = 0; i < num_symbols; ++i) {
       sorted_probabilities[i] = i;
     }
     std::sort(sorted_probabilities.begin(), sorted_probabilities.end(),
-              ProbabilityLess(&probability_table_));
+              ProbabilityLess(probability_table_));
     if (total_rans_prob < rans_precision_) {
       // This happens rather infrequently, just add the extra needed precision
       // to the most frequent symbol.
@@ -192,8 +217,8 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::EncodeTable(
     EncoderBuffer *buffer) {
   EncodeVarint(num_symbols_, buffer);
   // Use varint encoding for the probabilities (first two bits represent the
@@ -240,11 +265,11 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::StartEncoding(
     EncoderBuffer *buffer) {
   // Allocate extra storage just in case.
-  const uint64_t required_bits = 2 * num_expected_bits_ + 32;
+  const uint64_t required_bits = 2 * num_expected_bits_ + 32 * num_states_t;
 
   buffer_offset_ = buffer->size();
   const int64_t required_bytes = (required_bits + 7) / 8;
@@ -254,15 +279,15 @@ void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
   ans_.write_init(data + buffer_offset_);
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::EndEncoding(
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t>::EndEncoding(
     EncoderBuffer *buffer) {
   char *const src = const_cast<char *>(buffer->data()) + buffer_offset_;
 
   // TODO(fgalligan): Look into changing this to uint32_t as write_end()
   // returns an int.
   const uint64_t bytes_written = static_cast<uint64_t>(ans_.write_end());
-  EncoderBuffer var_size_buffer;
+  FixedVarintBuffer var_size_buffer;
   EncodeVarint(bytes_written, &var_size_buffer);
   const uint32_t size_len = var_size_buffer.size();
   char *const dst = src + size_len;
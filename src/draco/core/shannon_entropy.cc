@@ -7,9 +7,18 @@ namespace draco {
 
 int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
                               int max_value, int *out_num_unique_symbols) {
+  std::vector<int> symbol_frequencies;
+  return ComputeShannonEntropy(symbols, num_symbols, max_value,
+                               out_num_unique_symbols, &symbol_frequencies);
+}
+
+int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
+                              int max_value, int *out_num_unique_symbols,
+                              std::vector<int> *symbol_frequencies_ptr) {
   // First find frequency of all unique symbols in the input array.
   int num_unique_symbols = 0;
-  std::vector<int> symbol_frequencies(max_value + 1, 0);
+  std::vector<int> &symbol_frequencies = *symbol_frequencies_ptr;
+  symbol_frequencies.assign(max_value + 1, 0);
   for (int i = 0; i < num_symbols; ++i) {
     ++symbol_frequencies[symbols[i]];
   }
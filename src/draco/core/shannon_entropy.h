@@ -17,6 +17,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 namespace draco {
 
 // Computes an approximate Shannon entropy of symbols stored in the provided
@@ -33,6 +35,12 @@ namespace draco {
 int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
                               int max_value, int *out_num_unique_symbols);
 
+// Same as above, but the frequencies of the symbols are counted in
+// |symbol_frequencies| so that its memory can be reused between calls.
+int64_t ComputeShannonEntropy(const uint32_t *symbols, int num_symbols,
+                              int max_value, int *out_num_unique_symbols,
+                              std::vector<int> *symbol_frequencies);
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_SHANNON_ENTROPY_H_
@@ -0,0 +1,125 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/options.h"
+#include "draco/core/symbol_decoding.h"
+#include "draco/core/symbol_encoding.h"
+
+namespace draco {
+
+namespace {
+
+// Synthetic distributions of the encoded symbols.
+enum SymbolDistribution {
+  // Symbols uniformly distributed in range <0, 15>.
+  SYMBOL_DISTRIBUTION_UNIFORM_SMALL = 0,
+  // Geometrically distributed symbols, similar to prediction residuals.
+  SYMBOL_DISTRIBUTION_GEOMETRIC,
+  // Symbols uniformly distributed in range <0, 2^20 - 1>.
+  SYMBOL_DISTRIBUTION_UNIFORM_LARGE,
+};
+
+const int kNumSymbols = 1 << 18;
+
+std::vector<uint32_t> GenerateSymbols(SymbolDistribution distribution) {
+  std::mt19937 generator(1);
+  std::vector<uint32_t> symbols(kNumSymbols);
+  std::uniform_int_distribution<uint32_t> uniform_small(0, 15);
+  std::geometric_distribution<uint32_t> geometric(0.2);
+  std::uniform_int_distribution<uint32_t> uniform_large(0, (1 << 20) - 1);
+  for (uint32_t &symbol : symbols) {
+    switch (distribution) {
+      case SYMBOL_DISTRIBUTION_UNIFORM_SMALL:
+        symbol = uniform_small(generator);
+        break;
+      case SYMBOL_DISTRIBUTION_GEOMETRIC:
+        symbol = geometric(generator);
+        break;
+      case SYMBOL_DISTRIBUTION_UNIFORM_LARGE:
+        symbol = uniform_large(generator);
+        break;
+    }
+  }
+  return symbols;
+}
+
+Options CreateSymbolOptions(int method) {
+  Options options;
+  SetSymbolEncodingMethod(&options, static_cast<SymbolCodingMethod>(method));
+  return options;
+}
+
+// Arguments are the symbol distribution and the symbol coding method.
+void BM_EncodeSymbols(benchmark::State &state) {
+  const std::vector<uint32_t> symbols = GenerateSymbols(
+      static_cast<SymbolDistribution>(state.range(0)));
+  const Options options = CreateSymbolOptions(state.range(1));
+  EncoderBuffer buffer;
+  for (auto _ : state) {
+    buffer.Clear();
+    if (!EncodeSymbols(symbols.data(), kNumSymbols, 1, &options, &buffer)) {
+      state.SkipWithError("Failed to encode symbols.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumSymbols);
+  state.counters["encoded_bytes"] = buffer.size();
+}
+
+void BM_DecodeSymbols(benchmark::State &state) {
+  const std::vector<uint32_t> symbols = GenerateSymbols(
+      static_cast<SymbolDistribution>(state.range(0)));
+  const Options options = CreateSymbolOptions(state.range(1));
+  EncoderBuffer buffer;
+  if (!EncodeSymbols(symbols.data(), kNumSymbols, 1, &options, &buffer)) {
+    state.SkipWithError("Failed to encode symbols.");
+    return;
+  }
+  std::vector<uint32_t> decoded_symbols(kNumSymbols);
+  for (auto _ : state) {
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    dec_buffer.set_bitstream_version(kDracoBitstreamVersion);
+    if (!DecodeSymbols(kNumSymbols, 1, &dec_buffer, decoded_symbols.data())) {
+      state.SkipWithError("Failed to decode symbols.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumSymbols);
+}
+
+void SymbolCodingArguments(benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgNames({"distribution", "method"});
+  for (int distribution = SYMBOL_DISTRIBUTION_UNIFORM_SMALL;
+       distribution <= SYMBOL_DISTRIBUTION_UNIFORM_LARGE; ++distribution) {
+    for (int method = SYMBOL_CODING_TAGGED;
+         method < NUM_SYMBOL_CODING_METHODS; ++method) {
+      benchmark->Args({distribution, method});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_EncodeSymbols)->Apply(SymbolCodingArguments);
+BENCHMARK(BM_DecodeSymbols)->Apply(SymbolCodingArguments);
+
+}  // namespace draco
@@ -12,10 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <algorithm>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/encoder_buffer.h"
+#include "draco/core/rans_symbol_decoder.h"
+#include "draco/core/rans_symbol_encoder.h"
 #include "draco/core/symbol_coding_utils.h"
 #include "draco/core/symbol_decoding.h"
 #include "draco/core/symbol_encoding.h"
@@ -34,6 +38,48 @@ class SymbolCodingTest : public ::testing::Test {
     ASSERT_EQ(x, y);
   }
 
+  // Encodes |in| with RAnsSymbolEncoder and verifies that the data is
+  // correctly decoded using both types of rANS lookup tables.
+  template <int unique_symbols_bit_length_t, int num_states_t>
+  void TestLookupTableTypes(const std::vector<uint32_t> &in) {
+    uint32_t max_symbol = 0;
+    for (uint32_t symbol : in) {
+      max_symbol = std::max(max_symbol, symbol);
+    }
+    std::vector<uint64_t> frequencies(max_symbol + 1, 0);
+    for (uint32_t symbol : in) {
+      ++frequencies[symbol];
+    }
+    EncoderBuffer eb;
+    RAnsSymbolEncoder<unique_symbols_bit_length_t, num_states_t> encoder;
+    ASSERT_TRUE(encoder.Create(frequencies.data(), frequencies.size(), &eb));
+    encoder.StartEncoding(&eb);
+    for (int i = static_cast<int>(in.size()) - 1; i >= 0; --i) {
+      encoder.EncodeSymbol(in[i]);
+    }
+    encoder.EndEncoding(&eb);
+
+    const RAnsLookupTableType types[] = {RANS_LOOKUP_TABLE_SYMBOL_ID,
+                                         RANS_LOOKUP_TABLE_PACKED};
+    for (RAnsLookupTableType type : types) {
+      DecoderBuffer db;
+      db.Init(eb.data(), eb.size());
+      db.set_bitstream_version(bitstream_version_);
+      RAnsSymbolDecoder<unique_symbols_bit_length_t, num_states_t> decoder;
+      decoder.SetLookupTableType(type);
+      ASSERT_TRUE(decoder.Create(&db));
+      ASSERT_TRUE(decoder.StartDecoding(&db));
+      std::vector<uint32_t> out(in.size());
+      // Decode the first symbol separately to test both decoding functions.
+      out[0] = decoder.DecodeSymbol();
+      decoder.DecodeSymbols(&out[1], in.size() - 1);
+      decoder.EndDecoding();
+      for (uint32_t i = 0; i < in.size(); ++i) {
+        ASSERT_EQ(in[i], out[i]) << "lookup table type " << type;
+      }
+    }
+  }
+
   uint16_t bitstream_version_;
 };
 
@@ -158,6 +204,59 @@ TEST_F(SymbolCodingTest, TestLargeNumberCondition) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestInterleavedStates) {
+  // This test verifies that symbols encoded with any supported number of
+  // interleaved rANS states are decoded correctly, including inputs that are
+  // shorter than the number of states or not a multiple of it.
+  const int sizes[] = {1, 2, 3, 7, 9, 1000, 100003};
+  for (int size : sizes) {
+    std::vector<uint32_t> in(size);
+    uint32_t seed = 1;
+    for (int i = 0; i < size; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      // Skewed distribution of symbols.
+      const uint32_t r = (seed >> 16) & 0xffff;
+      in[i] = (r * r) >> 24;
+    }
+    for (int num_states = 1; num_states <= 8; num_states *= 2) {
+      Options options;
+      SetSymbolEncodingMethod(&options, SYMBOL_CODING_RAW);
+      ASSERT_TRUE(SetSymbolEncodingNumInterleavedStates(&options, num_states));
+      EncoderBuffer eb;
+      ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+      ASSERT_EQ(eb.data()[0], num_states == 1 ? SYMBOL_CODING_RAW
+                                              : SYMBOL_CODING_RAW_INTERLEAVED);
+      std::vector<uint32_t> out(in.size());
+      DecoderBuffer db;
+      db.Init(eb.data(), eb.size());
+      db.set_bitstream_version(bitstream_version_);
+      ASSERT_TRUE(DecodeSymbols(in.size(), 1, &db, &out[0]));
+      for (int i = 0; i < size; ++i) {
+        ASSERT_EQ(in[i], out[i]) << "num_states " << num_states;
+      }
+    }
+  }
+  Options options;
+  ASSERT_FALSE(SetSymbolEncodingNumInterleavedStates(&options, 3));
+}
+
+TEST_F(SymbolCodingTest, TestLookupTableTypes) {
+  // This test verifies that the packed rANS lookup table decodes the same
+  // symbols as the default lookup table. Precisions that are too large for the
+  // packed table must fall back to the default table.
+  std::vector<uint32_t> in(20001);
+  uint32_t seed = 7;
+  for (uint32_t i = 0; i < in.size(); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    const uint32_t r = (seed >> 16) & 0xff;
+    in[i] = (r * r) >> 10;
+  }
+  TestLookupTableTypes<5, 1>(in);
+  TestLookupTableTypes<9, 1>(in);
+  TestLookupTableTypes<9, 4>(in);
+  TestLookupTableTypes<14, 1>(in);
+}
+
 TEST_F(SymbolCodingTest, TestConversionFullRange) {
   TestConvertToSymbolAndBack(static_cast<int8_t>(-128));
   TestConvertToSymbolAndBack(static_cast<int8_t>(-127));
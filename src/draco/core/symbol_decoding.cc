@@ -21,11 +21,11 @@
 
 namespace draco {
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
                          DecoderBuffer *src_buffer, uint32_t *out_values);
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT, int num_states_t>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values);
 
@@ -41,17 +41,34 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
     return DecodeTaggedSymbols<RAnsSymbolDecoder>(num_values, num_components,
                                                   src_buffer, out_values);
   } else if (scheme == SYMBOL_CODING_RAW) {
-    return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
-                                               out_values);
+    return DecodeRawSymbols<RAnsSymbolDecoder, 1>(num_values, src_buffer,
+                                                  out_values);
+  } else if (scheme == SYMBOL_CODING_RAW_INTERLEAVED) {
+    uint8_t num_states;
+    if (!src_buffer->Decode(&num_states))
+      return false;
+    switch (num_states) {
+      case 2:
+        return DecodeRawSymbols<RAnsSymbolDecoder, 2>(num_values, src_buffer,
+                                                      out_values);
+      case 4:
+        return DecodeRawSymbols<RAnsSymbolDecoder, 4>(num_values, src_buffer,
+                                                      out_values);
+      case 8:
+        return DecodeRawSymbols<RAnsSymbolDecoder, 8>(num_values, src_buffer,
+                                                      out_values);
+      default:
+        return false;
+    }
   }
   return false;
 }
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
                          DecoderBuffer *src_buffer, uint32_t *out_values) {
   // Decode the encoded data.
-  SymbolDecoderT<5> tag_decoder;
+  SymbolDecoderT<5, 1> tag_decoder;
   if (!tag_decoder.Create(src_buffer))
     return false;
 
@@ -93,16 +110,12 @@ bool DecodeRawSymbolsInternal(uint32_t num_values, DecoderBuffer *src_buffer,
 
   if (!decoder.StartDecoding(src_buffer))
     return false;
-  for (uint32_t i = 0; i < num_values; ++i) {
-    // Decode a symbol into the value.
-    const uint32_t value = decoder.DecodeSymbol();
-    out_values[i] = value;
-  }
+  decoder.DecodeSymbols(out_values, num_values);
   decoder.EndDecoding();
   return true;
 }
 
-template <template <int> class SymbolDecoderT>
+template <template <int, int> class SymbolDecoderT, int num_states_t>
 bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
                       uint32_t *out_values) {
   uint8_t max_bit_length;
@@ -110,58 +123,58 @@ bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
     return false;
   switch (max_bit_length) {
     case 1:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<1>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<1, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 2:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<2>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<2, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 3:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<3>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<3, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 4:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<4>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<4, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 5:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<5>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<5, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 6:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<6>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<6, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 7:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<7>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<7, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 8:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<8>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<8, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 9:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<9>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<9, num_states_t>>(
+          num_values, src_buffer, out_values);
     case 10:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<10>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<10, num_states_t>>(
           num_values, src_buffer, out_values);
     case 11:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<11>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<11, num_states_t>>(
           num_values, src_buffer, out_values);
     case 12:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<12>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<12, num_states_t>>(
           num_values, src_buffer, out_values);
     case 13:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<13>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<13, num_states_t>>(
           num_values, src_buffer, out_values);
     case 14:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<14>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<14, num_states_t>>(
           num_values, src_buffer, out_values);
     case 15:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<15>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<15, num_states_t>>(
           num_values, src_buffer, out_values);
     case 16:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<16>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<16, num_states_t>>(
           num_values, src_buffer, out_values);
     case 17:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<17>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<17, num_states_t>>(
           num_values, src_buffer, out_values);
     case 18:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<18>>(
+      return DecodeRawSymbolsInternal<SymbolDecoderT<18, num_states_t>>(
           num_values, src_buffer, out_values);
     default:
       return false;
@@ -27,6 +27,7 @@ namespace draco {
 constexpr int32_t kMaxTagSymbolBitLength = 32;
 constexpr int kMaxRawEncodingBitLength = 18;
 constexpr int kDefaultSymbolCodingCompressionLevel = 7;
+constexpr int kDefaultNumInterleavedStates = 4;
 
 typedef uint64_t TaggedBitLengthFrequencies[kMaxTagSymbolBitLength];
 
@@ -42,6 +43,14 @@ bool SetSymbolEncodingCompressionLevel(Options *options,
   return true;
 }
 
+bool SetSymbolEncodingNumInterleavedStates(Options *options, int num_states) {
+  if (num_states != 1 && num_states != 2 && num_states != 4 &&
+      num_states != 8)
+    return false;
+  options->SetInt("symbol_encoding_num_interleaved_states", num_states);
+  return true;
+}
+
 // Computes bit lengths of the input values. If num_components > 1, the values
 // are processed in "num_components" sized chunks and the bit length is always
 // computed for the largest value from the chunk.
@@ -49,6 +58,7 @@ static void ComputeBitLengths(const uint32_t *symbols, int num_values,
                               int num_components,
                               std::vector<uint32_t> *out_bit_lengths,
                               uint32_t *out_max_value) {
+  out_bit_lengths->clear();
   out_bit_lengths->reserve(num_values);
   *out_max_value = 0;
   // Maximum integer value across all components.
@@ -71,7 +81,8 @@ static void ComputeBitLengths(const uint32_t *symbols, int num_values,
 }
 
 static int64_t ApproximateTaggedSchemeBits(
-    const std::vector<uint32_t> bit_lengths, int num_components) {
+    const std::vector<uint32_t> &bit_lengths, int num_components,
+    std::vector<int> *symbol_frequencies) {
   // Compute the total bit length used by all values (the length of data encode
   // after tags).
   uint64_t total_bit_length = 0;
@@ -80,8 +91,9 @@ static int64_t ApproximateTaggedSchemeBits(
   }
   // Compute the number of entropy bits for tags.
   int num_unique_symbols;
-  const int64_t tag_bits = ComputeShannonEntropy(
-      bit_lengths.data(), bit_lengths.size(), 32, &num_unique_symbols);
+  const int64_t tag_bits =
+      ComputeShannonEntropy(bit_lengths.data(), bit_lengths.size(), 32,
+                            &num_unique_symbols, symbol_frequencies);
   const int64_t tag_table_bits =
       ApproximateRAnsFrequencyTableBits(num_unique_symbols, num_unique_symbols);
   return tag_bits + tag_table_bits + total_bit_length * num_components;
@@ -89,50 +101,64 @@ static int64_t ApproximateTaggedSchemeBits(
 
 static int64_t ApproximateRawSchemeBits(const uint32_t *symbols,
                                         int num_symbols, uint32_t max_value,
-                                        int *out_num_unique_symbols) {
+                                        int *out_num_unique_symbols,
+                                        std::vector<int> *symbol_frequencies) {
   int num_unique_symbols;
-  const int64_t data_bits = ComputeShannonEntropy(
-      symbols, num_symbols, max_value, &num_unique_symbols);
+  const int64_t data_bits =
+      ComputeShannonEntropy(symbols, num_symbols, max_value,
+                            &num_unique_symbols, symbol_frequencies);
   const int64_t table_bits =
       ApproximateRAnsFrequencyTableBits(max_value, num_unique_symbols);
   *out_num_unique_symbols = num_unique_symbols;
   return table_bits + data_bits;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT>
 bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
                          int num_components,
                          const std::vector<uint32_t> &bit_lengths,
+                         SymbolEncodingBuffers *buffers,
                          EncoderBuffer *target_buffer);
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT, int num_states_t>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
                       uint32_t max_entry_value, int32_t num_unique_symbols,
-                      const Options *options, EncoderBuffer *target_buffer);
+                      const Options *options, SymbolEncodingBuffers *buffers,
+                      EncoderBuffer *target_buffer);
 
 bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                    const Options *options, EncoderBuffer *target_buffer) {
+  SymbolEncodingBuffers buffers;
+  return EncodeSymbols(symbols, num_values, num_components, options, &buffers,
+                       target_buffer);
+}
+
+bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
+                   const Options *options, SymbolEncodingBuffers *buffers,
+                   EncoderBuffer *target_buffer) {
   if (num_values < 0)
     return false;
   if (num_values == 0)
     return true;
   if (num_components <= 0)
     num_components = 1;
-  std::vector<uint32_t> bit_lengths;
+  std::vector<uint32_t> &bit_lengths = buffers->bit_lengths;
   uint32_t max_value;
   ComputeBitLengths(symbols, num_values, num_components, &bit_lengths,
                     &max_value);
 
   // Approximate number of bits needed for storing the symbols using the tagged
   // scheme.
-  const int64_t tagged_scheme_total_bits =
-      ApproximateTaggedSchemeBits(bit_lengths, num_components);
+  const int64_t tagged_scheme_total_bits = ApproximateTaggedSchemeBits(
+      bit_lengths, num_components, &buffers->symbol_frequencies);
 
   // Approximate number of bits needed for storing the symbols using the raw
   // scheme.
   int num_unique_symbols = 0;
-  const int64_t raw_scheme_total_bits = ApproximateRawSchemeBits(
-      symbols, num_values, max_value, &num_unique_symbols);
+  const int64_t raw_scheme_total_bits =
+      ApproximateRawSchemeBits(symbols, num_values, max_value,
+                               &num_unique_symbols,
+                               &buffers->symbol_frequencies);
 
   // The maximum bit length of a single entry value that we can encode using
   // the raw scheme.
@@ -150,25 +176,56 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
       method = SYMBOL_CODING_RAW;
     }
   }
+  int num_states = kDefaultNumInterleavedStates;
+  if (options != nullptr &&
+      options->IsOptionSet("symbol_encoding_num_interleaved_states")) {
+    num_states = options->GetInt("symbol_encoding_num_interleaved_states");
+    // The raw scheme is coded with the interleaved states when requested.
+    if (method == SYMBOL_CODING_RAW && num_states > 1)
+      method = SYMBOL_CODING_RAW_INTERLEAVED;
+  }
+  if (method == SYMBOL_CODING_RAW_INTERLEAVED && num_states == 1)
+    method = SYMBOL_CODING_RAW;
   // Use the tagged scheme.
   target_buffer->Encode(static_cast<uint8_t>(method));
   if (method == SYMBOL_CODING_TAGGED) {
-    return EncodeTaggedSymbols<RAnsSymbolEncoder>(
-        symbols, num_values, num_components, bit_lengths, target_buffer);
+    return EncodeTaggedSymbols<RAnsSymbolEncoder>(symbols, num_values,
+                                                  num_components, bit_lengths,
+                                                  buffers, target_buffer);
   }
   if (method == SYMBOL_CODING_RAW) {
-    return EncodeRawSymbols<RAnsSymbolEncoder>(symbols, num_values, max_value,
-                                               num_unique_symbols, options,
-                                               target_buffer);
+    return EncodeRawSymbols<RAnsSymbolEncoder, 1>(
+        symbols, num_values, max_value, num_unique_symbols, options, buffers,
+        target_buffer);
+  }
+  if (method == SYMBOL_CODING_RAW_INTERLEAVED) {
+    target_buffer->Encode(static_cast<uint8_t>(num_states));
+    switch (num_states) {
+      case 2:
+        return EncodeRawSymbols<RAnsSymbolEncoder, 2>(
+            symbols, num_values, max_value, num_unique_symbols, options,
+            buffers, target_buffer);
+      case 4:
+        return EncodeRawSymbols<RAnsSymbolEncoder, 4>(
+            symbols, num_values, max_value, num_unique_symbols, options,
+            buffers, target_buffer);
+      case 8:
+        return EncodeRawSymbols<RAnsSymbolEncoder, 8>(
+            symbols, num_values, max_value, num_unique_symbols, options,
+            buffers, target_buffer);
+      default:
+        return false;
+    }
   }
   // Unknown method selected.
   return false;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT>
 bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
                          int num_components,
                          const std::vector<uint32_t> &bit_lengths,
+                         SymbolEncodingBuffers *buffers,
                          EncoderBuffer *target_buffer) {
   // Create entries for entropy coding. Each entry corresponds to a different
   // number of bits that are necessary to encode a given value. Every value
@@ -186,15 +243,16 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
     ++frequencies[bit_lengths[i]];
   }
 
-  // Create one extra buffer to store raw value.
-  EncoderBuffer value_buffer;
+  // Use one extra buffer to store raw value.
+  EncoderBuffer &value_buffer = buffers->value_buffer;
+  value_buffer.Clear();
   // Number of expected bits we need to store the values (can be optimized if
   // needed).
   const uint64_t value_bits =
       kMaxTagSymbolBitLength * static_cast<uint64_t>(num_values);
 
   // Create encoder for encoding the bit tags.
-  SymbolEncoderT<5> tag_encoder;
+  SymbolEncoderT<5, 1> tag_encoder(&buffers->rans_buffers);
   tag_encoder.Create(frequencies, kMaxTagSymbolBitLength, target_buffer);
 
   // Start encoding bit tags.
@@ -239,14 +297,16 @@ bool EncodeTaggedSymbols(const uint32_t *symbols, int num_values,
 template <class SymbolEncoderT>
 bool EncodeRawSymbolsInternal(const uint32_t *symbols, int num_values,
                               uint32_t max_entry_value,
+                              SymbolEncodingBuffers *buffers,
                               EncoderBuffer *target_buffer) {
   // Count the frequency of each entry value.
-  std::vector<uint64_t> frequencies(max_entry_value + 1, 0);
+  std::vector<uint64_t> &frequencies = buffers->frequencies;
+  frequencies.assign(max_entry_value + 1, 0);
   for (int i = 0; i < num_values; ++i) {
     ++frequencies[symbols[i]];
   }
 
-  SymbolEncoderT encoder;
+  SymbolEncoderT encoder(&buffers->rans_buffers);
   encoder.Create(frequencies.data(), frequencies.size(), target_buffer);
   encoder.StartEncoding(target_buffer);
   // Encode all values.
@@ -263,10 +323,11 @@ bool EncodeRawSymbolsInternal(const uint32_t *symbols, int num_values,
   return true;
 }
 
-template <template <int> class SymbolEncoderT>
+template <template <int, int> class SymbolEncoderT, int num_states_t>
 bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
                       uint32_t max_entry_value, int32_t num_unique_symbols,
-                      const Options *options, EncoderBuffer *target_buffer) {
+                      const Options *options, SymbolEncodingBuffers *buffers,
+                      EncoderBuffer *target_buffer) {
   int symbol_bits = 0;
   if (num_unique_symbols > 0) {
     symbol_bits = bits::MostSignificantBit(num_unique_symbols);
@@ -307,59 +368,59 @@ bool EncodeRawSymbols(const uint32_t *symbols, int num_values,
     case 0:
       FALLTHROUGH_INTENDED;
     case 1:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<1>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<1, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 2:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<2>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<2, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 3:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<3>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<3, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 4:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<4>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<4, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 5:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<5>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<5, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 6:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<6>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<6, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 7:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<7>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<7, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 8:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<8>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<8, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 9:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<9>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<9, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 10:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<10>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<10, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 11:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<11>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<11, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 12:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<12>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<12, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 13:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<13>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<13, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 14:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<14>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<14, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 15:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<15>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<15, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 16:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<16>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<16, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 17:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<17>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<17, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     case 18:
-      return EncodeRawSymbolsInternal<SymbolEncoderT<18>>(
-          symbols, num_values, max_entry_value, target_buffer);
+      return EncodeRawSymbolsInternal<SymbolEncoderT<18, num_states_t>>(
+          symbols, num_values, max_entry_value, buffers, target_buffer);
     default:
       return false;
   }
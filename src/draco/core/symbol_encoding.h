@@ -15,12 +15,26 @@
 #ifndef DRACO_CORE_SYMBOL_ENCODING_H_
 #define DRACO_CORE_SYMBOL_ENCODING_H_
 
+#include <vector>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/options.h"
+#include "draco/core/rans_symbol_encoder.h"
 
 namespace draco {
 
+// Temporary memory used by EncodeSymbols(). Callers that encode symbols
+// repeatedly (e.g. an encoder that is reused for many frames) can keep one
+// instance and pass it to all calls so that the memory is allocated only once.
+struct SymbolEncodingBuffers {
+  std::vector<uint32_t> bit_lengths;
+  std::vector<int> symbol_frequencies;
+  std::vector<uint64_t> frequencies;
+  RAnsSymbolEncoderBuffers rans_buffers;
+  EncoderBuffer value_buffer;
+};
+
 // Encodes an array of symbols using an entropy coding. This function
 // automatically decides whether to encode the symbol values using using bit
 // length tags (see EncodeTaggedSymbols), or whether to encode them directly
@@ -32,6 +46,11 @@ namespace draco {
 bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                    const Options *options, EncoderBuffer *target_buffer);
 
+// Same as above, but all temporary memory is taken from |buffers|.
+bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
+                   const Options *options, SymbolEncodingBuffers *buffers,
+                   EncoderBuffer *target_buffer);
+
 // Sets an option that forces symbol encoder to use the specified encoding
 // method.
 void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
@@ -42,6 +61,15 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 // Returns false if an invalid level has been set.
 bool SetSymbolEncodingCompressionLevel(Options *options, int compression_level);
 
+// Sets the number of interleaved rANS states (1, 2, 4 or 8) used by the raw
+// encoding method. When more than one state is set, symbols that would be
+// encoded with SYMBOL_CODING_RAW are encoded with
+// SYMBOL_CODING_RAW_INTERLEAVED instead, which is faster to decode but adds a
+// few bytes for each state. If the option is not set, the raw method uses a
+// single state and SYMBOL_CODING_RAW_INTERLEAVED uses four states.
+// Returns false if an invalid number of states has been set.
+bool SetSymbolEncodingNumInterleavedStates(Options *options, int num_states);
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_SYMBOL_ENCODING_H_
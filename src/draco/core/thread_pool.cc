@@ -0,0 +1,128 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "draco/core/memory_arena.h"
+
+namespace draco {
+
+// Shared state of one ParallelFor() call. Iterations are claimed by the
+// participating threads through the atomic |next| counter.
+struct ThreadPool::Batch {
+  std::atomic<int> next;
+  int end;
+  const std::function<void(int)> *func;
+  // Number of iterations that have not been finished yet.
+  int num_remaining;
+  // Memory arena of the thread that called ParallelFor(). It is used by all
+  // threads processing the batch.
+  MemoryArena *arena;
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+ThreadPool::ThreadPool(int num_threads) : is_stopping_(false) {
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  task_available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(int begin, int end,
+                             const std::function<void(int)> &func) {
+  if (end <= begin)
+    return;
+  if (workers_.empty() || end - begin == 1) {
+    for (int i = begin; i < end; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::shared_ptr<Batch> batch(new Batch());
+  batch->next = begin;
+  batch->end = end;
+  batch->func = &func;
+  batch->num_remaining = end - begin;
+  batch->arena = MemoryArena::current();
+
+  // Wake up as many workers as can be useful. The calling thread processes
+  // the iterations as well.
+  const int num_helpers =
+      std::min(static_cast<int>(workers_.size()), end - begin - 1);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (int i = 0; i < num_helpers; ++i) {
+      tasks_.push_back([batch]() { RunBatch(batch.get()); });
+    }
+  }
+  if (num_helpers == 1) {
+    task_available_.notify_one();
+  } else {
+    task_available_.notify_all();
+  }
+
+  RunBatch(batch.get());
+
+  // Wait for iterations that are still processed by the other threads.
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->done.wait(lock, [&batch]() { return batch->num_remaining == 0; });
+}
+
+void ThreadPool::RunBatch(Batch *batch) {
+  const ScopedMemoryArena arena_scope(batch->arena);
+  int num_processed = 0;
+  for (int i = batch->next++; i < batch->end; i = batch->next++) {
+    (*batch->func)(i);
+    ++num_processed;
+  }
+  if (num_processed == 0)
+    return;
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->num_remaining -= num_processed;
+  if (batch->num_remaining == 0)
+    batch->done.notify_all();
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(
+          lock, [this]() { return is_stopping_ || !tasks_.empty(); });
+      if (tasks_.empty())
+        return;  // Stopping and there is nothing left to do.
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace draco
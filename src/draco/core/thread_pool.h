@@ -0,0 +1,66 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_THREAD_POOL_H_
+#define DRACO_CORE_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace draco {
+
+// Simple fixed size pool of worker threads used to run independent parts of
+// the encoding and decoding pipeline concurrently. The pool is designed around
+// a single blocking primitive, ParallelFor(), in which the calling thread
+// participates in the work. Because of that, ParallelFor() can be safely
+// called from within another ParallelFor() task without risking a deadlock.
+class ThreadPool {
+ public:
+  // Creates a pool that runs tasks on up to |num_threads| threads in total,
+  // including the thread calling ParallelFor(). I.e., |num_threads| - 1 worker
+  // threads are spawned. Values smaller than 2 create a pool that executes all
+  // tasks on the calling thread.
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  // Calls |func(i)| for every i in range <begin, end) and returns after all
+  // the calls are finished. The calls may be executed in any order and on any
+  // thread of the pool.
+  void ParallelFor(int begin, int end, const std::function<void(int)> &func);
+
+  // Returns the maximum number of threads that can execute tasks concurrently.
+  int num_threads() const { return workers_.size() + 1; }
+
+ private:
+  struct Batch;
+
+  void WorkerLoop();
+
+  // Runs all remaining iterations of the |batch| on the current thread.
+  static void RunBatch(Batch *batch);
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  bool is_stopping_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_THREAD_POOL_H_
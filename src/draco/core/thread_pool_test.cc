@@ -0,0 +1,57 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  ThreadPoolTest() {}
+};
+
+TEST_F(ThreadPoolTest, TestParallelFor) {
+  // Tests that every iteration of the loop is executed exactly once.
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    draco::ThreadPool pool(num_threads);
+    ASSERT_EQ(pool.num_threads(), num_threads);
+    std::vector<int> counts(1000, 0);
+    pool.ParallelFor(0, counts.size(), [&counts](int i) { counts[i]++; });
+    for (int count : counts) {
+      ASSERT_EQ(count, 1);
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, TestNestedParallelFor) {
+  // Tests that ParallelFor() can be called from within another ParallelFor()
+  // task on the same pool.
+  draco::ThreadPool pool(3);
+  std::vector<std::vector<int>> values(8, std::vector<int>(100, 0));
+  pool.ParallelFor(0, values.size(), [&pool, &values](int i) {
+    pool.ParallelFor(0, values[i].size(),
+                     [&values, i](int j) { values[i][j] = i + j; });
+  });
+  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+    for (int j = 0; j < static_cast<int>(values[i].size()); ++j) {
+      ASSERT_EQ(values[i][j], i + j);
+    }
+  }
+}
+
+}  // namespace
@@ -23,9 +23,10 @@
 namespace draco {
 
 // Encodes a specified integer as varint. Note that different coding is used
-// when IntTypeT is an unsigned data type.
-template <typename IntTypeT>
-bool EncodeVarint(IntTypeT val, EncoderBuffer *out_buffer) {
+// when IntTypeT is an unsigned data type. |out_buffer| is usually an
+// EncoderBuffer, but any type with a bool Encode(uint8_t) method can be used.
+template <typename IntTypeT, class BufferT = EncoderBuffer>
+bool EncodeVarint(IntTypeT val, BufferT *out_buffer) {
   if (std::is_unsigned<IntTypeT>::value) {
     // Coding of unsigned values.
     // 0-6 bit - data
@@ -52,6 +53,26 @@ bool EncodeVarint(IntTypeT val, EncoderBuffer *out_buffer) {
   return true;
 }
 
+// Buffer with a fixed capacity that can hold any varint encoded 64-bit value.
+// It can be passed to EncodeVarint() to encode a value without allocating any
+// memory.
+class FixedVarintBuffer {
+ public:
+  FixedVarintBuffer() : size_(0) {}
+  bool Encode(uint8_t value) {
+    if (size_ >= sizeof(data_))
+      return false;
+    data_[size_++] = value;
+    return true;
+  }
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  char data_[10];
+  size_t size_;
+};
+
 }  // namespace draco
 
 #endif  // DRACO_CORE_VARINT_ENCODING_H_
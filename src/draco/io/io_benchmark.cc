@@ -0,0 +1,218 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/io/mapped_file.h"
+#include "draco/io/mesh_io.h"
+#include "draco/io/obj_decoder.h"
+#include "draco/io/parser_utils.h"
+#include "draco/io/ply_decoder.h"
+
+namespace draco {
+
+namespace {
+
+// Parses an OBJ file that is already loaded in memory.
+void BM_ObjDecode(benchmark::State &state, const std::string &file_name) {
+  MappedFile file;
+  if (!file.Open(GetBenchmarkFileFullPath(file_name))) {
+    state.SkipWithError("Failed to open the file.");
+    return;
+  }
+  for (auto _ : state) {
+    DecoderBuffer buffer;
+    buffer.Init(file.data(), file.size());
+    ObjDecoder decoder;
+    Mesh mesh;
+    if (!decoder.DecodeFromBuffer(&buffer, &mesh).ok()) {
+      state.SkipWithError("Failed to decode the file.");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * file.size());
+}
+
+// Parses a PLY file that is already loaded in memory.
+void BM_PlyDecode(benchmark::State &state, const std::string &file_name) {
+  MappedFile file;
+  if (!file.Open(GetBenchmarkFileFullPath(file_name))) {
+    state.SkipWithError("Failed to open the file.");
+    return;
+  }
+  for (auto _ : state) {
+    DecoderBuffer buffer;
+    buffer.Init(file.data(), file.size());
+    PlyDecoder decoder;
+    Mesh mesh;
+    if (!decoder.DecodeFromBuffer(&buffer, &mesh)) {
+      state.SkipWithError("Failed to decode the file.");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * file.size());
+}
+
+// Loads a mesh including opening and reading of the file.
+void BM_ReadMeshFromFile(benchmark::State &state,
+                         const std::string &file_name) {
+  const std::string path = GetBenchmarkFileFullPath(file_name);
+  for (auto _ : state) {
+    if (!ReadMeshFromFile(path).ok()) {
+      state.SkipWithError("Failed to read the mesh.");
+      break;
+    }
+  }
+}
+
+// Number of values parsed by the float parsing benchmarks.
+constexpr int kNumParsedFloats = 300000;
+
+// Returns |num_values| random floats with six decimals stored as text with
+// three values per line, as they are stored in OBJ and ASCII PLY files.
+std::string GenerateFloatText(int num_values) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-100.f, 100.f);
+  std::string text;
+  char value[32];
+  for (int i = 0; i < num_values; ++i) {
+    snprintf(value, sizeof(value), "%.6f%c", dist(rng),
+             i % 3 == 2 ? '\n' : ' ');
+    text += value;
+  }
+  return text;
+}
+
+// The float parser used before parser::ParseFloat() was made correctly
+// rounded. It is kept here as the baseline of the parser benchmarks.
+bool LegacyParseFloat(DecoderBuffer *buffer, float *value) {
+  char ch;
+  if (!buffer->Peek(&ch))
+    return false;
+  int sign = parser::GetSignValue(ch);
+  if (sign != 0) {
+    buffer->Advance(1);
+  } else {
+    sign = 1;
+  }
+  bool have_digits = false;
+  double v = 0.0;
+  while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
+    v *= 10.0;
+    v += (ch - '0');
+    buffer->Advance(1);
+    have_digits = true;
+  }
+  if (ch == '.') {
+    buffer->Advance(1);
+    double fraction = 1.0;
+    while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
+      fraction *= 0.1;
+      v += (ch - '0') * fraction;
+      buffer->Advance(1);
+      have_digits = true;
+    }
+  }
+  if (!have_digits)
+    return false;
+  if (ch == 'e' || ch == 'E') {
+    buffer->Advance(1);
+    int32_t exponent = 0;
+    if (!parser::ParseSignedInt(buffer, &exponent))
+      return false;
+    v *= std::pow(10.0, exponent);
+  }
+  *value = static_cast<float>(sign < 0 ? -v : v);
+  return true;
+}
+
+// Parses the values one by one with the legacy parser.
+void BM_LegacyParseFloat(benchmark::State &state) {
+  const std::string text = GenerateFloatText(kNumParsedFloats);
+  std::vector<float> values(kNumParsedFloats);
+  for (auto _ : state) {
+    DecoderBuffer buffer;
+    buffer.Init(text.data(), text.size());
+    for (int i = 0; i < kNumParsedFloats; ++i) {
+      parser::SkipWhitespace(&buffer);
+      if (!LegacyParseFloat(&buffer, &values[i])) {
+        state.SkipWithError("Failed to parse the values.");
+        return;
+      }
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumParsedFloats);
+}
+
+// Parses the values one by one with parser::ParseFloat().
+void BM_ParseFloat(benchmark::State &state) {
+  const std::string text = GenerateFloatText(kNumParsedFloats);
+  std::vector<float> values(kNumParsedFloats);
+  for (auto _ : state) {
+    DecoderBuffer buffer;
+    buffer.Init(text.data(), text.size());
+    for (int i = 0; i < kNumParsedFloats; ++i) {
+      parser::SkipWhitespace(&buffer);
+      if (!parser::ParseFloat(&buffer, &values[i])) {
+        state.SkipWithError("Failed to parse the values.");
+        return;
+      }
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumParsedFloats);
+}
+
+// Parses the values three at a time with parser::ParseFloats().
+void BM_ParseFloats(benchmark::State &state) {
+  const std::string text = GenerateFloatText(kNumParsedFloats);
+  std::vector<float> values(kNumParsedFloats);
+  for (auto _ : state) {
+    DecoderBuffer buffer;
+    buffer.Init(text.data(), text.size());
+    for (int i = 0; i < kNumParsedFloats; i += 3) {
+      if (!parser::ParseFloats(&buffer, 3, &values[i])) {
+        state.SkipWithError("Failed to parse the values.");
+        return;
+      }
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumParsedFloats);
+}
+
+}  // namespace
+
+BENCHMARK(BM_LegacyParseFloat);
+BENCHMARK(BM_ParseFloat);
+BENCHMARK(BM_ParseFloats);
+BENCHMARK_CAPTURE(BM_ObjDecode, cube_subd, std::string("cube_subd.obj"));
+BENCHMARK_CAPTURE(BM_ObjDecode, mat_test, std::string("mat_test.obj"));
+BENCHMARK_CAPTURE(BM_PlyDecode, bun_zipper, std::string("bun_zipper.ply"));
+BENCHMARK_CAPTURE(BM_PlyDecode, test_pos_color,
+                  std::string("test_pos_color.ply"));
+BENCHMARK_CAPTURE(BM_ReadMeshFromFile, cube_subd,
+                  std::string("cube_subd.obj"));
+BENCHMARK_CAPTURE(BM_ReadMeshFromFile, bun_zipper,
+                  std::string("bun_zipper.ply"));
+
+}  // namespace draco
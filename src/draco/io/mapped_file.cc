@@ -0,0 +1,131 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/mapped_file.h"
+
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#define DRACO_MMAP_SUPPORTED
+#elif !defined(__EMSCRIPTEN__) && \
+    (defined(__unix__) || defined(__APPLE__) || defined(__linux__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DRACO_MMAP_SUPPORTED
+#endif
+
+namespace draco {
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_data_(nullptr) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string &file_name) {
+  Close();
+  if (MapFile(file_name))
+    return true;
+  // Fall back to reading the file when the mapping is not possible.
+  Close();
+  return ReadFile(file_name);
+}
+
+void MappedFile::Close() {
+  if (mapped_data_ != nullptr) {
+#if defined(_WIN32)
+    UnmapViewOfFile(mapped_data_);
+#elif defined(DRACO_MMAP_SUPPORTED)
+    munmap(mapped_data_, size_);
+#endif
+    mapped_data_ = nullptr;
+  }
+  std::vector<char>().swap(file_data_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool MappedFile::MapFile(const std::string &file_name) {
+#if defined(_WIN32)
+  const HANDLE file =
+      CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  const HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+    return false;
+  // The view keeps the mapping alive after its handle is closed.
+  mapped_data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (mapped_data_ == nullptr)
+    return false;
+  size_ = static_cast<size_t>(file_size.QuadPart);
+#elif defined(DRACO_MMAP_SUPPORTED)
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  const size_t file_size = static_cast<size_t>(file_stat.st_size);
+  void *const mapped_data =
+      mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (mapped_data == MAP_FAILED)
+    return false;
+  // The file is usually parsed from the beginning to the end.
+  posix_madvise(mapped_data, file_size, POSIX_MADV_SEQUENTIAL);
+  mapped_data_ = mapped_data;
+  size_ = file_size;
+#else
+  (void)file_name;
+  return false;
+#endif
+  data_ = static_cast<const char *>(mapped_data_);
+  return true;
+}
+
+bool MappedFile::ReadFile(const std::string &file_name) {
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file)
+    return false;
+  file.seekg(0, std::ios::end);
+  const std::streamoff file_size = file.tellg();
+  if (file_size <= 0)
+    return false;
+  file.seekg(0, std::ios::beg);
+  file_data_.resize(static_cast<size_t>(file_size));
+  if (!file.read(&file_data_[0], file_size))
+    return false;
+  data_ = &file_data_[0];
+  size_ = file_data_.size();
+  return true;
+}
+
+}  // namespace draco
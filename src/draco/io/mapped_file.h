@@ -0,0 +1,60 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_MAPPED_FILE_H_
+#define DRACO_IO_MAPPED_FILE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+namespace draco {
+
+// Provides read-only access to the content of a file. Whenever the platform
+// supports it, the file is mapped into memory so that its content is paged in
+// on demand and no copy of the data is made. On other platforms the content of
+// the file is read into an internal buffer.
+class MappedFile {
+ public:
+  MappedFile();
+  ~MappedFile();
+
+  // Opens the file |file_name|. Any previously opened file is closed.
+  // Returns false when the file can't be opened or when it is empty.
+  bool Open(const std::string &file_name);
+  void Close();
+
+  // Returns the content of the opened file or nullptr if no file is open.
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  // MappedFile is non-copyable.
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool MapFile(const std::string &file_name);
+  bool ReadFile(const std::string &file_name);
+
+  const char *data_;
+  size_t size_;
+  // Memory mapped by MapFile(). nullptr when the data were read by ReadFile().
+  void *mapped_data_;
+  std::vector<char> file_data_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_MAPPED_FILE_H_
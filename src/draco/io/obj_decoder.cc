@@ -14,15 +14,287 @@
 //
 #include "draco/io/obj_decoder.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 
+#include "draco/core/thread_pool.h"
+#include "draco/io/mapped_file.h"
 #include "draco/io/parser_utils.h"
 #include "draco/metadata/geometry_metadata.h"
 
 namespace draco {
 
+namespace {
+
+// Parses triplet of position, tex coords and normal indices.
+// Returns false on error.
+bool ParseVertexIndices(DecoderBuffer *buffer,
+                        std::array<int32_t, 3> *out_indices) {
+  // Parsed attribute indices can be in format:
+  // 1. POS_INDEX
+  // 2. POS_INDEX/TEX_COORD_INDEX
+  // 3. POS_INDEX/TEX_COORD_INDEX/NORMAL_INDEX
+  // 4. POS_INDEX//NORMAL_INDEX
+  parser::SkipCharacters(buffer, " \t");
+  if (!parser::ParseSignedInt(buffer, &(*out_indices)[0]) ||
+      (*out_indices)[0] == 0)
+    return false;  // Position index must be present and valid.
+  (*out_indices)[1] = (*out_indices)[2] = 0;
+  char ch;
+  if (!buffer->Peek(&ch))
+    return true;  // It may be OK if we cannot read any more characters.
+  if (ch != '/')
+    return true;
+  buffer->Advance(1);
+  // Check if we should skip texture index or not.
+  if (!buffer->Peek(&ch))
+    return false;  // Here, we should be always able to read the next char.
+  if (ch != '/') {
+    // Must be texture coord index.
+    if (!parser::ParseSignedInt(buffer, &(*out_indices)[1]) ||
+        (*out_indices)[1] == 0)
+      return false;  // Texture index must be present and valid.
+  }
+  if (!buffer->Peek(&ch))
+    return true;
+  if (ch == '/') {
+    buffer->Advance(1);
+    // Read normal index.
+    if (!parser::ParseSignedInt(buffer, &(*out_indices)[2]) ||
+        (*out_indices)[2] == 0)
+      return false;  // Normal index must be present and valid.
+  }
+  return true;
+}
+
+// Minimum size of the input in bytes that is parsed by a single task of
+// ObjDecoder::DecodeInternalParallel().
+constexpr size_t kMinParallelChunkSize = 1 << 16;
+
+// Definition that needs to be processed in the order in which it appears in
+// the input data, after all preceding chunks are merged.
+struct ObjDirective {
+  enum Type { MATERIAL_LIB, MATERIAL, OBJECT };
+
+  Type type;
+  std::string name;
+  // Number of faces defined in the chunk before the directive.
+  int num_preceding_faces;
+  // Material or sub-object id assigned to |name| during the merging.
+  int id;
+};
+
+// Data parsed from a range of whole lines of the input.
+struct ObjChunk {
+  ObjChunk()
+      : status(Status::OK),
+        first_position(0),
+        first_tex_coord(0),
+        first_normal(0),
+        first_face(0),
+        material_id(0),
+        sub_obj_id(0) {}
+
+  DecoderBuffer buffer;
+  Status status;
+  std::vector<float> positions;
+  std::vector<float> tex_coords;
+  std::vector<float> normals;
+  // Zero based position, texture coordinate and normal indices for each
+  // corner of the parsed triangles. Missing indices are stored as 0. Relative
+  // (negative) indices are resolved using only the values parsed in this
+  // chunk, they are listed in |relative_indices| as 3 * corner + component
+  // and they are offset when the chunks are merged.
+  std::vector<std::array<int32_t, 3>> corners;
+  std::vector<size_t> relative_indices;
+  std::vector<ObjDirective> directives;
+
+  // Offsets of the chunk data in the merged geometry and the material and
+  // sub-object ids that are active at the start of the chunk.
+  int first_position;
+  int first_tex_coord;
+  int first_normal;
+  int first_face;
+  int material_id;
+  int sub_obj_id;
+};
+
+void AddDirective(ObjDirective::Type type, const std::string &name,
+                  ObjChunk *chunk) {
+  ObjDirective directive;
+  directive.type = type;
+  directive.name = name;
+  directive.num_preceding_faces = chunk->corners.size() / 3;
+  directive.id = 0;
+  chunk->directives.push_back(directive);
+}
+
+void AddCorner(const std::array<int32_t, 3> &indices, ObjChunk *chunk) {
+  const int num_values[3] = {static_cast<int>(chunk->positions.size() / 3),
+                             static_cast<int>(chunk->tex_coords.size() / 2),
+                             static_cast<int>(chunk->normals.size() / 3)};
+  std::array<int32_t, 3> corner;
+  for (int i = 0; i < 3; ++i) {
+    if (indices[i] > 0) {
+      corner[i] = indices[i] - 1;
+    } else if (indices[i] < 0) {
+      corner[i] = num_values[i] + indices[i];
+      chunk->relative_indices.push_back(3 * chunk->corners.size() + i);
+    } else {
+      corner[i] = 0;
+    }
+  }
+  chunk->corners.push_back(corner);
+}
+
+bool ParseChunkValues(int num_components, DecoderBuffer *buffer,
+                      std::vector<float> *out_values) {
+  const size_t num_values = out_values->size();
+  out_values->resize(num_values + num_components);
+  return parser::ParseFloats(buffer, num_components,
+                             &(*out_values)[num_values]);
+}
+
+bool ParseChunkFace(ObjChunk *chunk) {
+  DecoderBuffer *const buffer = &chunk->buffer;
+  buffer->Advance(1);
+  // Count the indices the same way as ObjDecoder::ParseFace() in the counting
+  // mode to reject the same faces.
+  DecoderBuffer count_buffer = *buffer;
+  parser::SkipWhitespace(&count_buffer);
+  int num_indices = 0;
+  bool is_end = false;
+  char c;
+  while (count_buffer.Peek(&c) && c != '\n') {
+    if (parser::PeekWhitespace(&count_buffer, &is_end)) {
+      count_buffer.Advance(1);
+    } else {
+      num_indices++;
+      while (!parser::PeekWhitespace(&count_buffer, &is_end) && !is_end) {
+        count_buffer.Advance(1);
+      }
+    }
+  }
+  if (num_indices < 3 || num_indices > 4) {
+    chunk->status =
+        Status(Status::ERROR, "Invalid number of indices on a face");
+    return false;
+  }
+  std::array<int32_t, 3> indices[4];
+  int num_valid_indices = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (!ParseVertexIndices(buffer, &indices[i])) {
+      if (i == 3)
+        break;
+      chunk->status = Status(Status::ERROR, "Failed to parse vertex indices");
+      return false;
+    }
+    ++num_valid_indices;
+  }
+  AddCorner(indices[0], chunk);
+  AddCorner(indices[1], chunk);
+  AddCorner(indices[2], chunk);
+  if (num_valid_indices == 4) {
+    // Second triangle of the quad, see ObjDecoder::ParseFace().
+    AddCorner(indices[0], chunk);
+    AddCorner(indices[2], chunk);
+    AddCorner(indices[3], chunk);
+  }
+  parser::SkipLine(buffer);
+  return true;
+}
+
+// Parses the next definition of the chunk. The definitions are recognized in
+// the same order as in ObjDecoder::ParseDefinition().
+// Returns false when the end of the chunk was reached or on error.
+bool ParseChunkDefinition(ObjChunk *chunk) {
+  DecoderBuffer *const buffer = &chunk->buffer;
+  char c;
+  parser::SkipWhitespace(buffer);
+  if (!buffer->Peek(&c))
+    return false;
+  if (c == '#') {
+    parser::SkipLine(buffer);
+    return true;
+  }
+  std::array<char, 2> c2;
+  if (c == 'v' && buffer->Peek(&c2)) {
+    std::vector<float> *values = nullptr;
+    int num_components = 3;
+    if (c2[1] == ' ') {
+      values = &chunk->positions;
+    } else if (c2[1] == 'n') {
+      values = &chunk->normals;
+    } else if (c2[1] == 't') {
+      values = &chunk->tex_coords;
+      num_components = 2;
+    }
+    if (values != nullptr) {
+      buffer->Advance(2);
+      if (!ParseChunkValues(num_components, buffer, values)) {
+        chunk->status = Status(Status::ERROR, "Failed to parse a float number");
+        return false;
+      }
+      parser::SkipLine(buffer);
+      return true;
+    }
+  }
+  if (c == 'f')
+    return ParseChunkFace(chunk);
+  std::array<char, 6> c6;
+  std::string name;
+  if (buffer->Peek(&c6) && std::memcmp(&c6[0], "usemtl", 6) == 0) {
+    buffer->Advance(6);
+    DecoderBuffer line_buffer = parser::ParseLineIntoDecoderBuffer(buffer);
+    parser::SkipWhitespace(&line_buffer);
+    parser::ParseLine(&line_buffer, &name);
+    if (name.length() > 0) {
+      AddDirective(ObjDirective::MATERIAL, name, chunk);
+      return true;
+    }
+    // Same as in ObjDecoder::ParseDefinition(), the remaining definitions are
+    // matched against the following line.
+  }
+  if (buffer->Peek(&c6) && std::memcmp(&c6[0], "mtllib", 6) == 0) {
+    buffer->Advance(6);
+    DecoderBuffer line_buffer = parser::ParseLineIntoDecoderBuffer(buffer);
+    parser::SkipWhitespace(&line_buffer);
+    if (!parser::ParseString(&line_buffer, &name)) {
+      chunk->status =
+          Status(Status::ERROR, "Failed to parse material file name");
+      return false;
+    }
+    AddDirective(ObjDirective::MATERIAL_LIB, name, chunk);
+    return true;
+  }
+  if (buffer->Peek(&c2) && std::memcmp(&c2[0], "o ", 2) == 0) {
+    buffer->Advance(1);
+    DecoderBuffer line_buffer = parser::ParseLineIntoDecoderBuffer(buffer);
+    parser::SkipWhitespace(&line_buffer);
+    if (parser::ParseString(&line_buffer, &name)) {
+      if (name.length() > 0)
+        AddDirective(ObjDirective::OBJECT, name, chunk);
+      return true;
+    }
+  }
+  parser::SkipLine(buffer);
+  return true;
+}
+
+// Writes parsed attribute values starting at the value |first_value|.
+void CopyChunkValues(const std::vector<float> &values, int first_value,
+                     PointAttribute *att) {
+  if (att == nullptr || values.empty())
+    return;
+  att->buffer()->Write(first_value * att->byte_stride(), values.data(),
+                       values.size() * sizeof(float));
+}
+
+}  // namespace
+
 ObjDecoder::ObjDecoder()
     : counting_mode_(true),
       num_obj_faces_(0),
@@ -39,6 +311,7 @@ ObjDecoder::ObjDecoder()
       deduplicate_input_values_(true),
       last_material_id_(0),
       use_metadata_(false),
+      num_threads_(1),
       out_mesh_(nullptr),
       out_point_cloud_(nullptr) {}
 
@@ -50,22 +323,17 @@ Status ObjDecoder::DecodeFromFile(const std::string &file_name,
 
 Status ObjDecoder::DecodeFromFile(const std::string &file_name,
                                   PointCloud *out_point_cloud) {
-  std::ifstream file(file_name, std::ios::binary);
-  if (!file)
-    return Status(Status::IO_ERROR);
-  // Read the whole file into a buffer.
-  auto pos0 = file.tellg();
-  file.seekg(0, std::ios::end);
-  auto file_size = file.tellg() - pos0;
-  if (file_size == 0)
+  // The file is mapped into memory and it must stay open until the decoding
+  // is finished.
+  MappedFile file;
+  if (!file.Open(file_name))
     return Status(Status::IO_ERROR);
-  file.seekg(0, std::ios::beg);
-  std::vector<char> data(file_size);
-  file.read(&data[0], file_size);
-  buffer_.Init(&data[0], file_size);
+  buffer_.Init(file.data(), file.size());
 
   out_point_cloud_ = out_point_cloud;
   input_file_name_ = file_name;
+  if (num_threads_ > 1)
+    return DecodeInternalParallel();
   return DecodeInternal();
 }
 
@@ -78,6 +346,8 @@ Status ObjDecoder::DecodeFromBuffer(DecoderBuffer *buffer,
                                     PointCloud *out_point_cloud) {
   out_point_cloud_ = out_point_cloud;
   buffer_.Init(buffer->data_head(), buffer->remaining_size());
+  if (num_threads_ > 1)
+    return DecodeInternalParallel();
   return DecodeInternal();
 }
 
@@ -96,6 +366,167 @@ Status ObjDecoder::DecodeInternal() {
   }
   if (!status.ok())
     return status;
+  status = AddAttributes();
+  if (!status.ok())
+    return status;
+
+  // Perform a second iteration of parsing and fill all the data.
+  counting_mode_ = false;
+  ResetCounters();
+  // Start parsing from the beginning of the buffer again.
+  buffer()->StartDecodingFrom(0);
+  while (ParseDefinition(&status) && status.ok()) {
+  }
+  if (!status.ok())
+    return status;
+  FinalizeGeometry(nullptr);
+  return status;
+}
+
+Status ObjDecoder::DecodeInternalParallel() {
+  const size_t size = buffer()->remaining_size();
+  const size_t num_chunks =
+      std::min(static_cast<size_t>(4 * num_threads_),
+               size / kMinParallelChunkSize);
+  if (num_chunks < 2)
+    return DecodeInternal();
+
+  // Split the input into chunks of whole lines.
+  const char *const data = buffer()->data_head();
+  const char *const data_end = data + size;
+  std::vector<ObjChunk> chunks;
+  chunks.reserve(num_chunks);
+  const char *chunk_begin = data;
+  for (size_t i = 1; i <= num_chunks && chunk_begin < data_end; ++i) {
+    const char *chunk_end = data_end;
+    if (i < num_chunks) {
+      chunk_end = std::max(chunk_begin, data + size / num_chunks * i);
+      const void *const line_end =
+          std::memchr(chunk_end, '\n', data_end - chunk_end);
+      chunk_end = line_end ? static_cast<const char *>(line_end) + 1 : data_end;
+    }
+    chunks.push_back(ObjChunk());
+    chunks.back().buffer.Init(chunk_begin, chunk_end - chunk_begin);
+    chunk_begin = chunk_end;
+  }
+
+  const int num_split_chunks = chunks.size();
+  ThreadPool thread_pool(num_threads_);
+  thread_pool.ParallelFor(0, num_split_chunks, [&chunks](int i) {
+    while (ParseChunkDefinition(&chunks[i])) {
+    }
+  });
+
+  // Compute offsets of all chunks and process materials and sub-objects in
+  // the same order as in the first pass of DecodeInternal().
+  ResetCounters();
+  material_name_to_id_.clear();
+  Status status(Status::OK);
+  for (ObjChunk &chunk : chunks) {
+    if (!chunk.status.ok())
+      return chunk.status;
+    chunk.first_position = num_positions_;
+    chunk.first_tex_coord = num_tex_coords_;
+    chunk.first_normal = num_normals_;
+    chunk.first_face = num_obj_faces_;
+    chunk.material_id = last_material_id_;
+    chunk.sub_obj_id = last_sub_obj_id_;
+    num_positions_ += chunk.positions.size() / 3;
+    num_tex_coords_ += chunk.tex_coords.size() / 2;
+    num_normals_ += chunk.normals.size() / 3;
+    num_obj_faces_ += chunk.corners.size() / 3;
+    for (ObjDirective &directive : chunk.directives) {
+      if (directive.type == ObjDirective::MATERIAL_LIB) {
+        // Allow only one material library per file (see ParseMaterialLib()).
+        if (material_name_to_id_.size() > 0)
+          continue;
+        material_file_name_ = directive.name;
+        if (material_file_name_.size() > 0)
+          ParseMaterialFile(material_file_name_, &status);
+      } else if (directive.type == ObjDirective::MATERIAL) {
+        auto it = material_name_to_id_.find(directive.name);
+        if (it == material_name_to_id_.end()) {
+          last_material_id_ = num_materials_;
+          material_name_to_id_[directive.name] = num_materials_++;
+        } else {
+          last_material_id_ = it->second;
+        }
+        directive.id = last_material_id_;
+      } else {
+        auto it = obj_name_to_id_.find(directive.name);
+        if (it == obj_name_to_id_.end()) {
+          const int num_obj = obj_name_to_id_.size();
+          obj_name_to_id_[directive.name] = num_obj;
+          last_sub_obj_id_ = num_obj;
+        } else {
+          last_sub_obj_id_ = it->second;
+        }
+        directive.id = last_sub_obj_id_;
+      }
+    }
+  }
+  status = AddAttributes();
+  if (!status.ok())
+    return status;
+
+  // Copy the parsed data to the output geometry.
+  thread_pool.ParallelFor(0, num_split_chunks, [this, &chunks](int i) {
+    ObjChunk *const chunk = &chunks[i];
+    PointAttribute *const atts[3] = {
+        pos_att_id_ >= 0 ? out_point_cloud_->attribute(pos_att_id_) : nullptr,
+        tex_att_id_ >= 0 ? out_point_cloud_->attribute(tex_att_id_) : nullptr,
+        norm_att_id_ >= 0 ? out_point_cloud_->attribute(norm_att_id_)
+                          : nullptr};
+    CopyChunkValues(chunk->positions, chunk->first_position, atts[0]);
+    CopyChunkValues(chunk->tex_coords, chunk->first_tex_coord, atts[1]);
+    CopyChunkValues(chunk->normals, chunk->first_normal, atts[2]);
+    if (chunk->corners.empty())
+      return;
+
+    const int value_offsets[3] = {chunk->first_position,
+                                  chunk->first_tex_coord, chunk->first_normal};
+    for (const size_t index : chunk->relative_indices) {
+      chunk->corners[index / 3][index % 3] += value_offsets[index % 3];
+    }
+    PointAttribute *const material_att =
+        material_att_id_ >= 0 ? out_point_cloud_->attribute(material_att_id_)
+                              : nullptr;
+    PointAttribute *const sub_obj_att =
+        sub_obj_att_id_ >= 0 ? out_point_cloud_->attribute(sub_obj_att_id_)
+                             : nullptr;
+    int material_id = chunk->material_id;
+    int sub_obj_id = chunk->sub_obj_id;
+    size_t next_directive = 0;
+    for (size_t c = 0; c < chunk->corners.size(); ++c) {
+      // Apply all directives that precede the current face.
+      while (next_directive < chunk->directives.size() &&
+             3 * chunk->directives[next_directive].num_preceding_faces <=
+                 static_cast<int>(c)) {
+        const ObjDirective &directive = chunk->directives[next_directive++];
+        if (directive.type == ObjDirective::MATERIAL) {
+          material_id = directive.id;
+        } else if (directive.type == ObjDirective::OBJECT) {
+          sub_obj_id = directive.id;
+        }
+      }
+      const PointIndex pi(3 * chunk->first_face + c);
+      for (int j = 0; j < 3; ++j) {
+        if (atts[j] != nullptr) {
+          atts[j]->SetPointMapEntry(
+              pi, AttributeValueIndex(chunk->corners[c][j]));
+        }
+      }
+      if (material_att != nullptr)
+        material_att->SetPointMapEntry(pi, AttributeValueIndex(material_id));
+      if (sub_obj_att != nullptr)
+        sub_obj_att->SetPointMapEntry(pi, AttributeValueIndex(sub_obj_id));
+    }
+  });
+  FinalizeGeometry(&thread_pool);
+  return OkStatus();
+}
+
+Status ObjDecoder::AddAttributes() {
   bool use_identity_mapping = false;
   if (num_obj_faces_ == 0) {
     // Mesh has no faces. In this case we try to read the geometry as a point
@@ -215,15 +646,10 @@ Status ObjDecoder::DecodeInternal() {
     }
   }
 
-  // Perform a second iteration of parsing and fill all the data.
-  counting_mode_ = false;
-  ResetCounters();
-  // Start parsing from the beginning of the buffer again.
-  buffer()->StartDecodingFrom(0);
-  while (ParseDefinition(&status) && status.ok()) {
-  }
-  if (!status.ok())
-    return status;
+  return OkStatus();
+}
+
+void ObjDecoder::FinalizeGeometry(ThreadPool *thread_pool) {
   if (out_mesh_) {
     // Add faces with identity mapping between vertex and corner indices.
     // Duplicate vertices will get removed later.
@@ -236,11 +662,10 @@ Status ObjDecoder::DecodeInternal() {
   }
 #ifdef DRACO_ATTRIBUTE_DEDUPLICATION_SUPPORTED
   if (deduplicate_input_values_) {
-    out_point_cloud_->DeduplicateAttributeValues();
+    out_point_cloud_->DeduplicateAttributeValues(thread_pool);
   }
-  out_point_cloud_->DeduplicatePointIds();
+  out_point_cloud_->DeduplicatePointIds(thread_pool);
 #endif
-  return status;
 }
 
 void ObjDecoder::ResetCounters() {
@@ -295,13 +720,10 @@ bool ObjDecoder::ParseVertexPosition(Status *status) {
   if (!counting_mode_) {
     // Parse three float numbers for vertex position coordinates.
     float val[3];
-    for (int i = 0; i < 3; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+    if (!parser::ParseFloats(buffer(), 3, val)) {
+      *status = Status(Status::ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
     out_point_cloud_->attribute(pos_att_id_)
         ->SetAttributeValue(AttributeValueIndex(num_positions_), val);
@@ -323,13 +745,10 @@ bool ObjDecoder::ParseNormal(Status *status) {
   if (!counting_mode_) {
     // Parse three float numbers for the normal vector.
     float val[3];
-    for (int i = 0; i < 3; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+    if (!parser::ParseFloats(buffer(), 3, val)) {
+      *status = Status(Status::ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
     out_point_cloud_->attribute(norm_att_id_)
         ->SetAttributeValue(AttributeValueIndex(num_normals_), val);
@@ -351,13 +770,10 @@ bool ObjDecoder::ParseTexCoord(Status *status) {
   if (!counting_mode_) {
     // Parse two float numbers for the texture coordinate.
     float val[2];
-    for (int i = 0; i < 2; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+    if (!parser::ParseFloats(buffer(), 2, val)) {
+      *status = Status(Status::ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
     out_point_cloud_->attribute(tex_att_id_)
         ->SetAttributeValue(AttributeValueIndex(num_tex_coords_), val);
@@ -381,7 +797,7 @@ bool ObjDecoder::ParseFace(Status *status) {
     // Parse face indices (we try to look for up to four to support quads).
     int num_valid_indices = 0;
     for (int i = 0; i < 4; ++i) {
-      if (!ParseVertexIndices(&indices[i])) {
+      if (!ParseVertexIndices(buffer(), &indices[i])) {
         if (i == 3) {
           break;  // It's OK if there is no fourth vertex index.
         }
@@ -524,44 +940,6 @@ bool ObjDecoder::ParseObject(Status *status) {
   return true;
 }
 
-bool ObjDecoder::ParseVertexIndices(std::array<int32_t, 3> *out_indices) {
-  // Parsed attribute indices can be in format:
-  // 1. POS_INDEX
-  // 2. POS_INDEX/TEX_COORD_INDEX
-  // 3. POS_INDEX/TEX_COORD_INDEX/NORMAL_INDEX
-  // 4. POS_INDEX//NORMAL_INDEX
-  parser::SkipCharacters(buffer(), " \t");
-  if (!parser::ParseSignedInt(buffer(), &(*out_indices)[0]) ||
-      (*out_indices)[0] == 0)
-    return false;  // Position index must be present and valid.
-  (*out_indices)[1] = (*out_indices)[2] = 0;
-  char ch;
-  if (!buffer()->Peek(&ch))
-    return true;  // It may be OK if we cannot read any more characters.
-  if (ch != '/')
-    return true;
-  buffer()->Advance(1);
-  // Check if we should skip texture index or not.
-  if (!buffer()->Peek(&ch))
-    return false;  // Here, we should be always able to read the next char.
-  if (ch != '/') {
-    // Must be texture coord index.
-    if (!parser::ParseSignedInt(buffer(), &(*out_indices)[1]) ||
-        (*out_indices)[1] == 0)
-      return false;  // Texture index must be present and valid.
-  }
-  if (!buffer()->Peek(&ch))
-    return true;
-  if (ch == '/') {
-    buffer()->Advance(1);
-    // Read normal index.
-    if (!parser::ParseSignedInt(buffer(), &(*out_indices)[2]) ||
-        (*out_indices)[2] == 0)
-      return false;  // Normal index must be present and valid.
-  }
-  return true;
-}
-
 void ObjDecoder::MapPointToVertexIndices(
     PointIndex vert_id, const std::array<int32_t, 3> &indices) {
   // Use face entries to store mapping between vertex and attribute indices
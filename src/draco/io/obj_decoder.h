@@ -24,6 +24,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // Decodes a Wavefront OBJ file into draco::Mesh (or draco::PointCloud if the
 // connectivity data is not needed).. This decoder can handle decoding of
 // positions, texture coordinates, normals and triangular faces.
@@ -49,15 +51,32 @@ class ObjDecoder {
   // Flag for whether using metadata to record other information in the obj
   // file, e.g. material names, object names.
   void set_use_metadata(bool flag) { use_metadata_ = flag; }
+  // Sets the maximum number of threads used for parsing and deduplication.
+  // When more than one thread is allowed, large inputs are split into chunks
+  // at line boundaries that are parsed concurrently. The decoded geometry is
+  // the same for any number of threads.
+  // Default: 1
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
 
  protected:
   Status DecodeInternal();
+  // Same as DecodeInternal() but the input is parsed only once, in chunks that
+  // are processed in parallel and merged afterwards.
+  Status DecodeInternalParallel();
   DecoderBuffer *buffer() { return &buffer_; }
 
  private:
   // Resets internal counters for attributes and faces.
   void ResetCounters();
 
+  // Adds all attributes to the output geometry using the counts of parsed
+  // elements.
+  Status AddAttributes();
+
+  // Adds faces to the output mesh and removes duplicate attribute values and
+  // points. The deduplication uses |thread_pool| when it is not nullptr.
+  void FinalizeGeometry(ThreadPool *thread_pool);
+
   // Parses the next mesh property definition (position, tex coord, normal, or
   // face). If the parsed data is unrecognized, it will be skipped.
   // Returns false when the end of file was reached.
@@ -74,10 +93,6 @@ class ObjDecoder {
   bool ParseMaterial(Status *status);
   bool ParseObject(Status *status);
 
-  // Parses triplet of position, tex coords and normal indices.
-  // Returns false on error.
-  bool ParseVertexIndices(std::array<int32_t, 3> *out_indices);
-
   // Maps specified point index to the parsed vertex indices (triplet of
   // position, texture coordinate, and normal indices) .
   void MapPointToVertexIndices(PointIndex pi,
@@ -114,6 +129,7 @@ class ObjDecoder {
   std::unordered_map<std::string, int> obj_name_to_id_;
 
   bool use_metadata_;
+  int num_threads_;
 
   DecoderBuffer buffer_;
 
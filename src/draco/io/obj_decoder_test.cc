@@ -51,6 +51,18 @@ class ObjDecoderTest : public ::testing::Test {
     return geometry;
   }
 
+  std::unique_ptr<Mesh> DecodeObjFromString(const std::string &data,
+                                            int num_threads) const {
+    DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    ObjDecoder decoder;
+    decoder.set_num_threads(num_threads);
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    if (!decoder.DecodeFromBuffer(&buffer, mesh.get()).ok())
+      return nullptr;
+    return mesh;
+  }
+
   void test_decoding(const std::string &file_name) {
     const std::unique_ptr<Mesh> mesh(DecodeObj<Mesh>(file_name));
     ASSERT_NE(mesh, nullptr) << "Failed to load test model " << file_name;
@@ -161,6 +173,72 @@ TEST_F(ObjDecoderTest, WrongAttributeMapping) {
   ASSERT_EQ(mesh->attribute(0)->size(), 3);
 }
 
+TEST_F(ObjDecoderTest, ParallelDecoding) {
+  // Tests that parsing of a large input with multiple threads produces the
+  // same mesh as the single threaded decoding.
+  std::stringstream obj;
+  obj << "# Grid with materials, sub-objects and relative indices.\n";
+  const int grid_size = 200;
+  for (int y = 0; y < grid_size; ++y) {
+    if (y % 17 == 0)
+      obj << "o part" << (y / 17) % 5 << "\n";
+    if (y % 11 == 0)
+      obj << "usemtl mat" << (y / 11) % 7 << "\n";
+    for (int x = 0; x < grid_size; ++x) {
+      obj << "v " << x << " " << y << " " << (x * y) % 13 << "\n";
+      obj << "vt " << x * 0.005f << " " << y * 0.005f << "\n";
+      obj << "vn 0 " << (x % 2) << " 1\n";
+    }
+    if (y == 0)
+      continue;
+    for (int x = 0; x < grid_size - 1; ++x) {
+      // Vertices of the previous and the current row (1-based).
+      const int v0 = (y - 1) * grid_size + x + 1;
+      const int v1 = y * grid_size + x + 1;
+      if (x % 3 == 0) {
+        // Quad with relative indices.
+        const int r0 = v0 - (y + 1) * grid_size - 1;
+        const int r1 = v1 - (y + 1) * grid_size - 1;
+        obj << "f " << r0 << "/" << r0 << "/" << r0 << " " << r0 + 1 << "/"
+            << r0 + 1 << "/" << r0 + 1 << " " << r1 + 1 << "/" << r1 + 1
+            << "/" << r1 + 1 << " " << r1 << "/" << r1 << "/" << r1 << "\n";
+      } else {
+        obj << "f " << v0 << "//" << v0 << " " << v0 + 1 << "//" << v0 + 1
+            << " " << v1 << "//" << v1 << "\n";
+        obj << "f " << v0 + 1 << " " << v1 + 1 << " " << v1 << "\n";
+      }
+    }
+  }
+  const std::string data = obj.str();
+  const std::unique_ptr<Mesh> mesh = DecodeObjFromString(data, 1);
+  ASSERT_NE(mesh, nullptr);
+  ASSERT_EQ(mesh->num_attributes(), 5);
+  for (int num_threads = 2; num_threads <= 8; num_threads *= 2) {
+    const std::unique_ptr<Mesh> parallel_mesh =
+        DecodeObjFromString(data, num_threads);
+    ASSERT_NE(parallel_mesh, nullptr);
+    ASSERT_EQ(mesh->num_points(), parallel_mesh->num_points());
+    ASSERT_EQ(mesh->num_faces(), parallel_mesh->num_faces());
+    for (FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+      ASSERT_EQ(mesh->face(fi), parallel_mesh->face(fi));
+    }
+    ASSERT_EQ(mesh->num_attributes(), parallel_mesh->num_attributes());
+    for (int i = 0; i < mesh->num_attributes(); ++i) {
+      const PointAttribute *const att = mesh->attribute(i);
+      const PointAttribute *const parallel_att = parallel_mesh->attribute(i);
+      ASSERT_EQ(att->size(), parallel_att->size());
+      ASSERT_EQ(att->byte_stride(), parallel_att->byte_stride());
+      std::vector<uint8_t> value(att->byte_stride());
+      std::vector<uint8_t> parallel_value(att->byte_stride());
+      for (PointIndex pi(0); pi < mesh->num_points(); ++pi) {
+        att->GetMappedValue(pi, &value[0]);
+        parallel_att->GetMappedValue(pi, &parallel_value[0]);
+        ASSERT_EQ(value, parallel_value);
+      }
+    }
+  }
+}
+
 TEST_F(ObjDecoderTest, TestObjDecodingAll) {
   // test if we can read all obj that are currently in test folder.
   test_decoding("bunny_norm.obj");
@@ -16,12 +16,396 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cfloat>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <locale>
+#include <sstream>
 
 namespace draco {
 namespace parser {
 
+namespace {
+
+// Range of decimal exponents for which float values can be nonzero and finite
+// when the significand has at most 19 digits.
+constexpr int kMinFloatPowerOfTen = -65;
+constexpr int kMaxFloatPowerOfTen = 38;
+
+// 128-bit approximations of 5^q for q in <kMinFloatPowerOfTen,
+// kMaxFloatPowerOfTen>, normalized so that the most significant bit is set.
+// Each entry stores the upper and the lower 64 bits.
+const uint64_t kPowersOfFive128[][2] = {
+    {0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull},  // 5^-65
+    {0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull},  // 5^-64
+    {0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull},  // 5^-63
+    {0x83a3eeeef9153e89ull, 0x1953cf68300424acull},  // 5^-62
+    {0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull},  // 5^-61
+    {0xcdb02555653131b6ull, 0x3792f412cb06794dull},  // 5^-60
+    {0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull},  // 5^-59
+    {0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull},  // 5^-58
+    {0xc8de047564d20a8bull, 0xf245825a5a445275ull},  // 5^-57
+    {0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull},  // 5^-56
+    {0x9ced737bb6c4183dull, 0x55464dd69685606bull},  // 5^-55
+    {0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull},  // 5^-54
+    {0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull},  // 5^-53
+    {0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull},  // 5^-52
+    {0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull},  // 5^-51
+    {0xef73d256a5c0f77cull, 0x963e66858f6d4440ull},  // 5^-50
+    {0x95a8637627989aadull, 0xdde7001379a44aa8ull},  // 5^-49
+    {0xbb127c53b17ec159ull, 0x5560c018580d5d52ull},  // 5^-48
+    {0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull},  // 5^-47
+    {0x9226712162ab070dull, 0xcab3961304ca70e8ull},  // 5^-46
+    {0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull},  // 5^-45
+    {0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull},  // 5^-44
+    {0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull},  // 5^-43
+    {0xb267ed1940f1c61cull, 0x55f038b237591ed3ull},  // 5^-42
+    {0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull},  // 5^-41
+    {0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull},  // 5^-40
+    {0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull},  // 5^-39
+    {0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull},  // 5^-38
+    {0x881cea14545c7575ull, 0x7e50d64177da2e54ull},  // 5^-37
+    {0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull},  // 5^-36
+    {0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull},  // 5^-35
+    {0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull},  // 5^-34
+    {0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull},  // 5^-33
+    {0xcfb11ead453994baull, 0x67de18eda5814af2ull},  // 5^-32
+    {0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull},  // 5^-31
+    {0xa2425ff75e14fc31ull, 0xa1258379a94d028dull},  // 5^-30
+    {0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull},  // 5^-29
+    {0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull},  // 5^-28
+    {0x9e74d1b791e07e48ull, 0x775ea264cf55347eull},  // 5^-27
+    {0xc612062576589ddaull, 0x95364afe032a819eull},  // 5^-26
+    {0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull},  // 5^-25
+    {0x9abe14cd44753b52ull, 0xc4926a9672793543ull},  // 5^-24
+    {0xc16d9a0095928a27ull, 0x75b7053c0f178294ull},  // 5^-23
+    {0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull},  // 5^-22
+    {0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull},  // 5^-21
+    {0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull},  // 5^-20
+    {0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull},  // 5^-19
+    {0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull},  // 5^-18
+    {0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull},  // 5^-17
+    {0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull},  // 5^-16
+    {0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull},  // 5^-15
+    {0xb424dc35095cd80full, 0x538484c19ef38c95ull},  // 5^-14
+    {0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull},  // 5^-13
+    {0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull},  // 5^-12
+    {0xafebff0bcb24aafeull, 0xf78f69a51539d749ull},  // 5^-11
+    {0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull},  // 5^-10
+    {0x89705f4136b4a597ull, 0x31680a88f8953031ull},  // 5^-9
+    {0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull},  // 5^-8
+    {0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull},  // 5^-7
+    {0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull},  // 5^-6
+    {0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull},  // 5^-5
+    {0xd1b71758e219652bull, 0xd3c36113404ea4a9ull},  // 5^-4
+    {0x83126e978d4fdf3bull, 0x645a1cac083126eaull},  // 5^-3
+    {0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull},  // 5^-2
+    {0xccccccccccccccccull, 0xcccccccccccccccdull},  // 5^-1
+    {0x8000000000000000ull, 0x0000000000000000ull},  // 5^0
+    {0xa000000000000000ull, 0x0000000000000000ull},  // 5^1
+    {0xc800000000000000ull, 0x0000000000000000ull},  // 5^2
+    {0xfa00000000000000ull, 0x0000000000000000ull},  // 5^3
+    {0x9c40000000000000ull, 0x0000000000000000ull},  // 5^4
+    {0xc350000000000000ull, 0x0000000000000000ull},  // 5^5
+    {0xf424000000000000ull, 0x0000000000000000ull},  // 5^6
+    {0x9896800000000000ull, 0x0000000000000000ull},  // 5^7
+    {0xbebc200000000000ull, 0x0000000000000000ull},  // 5^8
+    {0xee6b280000000000ull, 0x0000000000000000ull},  // 5^9
+    {0x9502f90000000000ull, 0x0000000000000000ull},  // 5^10
+    {0xba43b74000000000ull, 0x0000000000000000ull},  // 5^11
+    {0xe8d4a51000000000ull, 0x0000000000000000ull},  // 5^12
+    {0x9184e72a00000000ull, 0x0000000000000000ull},  // 5^13
+    {0xb5e620f480000000ull, 0x0000000000000000ull},  // 5^14
+    {0xe35fa931a0000000ull, 0x0000000000000000ull},  // 5^15
+    {0x8e1bc9bf04000000ull, 0x0000000000000000ull},  // 5^16
+    {0xb1a2bc2ec5000000ull, 0x0000000000000000ull},  // 5^17
+    {0xde0b6b3a76400000ull, 0x0000000000000000ull},  // 5^18
+    {0x8ac7230489e80000ull, 0x0000000000000000ull},  // 5^19
+    {0xad78ebc5ac620000ull, 0x0000000000000000ull},  // 5^20
+    {0xd8d726b7177a8000ull, 0x0000000000000000ull},  // 5^21
+    {0x878678326eac9000ull, 0x0000000000000000ull},  // 5^22
+    {0xa968163f0a57b400ull, 0x0000000000000000ull},  // 5^23
+    {0xd3c21bcecceda100ull, 0x0000000000000000ull},  // 5^24
+    {0x84595161401484a0ull, 0x0000000000000000ull},  // 5^25
+    {0xa56fa5b99019a5c8ull, 0x0000000000000000ull},  // 5^26
+    {0xcecb8f27f4200f3aull, 0x0000000000000000ull},  // 5^27
+    {0x813f3978f8940984ull, 0x4000000000000000ull},  // 5^28
+    {0xa18f07d736b90be5ull, 0x5000000000000000ull},  // 5^29
+    {0xc9f2c9cd04674edeull, 0xa400000000000000ull},  // 5^30
+    {0xfc6f7c4045812296ull, 0x4d00000000000000ull},  // 5^31
+    {0x9dc5ada82b70b59dull, 0xf020000000000000ull},  // 5^32
+    {0xc5371912364ce305ull, 0x6c28000000000000ull},  // 5^33
+    {0xf684df56c3e01bc6ull, 0xc732000000000000ull},  // 5^34
+    {0x9a130b963a6c115cull, 0x3c7f400000000000ull},  // 5^35
+    {0xc097ce7bc90715b3ull, 0x4b9f100000000000ull},  // 5^36
+    {0xf0bdc21abb48db20ull, 0x1e86d40000000000ull},  // 5^37
+    {0x96769950b50d88f4ull, 0x1314448000000000ull},  // 5^38
+};
+
+// Powers of ten that are exactly representable by a double.
+const double kExactPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                    1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                    1e18, 1e19, 1e20, 1e21, 1e22};
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Same as isspace() in the classic locale.
+inline bool IsWhitespace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline int CountLeadingZeros64(uint64_t n) {
+#if defined(__GNUC__)
+  return __builtin_clzll(n);
+#else
+  int num_zeros = 0;
+  while (!(n & (uint64_t(1) << 63))) {
+    n <<= 1;
+    ++num_zeros;
+  }
+  return num_zeros;
+#endif
+}
+
+// Returns the lower 64 bits of a * b and stores the upper 64 bits into |high|.
+inline uint64_t MultiplyFull64(uint64_t a, uint64_t b, uint64_t *high) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *high = static_cast<uint64_t>(product >> 64);
+  return static_cast<uint64_t>(product);
+#else
+  const uint64_t a_lo = a & 0xffffffff;
+  const uint64_t a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xffffffff;
+  const uint64_t b_hi = b >> 32;
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t hi_hi = a_hi * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+  *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  return (cross << 32) | (lo_lo & 0xffffffff);
+#endif
+}
+
+inline float FloatFromBits(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Computes w * 10^q using exact double arithmetic. Returns false when the
+// operands are not exact or when rounding of the double result to float could
+// differ from the correct rounding of the exact value.
+bool ComputeFloatFastPath(uint64_t w, int64_t q, float *value) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+  // Intermediate results may be rounded twice.
+  return false;
+#else
+  if (w > (uint64_t(1) << 53) || q < -22 || q > 22)
+    return false;
+  double d = static_cast<double>(w);
+  if (q < 0) {
+    d /= kExactPowersOfTen[-q];
+  } else {
+    d *= kExactPowersOfTen[q];
+  }
+  if (d < std::numeric_limits<float>::min() ||
+      d > std::numeric_limits<float>::max())
+    return false;
+  // The correctly rounded double is rounded again to float. This gives the
+  // correctly rounded float unless the double is exactly halfway between two
+  // floats.
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  const uint64_t kHalfwayMask = (uint64_t(1) << 29) - 1;
+  if ((bits & kHalfwayMask) == (uint64_t(1) << 28))
+    return false;
+  *value = static_cast<float>(d);
+  return true;
+#endif
+}
+
+// Computes the correctly rounded float value of w * 10^q using the algorithm
+// of Eisel and Lemire (D. Lemire, "Number Parsing at a Gigabyte per Second",
+// Software: Practice and Experience 51(8), 2021).
+float ComputeFloatEiselLemire(uint64_t w, int64_t q) {
+  const int kMantissaBits = 23;
+  const int kMinExponent = -127;
+  if (w == 0 || q < kMinFloatPowerOfTen)
+    return 0.f;
+  if (q > kMaxFloatPowerOfTen)
+    return std::numeric_limits<float>::infinity();
+  const int lz = CountLeadingZeros64(w);
+  w <<= lz;
+  const uint64_t *const power_of_five =
+      kPowersOfFive128[q - kMinFloatPowerOfTen];
+  uint64_t high;
+  uint64_t low = MultiplyFull64(w, power_of_five[0], &high);
+  const uint64_t kPrecisionMask = ~uint64_t(0) >> (kMantissaBits + 3);
+  if ((high & kPrecisionMask) == kPrecisionMask) {
+    // The truncated product may be inexact, use the lower bits of 5^q.
+    uint64_t second_high;
+    MultiplyFull64(w, power_of_five[1], &second_high);
+    low += second_high;
+    if (second_high > low)
+      ++high;
+  }
+  const int upper_bit = static_cast<int>(high >> 63);
+  const int shift = upper_bit + 64 - kMantissaBits - 3;
+  uint64_t mantissa = high >> shift;
+  // floor(log2(10^q)) + 63.
+  const int power_of_two =
+      static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+  int exponent = power_of_two + upper_bit - lz - kMinExponent;
+  if (exponent <= 0) {
+    // Subnormal number.
+    if (-exponent + 1 >= 64)
+      return 0.f;
+    mantissa >>= -exponent + 1;
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    exponent = (mantissa < (uint64_t(1) << kMantissaBits)) ? 0 : 1;
+    return FloatFromBits(static_cast<uint32_t>(mantissa) |
+                         (static_cast<uint32_t>(exponent) << kMantissaBits));
+  }
+  // Exact halfway cases are possible only for small exponents and they must be
+  // rounded to even.
+  if (low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1 &&
+      (mantissa << shift) == high) {
+    mantissa &= ~uint64_t(1);
+  }
+  mantissa += (mantissa & 1);
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t(2) << kMantissaBits)) {
+    mantissa = uint64_t(1) << kMantissaBits;
+    ++exponent;
+  }
+  mantissa &= ~(uint64_t(1) << kMantissaBits);
+  if (exponent >= 0xff)
+    return std::numeric_limits<float>::infinity();
+  return FloatFromBits(static_cast<uint32_t>(mantissa) |
+                       (static_cast<uint32_t>(exponent) << kMantissaBits));
+}
+
+// Computes the float nearest to the number with significand digits
+// <digits_begin, digits_end) and explicit decimal exponent |exponent| for
+// numbers that are not handled by ComputeFloatFastPath(). The significand may
+// contain a decimal point. <digits_begin, number_end) is the whole number
+// without its sign.
+bool ComputeFloatSlowPath(const char *digits_begin, const char *digits_end,
+                          const char *number_end, int64_t exponent,
+                          float *value) {
+  // The value of the number is w * 10^q. Only the first 19 significant digits
+  // fit into |w|, |truncated| is set when any of the remaining ones is not
+  // zero.
+  uint64_t w = 0;
+  int64_t q = exponent;
+  int num_significant_digits = 0;
+  bool is_fraction = false;
+  bool truncated = false;
+  for (const char *d = digits_begin; d != digits_end; ++d) {
+    if (*d == '.') {
+      is_fraction = true;
+    } else if (num_significant_digits < 19) {
+      w = 10 * w + (*d - '0');
+      if (w != 0)
+        ++num_significant_digits;
+      if (is_fraction)
+        --q;
+    } else {
+      if (!is_fraction)
+        ++q;
+      truncated |= *d != '0';
+    }
+  }
+  float result = ComputeFloatEiselLemire(w, q);
+  // The digits that didn't fit into |w| can change the result only when
+  // w * 10^q and (w + 1) * 10^q round to different values.
+  if (truncated && result != ComputeFloatEiselLemire(w + 1, q)) {
+    // Hard case, use the standard library with the classic locale.
+    std::istringstream stream(std::string(digits_begin, number_end));
+    stream.imbue(std::locale::classic());
+    stream >> result;
+    if (stream.fail()) {
+      // Values out of range are reported as the maximum float value.
+      if (result != std::numeric_limits<float>::max())
+        return false;
+      result = std::numeric_limits<float>::infinity();
+    }
+  }
+  *value = result;
+  return true;
+}
+
+// Parses a decimal number from <begin, end). The number must contain at least
+// one digit, special values are not handled. Returns the number of parsed
+// characters, 0 when no digits were found, or -1 when the number is invalid.
+inline int64_t ParseDecimalFloat(const char *begin, const char *end,
+                                 float *value) {
+  const char *p = begin;
+  bool negative = false;
+  if (p != end && GetSignValue(*p) != 0) {
+    negative = *p == '-';
+    ++p;
+  }
+  // Accumulate the digits into an integer significand |w| and scale it by the
+  // power of ten |q| at the end. Both are exact for up to 19 digits.
+  const char *const digits_begin = p;
+  uint64_t w = 0;
+  for (; p != end && IsDigit(*p); ++p) {
+    w = 10 * w + (*p - '0');
+  }
+  int64_t num_digits = p - digits_begin;
+  int64_t q = 0;
+  if (p != end && *p == '.') {
+    ++p;
+    const char *const fraction_begin = p;
+    for (; p != end && IsDigit(*p); ++p) {
+      w = 10 * w + (*p - '0');
+    }
+    q = fraction_begin - p;
+    num_digits += p - fraction_begin;
+  }
+  if (num_digits == 0)
+    return 0;
+  const char *const digits_end = p;
+  int64_t exponent = 0;
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p != end && GetSignValue(*p) != 0) {
+      negative_exponent = *p == '-';
+      ++p;
+    }
+    if (p == end || !IsDigit(*p))
+      return -1;
+    for (; p != end && IsDigit(*p); ++p) {
+      // Larger exponents give zero or infinity anyway.
+      if (exponent < 100000)
+        exponent = 10 * exponent + (*p - '0');
+    }
+    if (negative_exponent)
+      exponent = -exponent;
+  }
+
+  float result;
+  if (num_digits <= 19 && w == 0) {
+    result = 0.f;
+  } else if (num_digits > 19 ||
+             !ComputeFloatFastPath(w, q + exponent, &result)) {
+    if (!ComputeFloatSlowPath(digits_begin, digits_end, p, exponent, &result))
+      return -1;
+  }
+  *value = negative ? -result : result;
+  return p - begin;
+}
+
+}  // namespace
+
 void SkipCharacters(DecoderBuffer *buffer, const char *skip_chars) {
   if (skip_chars == nullptr)
     return;
@@ -72,7 +456,17 @@ void SkipLine(DecoderBuffer *buffer) {
 }
 
 bool ParseFloat(DecoderBuffer *buffer, float *value) {
-  // Read optional sign.
+  const int64_t num_parsed_chars = ParseDecimalFloat(
+      buffer->data_head(), buffer->data_head() + buffer->remaining_size(),
+      value);
+  if (num_parsed_chars < 0)
+    return false;
+  if (num_parsed_chars > 0) {
+    buffer->Advance(num_parsed_chars);
+    return true;
+  }
+
+  // No digits found. Read optional sign.
   char ch;
   if (!buffer->Peek(&ch))
     return false;
@@ -82,57 +476,45 @@ bool ParseFloat(DecoderBuffer *buffer, float *value) {
   } else {
     sign = 1;
   }
-
-  // Parse integer component.
-  bool have_digits = false;
-  double v = 0.0;
-  while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
-    v *= 10.0;
-    v += (ch - '0');
-    buffer->Advance(1);
-    have_digits = true;
-  }
-  if (ch == '.') {
-    // Parse fractional component.
-    buffer->Advance(1);
-    double fraction = 1.0;
-    while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
-      fraction *= 0.1;
-      v += (ch - '0') * fraction;
-      buffer->Advance(1);
-      have_digits = true;
-    }
+  // Check for special constants (inf, nan, ...).
+  std::string text;
+  if (!ParseString(buffer, &text))
+    return false;
+  float v;
+  if (text == "inf" || text == "Inf") {
+    v = std::numeric_limits<float>::infinity();
+  } else if (text == "nan" || text == "NaN") {
+    v = std::nanf("");
+  } else {
+    // Invalid string.
+    return false;
   }
+  *value = (sign < 0) ? -v : v;
+  return true;
+}
 
-  if (!have_digits) {
-    // Check for special constants (inf, nan, ...).
-    std::string text;
-    if (!ParseString(buffer, &text))
-      return false;
-    if (text == "inf" || text == "Inf") {
-      v = std::numeric_limits<double>::infinity();
-    } else if (text == "nan" || text == "NaN") {
-      v = nan("");
-    } else {
-      // Invalid string.
-      return false;
+bool ParseFloats(DecoderBuffer *buffer, int num_values, float *out_values) {
+  // Parse all values directly from the buffer data and advance the buffer only
+  // once at the end.
+  const char *begin = buffer->data_head();
+  const char *const end = begin + buffer->remaining_size();
+  const char *p = begin;
+  for (int i = 0; i < num_values; ++i) {
+    while (p != end && IsWhitespace(*p)) {
+      ++p;
     }
-  } else {
-    // Handle exponent if present.
-    if (ch == 'e' || ch == 'E') {
-      buffer->Advance(1);  // Skip 'e' marker.
-
-      // Parse integer exponent.
-      int32_t exponent = 0;
-      if (!ParseSignedInt(buffer, &exponent))
-        return false;
-
-      // Apply exponent scaling to value.
-      v *= pow(10.0, exponent);
+    const int64_t num_parsed_chars = ParseDecimalFloat(p, end, out_values + i);
+    if (num_parsed_chars > 0) {
+      p += num_parsed_chars;
+      continue;
     }
+    buffer->Advance(p - begin);
+    // Special values are handled by ParseFloat().
+    if (num_parsed_chars < 0 || !ParseFloat(buffer, out_values + i))
+      return false;
+    begin = p = buffer->data_head();
   }
-
-  *value = (sign < 0) ? -v : v;
+  buffer->Advance(p - begin);
   return true;
 }
 
@@ -31,9 +31,14 @@ void SkipWhitespace(DecoderBuffer *buffer);
 bool PeekWhitespace(DecoderBuffer *buffer, bool *end_reached);
 void SkipLine(DecoderBuffer *buffer);
 
-// Parses signed floating point number or returns false on error.
+// Parses signed floating point number or returns false on error. The parsed
+// value is correctly rounded to the nearest float.
 bool ParseFloat(DecoderBuffer *buffer, float *value);
 
+// Parses |num_values| floating point numbers separated by whitespace into
+// |out_values|. Returns false on error.
+bool ParseFloats(DecoderBuffer *buffer, int num_values, float *out_values);
+
 // Parses a signed integer (can be preceded by '-' or '+' characters.
 bool ParseSignedInt(DecoderBuffer *buffer, int32_t *value);
 
@@ -0,0 +1,124 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/parser_utils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+
+namespace draco {
+
+class ParserUtilsTest : public ::testing::Test {
+ protected:
+  // Parses |text| and verifies that the result is bit exact with the
+  // correctly rounded value computed by the standard library.
+  void TestParseFloat(const std::string &text) {
+    DecoderBuffer buffer;
+    buffer.Init(text.data(), text.size());
+    float value;
+    ASSERT_TRUE(parser::ParseFloat(&buffer, &value)) << text;
+    ASSERT_EQ(buffer.remaining_size(), 0) << text;
+    const float expected_value = std::strtof(text.c_str(), nullptr);
+    uint32_t bits, expected_bits;
+    memcpy(&bits, &value, sizeof(bits));
+    memcpy(&expected_bits, &expected_value, sizeof(expected_bits));
+    ASSERT_EQ(bits, expected_bits) << text;
+  }
+};
+
+TEST_F(ParserUtilsTest, TestParseFloat) {
+  const char *const kTestValues[] = {
+      "0", "-0", "+1", "1.", ".5", "-.25", "3.14159265358979323846",
+      "0.1", "1e10", "1E-10", "-2.5e+3", "0.000001", "123456789",
+      "16777217",  // Halfway between two floats.
+      "16777219", "3.4028234e38", "3.4028236e38", "3.4028235677973366e38",
+      "1e39", "1.17549435e-38", "1.4e-45", "7e-46", "7.1e-46", "1e-50",
+      "0.1000000000000000055511151231257827021181583404541015625",
+      "1.00000005960464477539062500000000000000000001",
+      "1.000000059604644775390625", "0.00000000000000000000000000000000001",
+      "123456789012345678901234567890", "1e-7", "9999999999999999999e-20",
+      "4.7019774032891500318749461488889827112746622270883500860350068251e-38"};
+  for (const char *text : kTestValues) {
+    TestParseFloat(text);
+  }
+}
+
+TEST_F(ParserUtilsTest, TestParseRandomFloats) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint32_t> bits_distribution;
+  char text[64];
+  for (int i = 0; i < 20000; ++i) {
+    // Random finite floats printed with various precisions.
+    const uint32_t bits = bits_distribution(generator);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value))
+      continue;
+    snprintf(text, sizeof(text), "%.*g", 1 + i % 20, value);
+    TestParseFloat(text);
+    // Typical values of ASCII mesh formats.
+    snprintf(text, sizeof(text), "%f",
+             static_cast<double>(bits % 2000000) / 1000.0 - 1000.0);
+    TestParseFloat(text);
+  }
+}
+
+TEST_F(ParserUtilsTest, TestParseSpecialFloats) {
+  const std::string text = "inf -inf NaN 2.5x -";
+  DecoderBuffer buffer;
+  buffer.Init(text.data(), text.size());
+  float values[3];
+  ASSERT_TRUE(parser::ParseFloats(&buffer, 3, values));
+  ASSERT_TRUE(std::isinf(values[0]));
+  ASSERT_GT(values[0], 0.f);
+  ASSERT_TRUE(std::isinf(values[1]));
+  ASSERT_LT(values[1], 0.f);
+  ASSERT_TRUE(std::isnan(values[2]));
+  // The number ends at the first invalid character.
+  parser::SkipWhitespace(&buffer);
+  ASSERT_TRUE(parser::ParseFloat(&buffer, values));
+  ASSERT_EQ(values[0], 2.5f);
+  char c;
+  ASSERT_TRUE(buffer.Peek(&c));
+  ASSERT_EQ(c, 'x');
+  buffer.Advance(1);
+  // A sign without digits is not a number.
+  parser::SkipWhitespace(&buffer);
+  ASSERT_FALSE(parser::ParseFloat(&buffer, values));
+
+  // Missing exponent digits.
+  const std::string invalid_exponent = "1e";
+  buffer.Init(invalid_exponent.data(), invalid_exponent.size());
+  ASSERT_FALSE(parser::ParseFloat(&buffer, values));
+}
+
+TEST_F(ParserUtilsTest, TestParseFloats) {
+  const std::string text = "v 1.5 -2\t3e2\n0.25 x";
+  DecoderBuffer buffer;
+  buffer.Init(text.data() + 1, text.size() - 1);
+  float values[4];
+  ASSERT_TRUE(parser::ParseFloats(&buffer, 4, values));
+  ASSERT_EQ(values[0], 1.5f);
+  ASSERT_EQ(values[1], -2.f);
+  ASSERT_EQ(values[2], 300.f);
+  ASSERT_EQ(values[3], 0.25f);
+  ASSERT_FALSE(parser::ParseFloats(&buffer, 1, values));
+}
+
+}  // namespace draco
@@ -59,6 +59,13 @@ bool PlyDecoder::DecodeFromBuffer(DecoderBuffer *buffer,
   return DecodeInternal();
 }
 
+bool PlyDecoder::DecodeVertexElement(const PlyElement &vertex_element,
+                                     PointCloud *out_point_cloud) {
+  out_mesh_ = nullptr;
+  out_point_cloud_ = out_point_cloud;
+  return DecodeVertexData(&vertex_element);
+}
+
 bool PlyDecoder::DecodeInternal() {
   PlyReader ply_reader;
   if (!ply_reader.Read(buffer()))
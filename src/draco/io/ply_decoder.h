@@ -41,6 +41,12 @@ class PlyDecoder {
   bool DecodeFromBuffer(DecoderBuffer *buffer, Mesh *out_mesh);
   bool DecodeFromBuffer(DecoderBuffer *buffer, PointCloud *out_point_cloud);
 
+  // Decodes vertex attributes stored in an already parsed PLY element into
+  // |out_point_cloud|. Used by readers that parse the input data on their own
+  // such as the PlyStreamReader.
+  bool DecodeVertexElement(const PlyElement &vertex_element,
+                           PointCloud *out_point_cloud);
+
  protected:
   bool DecodeInternal();
   DecoderBuffer *buffer() { return &buffer_; }
@@ -35,6 +35,16 @@ PlyElement::PlyElement(const std::string &name, int64_t num_entries)
 PlyReader::PlyReader() : format_(kLittleEndian) {}
 
 bool PlyReader::Read(DecoderBuffer *buffer) {
+  if (!ReadHeader(buffer))
+    return false;
+  if (!ParsePropertiesData(buffer))
+    return false;
+  return true;
+}
+
+bool PlyReader::ReadHeader(DecoderBuffer *buffer) {
+  elements_.clear();
+  element_index_.clear();
   error_message_.clear();
   std::string value;
   // The first line needs to by "ply".
@@ -70,11 +80,7 @@ bool PlyReader::Read(DecoderBuffer *buffer) {
   } else {
     format_ = kLittleEndian;
   }
-  if (!ParseHeader(buffer))
-    return false;
-  if (!ParsePropertiesData(buffer))
-    return false;
-  return true;
+  return ParseHeader(buffer);
 }
 
 bool PlyReader::ParseHeader(DecoderBuffer *buffer) {
@@ -173,6 +179,11 @@ bool PlyReader::ParseProperty(DecoderBuffer *buffer) {
 
 bool PlyReader::ParsePropertiesData(DecoderBuffer *buffer) {
   for (int i = 0; i < static_cast<int>(elements_.size()); ++i) {
+    PlyElement &element = elements_[i];
+    for (int p = 0; p < element.num_properties(); ++p) {
+      if (!element.property(p).is_list())
+        element.property(p).ReserveData(element.num_entries());
+    }
     if (format_ == kLittleEndian) {
       if (!ParseElementData(buffer, i)) {
         return false;
@@ -220,9 +231,33 @@ bool PlyReader::ParseElementData(DecoderBuffer *buffer, int element_index) {
 bool PlyReader::ParseElementDataAscii(DecoderBuffer *buffer,
                                       int element_index) {
   PlyElement &element = elements_[element_index];
+  std::vector<float> float_values;
   for (int entry = 0; entry < element.num_entries(); ++entry) {
     for (int i = 0; i < element.num_properties(); ++i) {
       PlyProperty &prop = element.property(i);
+      const bool is_float =
+          prop.data_type() == DT_FLOAT32 || prop.data_type() == DT_FLOAT64;
+      if (is_float && !prop.is_list()) {
+        // Parse all consecutive floating point properties at once (e.g.,
+        // x, y, z coordinates of vertices).
+        int num_props = 1;
+        while (i + num_props < element.num_properties()) {
+          const PlyProperty &next_prop = element.property(i + num_props);
+          if (next_prop.is_list() || (next_prop.data_type() != DT_FLOAT32 &&
+                                      next_prop.data_type() != DT_FLOAT64))
+            break;
+          ++num_props;
+        }
+        float_values.resize(num_props);
+        if (!parser::ParseFloats(buffer, num_props, &float_values[0]))
+          return false;
+        for (int p = 0; p < num_props; ++p) {
+          PlyPropertyWriter<double> prop_writer(&element.property(i + p));
+          prop_writer.PushBackValue(float_values[p]);
+        }
+        i += num_props - 1;
+        continue;
+      }
       PlyPropertyWriter<double> prop_writer(&prop);
       int32_t num_entries = 1;
       if (prop.is_list()) {
@@ -240,7 +275,7 @@ bool PlyReader::ParseElementDataAscii(DecoderBuffer *buffer,
       // Read and store the actual property data.
       for (int v = 0; v < num_entries; ++v) {
         parser::SkipWhitespace(buffer);
-        if (prop.data_type() == DT_FLOAT32 || prop.data_type() == DT_FLOAT64) {
+        if (is_float) {
           float val;
           if (!parser::ParseFloat(buffer, &val))
             return false;
@@ -35,9 +35,10 @@ namespace draco {
 class PlyProperty {
  public:
   friend class PlyReader;
+  friend class PlyStreamReader;
 
   PlyProperty(const std::string &name, DataType data_type, DataType list_type);
-  void ReserveData(int num_entries) {
+  void ReserveData(int64_t num_entries) {
     data_.reserve(DataTypeLength(data_type_) * num_entries);
   }
 
@@ -81,8 +82,6 @@ class PlyElement {
   void AddProperty(const PlyProperty &prop) {
     property_index_[prop.name()] = properties_.size();
     properties_.emplace_back(prop);
-    if (!properties_.back().is_list())
-      properties_.back().ReserveData(num_entries_);
   }
 
   const PlyProperty *GetPropertyByName(const std::string &name) const {
@@ -93,7 +92,7 @@ class PlyElement {
   }
 
   int num_properties() const { return properties_.size(); }
-  int num_entries() const { return num_entries_; }
+  int64_t num_entries() const { return num_entries_; }
   const PlyProperty &property(int prop_index) const {
     return properties_[prop_index];
   }
@@ -112,6 +111,9 @@ class PlyReader {
  public:
   PlyReader();
   bool Read(DecoderBuffer *buffer);
+  // Parses only the header of the PLY file. The data of the elements are not
+  // read and |buffer| is left at the first byte after the header.
+  bool ReadHeader(DecoderBuffer *buffer);
 
   const PlyElement *GetElementByName(const std::string &name) const {
     const auto it = element_index_.find(name);
@@ -124,6 +126,7 @@ class PlyReader {
   const PlyElement &element(int element_index) const {
     return elements_[element_index];
   }
+  bool is_ascii() const { return format_ == kAscii; }
 
  private:
   enum Format { kLittleEndian = 0, kAscii };
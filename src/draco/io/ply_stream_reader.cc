@@ -0,0 +1,162 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/ply_stream_reader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+#include "draco/io/ply_decoder.h"
+
+namespace draco {
+
+namespace {
+
+// Default number of vertices returned by PlyStreamReader::ReadNextBatch().
+constexpr int64_t kDefaultBatchSize = 1 << 20;
+
+}  // namespace
+
+PlyStreamReader::PlyStreamReader()
+    : stream_(nullptr),
+      vertex_element_(nullptr),
+      vertex_stride_(0),
+      num_remaining_vertices_(0),
+      batch_size_(kDefaultBatchSize) {}
+
+bool PlyStreamReader::Open(const std::string &file_name) {
+  std::unique_ptr<std::ifstream> file(
+      new std::ifstream(file_name, std::ios::binary));
+  if (!*file)
+    return false;
+  if (!Open(file.get()))
+    return false;
+  file_ = std::move(file);
+  return true;
+}
+
+bool PlyStreamReader::Open(std::istream *stream) {
+  file_ = nullptr;
+  stream_ = stream;
+  vertex_element_ = nullptr;
+  vertex_property_offsets_.clear();
+  vertex_stride_ = 0;
+  num_remaining_vertices_ = 0;
+  if (!ReadHeader())
+    return false;
+  if (header_reader_.is_ascii())
+    return false;  // Only binary files can be streamed.
+  vertex_element_ = header_reader_.GetElementByName("vertex");
+  if (vertex_element_ == nullptr)
+    return false;
+  for (int i = 0; i < vertex_element_->num_properties(); ++i) {
+    const PlyProperty &prop = vertex_element_->property(i);
+    if (prop.is_list())
+      return false;  // Vertex entries must have a fixed size.
+    vertex_property_offsets_.push_back(vertex_stride_);
+    vertex_stride_ += prop.data_type_num_bytes();
+  }
+  if (!SkipElementsBeforeVertices())
+    return false;
+  num_remaining_vertices_ = vertex_element_->num_entries();
+  return true;
+}
+
+int64_t PlyStreamReader::num_vertices() const {
+  if (vertex_element_ == nullptr)
+    return 0;
+  return vertex_element_->num_entries();
+}
+
+std::unique_ptr<PointCloud> PlyStreamReader::ReadNextBatch() {
+  const int64_t num_batch_vertices =
+      std::min(batch_size_, num_remaining_vertices_);
+  if (num_batch_vertices <= 0)
+    return nullptr;
+  batch_data_.resize(num_batch_vertices * vertex_stride_);
+  if (!stream_->read(reinterpret_cast<char *>(batch_data_.data()),
+                     batch_data_.size()))
+    return nullptr;
+  num_remaining_vertices_ -= num_batch_vertices;
+
+  // Split the interleaved vertex data into separate properties.
+  PlyElement batch_element("vertex", num_batch_vertices);
+  for (int i = 0; i < vertex_element_->num_properties(); ++i) {
+    batch_element.AddProperty(vertex_element_->property(i));
+    PlyProperty &prop = batch_element.property(i);
+    const int num_bytes = prop.data_type_num_bytes();
+    prop.data_.resize(num_batch_vertices * num_bytes);
+    const uint8_t *src = batch_data_.data() + vertex_property_offsets_[i];
+    uint8_t *dst = prop.data_.data();
+    for (int64_t v = 0; v < num_batch_vertices; ++v) {
+      memcpy(dst, src, num_bytes);
+      src += vertex_stride_;
+      dst += num_bytes;
+    }
+  }
+
+  std::unique_ptr<PointCloud> pc(new PointCloud());
+  PlyDecoder decoder;
+  if (!decoder.DecodeVertexElement(batch_element, pc.get()))
+    return nullptr;
+  return pc;
+}
+
+bool PlyStreamReader::ReadHeader() {
+  // Read the header line by line so that the stream is left at the first byte
+  // of the element data.
+  std::string header;
+  std::string line;
+  while (std::getline(*stream_, line)) {
+    header += line;
+    header += '\n';
+    line.erase(std::remove_if(line.begin(), line.end(),
+                              [](unsigned char c) { return std::isspace(c); }),
+               line.end());
+    if (line == "end_header")
+      break;
+  }
+  if (line != "end_header")
+    return false;
+  DecoderBuffer buffer;
+  buffer.Init(header.data(), header.size());
+  return header_reader_.ReadHeader(&buffer);
+}
+
+bool PlyStreamReader::SkipElementsBeforeVertices() {
+  for (int i = 0; i < header_reader_.num_elements(); ++i) {
+    const PlyElement &element = header_reader_.element(i);
+    if (&element == vertex_element_)
+      return true;
+    int64_t stride = 0;
+    for (int p = 0; p < element.num_properties(); ++p) {
+      if (element.property(p).is_list())
+        return false;
+      stride += element.property(p).data_type_num_bytes();
+    }
+    // Reject elements whose size doesn't fit into the stream offset type.
+    const int64_t num_entries = element.num_entries();
+    if (num_entries < 0 ||
+        (num_entries > 0 &&
+         stride > std::numeric_limits<std::streamsize>::max() / num_entries))
+      return false;
+    if (!stream_->ignore(stride * num_entries))
+      return false;
+  }
+  return true;
+}
+
+}  // namespace draco
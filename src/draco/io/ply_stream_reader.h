@@ -0,0 +1,93 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_PLY_STREAM_READER_H_
+#define DRACO_IO_PLY_STREAM_READER_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/io/ply_reader.h"
+#include "draco/point_cloud/point_cloud.h"
+
+namespace draco {
+
+// Reads vertices of a binary little endian PLY file in batches of a fixed
+// size. Unlike the PlyDecoder, the reader never loads the whole file into
+// memory so it can be used to process point clouds that are larger than the
+// available memory. Each batch is returned as a separate point cloud with the
+// same attributes that would be created by the PlyDecoder.
+//
+// Usage:
+//   PlyStreamReader reader;
+//   if (!reader.Open(file_name))
+//     return false;
+//   while (reader.num_remaining_vertices() > 0) {
+//     std::unique_ptr<PointCloud> batch = reader.ReadNextBatch();
+//     if (batch == nullptr)
+//       return false;
+//     ...
+//   }
+//
+// Elements stored in the file before the "vertex" element can't contain list
+// properties and all elements after it are ignored.
+class PlyStreamReader {
+ public:
+  PlyStreamReader();
+
+  // Opens the file |file_name| and parses its header. Returns false when the
+  // file is not a supported PLY file.
+  bool Open(const std::string &file_name);
+  // Same as above but the data are read from |stream| that must remain valid
+  // for the lifetime of the reader.
+  bool Open(std::istream *stream);
+
+  // Reads at most batch_size() of the remaining vertices. Returns nullptr on
+  // error or when all vertices were already read.
+  std::unique_ptr<PointCloud> ReadNextBatch();
+
+  // Sets the maximum number of vertices returned by ReadNextBatch().
+  void set_batch_size(int64_t batch_size) { batch_size_ = batch_size; }
+  int64_t batch_size() const { return batch_size_; }
+
+  int64_t num_vertices() const;
+  int64_t num_remaining_vertices() const { return num_remaining_vertices_; }
+
+  // Returns the vertex element parsed from the header. The element describes
+  // the vertex properties but it doesn't contain any data.
+  const PlyElement *vertex_element() const { return vertex_element_; }
+
+ private:
+  bool ReadHeader();
+  // Skips data of all elements stored before the vertex element.
+  bool SkipElementsBeforeVertices();
+
+  std::unique_ptr<std::ifstream> file_;
+  std::istream *stream_;
+  PlyReader header_reader_;
+  const PlyElement *vertex_element_;
+  // Offset of each vertex property within a single vertex entry.
+  std::vector<int> vertex_property_offsets_;
+  int vertex_stride_;
+  int64_t num_remaining_vertices_;
+  int64_t batch_size_;
+  // Raw vertex data of the last batch.
+  std::vector<uint8_t> batch_data_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_PLY_STREAM_READER_H_
@@ -0,0 +1,141 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/ply_stream_reader.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/ply_decoder.h"
+
+namespace draco {
+
+class PlyStreamReaderTest : public ::testing::Test {
+ protected:
+  // Reads all batches from |reader| and verifies that their attribute values
+  // match the values of |expected_pc| decoded by the PlyDecoder.
+  void CompareBatches(PlyStreamReader *reader, const PointCloud &expected_pc) {
+    int64_t num_read_points = 0;
+    while (reader->num_remaining_vertices() > 0) {
+      const std::unique_ptr<PointCloud> batch = reader->ReadNextBatch();
+      ASSERT_NE(batch, nullptr);
+      ASSERT_LE(batch->num_points(), reader->batch_size());
+      ASSERT_EQ(batch->num_attributes(), expected_pc.num_attributes());
+      for (int a = 0; a < batch->num_attributes(); ++a) {
+        const PointAttribute *const att = batch->attribute(a);
+        const PointAttribute *const expected_att = expected_pc.attribute(a);
+        ASSERT_EQ(att->attribute_type(), expected_att->attribute_type());
+        ASSERT_EQ(att->byte_stride(), expected_att->byte_stride());
+        for (PointIndex i(0); i < batch->num_points(); ++i) {
+          const PointIndex expected_i(num_read_points + i.value());
+          ASSERT_EQ(memcmp(att->GetAddress(att->mapped_index(i)),
+                           expected_att->GetAddress(
+                               expected_att->mapped_index(expected_i)),
+                           att->byte_stride()),
+                    0);
+        }
+      }
+      num_read_points += batch->num_points();
+    }
+    ASSERT_EQ(num_read_points, expected_pc.num_points());
+    ASSERT_EQ(reader->ReadNextBatch(), nullptr);
+  }
+};
+
+TEST_F(PlyStreamReaderTest, TestReadFileInBatches) {
+  const std::string path = GetTestFileFullPath("test_pos_color.ply");
+  PointCloud expected_pc;
+  PlyDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeFromFile(path, &expected_pc));
+
+  PlyStreamReader reader;
+  reader.set_batch_size(50);
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_EQ(reader.num_vertices(), 114);
+  ASSERT_NE(reader.vertex_element(), nullptr);
+  ASSERT_EQ(reader.vertex_element()->num_properties(), 7);
+  CompareBatches(&reader, expected_pc);
+}
+
+TEST_F(PlyStreamReaderTest, TestSkipLeadingElements) {
+  // Generate a file with an extra element stored before the vertices.
+  const int num_vertices = 1000;
+  std::string data =
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "element camera 2\n"
+      "property float view_x\n"
+      "property uchar id\n"
+      "element vertex " +
+      std::to_string(num_vertices) +
+      "\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "property float nx\n"
+      "property float ny\n"
+      "property float nz\n"
+      "end_header\n";
+  data.append(2 * 5, '\xff');
+  for (int i = 0; i < num_vertices; ++i) {
+    const float values[6] = {static_cast<float>(i), 1.f, -2.5f * i,
+                             0.f,                   0.f, 1.f};
+    data.append(reinterpret_cast<const char *>(values), sizeof(values));
+  }
+  PointCloud expected_pc;
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  PlyDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeFromBuffer(&buffer, &expected_pc));
+  ASSERT_EQ(expected_pc.num_attributes(), 2);
+
+  std::istringstream stream(data);
+  PlyStreamReader reader;
+  reader.set_batch_size(128);
+  ASSERT_TRUE(reader.Open(&stream));
+  ASSERT_EQ(reader.num_vertices(), num_vertices);
+  CompareBatches(&reader, expected_pc);
+}
+
+TEST_F(PlyStreamReaderTest, TestUnsupportedFiles) {
+  PlyStreamReader reader;
+  // Ascii files can't be streamed.
+  ASSERT_FALSE(reader.Open(GetTestFileFullPath("test_pos_color_ascii.ply")));
+  ASSERT_FALSE(reader.Open(GetTestFileFullPath("missing_file.ply")));
+  ASSERT_EQ(reader.ReadNextBatch(), nullptr);
+}
+
+TEST_F(PlyStreamReaderTest, TestOverflowingLeadingElement) {
+  // The size of the leading element doesn't fit into the stream offset. Its
+  // size would wrap around to the size of a single entry (8 bytes) so the
+  // stored data would look valid if the overflow wasn't detected.
+  std::string data =
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "element camera 2305843009213693953\n"
+      "property double view_x\n"
+      "element vertex 1\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "end_header\n";
+  data.append(8 + 3 * sizeof(float), '\0');
+  std::istringstream stream(data);
+  PlyStreamReader reader;
+  ASSERT_FALSE(reader.Open(&stream));
+}
+
+}  // namespace draco
@@ -14,8 +14,10 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
 #include <limits>
 
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 
 namespace draco {
@@ -35,17 +37,31 @@ std::unique_ptr<CornerTable> CornerTable::Create(
 
 bool CornerTable::Initialize(
     const IndexTypeVector<FaceIndex, FaceType> &faces) {
-  ClearValenceCache();
-  ClearValenceCacheInaccurate();
   corner_to_vertex_map_.resize(faces.size() * 3);
   for (FaceIndex fi(0); fi < faces.size(); ++fi) {
     for (int i = 0; i < 3; ++i) {
       corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
     }
   }
+  return ComputeConnectivity();
+}
+
+bool CornerTable::ComputeConnectivity() {
+  return ComputeConnectivity(nullptr);
+}
+
+bool CornerTable::ComputeConnectivity(ThreadPool *thread_pool) {
+  ClearValenceCache();
+  ClearValenceCacheInaccurate();
+  num_degenerated_faces_ = 0;
+  non_manifold_vertex_parents_.clear();
   int num_vertices = -1;
-  if (!ComputeOppositeCorners(&num_vertices))
+  if (thread_pool != nullptr && thread_pool->num_threads() > 1) {
+    if (!ComputeOppositeCornersParallel(thread_pool, &num_vertices))
+      return false;
+  } else if (!ComputeOppositeCorners(&num_vertices)) {
     return false;
+  }
   if (!ComputeVertexCorners(num_vertices))
     return false;
   return true;
@@ -73,7 +89,7 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   DCHECK_EQ(vertex_valence_cache_32_bit_.size(), 0);
   if (num_vertices == nullptr)
     return false;
-  opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
+  opposite_corners_.assign(num_corners(), kInvalidCornerIndex);
 
   // Out implementation for finding opposite corners is based on keeping track
   // of outgoing half-edges for each vertex of the mesh. Half-edges (defined by
@@ -85,7 +101,9 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
 
   // First compute the number of outgoing half-edges (corners) attached to each
   // vertex.
-  std::vector<int> num_corners_on_vertices;
+  std::vector<int> &num_corners_on_vertices =
+      connectivity_buffers_.num_corners_on_vertices;
+  num_corners_on_vertices.clear();
   num_corners_on_vertices.reserve(num_corners());
   for (CornerIndex c(0); c < num_corners(); ++c) {
     const VertexIndex v1 = Vertex(c);
@@ -102,19 +120,16 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   // Each vertex will be assigned storage for up to
   // |num_corners_on_vertices[vert_id]| half-edges. Unused half-edges are marked
   // with |sink_vert| == kInvalidVertexIndex.
-  struct VertexEdgePair {
-    VertexEdgePair()
-        : sink_vert(kInvalidVertexIndex), edge_corner(kInvalidCornerIndex) {}
-    VertexIndex sink_vert;
-    CornerIndex edge_corner;
-  };
-  std::vector<VertexEdgePair> vertex_edges(num_corners(), VertexEdgePair());
+  std::vector<VertexEdgePair> &vertex_edges =
+      connectivity_buffers_.vertex_edges;
+  vertex_edges.assign(num_corners(), VertexEdgePair());
 
   // For each vertex compute the offset (location where the first half-edge
   // entry of a given vertex is going to be stored). This way each vertex is
   // guaranteed to have a non-overlapping storage with respect to the other
   // vertices.
-  std::vector<int> vertex_offset(num_corners_on_vertices.size());
+  std::vector<int> &vertex_offset = connectivity_buffers_.vertex_offset;
+  vertex_offset.resize(num_corners_on_vertices.size());
   int offset = 0;
   for (size_t i = 0; i < num_corners_on_vertices.size(); ++i) {
     vertex_offset[i] = offset;
@@ -190,15 +205,170 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   return true;
 }
 
+bool CornerTable::ComputeOppositeCornersParallel(ThreadPool *thread_pool,
+                                                 int *num_vertices) {
+  DCHECK_EQ(vertex_valence_cache_8_bit_.size(), 0);
+  DCHECK_EQ(vertex_valence_cache_32_bit_.size(), 0);
+  if (num_vertices == nullptr)
+    return false;
+  opposite_corners_.assign(num_corners(), kInvalidCornerIndex);
+
+  // ComputeOppositeCorners() connects each half-edge with the first unpaired
+  // half-edge of the same edge in the opposite direction, processing the
+  // half-edges in the order of their corners. The pairing of one edge doesn't
+  // depend on any other edges, so we can get the same result by grouping the
+  // half-edges by their smaller vertex (keeping the order of the corners) and
+  // pairing the half-edges of each group independently. The vertices are split
+  // into one bucket per thread and each bucket is processed by one thread.
+
+  // Split the faces into one range per thread and find the number of vertices
+  // and degenerated faces.
+  const int num_buckets = thread_pool->num_threads();
+  std::vector<int> range_faces(num_buckets + 1);
+  for (int i = 0; i <= num_buckets; ++i) {
+    range_faces[i] =
+        static_cast<int>(static_cast<int64_t>(num_faces()) * i / num_buckets);
+  }
+  std::vector<int> range_max_vertex(num_buckets, -1);
+  std::vector<int> range_num_degenerated_faces(num_buckets, 0);
+  thread_pool->ParallelFor(0, num_buckets, [&](int r) {
+    for (FaceIndex f(range_faces[r]); f < range_faces[r + 1]; ++f) {
+      if (IsDegenerated(f))
+        ++range_num_degenerated_faces[r];
+      for (int k = 0; k < 3; ++k) {
+        const int v = Vertex(FirstCorner(f) + k).value();
+        range_max_vertex[r] = std::max(range_max_vertex[r], v);
+      }
+    }
+  });
+  num_degenerated_faces_ = 0;
+  int max_vertex = -1;
+  for (int r = 0; r < num_buckets; ++r) {
+    num_degenerated_faces_ += range_num_degenerated_faces[r];
+    max_vertex = std::max(max_vertex, range_max_vertex[r]);
+  }
+  const int64_t num_verts = max_vertex + 1;
+  // Returns the smaller vertex of the half-edge opposite to corner |c|.
+  const auto edge_vertex = [this](CornerIndex c) {
+    return std::min(Vertex(Next(c)), Vertex(Previous(c)));
+  };
+  const auto bucket = [num_buckets, num_verts](VertexIndex v) {
+    return static_cast<int>(static_cast<int64_t>(v.value()) * num_buckets /
+                            num_verts);
+  };
+
+  // Count the half-edges of each face range that belong to each bucket.
+  std::vector<int> bucket_offsets(num_buckets * num_buckets, 0);
+  thread_pool->ParallelFor(0, num_buckets, [&](int r) {
+    int *const counts = &bucket_offsets[r * num_buckets];
+    for (FaceIndex f(range_faces[r]); f < range_faces[r + 1]; ++f) {
+      if (IsDegenerated(f))
+        continue;
+      for (int k = 0; k < 3; ++k) {
+        ++counts[bucket(edge_vertex(FirstCorner(f) + k))];
+      }
+    }
+  });
+  // Compute where the half-edges of each face range are stored within each
+  // bucket. All buckets are stored in one array.
+  std::vector<int> bucket_starts(num_buckets + 1);
+  int offset = 0;
+  for (int b = 0; b < num_buckets; ++b) {
+    bucket_starts[b] = offset;
+    for (int r = 0; r < num_buckets; ++r) {
+      const int count = bucket_offsets[r * num_buckets + b];
+      bucket_offsets[r * num_buckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucket_starts[num_buckets] = offset;
+
+  // Store all half-edges (defined by their opposite corners) in the buckets.
+  std::vector<CornerIndex> &bucket_corners =
+      connectivity_buffers_.bucket_corners;
+  bucket_corners.resize(offset);
+  thread_pool->ParallelFor(0, num_buckets, [&](int r) {
+    int *const offsets = &bucket_offsets[r * num_buckets];
+    for (FaceIndex f(range_faces[r]); f < range_faces[r + 1]; ++f) {
+      if (IsDegenerated(f))
+        continue;
+      for (int k = 0; k < 3; ++k) {
+        const CornerIndex c = FirstCorner(f) + k;
+        bucket_corners[offsets[bucket(edge_vertex(c))]++] = c;
+      }
+    }
+  });
+
+  // Within each bucket, group the half-edges by their smaller vertex and pair
+  // them.
+  std::vector<int> &num_corners_on_vertices =
+      connectivity_buffers_.num_corners_on_vertices;
+  num_corners_on_vertices.assign(num_verts, 0);
+  std::vector<int> &vertex_offset = connectivity_buffers_.vertex_offset;
+  vertex_offset.resize(num_verts);
+  std::vector<CornerIndex> &sorted_corners =
+      connectivity_buffers_.vertex_half_edge_corners;
+  sorted_corners.resize(offset);
+  thread_pool->ParallelFor(0, num_buckets, [&](int b) {
+    // First vertex of the bucket and the first vertex of the next bucket.
+    const int first_v = (b * num_verts + num_buckets - 1) / num_buckets;
+    const int end_v = ((b + 1) * num_verts + num_buckets - 1) / num_buckets;
+    for (int i = bucket_starts[b]; i < bucket_starts[b + 1]; ++i) {
+      ++num_corners_on_vertices[edge_vertex(bucket_corners[i]).value()];
+    }
+    int vertex_start = bucket_starts[b];
+    for (int v = first_v; v < end_v; ++v) {
+      vertex_offset[v] = vertex_start;
+      vertex_start += num_corners_on_vertices[v];
+    }
+    for (int i = bucket_starts[b]; i < bucket_starts[b + 1]; ++i) {
+      const CornerIndex c = bucket_corners[i];
+      sorted_corners[vertex_offset[edge_vertex(c).value()]++] = c;
+    }
+
+    // Unpaired half-edges of the current vertex.
+    std::vector<CornerIndex> unpaired_corners;
+    int vertex_end = bucket_starts[b];
+    for (int v = first_v; v < end_v; ++v) {
+      const int vertex_begin = vertex_end;
+      vertex_end += num_corners_on_vertices[v];
+      unpaired_corners.clear();
+      for (int i = vertex_begin; i < vertex_end; ++i) {
+        const CornerIndex c = sorted_corners[i];
+        const VertexIndex source_v = Vertex(Next(c));
+        const VertexIndex sink_v = Vertex(Previous(c));
+        // Find the first unpaired half-edge going from |sink_v| to
+        // |source_v|.
+        auto it = unpaired_corners.begin();
+        for (; it != unpaired_corners.end(); ++it) {
+          if (Vertex(Next(*it)) == sink_v && Vertex(Previous(*it)) == source_v)
+            break;
+        }
+        if (it == unpaired_corners.end()) {
+          unpaired_corners.push_back(c);
+        } else {
+          opposite_corners_[c] = *it;
+          opposite_corners_[*it] = c;
+          unpaired_corners.erase(it);
+        }
+      }
+    }
+  });
+  *num_vertices = num_verts;
+  return true;
+}
+
 bool CornerTable::ComputeVertexCorners(int num_vertices) {
   DCHECK_EQ(vertex_valence_cache_8_bit_.size(), 0);
   DCHECK_EQ(vertex_valence_cache_32_bit_.size(), 0);
   num_original_vertices_ = num_vertices;
-  vertex_corners_.resize(num_vertices, kInvalidCornerIndex);
+  vertex_corners_.assign(num_vertices, kInvalidCornerIndex);
   // Arrays for marking visited vertices and corners that allow us to detect
   // non-manifold vertices.
-  std::vector<bool> visited_vertices(num_vertices, false);
-  std::vector<bool> visited_corners(num_corners(), false);
+  std::vector<bool> &visited_vertices = connectivity_buffers_.visited_vertices;
+  visited_vertices.assign(num_vertices, false);
+  std::vector<bool> &visited_corners = connectivity_buffers_.visited_corners;
+  visited_corners.assign(num_corners(), false);
 
   for (FaceIndex f(0); f < num_faces(); ++f) {
     const CornerIndex first_face_corner = FirstCorner(f);
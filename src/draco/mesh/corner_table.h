@@ -17,6 +17,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
 #include "draco/core/draco_index_type_vector.h"
@@ -24,6 +25,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // CornerTable is used to represent connectivity of triangular meshes.
 // For every corner of all faces, the corner table stores the index of the
 // opposite corner in the neighboring face (if it exists) as illustrated in the
@@ -69,6 +72,17 @@ class CornerTable {
   // non-manifold edges and vertices are going to be split.
   bool Initialize(const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Computes the connectivity of faces that were set using Reset() and
+  // SetFaceData(). Memory allocated by previous initializations of the table
+  // is reused, so a table can be re-initialized for a new mesh of the same or
+  // smaller size without any new allocations.
+  bool ComputeConnectivity();
+
+  // Same as ComputeConnectivity() but the opposite corners are computed on all
+  // threads of |thread_pool|. The resulting table is identical to the table
+  // computed on a single thread. |thread_pool| can be nullptr.
+  bool ComputeConnectivity(ThreadPool *thread_pool);
+
   // Resets the corner table to the given number of invalid faces.
   bool Reset(int num_faces);
 
@@ -423,11 +437,44 @@ class CornerTable {
   // is always a 2-manifold surface.
   bool ComputeOppositeCorners(int *num_vertices);
 
+  // Parallel version of ComputeOppositeCorners() that produces the same
+  // opposite corners.
+  bool ComputeOppositeCornersParallel(ThreadPool *thread_pool,
+                                      int *num_vertices);
+
   // Computes the lookup map for going from a vertex to a corner. This method
   // can handle non-manifold vertices by splitting them into multiple manifold
   // vertices.
   bool ComputeVertexCorners(int num_vertices);
 
+  // Half-edge entry used by ComputeOppositeCorners().
+  struct VertexEdgePair {
+    VertexEdgePair()
+        : sink_vert(kInvalidVertexIndex), edge_corner(kInvalidCornerIndex) {}
+    VertexIndex sink_vert;
+    CornerIndex edge_corner;
+  };
+
+  // Temporary arrays used by ComputeConnectivity(). They are stored as member
+  // variables to prevent memory reallocations when the table is initialized
+  // repeatedly. The arrays are not part of the table state, so they are never
+  // copied together with the table.
+  struct ConnectivityBuffers {
+    ConnectivityBuffers() {}
+    ConnectivityBuffers(const ConnectivityBuffers &) {}
+    ConnectivityBuffers &operator=(const ConnectivityBuffers &) {
+      return *this;
+    }
+
+    std::vector<int> num_corners_on_vertices;
+    std::vector<VertexEdgePair> vertex_edges;
+    std::vector<int> vertex_offset;
+    std::vector<bool> visited_vertices;
+    std::vector<bool> visited_corners;
+    std::vector<CornerIndex> bucket_corners;
+    std::vector<CornerIndex> vertex_half_edge_corners;
+  };
+
   // Each three consecutive corners represent one face.
   IndexTypeVector<CornerIndex, VertexIndex> corner_to_vertex_map_;
   IndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
@@ -441,6 +488,8 @@ class CornerTable {
   // Retain valences and clip them to char size.
   mutable IndexTypeVector<VertexIndex, int8_t> vertex_valence_cache_8_bit_;
   mutable IndexTypeVector<VertexIndex, int32_t> vertex_valence_cache_32_bit_;
+
+  ConnectivityBuffers connectivity_buffers_;
 };
 
 // TODO(ostava): All these iterators will be moved into a new file in a separate
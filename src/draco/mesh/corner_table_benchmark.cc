@@ -0,0 +1,53 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "benchmark/benchmark.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/thread_pool.h"
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+namespace {
+
+// The argument is the number of threads. A single thread computes the
+// connectivity without a thread pool.
+void BM_CornerTableComputeConnectivity(benchmark::State &state) {
+  const std::unique_ptr<Mesh> mesh = CreateBenchmarkGridMesh(512);
+  const int num_threads = state.range(0);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_threads > 1)
+    thread_pool.reset(new ThreadPool(num_threads));
+  CornerTable corner_table;
+  for (auto _ : state) {
+    if (!InitializeCornerTableFromPositionAttribute(mesh.get(), &corner_table,
+                                                    thread_pool.get())) {
+      state.SkipWithError("Failed to initialize the corner table.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mesh->num_faces());
+}
+
+}  // namespace
+
+BENCHMARK(BM_CornerTableComputeConnectivity)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+
+}  // namespace draco
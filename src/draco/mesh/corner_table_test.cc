@@ -0,0 +1,99 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/corner_table.h"
+
+#include <random>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
+namespace draco {
+
+class CornerTableTest : public ::testing::Test {
+ protected:
+  void VerifyTablesAreIdentical(const CornerTable &ct0,
+                                const CornerTable &ct1) {
+    ASSERT_EQ(ct0.num_faces(), ct1.num_faces());
+    ASSERT_EQ(ct0.num_vertices(), ct1.num_vertices());
+    ASSERT_EQ(ct0.NumDegeneratedFaces(), ct1.NumDegeneratedFaces());
+    ASSERT_EQ(ct0.NumIsolatedVertices(), ct1.NumIsolatedVertices());
+    for (CornerIndex c(0); c < ct0.num_corners(); ++c) {
+      ASSERT_EQ(ct0.Opposite(c), ct1.Opposite(c)) << "corner " << c;
+      ASSERT_EQ(ct0.Vertex(c), ct1.Vertex(c)) << "corner " << c;
+    }
+    for (VertexIndex v(0); v < ct0.num_vertices(); ++v) {
+      ASSERT_EQ(ct0.LeftMostCorner(v), ct1.LeftMostCorner(v)) << "vertex " << v;
+    }
+  }
+
+  // Verifies that the connectivity of |file_name| computed on multiple
+  // threads is the same as the connectivity computed on a single thread.
+  void TestFile(const std::string &file_name) {
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr) << "Failed to load " << file_name;
+    CornerTable serial_ct;
+    ASSERT_TRUE(InitializeCornerTableFromPositionAttribute(mesh.get(),
+                                                           &serial_ct));
+    CornerTable serial_all_ct;
+    ASSERT_TRUE(
+        InitializeCornerTableFromAllAttributes(mesh.get(), &serial_all_ct));
+    for (int num_threads : {2, 3, 8}) {
+      ThreadPool thread_pool(num_threads);
+      CornerTable ct;
+      ASSERT_TRUE(InitializeCornerTableFromPositionAttribute(mesh.get(), &ct,
+                                                             &thread_pool));
+      VerifyTablesAreIdentical(serial_ct, ct);
+      ASSERT_TRUE(InitializeCornerTableFromAllAttributes(mesh.get(), &ct,
+                                                         &thread_pool));
+      VerifyTablesAreIdentical(serial_all_ct, ct);
+    }
+  }
+};
+
+TEST_F(CornerTableTest, TestParallelConnectivity) {
+  TestFile("sphere.obj");
+  TestFile("cube_att.obj");
+  TestFile("test_nm.obj");
+  TestFile("bun_zipper.ply");
+}
+
+TEST_F(CornerTableTest, TestParallelConnectivityNonManifold) {
+  // Random faces on a small number of vertices contain many degenerated faces
+  // and edges shared by more than two faces in both directions.
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, 15);
+  const int num_faces = 2000;
+  CornerTable serial_ct;
+  CornerTable ct;
+  ASSERT_TRUE(serial_ct.Reset(num_faces));
+  ASSERT_TRUE(ct.Reset(num_faces));
+  for (FaceIndex f(0); f < num_faces; ++f) {
+    CornerTable::FaceType face;
+    for (int i = 0; i < 3; ++i) {
+      face[i] = VertexIndex(distribution(generator));
+    }
+    serial_ct.SetFaceData(f, face);
+    ct.SetFaceData(f, face);
+  }
+  ASSERT_TRUE(serial_ct.ComputeConnectivity());
+  ASSERT_GT(serial_ct.NumDegeneratedFaces(), 0);
+  ThreadPool thread_pool(4);
+  ASSERT_TRUE(ct.ComputeConnectivity(&thread_pool));
+  VerifyTablesAreIdentical(serial_ct, ct);
+}
+
+}  // namespace draco
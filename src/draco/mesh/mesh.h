@@ -58,6 +58,21 @@ class Mesh : public PointCloud {
   // existing ones if necessary.
   void SetNumFaces(size_t num_faces) { faces_.resize(num_faces, Face()); }
 
+  // Replaces all faces of the mesh with |num_faces| faces read from |indices|.
+  // Each face is defined by three consecutive point indices. Much faster than
+  // adding the faces one by one for large meshes.
+  template <typename IndexT>
+  void SetFaces(const IndexT *indices, size_t num_faces) {
+    faces_.resize(num_faces);
+    for (FaceIndex f(0); f < static_cast<uint32_t>(num_faces); ++f) {
+      Face &face = faces_[f];
+      face[0] = PointIndex(static_cast<uint32_t>(indices[0]));
+      face[1] = PointIndex(static_cast<uint32_t>(indices[1]));
+      face[2] = PointIndex(static_cast<uint32_t>(indices[2]));
+      indices += 3;
+    }
+  }
+
   FaceIndex::ValueType num_faces() const { return faces_.size(); }
   const Face &face(FaceIndex face_id) const {
     DCHECK_LE(0, face_id.value());
@@ -128,6 +128,8 @@ void MeshAttributeCornerTable::RecomputeVertices(const Mesh *mesh,
 template <bool init_vertex_to_attribute_entry_map>
 void MeshAttributeCornerTable::RecomputeVerticesInternal(
     const Mesh *mesh, const PointAttribute *att) {
+  vertex_to_attribute_entry_id_map_.clear();
+  vertex_to_left_most_corner_map_.clear();
   int num_new_vertices = 0;
   for (VertexIndex v(0); v < corner_table_->num_vertices(); ++v) {
     const CornerIndex c = corner_table_->LeftMostCorner(v);
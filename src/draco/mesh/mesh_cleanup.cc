@@ -14,8 +14,38 @@
 //
 #include "draco/mesh/mesh_cleanup.h"
 
+#include <atomic>
+#include <cstring>
+
+#include "draco/core/thread_pool.h"
+
 namespace draco {
 
+namespace {
+
+// Splits range <0, |size|) into |num_chunks| continuous chunks. Returns the
+// start of each chunk followed by |size|.
+std::vector<int> ComputeChunkStarts(int size, int num_chunks) {
+  std::vector<int> starts(num_chunks + 1);
+  for (int c = 0; c <= num_chunks; ++c) {
+    starts[c] = static_cast<int>(static_cast<int64_t>(size) * c / num_chunks);
+  }
+  return starts;
+}
+
+// Replaces |counts| with their exclusive prefix sums and returns the total.
+int ComputeOffsets(std::vector<int> *counts) {
+  int offset = 0;
+  for (int &count : *counts) {
+    const int next_offset = offset + count;
+    count = offset;
+    offset = next_offset;
+  }
+  return offset;
+}
+
+}  // namespace
+
 bool MeshCleanup::operator()(Mesh *mesh, const MeshCleanupOptions &options) {
   if (!options.remove_degenerated_faces && !options.remove_unused_attributes)
     return true;  // Nothing to cleanup.
@@ -168,7 +198,8 @@ bool MeshCleanup::operator()(Mesh *mesh, const MeshCleanupOptions &options) {
                 att->mapped_index(i);
             // New index of the same entry after unused entries were removed.
             const AttributeValueIndex new_entry_index =
-                att_index_map[original_entry_index];
+                att_indices_changed ? att_index_map[original_entry_index]
+                                    : original_entry_index;
             att->SetPointMapEntry(new_point_id, new_entry_index);
           }
           // If the number of points changed, we need to set a new explicit map
@@ -181,4 +212,212 @@ bool MeshCleanup::operator()(Mesh *mesh, const MeshCleanupOptions &options) {
   return true;
 }
 
+bool MeshCleanup::operator()(Mesh *mesh, const MeshCleanupOptions &options,
+                             ThreadPool *thread_pool) {
+  if (thread_pool == nullptr || thread_pool->num_threads() == 1)
+    return (*this)(mesh, options);
+  if (!options.remove_degenerated_faces && !options.remove_unused_attributes)
+    return true;  // Nothing to cleanup.
+  const PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr)
+    return false;
+  const int num_chunks = thread_pool->num_threads();
+
+  // Detect degenerated faces and mark points used by the remaining faces. The
+  // marks are atomic because the same point can be marked by multiple chunks.
+  const int num_original_faces = mesh->num_faces();
+  const std::vector<int> face_starts =
+      ComputeChunkStarts(num_original_faces, num_chunks);
+  std::vector<uint8_t> is_face_valid(num_original_faces, 1);
+  std::vector<std::atomic<uint8_t>> is_point_used(
+      options.remove_unused_attributes ? mesh->num_points() : 0);
+  std::vector<int> face_offsets(num_chunks);
+  thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+    int num_valid_faces = 0;
+    for (int f = face_starts[c]; f < face_starts[c + 1]; ++f) {
+      const Mesh::Face &face = mesh->face(FaceIndex(f));
+      if (options.remove_degenerated_faces) {
+        const AttributeValueIndex p0 = pos_att->mapped_index(face[0]);
+        const AttributeValueIndex p1 = pos_att->mapped_index(face[1]);
+        const AttributeValueIndex p2 = pos_att->mapped_index(face[2]);
+        if (p0 == p1 || p0 == p2 || p1 == p2) {
+          is_face_valid[f] = 0;
+          continue;
+        }
+      }
+      ++num_valid_faces;
+      if (options.remove_unused_attributes) {
+        for (int p = 0; p < 3; ++p) {
+          is_point_used[face[p].value()].store(1, std::memory_order_relaxed);
+        }
+      }
+    }
+    face_offsets[c] = num_valid_faces;
+  });
+  const int num_valid_faces = ComputeOffsets(&face_offsets);
+
+  // Map the used points to their new indices. Unused points are mapped to
+  // kInvalidPointIndex.
+  const int num_original_points = mesh->num_points();
+  IndexTypeVector<PointIndex, PointIndex> point_map;
+  int num_new_points = num_original_points;
+  if (options.remove_unused_attributes) {
+    point_map.resize(num_original_points);
+    const std::vector<int> point_starts =
+        ComputeChunkStarts(num_original_points, num_chunks);
+    std::vector<int> point_offsets(num_chunks);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      int num_used_points = 0;
+      for (int i = point_starts[c]; i < point_starts[c + 1]; ++i) {
+        num_used_points += is_point_used[i].load(std::memory_order_relaxed);
+      }
+      point_offsets[c] = num_used_points;
+    });
+    num_new_points = ComputeOffsets(&point_offsets);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      PointIndex new_point(point_offsets[c]);
+      for (int i = point_starts[c]; i < point_starts[c + 1]; ++i) {
+        if (is_point_used[i].load(std::memory_order_relaxed))
+          point_map[PointIndex(i)] = new_point++;
+        else
+          point_map[PointIndex(i)] = kInvalidPointIndex;
+      }
+    });
+  }
+  const bool points_changed = num_new_points < num_original_points;
+
+  // Compact the valid faces and update their points. The faces are gathered in
+  // a temporary array first because a chunk could otherwise overwrite faces
+  // that were not yet processed by the previous chunk.
+  if (num_valid_faces < num_original_faces || points_changed) {
+    std::vector<Mesh::Face> new_faces(num_valid_faces);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      int new_face = face_offsets[c];
+      for (int f = face_starts[c]; f < face_starts[c + 1]; ++f) {
+        if (!is_face_valid[f])
+          continue;
+        Mesh::Face face = mesh->face(FaceIndex(f));
+        if (points_changed) {
+          for (int p = 0; p < 3; ++p) {
+            face[p] = point_map[face[p]];
+          }
+        }
+        new_faces[new_face++] = face;
+      }
+    });
+    mesh->SetNumFaces(num_valid_faces);
+    const std::vector<int> new_face_starts =
+        ComputeChunkStarts(num_valid_faces, num_chunks);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      for (int f = new_face_starts[c]; f < new_face_starts[c + 1]; ++f) {
+        mesh->SetFace(FaceIndex(f), new_faces[f]);
+      }
+    });
+  }
+  if (!options.remove_unused_attributes)
+    return true;
+  if (points_changed)
+    mesh->set_num_points(num_new_points);
+
+  // Update attribute values and index mapping for all attributes.
+  const std::vector<int> point_starts =
+      ComputeChunkStarts(num_original_points, num_chunks);
+  IndexTypeVector<AttributeValueIndex, AttributeValueIndex> att_index_map;
+  std::vector<uint8_t> new_values;
+  std::vector<AttributeValueIndex> new_indices_map;
+  for (int a = 0; a < mesh->num_attributes(); ++a) {
+    PointAttribute *const att = mesh->attribute(a);
+    const int num_entries = att->size();
+    // First detect which attribute entries are used (included in a point).
+    std::vector<std::atomic<uint8_t>> is_att_index_used(num_entries);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      for (int i = point_starts[c]; i < point_starts[c + 1]; ++i) {
+        if (point_map[PointIndex(i)] != kInvalidPointIndex) {
+          const AttributeValueIndex entry_id = att->mapped_index(PointIndex(i));
+          is_att_index_used[entry_id.value()].store(1,
+                                                    std::memory_order_relaxed);
+        }
+      }
+    });
+    const std::vector<int> entry_starts =
+        ComputeChunkStarts(num_entries, num_chunks);
+    std::vector<int> entry_offsets(num_chunks);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      int num_used_entries = 0;
+      for (int i = entry_starts[c]; i < entry_starts[c + 1]; ++i) {
+        num_used_entries +=
+            is_att_index_used[i].load(std::memory_order_relaxed);
+      }
+      entry_offsets[c] = num_used_entries;
+    });
+    const int num_used_entries = ComputeOffsets(&entry_offsets);
+
+    // If there are some unused attribute entries, remap the attribute values
+    // in the attribute buffer. Like the faces, the values are gathered in a
+    // temporary buffer and then copied back.
+    const bool att_indices_changed = num_used_entries < num_entries;
+    if (att_indices_changed) {
+      // External values are copied into the attribute storage on the first
+      // write access, which must not happen concurrently in the workers.
+      att->buffer()->CopyExternalData();
+      const int64_t byte_stride = att->byte_stride();
+      att_index_map.resize(num_entries);
+      new_values.resize(num_used_entries * byte_stride);
+      thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+        AttributeValueIndex new_entry(entry_offsets[c]);
+        for (int i = entry_starts[c]; i < entry_starts[c + 1]; ++i) {
+          if (!is_att_index_used[i].load(std::memory_order_relaxed))
+            continue;
+          memcpy(&new_values[new_entry.value() * byte_stride],
+                 att->GetAddress(AttributeValueIndex(i)), byte_stride);
+          att_index_map[AttributeValueIndex(i)] = new_entry++;
+        }
+      });
+      thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+        const int next_offset =
+            c + 1 < num_chunks ? entry_offsets[c + 1] : num_used_entries;
+        if (next_offset == entry_offsets[c])
+          return;
+        const AttributeValueIndex first_entry(entry_offsets[c]);
+        att->buffer()->Write(att->GetBytePos(first_entry),
+                             &new_values[first_entry.value() * byte_stride],
+                             (next_offset - entry_offsets[c]) * byte_stride);
+      });
+      // Update the number of unique entries in the vertex buffer.
+      att->Resize(num_used_entries);
+    }
+
+    // If either the points or attribute indices have changed, we need to
+    // update the attribute index mapping. Identity mapping remains identity
+    // only if the number of point and attribute indices is still the same.
+    if (!points_changed && !att_indices_changed)
+      continue;
+    if (att->is_mapping_identity() && num_used_entries == num_new_points)
+      continue;
+    new_indices_map.resize(num_new_points);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      for (int i = point_starts[c]; i < point_starts[c + 1]; ++i) {
+        const PointIndex new_point_id = point_map[PointIndex(i)];
+        if (new_point_id == kInvalidPointIndex)
+          continue;
+        const AttributeValueIndex original_entry_index =
+            att->mapped_index(PointIndex(i));
+        new_indices_map[new_point_id.value()] =
+            att_indices_changed ? att_index_map[original_entry_index]
+                                : original_entry_index;
+      }
+    });
+    att->SetExplicitMapping(num_new_points);
+    const std::vector<int> new_point_starts =
+        ComputeChunkStarts(num_new_points, num_chunks);
+    thread_pool->ParallelFor(0, num_chunks, [&](int c) {
+      for (int i = new_point_starts[c]; i < new_point_starts[c + 1]; ++i) {
+        att->SetPointMapEntry(PointIndex(i), new_indices_map[i]);
+      }
+    });
+  }
+  return true;
+}
+
 }  // namespace draco
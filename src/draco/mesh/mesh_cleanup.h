@@ -19,6 +19,8 @@
 
 namespace draco {
 
+class ThreadPool;
+
 // Options used by the MeshCleanup class.
 struct MeshCleanupOptions {
   MeshCleanupOptions()
@@ -36,6 +38,12 @@ class MeshCleanup {
  public:
   // Performs in-place cleanup of the input mesh according to the input options.
   bool operator()(Mesh *mesh, const MeshCleanupOptions &options);
+
+  // Same as above but faces, points and attribute values are processed in
+  // chunks on all threads of |thread_pool|. The result is identical to the
+  // serial cleanup. When |thread_pool| is nullptr, the serial cleanup is used.
+  bool operator()(Mesh *mesh, const MeshCleanupOptions &options,
+                  ThreadPool *thread_pool);
 };
 
 }  // namespace draco
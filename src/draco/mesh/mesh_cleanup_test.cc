@@ -14,7 +14,11 @@
 //
 #include "draco/mesh/mesh_cleanup.h"
 
+#include <random>
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/vector_d.h"
 #include "draco/mesh/triangle_soup_mesh_builder.h"
 
@@ -128,4 +132,159 @@ TEST_F(MeshCleanupTest, TestAttributes) {
       << "Wrong number of generic attribute entries after cleanup.";
 }
 
+// Creates a random mesh with degenerated faces, unused points and unused
+// attribute values. When |use_all_pos_values| is set, the points used by the
+// faces reference all position values.
+std::unique_ptr<Mesh> CreateRandomMesh(bool use_all_pos_values) {
+  const int num_points = 3000;
+  const int num_pos_values = 1500;
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> point_distribution(0, 2500);
+  std::uniform_int_distribution<int> pos_distribution(0, 1200);
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->set_num_points(num_points);
+  for (int f = 0; f < 5000; ++f) {
+    Mesh::Face face;
+    for (int c = 0; c < 3; ++c) {
+      face[c] = point_distribution(generator);
+    }
+    mesh->AddFace(face);
+  }
+  GeometryAttribute pos_att;
+  pos_att.Init(GeometryAttribute::POSITION, nullptr, 3, DT_FLOAT32, false, 12,
+               0);
+  GeometryAttribute generic_att;
+  generic_att.Init(GeometryAttribute::GENERIC, nullptr, 1, DT_UINT16, false, 2,
+                   0);
+  const int pos_att_id = mesh->AddAttribute(pos_att, false, num_pos_values);
+  const int generic_att_id = mesh->AddAttribute(generic_att, true, num_points);
+  PointAttribute *const pos = mesh->attribute(pos_att_id);
+  for (AttributeValueIndex i(0); i < num_pos_values; ++i) {
+    Vector3f value(i.value(), 0.f, 1.f);
+    pos->SetAttributeValue(i, value.data());
+  }
+  pos->SetExplicitMapping(num_points);
+  for (PointIndex i(0); i < num_points; ++i) {
+    pos->SetPointMapEntry(i, AttributeValueIndex(pos_distribution(generator)));
+  }
+  if (use_all_pos_values) {
+    // Assign the position values to the used points in turn. There are more
+    // used points than position values.
+    std::vector<bool> is_point_used(num_points, false);
+    int num_used_points = 0;
+    for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+      for (int c = 0; c < 3; ++c) {
+        const PointIndex p = mesh->face(f)[c];
+        if (is_point_used[p.value()])
+          continue;
+        is_point_used[p.value()] = true;
+        pos->SetPointMapEntry(
+            p, AttributeValueIndex(num_used_points++ % num_pos_values));
+      }
+    }
+  }
+  for (AttributeValueIndex i(0); i < num_points; ++i) {
+    const uint16_t value = i.value();
+    mesh->attribute(generic_att_id)->SetAttributeValue(i, &value);
+  }
+  return mesh;
+}
+
+// Verifies that the faces, points and attributes of two meshes are the same.
+void VerifyMeshesEqual(const Mesh &mesh, const Mesh &other_mesh) {
+  EXPECT_EQ(mesh.num_faces(), other_mesh.num_faces());
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    EXPECT_EQ(mesh.face(f), other_mesh.face(f));
+  }
+  EXPECT_EQ(mesh.num_points(), other_mesh.num_points());
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    const PointAttribute *const att = mesh.attribute(a);
+    const PointAttribute *const other_att = other_mesh.attribute(a);
+    EXPECT_EQ(att->size(), other_att->size());
+    EXPECT_EQ(att->is_mapping_identity(), other_att->is_mapping_identity());
+    EXPECT_EQ(att->indices_map_size(), other_att->indices_map_size());
+    for (PointIndex p(0); p < mesh.num_points(); ++p) {
+      EXPECT_EQ(att->mapped_index(p), other_att->mapped_index(p));
+    }
+    for (AttributeValueIndex i(0); i < att->size(); ++i) {
+      EXPECT_EQ(0, memcmp(att->GetAddress(i), other_att->GetAddress(i),
+                          att->byte_stride()));
+    }
+  }
+}
+
+// Verifies that random meshes cleaned on multiple threads are the same as
+// random meshes cleaned on a single thread. Returns the cleaned mesh.
+std::unique_ptr<Mesh> VerifyParallelCleanup(const MeshCleanupOptions &options,
+                                            bool use_all_pos_values) {
+  std::unique_ptr<Mesh> mesh = CreateRandomMesh(use_all_pos_values);
+  MeshCleanup cleanup;
+  EXPECT_TRUE(cleanup(mesh.get(), options));
+  for (int num_threads = 2; num_threads <= 8; num_threads *= 2) {
+    const std::unique_ptr<Mesh> parallel_mesh =
+        CreateRandomMesh(use_all_pos_values);
+    ThreadPool thread_pool(num_threads);
+    EXPECT_TRUE(cleanup(parallel_mesh.get(), options, &thread_pool));
+    VerifyMeshesEqual(*mesh, *parallel_mesh);
+  }
+  return mesh;
+}
+
+TEST_F(MeshCleanupTest, TestParallelCleanup) {
+  // Tests that meshes cleaned on multiple threads are the same as meshes
+  // cleaned on a single thread.
+  for (int o = 0; o < 3; ++o) {
+    MeshCleanupOptions options;
+    options.remove_degenerated_faces = (o != 1);
+    options.remove_unused_attributes = (o != 2);
+    const std::unique_ptr<Mesh> mesh = VerifyParallelCleanup(options, false);
+    if (options.remove_degenerated_faces) {
+      ASSERT_LT(mesh->num_faces(), 5000);
+    }
+    if (options.remove_unused_attributes) {
+      ASSERT_LT(mesh->num_points(), 3000);
+    }
+  }
+}
+
+TEST_F(MeshCleanupTest, TestParallelCleanupWithAllValuesUsed) {
+  // Tests the parallel cleanup of a mesh where unused points are removed but
+  // all position values remain referenced by the remaining points.
+  MeshCleanupOptions options;
+  options.remove_degenerated_faces = false;
+  const std::unique_ptr<Mesh> mesh = VerifyParallelCleanup(options, true);
+  ASSERT_LT(mesh->num_points(), 3000);
+  ASSERT_EQ(mesh->GetNamedAttribute(GeometryAttribute::POSITION)->size(),
+            1500u);
+}
+
+TEST_F(MeshCleanupTest, TestParallelCleanupOfExternalValues) {
+  // Tests the parallel cleanup of a mesh with attribute values stored in
+  // external memory. The values must be copied into the attributes before
+  // they are compacted and the external memory must remain unchanged.
+  const MeshCleanupOptions options;
+  const std::unique_ptr<Mesh> mesh = CreateRandomMesh(false);
+  MeshCleanup cleanup;
+  ASSERT_TRUE(cleanup(mesh.get(), options));
+
+  const std::unique_ptr<Mesh> external_mesh = CreateRandomMesh(false);
+  std::vector<std::vector<uint8_t>> external_values;
+  for (int a = 0; a < external_mesh->num_attributes(); ++a) {
+    PointAttribute *const att = external_mesh->attribute(a);
+    const uint8_t *const values =
+        static_cast<const PointAttribute *>(att)->GetAddress(
+            AttributeValueIndex(0));
+    external_values.emplace_back(values,
+                                 values + att->size() * att->byte_stride());
+    ASSERT_TRUE(att->ResetExternal(external_values.back().data(), att->size()));
+    ASSERT_TRUE(att->is_external());
+  }
+  const std::vector<std::vector<uint8_t>> original_values = external_values;
+  ThreadPool thread_pool(4);
+  ASSERT_TRUE(cleanup(external_mesh.get(), options, &thread_pool));
+  VerifyMeshesEqual(*mesh, *external_mesh);
+  ASSERT_FALSE(external_mesh->attribute(0)->is_external());
+  ASSERT_EQ(external_values, original_values);
+}
+
 }  // namespace draco
@@ -18,13 +18,41 @@ namespace draco {
 
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     const Mesh *mesh) {
+  std::unique_ptr<CornerTable> ct(new CornerTable());
+  if (!InitializeCornerTableFromPositionAttribute(mesh, ct.get()))
+    return nullptr;
+  return ct;
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh) {
+  std::unique_ptr<CornerTable> ct(new CornerTable());
+  if (!InitializeCornerTableFromAllAttributes(mesh, ct.get()))
+    return nullptr;
+  return ct;
+}
+
+bool InitializeCornerTableFromPositionAttribute(const Mesh *mesh,
+                                                CornerTable *ct) {
+  return InitializeCornerTableFromPositionAttribute(mesh, ct, nullptr);
+}
+
+bool InitializeCornerTableFromAllAttributes(const Mesh *mesh,
+                                            CornerTable *ct) {
+  return InitializeCornerTableFromAllAttributes(mesh, ct, nullptr);
+}
+
+bool InitializeCornerTableFromPositionAttribute(const Mesh *mesh,
+                                                CornerTable *ct,
+                                                ThreadPool *thread_pool) {
   typedef CornerTable::FaceType FaceType;
 
   const PointAttribute *const att =
       mesh->GetNamedAttribute(GeometryAttribute::POSITION);
   if (att == nullptr)
-    return nullptr;
-  IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
+    return false;
+  if (!ct->Reset(mesh->num_faces(), att->size()))
+    return false;
   FaceType new_face;
   for (FaceIndex i(0); i < mesh->num_faces(); ++i) {
     const Mesh::Face &face = mesh->face(i);
@@ -32,16 +60,17 @@ std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
       // Map general vertex indices to position indices.
       new_face[j] = att->mapped_index(face[j]).value();
     }
-    faces[FaceIndex(i)] = new_face;
+    ct->SetFaceData(i, new_face);
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return ct->ComputeConnectivity(thread_pool);
 }
 
-std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
-    const Mesh *mesh) {
+bool InitializeCornerTableFromAllAttributes(const Mesh *mesh, CornerTable *ct,
+                                            ThreadPool *thread_pool) {
   typedef CornerTable::FaceType FaceType;
-  IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
+  if (!ct->Reset(mesh->num_faces(), mesh->num_points()))
+    return false;
   FaceType new_face;
   for (FaceIndex i(0); i < mesh->num_faces(); ++i) {
     const Mesh::Face &face = mesh->face(i);
@@ -50,9 +79,10 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     for (int j = 0; j < 3; ++j) {
       new_face[j] = face[j].value();
     }
-    faces[i] = new_face;
+    ct->SetFaceData(i, new_face);
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return ct->ComputeConnectivity(thread_pool);
 }
+
 }  // namespace draco
@@ -18,6 +18,7 @@
 #ifndef DRACO_MESH_MESH_MISC_FUNCTIONS_H_
 #define DRACO_MESH_MESH_MISC_FUNCTIONS_H_
 
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table.h"
 #include "draco/mesh/mesh.h"
 
@@ -34,6 +35,22 @@ std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh);
 
+// Same as CreateCornerTableFromPositionAttribute() and
+// CreateCornerTableFromAllAttributes(), but the result is stored in an existing
+// |ct| whose memory is reused. Returns false on error.
+bool InitializeCornerTableFromPositionAttribute(const Mesh *mesh,
+                                                CornerTable *ct);
+bool InitializeCornerTableFromAllAttributes(const Mesh *mesh, CornerTable *ct);
+
+// Same as above, but the connectivity of the table is computed on all threads
+// of |thread_pool| (see CornerTable::ComputeConnectivity()). |thread_pool| can
+// be nullptr.
+bool InitializeCornerTableFromPositionAttribute(const Mesh *mesh,
+                                                CornerTable *ct,
+                                                ThreadPool *thread_pool);
+bool InitializeCornerTableFromAllAttributes(const Mesh *mesh, CornerTable *ct,
+                                            ThreadPool *thread_pool);
+
 // Returns true when the given corner lies opposite to an attribute seam.
 inline bool IsCornerOppositeToAttributeSeam(CornerIndex ci,
                                             const PointAttribute &att,
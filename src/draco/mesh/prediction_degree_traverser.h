@@ -61,9 +61,19 @@ class PredictionDegreeTraverser {
     traversal_observer_ = traversal_observer;
   }
 
+  // Re-initializes the traverser for a new traversal over |corner_table|.
+  // Unlike Init(), the processor is reset in place so that its memory can be
+  // reused. TraversalProcessorT must implement ResetProcessor(corner_table).
+  void Reset(const CornerTable *corner_table,
+             TraversalObserverT traversal_observer) {
+    processor_.ResetProcessor(corner_table);
+    corner_table_ = corner_table;
+    traversal_observer_ = traversal_observer;
+  }
+
   // Called before any traversing starts.
   void OnTraversalStart() {
-    prediction_degree_.resize(corner_table_->num_vertices(), 0);
+    prediction_degree_.assign(corner_table_->num_vertices(), 0);
   }
 
   // Called when all the traversing is done.
@@ -49,6 +49,22 @@ void TriangleSoupMeshBuilder::SetAttributeValuesForFace(
   attribute_element_types_[att_id] = MESH_CORNER_ATTRIBUTE;
 }
 
+void TriangleSoupMeshBuilder::SetAttributeValuesForFaces(
+    int att_id, FaceIndex first_face_id, int num_faces,
+    const void *corner_values, int64_t byte_stride) {
+  const int start_index = 3 * first_face_id.value();
+  mesh_->attribute(att_id)->SetAttributeValues(
+      AttributeValueIndex(start_index), 3 * num_faces, corner_values,
+      byte_stride);
+  for (int i = 0; i < num_faces; ++i) {
+    const int corner_index = start_index + 3 * i;
+    mesh_->SetFace(first_face_id + i,
+                   {{PointIndex(corner_index), PointIndex(corner_index + 1),
+                     PointIndex(corner_index + 2)}});
+  }
+  attribute_element_types_[att_id] = MESH_CORNER_ATTRIBUTE;
+}
+
 void TriangleSoupMeshBuilder::SetPerFaceAttributeValueForFace(
     int att_id, FaceIndex face_id, const void *value) {
   const int start_index = 3 * face_id.value();
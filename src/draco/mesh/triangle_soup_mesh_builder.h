@@ -40,6 +40,14 @@ class TriangleSoupMeshBuilder {
                                  const void *corner_value_1,
                                  const void *corner_value_2);
 
+  // Sets values for a given attribute on all corners of |num_faces| faces
+  // starting at |first_face_id|. |corner_values| contains the values of all
+  // three corners of each face, where consecutive values are |byte_stride|
+  // bytes apart (tightly packed when |byte_stride| is 0).
+  void SetAttributeValuesForFaces(int att_id, FaceIndex first_face_id,
+                                  int num_faces, const void *corner_values,
+                                  int64_t byte_stride = 0);
+
   // Sets value for a per-face attribute. If all faces of a given attribute are
   // set with this method, the attribute will be marked as per-face, otherwise
   // it will be marked as per-corner attribute.
@@ -194,4 +194,38 @@ TEST_F(TriangleSoupMeshBuilderTest, TestPerFaceAttribs) {
       << "Unexpected attribute element type.";
 }
 
+TEST_F(TriangleSoupMeshBuilderTest, BulkValuesTest) {
+  // This test verifies that the mesh builder accepts values of multiple faces
+  // stored in a single strided array.
+  // clang-format off
+  const float corners[] = {
+      // Position,     padding.
+      0.f, 0.f, 0.f,   -1.f,
+      1.f, 0.f, 0.f,   -1.f,
+      0.f, 1.f, 0.f,   -1.f,
+      0.f, 1.f, 0.f,   -1.f,
+      1.f, 0.f, 0.f,   -1.f,
+      1.f, 1.f, 0.f,   -1.f};
+  // clang-format on
+  TriangleSoupMeshBuilder mb;
+  mb.Start(2);
+  const int pos_att_id =
+      mb.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  mb.SetAttributeValuesForFaces(pos_att_id, FaceIndex(0), 2, corners,
+                                4 * sizeof(float));
+  std::unique_ptr<Mesh> mesh = mb.Finalize();
+  ASSERT_NE(mesh, nullptr) << "Failed to build the quad mesh.";
+  ASSERT_EQ(mesh->num_faces(), 2) << "Unexpected number of faces.";
+  ASSERT_EQ(mesh->num_points(), 4) << "Unexpected number of points.";
+  const PointAttribute *const pos_att = mesh->attribute(pos_att_id);
+  for (FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      Vector3f pos;
+      pos_att->GetMappedValue(mesh->face(f)[c], &pos[0]);
+      const float *const corner = corners + 4 * (3 * f.value() + c);
+      ASSERT_EQ(pos, Vector3f(corner[0], corner[1], corner[2]));
+    }
+  }
+}
+
 }  // namespace draco
@@ -15,7 +15,8 @@
 #include "draco/point_cloud/point_cloud.h"
 
 #include <algorithm>
-#include <unordered_map>
+
+#include "draco/core/flat_hash_set.h"
 
 namespace draco {
 
@@ -149,40 +150,46 @@ void PointCloud::DeleteAttribute(int att_id) {
 }
 
 #ifdef DRACO_ATTRIBUTE_DEDUPLICATION_SUPPORTED
-void PointCloud::DeduplicatePointIds() {
+void PointCloud::DeduplicatePointIds() { DeduplicatePointIds(nullptr); }
+
+void PointCloud::DeduplicatePointIds(ThreadPool *thread_pool) {
   // Hashing function for a single vertex.
-  auto point_hash = [this](PointIndex p) {
-    PointIndex::ValueType hash = 0;
+  auto point_hash = [this](int p) {
+    uint64_t hash = 0;
     for (int32_t i = 0; i < this->num_attributes(); ++i) {
-      const AttributeValueIndex att_id = attribute(i)->mapped_index(p);
-      hash = HashCombine(att_id.value(), hash);
+      const AttributeValueIndex att_id =
+          attribute(i)->mapped_index(PointIndex(p));
+      hash = MixHashBits(hash + att_id.value());
     }
     return hash;
   };
   // Comparison function between two vertices.
-  auto point_compare = [this](PointIndex p0, PointIndex p1) {
+  auto point_compare = [this](int p0, int p1) {
     for (int32_t i = 0; i < this->num_attributes(); ++i) {
-      const AttributeValueIndex att_id0 = attribute(i)->mapped_index(p0);
-      const AttributeValueIndex att_id1 = attribute(i)->mapped_index(p1);
+      const AttributeValueIndex att_id0 =
+          attribute(i)->mapped_index(PointIndex(p0));
+      const AttributeValueIndex att_id1 =
+          attribute(i)->mapped_index(PointIndex(p1));
       if (att_id0 != att_id1)
         return false;
     }
     return true;
   };
 
-  std::unordered_map<PointIndex, PointIndex, decltype(point_hash),
-                     decltype(point_compare)>
-      unique_point_map(num_points_, point_hash, point_compare);
+  // Find the first point equal to each point.
+  std::vector<int> first_points;
+  FindDuplicateKeys<int>(
+      num_points_, [](int p) { return p; }, point_hash, point_compare,
+      thread_pool, &first_points);
   int32_t num_unique_points = 0;
   IndexTypeVector<PointIndex, PointIndex> index_map(num_points_);
   std::vector<PointIndex> unique_points;
   // Go through all vertices and find their duplicates.
   for (PointIndex i(0); i < num_points_; ++i) {
-    const auto it = unique_point_map.find(i);
-    if (it != unique_point_map.end()) {
-      index_map[i] = it->second;
+    const PointIndex first_point(first_points[i.value()]);
+    if (first_point != i) {
+      index_map[i] = index_map[first_point];
     } else {
-      unique_point_map.insert(std::make_pair(i, PointIndex(num_unique_points)));
       index_map[i] = num_unique_points++;
       unique_points.push_back(i);
     }
@@ -216,12 +223,17 @@ void PointCloud::ApplyPointIdDeduplication(
 }
 
 bool PointCloud::DeduplicateAttributeValues() {
+  return DeduplicateAttributeValues(nullptr);
+}
+
+bool PointCloud::DeduplicateAttributeValues(ThreadPool *thread_pool) {
   // Go over all attributes and create mapping between duplicate entries.
   if (num_points() == 0)
     return false;  // Unexpected attribute size.
   // Deduplicate all attributes.
   for (int32_t att_id = 0; att_id < num_attributes(); ++att_id) {
-    if (!attribute(att_id)->DeduplicateValues(*attribute(att_id)))
+    if (!attribute(att_id)->DeduplicateValues(
+            *attribute(att_id), AttributeValueIndex(0), thread_pool))
       return false;
   }
   return true;
@@ -103,6 +103,12 @@ class PointCloud {
   // Removes duplicate point ids (two point ids are duplicate when all of their
   // attributes are mapped to the same entry ids).
   virtual void DeduplicatePointIds();
+
+  // Same as DeduplicateAttributeValues() and DeduplicatePointIds() but the
+  // duplicates are searched for on all threads of |thread_pool|. The result
+  // is the same as with a single thread. |thread_pool| can be nullptr.
+  bool DeduplicateAttributeValues(ThreadPool *thread_pool);
+  void DeduplicatePointIds(ThreadPool *thread_pool);
 #endif
 
   // Add metadata.
@@ -0,0 +1,59 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "benchmark/benchmark.h"
+#include "draco/core/draco_benchmark_utils.h"
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+namespace {
+
+// The argument is the number of threads. A single thread deduplicates the
+// values without a thread pool.
+void BM_DeduplicateAttributeValues(benchmark::State &state) {
+  const int num_threads = state.range(0);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_threads > 1)
+    thread_pool.reset(new ThreadPool(num_threads));
+  int num_points = 0;
+  for (auto _ : state) {
+    // Deduplication modifies the mesh so a new one is created each time.
+    state.PauseTiming();
+    std::unique_ptr<Mesh> mesh = CreateBenchmarkGridMesh(512);
+    num_points = mesh->num_points();
+    state.ResumeTiming();
+    if (!mesh->DeduplicateAttributeValues(thread_pool.get())) {
+      state.SkipWithError("Failed to deduplicate attribute values.");
+      break;
+    }
+    mesh->DeduplicatePointIds(thread_pool.get());
+    // Exclude the destruction of the mesh from the timing.
+    state.PauseTiming();
+    mesh.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_points);
+}
+
+}  // namespace
+
+BENCHMARK(BM_DeduplicateAttributeValues)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+
+}  // namespace draco
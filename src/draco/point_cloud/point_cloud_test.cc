@@ -14,6 +14,8 @@
 //
 #include "draco/point_cloud/point_cloud.h"
 
+#include <random>
+
 #include "draco/core/draco_test_base.h"
 
 namespace {
@@ -126,4 +128,54 @@ TEST_F(PointCloudTest, TestPointCloudWithMetadata) {
   // Attribute id of material attribute is changed from 1 to 0.
   ASSERT_NE(pc.GetAttributeMetadataByAttributeId(0), nullptr);
 }
+
+TEST_F(PointCloudTest, TestParallelDeduplication) {
+  // Tests that point clouds deduplicated on multiple threads are the same as
+  // point clouds deduplicated on a single thread.
+  const int num_points = 10000;
+  std::unique_ptr<draco::PointCloud> pcs[2];
+  for (int k = 0; k < 2; ++k) {
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> distribution(0, 20);
+    pcs[k].reset(new draco::PointCloud());
+    draco::PointCloud &pc = *pcs[k];
+    pc.set_num_points(num_points);
+    draco::GeometryAttribute pos_att;
+    pos_att.Init(draco::GeometryAttribute::POSITION, nullptr, 3,
+                 draco::DT_FLOAT32, false, 12, 0);
+    draco::GeometryAttribute color_att;
+    color_att.Init(draco::GeometryAttribute::COLOR, nullptr, 1,
+                   draco::DT_UINT8, false, 1, 0);
+    const int pos_att_id = pc.AddAttribute(pos_att, true, num_points);
+    const int color_att_id = pc.AddAttribute(color_att, true, num_points);
+    for (draco::AttributeValueIndex i(0); i < num_points; ++i) {
+      const float pos[3] = {static_cast<float>(distribution(generator) % 4),
+                            static_cast<float>(distribution(generator) % 4),
+                            0.f};
+      const uint8_t color = distribution(generator) % 3;
+      pc.attribute(pos_att_id)->SetAttributeValue(i, pos);
+      pc.attribute(color_att_id)->SetAttributeValue(i, &color);
+    }
+  }
+  ASSERT_TRUE(pcs[0]->DeduplicateAttributeValues());
+  pcs[0]->DeduplicatePointIds();
+  draco::ThreadPool thread_pool(4);
+  ASSERT_TRUE(pcs[1]->DeduplicateAttributeValues(&thread_pool));
+  pcs[1]->DeduplicatePointIds(&thread_pool);
+
+  ASSERT_EQ(pcs[0]->num_points(), 4 * 4 * 3);
+  ASSERT_EQ(pcs[1]->num_points(), pcs[0]->num_points());
+  for (int a = 0; a < pcs[0]->num_attributes(); ++a) {
+    const draco::PointAttribute *const att0 = pcs[0]->attribute(a);
+    const draco::PointAttribute *const att1 = pcs[1]->attribute(a);
+    ASSERT_EQ(att0->size(), att1->size());
+    for (draco::PointIndex p(0); p < pcs[0]->num_points(); ++p) {
+      ASSERT_EQ(att0->mapped_index(p), att1->mapped_index(p));
+      ASSERT_EQ(0, memcmp(att0->GetAddressOfMappedIndex(p),
+                          att1->GetAddressOfMappedIndex(p),
+                          att0->byte_stride()));
+    }
+  }
+}
+
 }  // namespace
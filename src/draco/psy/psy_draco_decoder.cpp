@@ -8,6 +8,7 @@
 */
 
 #include "psy_draco_decoder.h"
+#include <algorithm>
 #include "draco/attributes/point_attribute.h"
 #include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
 
@@ -19,6 +20,28 @@ namespace draco
 class MeshEdgeBreakerDecompression : protected ::draco::MeshEdgeBreakerDecoder
 {
 public:
+    /* Caller owned memory the values of an attribute are decompressed into */
+    struct OutputBuffer
+    {
+        OutputBuffer() :
+            mpData(nullptr),
+            mStride(0),
+            mCapacity(0),
+            mDataType(::draco::DT_INVALID),
+            mComponentsCount(0),
+            mIsWritten(false)
+        {
+        }
+
+        uint8_t* mpData;
+        size_t mStride;
+        size_t mCapacity;
+        ::draco::DataType mDataType;
+        int mComponentsCount;
+        /* set when the decoder has stored the values directly into mpData */
+        bool mIsWritten;
+    };
+
     MeshEdgeBreakerDecompression() : ::draco::MeshEdgeBreakerDecoder()
     {
         mIsIncrementalDecompression = false;
@@ -30,11 +53,62 @@ public:
                                const bool isIncrementalDecompression)
     {
         mIsIncrementalDecompression = isIncrementalDecompression;
-        const auto status = Decode(::draco::DecoderOptions(), &rBuffer, &rMesh);
+        for (auto& r_output_buffer : mOutputBuffers)
+        {
+            r_output_buffer.mIsWritten = false;
+        }
+        const auto status = Decode(mDecoderOptions, &rBuffer, &rMesh);
         mVerticesCount = (status.ok() ? rMesh.num_points() : 0);
         return status;
     }
+
+    void SetDecodingThreadsCount(const int decodingThreadsCount)
+    {
+        mDecoderOptions.SetGlobalInt("num_decoding_threads",
+                                     std::max(1, decodingThreadsCount));
+    }
+
+    void SetTemporalPrediction(const bool isTemporalPredictionEnabled)
+    {
+        // - incremental meshes may be predicted from the previous frame
+        //   (see MeshCompression::SetTemporalPrediction)
+        mDecoderOptions.SetGlobalBool("store_reference_attributes",
+                                      isTemporalPredictionEnabled);
+    }
+
+    void SetOutputBuffer(const ::draco::GeometryAttribute::Type type,
+                         const OutputBuffer& rOutputBuffer)
+    {
+        auto* p_output_buffer = FindOutputBuffer(type);
+        if (p_output_buffer)
+        {
+            *p_output_buffer = rOutputBuffer;
+        }
+    }
+
+    const OutputBuffer* GetOutputBuffer(const ::draco::GeometryAttribute::Type type) const
+    {
+        return const_cast<MeshEdgeBreakerDecompression*>(this)->FindOutputBuffer(type);
+    }
 protected:
+    uint8_t* GetAttributeOutputBuffer(int32_t attId, int64_t* pOutByteStride) override
+    {
+        // may be called concurrently for different attributes
+        const auto* p_att = point_cloud()->attribute(attId);
+        auto* p_output_buffer = FindOutputBuffer(p_att->attribute_type());
+        if (nullptr == p_output_buffer ||
+            nullptr == p_output_buffer->mpData ||
+            static_cast<size_t>(point_cloud()->num_points()) > p_output_buffer->mCapacity ||
+            p_att->data_type() != p_output_buffer->mDataType ||
+            p_att->num_components() != p_output_buffer->mComponentsCount)
+        {
+            return nullptr;
+        }
+        p_output_buffer->mIsWritten = true;
+        *pOutByteStride = static_cast<int64_t>(p_output_buffer->mStride);
+        return p_output_buffer->mpData;
+    }
+
     bool InitializeDecoder() override
     {
         if (mIsIncrementalDecompression)
@@ -60,15 +134,36 @@ protected:
         return status;
     }
 private:
+    OutputBuffer* FindOutputBuffer(const ::draco::GeometryAttribute::Type type)
+    {
+        switch (type)
+        {
+        case ::draco::GeometryAttribute::POSITION:
+            return &mOutputBuffers[0];
+        case ::draco::GeometryAttribute::GENERIC:
+            return &mOutputBuffers[1];
+        case ::draco::GeometryAttribute::COLOR:
+            return &mOutputBuffers[2];
+        default:
+            return nullptr;
+        }
+    }
+
     bool mIsIncrementalDecompression;
     size_t mVerticesCount;
+    ::draco::DecoderOptions mDecoderOptions;
+    /* output buffers of position, visibility and vertex color attributes */
+    OutputBuffer mOutputBuffers[3];
     std::unique_ptr<::draco::MeshEdgeBreakerDecoderImplInterface> mpDecoderState;
 };
 
 class MeshDecompression::Impl
 {
 public:
-    Impl()
+    Impl() :
+        mpOutputIndices(nullptr),
+        mMaxOutputVerticesCount(0),
+        mMaxOutputFacesCount(0)
     {
         mpBuffer.reset(new ::draco::DecoderBuffer());
         mpMesh.reset(new ::draco::Mesh());
@@ -115,9 +210,124 @@ public:
             return eStatus::FAILED;
         }
 
+        if (nullptr != mpOutputIndices && !UpdateOutputBuffers())
+        {
+            return eStatus::FAILED;
+        }
+
         return eStatus::SUCCEED;
     }
 
+    void SetOutputBuffers(float* pVertices,
+                          const size_t vertexStride,
+                          const size_t maxVerticesCount,
+                          unsigned int* pIndices,
+                          const size_t maxFacesCount,
+                          unsigned char* pVisibilityAttributes,
+                          unsigned char* pVertexColorAttributes)
+    {
+        mpOutputIndices = pIndices;
+        mMaxOutputVerticesCount = maxVerticesCount;
+        mMaxOutputFacesCount = maxFacesCount;
+        SetOutputBuffer(::draco::GeometryAttribute::POSITION,
+                        reinterpret_cast<uint8_t*>(pVertices),
+                        vertexStride,
+                        ::draco::DT_FLOAT32,
+                        3);
+        SetOutputBuffer(::draco::GeometryAttribute::GENERIC,
+                        pVisibilityAttributes,
+                        sizeof(uint8_t),
+                        ::draco::DT_UINT8,
+                        1);
+        SetOutputBuffer(::draco::GeometryAttribute::COLOR,
+                        pVertexColorAttributes,
+                        sizeof(uint8_t) * 3,
+                        ::draco::DT_UINT8,
+                        3);
+    }
+
+    void SetOutputBuffer(const ::draco::GeometryAttribute::Type type,
+                         uint8_t* pData,
+                         const size_t stride,
+                         const ::draco::DataType dataType,
+                         const int componentsCount)
+    {
+        MeshEdgeBreakerDecompression::OutputBuffer output_buffer;
+        output_buffer.mpData = pData;
+        output_buffer.mStride = stride;
+        output_buffer.mCapacity = mMaxOutputVerticesCount;
+        output_buffer.mDataType = dataType;
+        output_buffer.mComponentsCount = componentsCount;
+        mpMeshDecompression->SetOutputBuffer(type, output_buffer);
+    }
+
+    void ResetOutputBuffers()
+    {
+        // - values of the last mesh that were decompressed directly into the
+        //   output buffers are copied back into the mesh, so GetMesh() still
+        //   returns the last mesh after the buffers are unregistered
+        const ::draco::GeometryAttribute::Type types[] = {::draco::GeometryAttribute::POSITION,
+                                                          ::draco::GeometryAttribute::GENERIC,
+                                                          ::draco::GeometryAttribute::COLOR};
+        for (const auto type : types)
+        {
+            const auto* p_output_buffer = mpMeshDecompression->GetOutputBuffer(type);
+            const int att_id = mpMesh->GetNamedAttributeId(type);
+            if (p_output_buffer->mIsWritten && att_id >= 0)
+            {
+                RestoreAttributeValues(mpMesh->attribute(att_id), *p_output_buffer);
+            }
+        }
+        SetOutputBuffers(nullptr, 0, 0, nullptr, 0, nullptr, nullptr);
+    }
+
+    void RestoreAttributeValues(::draco::PointAttribute* pPointAttribute,
+                                const MeshEdgeBreakerDecompression::OutputBuffer& rOutputBuffer) const
+    {
+        // - the output buffer holds one value per vertex
+        const size_t vertices_count = mpMesh->num_points();
+        pPointAttribute->SetIdentityMapping();
+        pPointAttribute->Reset(vertices_count);
+        const uint8_t* p_src = rOutputBuffer.mpData;
+        for (size_t i = 0; i < vertices_count; ++i, p_src += rOutputBuffer.mStride)
+        {
+            pPointAttribute->SetAttributeValue(::draco::AttributeValueIndex(static_cast<uint32_t>(i)), p_src);
+        }
+    }
+
+    // Stores the parts of the decompressed mesh that were not written directly
+    // by the decoder into the registered output buffers.
+    bool UpdateOutputBuffers()
+    {
+        const size_t vertices_count = mpMesh->num_points();
+        if (vertices_count > mMaxOutputVerticesCount ||
+            static_cast<size_t>(mpMesh->num_faces()) > mMaxOutputFacesCount)
+        {
+            mStatus = ::draco::Status(::draco::Status::ERROR,
+                                      "Output buffers are too small for the decompressed mesh.");
+            return false;
+        }
+        UpdateFaces(mpOutputIndices);
+        const ::draco::GeometryAttribute::Type types[] = {::draco::GeometryAttribute::POSITION,
+                                                          ::draco::GeometryAttribute::GENERIC,
+                                                          ::draco::GeometryAttribute::COLOR};
+        for (const auto type : types)
+        {
+            const auto* p_output_buffer = mpMeshDecompression->GetOutputBuffer(type);
+            const auto* p_point_attribute = GetPointAttributeByType(type);
+            if (nullptr != p_output_buffer->mpData &&
+                !p_output_buffer->mIsWritten &&
+                nullptr != p_point_attribute)
+            {
+                UpdateGeometryAttributeValues(p_point_attribute,
+                                              p_output_buffer->mpData,
+                                              p_output_buffer->mStride,
+                                              vertices_count);
+            }
+        }
+        return true;
+    }
+
     void UpdateGeometryAttributeValues(const ::draco::PointAttribute* pPointAttribute,
                                        uint8_t* pValues,
                                        const size_t stride,
@@ -181,6 +391,47 @@ public:
         return (nullptr != GetVertexColorAttribute());
     }
 
+    void UpdateFaces(unsigned int* pIndices) const
+    {
+        // draco faces are stored as three consecutive 32-bit point indices
+        static_assert(sizeof(::draco::Mesh::Face) == sizeof(unsigned int) * 3,
+                      "Unexpected layout of draco::Mesh::Face");
+        const auto faces_count = mpMesh->num_faces();
+        if (faces_count > 0)
+        {
+            memcpy(pIndices,
+                   &mpMesh->face(::draco::FaceIndex(0)),
+                   faces_count * sizeof(::draco::Mesh::Face));
+        }
+    }
+
+    void UpdateAttributeValues(const ::draco::GeometryAttribute::Type type,
+                               uint8_t* pValues,
+                               const size_t stride) const
+    {
+        const auto* p_output_buffer = mpMeshDecompression->GetOutputBuffer(type);
+        if (p_output_buffer->mIsWritten)
+        {
+            // values were decompressed directly into the registered output buffer
+            if (pValues != p_output_buffer->mpData)
+            {
+                const size_t data_sz_in_bytes =
+                    ::draco::DataTypeLength(p_output_buffer->mDataType) * p_output_buffer->mComponentsCount;
+                const uint8_t* p_src = p_output_buffer->mpData;
+                for (size_t i = 0; i < static_cast<size_t>(mpMesh->num_points());
+                     ++i, pValues += stride, p_src += p_output_buffer->mStride)
+                {
+                    memcpy(pValues, p_src, data_sz_in_bytes);
+                }
+            }
+            return;
+        }
+        UpdateGeometryAttributeValues(GetPointAttributeByType(type),
+                                      pValues,
+                                      stride,
+                                      mpMesh->num_points());
+    }
+
     void GetMesh(float* pVertices,
                  const size_t vertexStride,
                  unsigned int* pIndices,
@@ -188,42 +439,32 @@ public:
                  unsigned char* pVertexColorAttributes) const
     {
         // update faces
+        if (pIndices != mpOutputIndices)
         {
-            const auto faces_count = mpMesh->num_faces();
-            ::draco::FaceIndex face_index(0);
-            for (int32_t i = 0, j = 0; i < faces_count; i++, face_index++)
-            {
-                const auto& face = mpMesh->face(face_index);
-                pIndices[j++] = static_cast<unsigned int>(face[0].value());
-                pIndices[j++] = static_cast<unsigned int>(face[1].value());
-                pIndices[j++] = static_cast<unsigned int>(face[2].value());
-            }
+            UpdateFaces(pIndices);
         }
 
         // update vertices
         {
-            UpdateGeometryAttributeValues(GetPointAttributeByType(::draco::GeometryAttribute::POSITION),
-                                          reinterpret_cast<uint8_t*>(pVertices),
-                                          vertexStride,
-                                          mpMesh->num_points());
+            UpdateAttributeValues(::draco::GeometryAttribute::POSITION,
+                                  reinterpret_cast<uint8_t*>(pVertices),
+                                  vertexStride);
         }
 
         // update visibility attribute
         if (nullptr != pVisibilityAttributes && HasVisibilityInfo())
         {
-            UpdateGeometryAttributeValues(GetVisibilityAttribute(),
-                                          pVisibilityAttributes,
-                                          sizeof(uint8_t),
-                                          mpMesh->num_points());
+            UpdateAttributeValues(::draco::GeometryAttribute::GENERIC,
+                                  pVisibilityAttributes,
+                                  sizeof(uint8_t));
         }
 
         // update visibility attribute
         if (nullptr != pVertexColorAttributes && HasVertexColorInfo())
         {
-            UpdateGeometryAttributeValues(GetVertexColorAttribute(),
-                                          pVertexColorAttributes,
-                                          sizeof(uint8_t) * 3,
-                                          mpMesh->num_points());
+            UpdateAttributeValues(::draco::GeometryAttribute::COLOR,
+                                  pVertexColorAttributes,
+                                  sizeof(uint8_t) * 3);
         }
     }
 
@@ -232,6 +473,9 @@ public:
     std::shared_ptr<::draco::DecoderBuffer> mpBuffer;
     std::unique_ptr<MeshEdgeBreakerDecompression> mpMeshDecompression;
     ::draco::Status mStatus;
+    unsigned int* mpOutputIndices;
+    size_t mMaxOutputVerticesCount;
+    size_t mMaxOutputFacesCount;
 };
 
 MeshDecompression::MeshDecompression(const MeshDecompression&) : mpImpl(nullptr) {};
@@ -251,6 +495,38 @@ MeshDecompression::~MeshDecompression()
     mpImpl = nullptr;
 }
 
+void MeshDecompression::SetDecodingThreadsCount(const int decodingThreadsCount)
+{
+    mpImpl->mpMeshDecompression->SetDecodingThreadsCount(decodingThreadsCount);
+}
+
+void MeshDecompression::SetTemporalPrediction(const bool isTemporalPredictionEnabled)
+{
+    mpImpl->mpMeshDecompression->SetTemporalPrediction(isTemporalPredictionEnabled);
+}
+
+void MeshDecompression::SetOutputBuffers(float* pVertices,
+                                         const size_t vertexStride,
+                                         const size_t maxVerticesCount,
+                                         unsigned int* pIndices,
+                                         const size_t maxFacesCount,
+                                         unsigned char* pVisibilityAttributes,
+                                         unsigned char* pVertexColorAttributes)
+{
+    mpImpl->SetOutputBuffers(pVertices,
+                             vertexStride,
+                             maxVerticesCount,
+                             pIndices,
+                             maxFacesCount,
+                             pVisibilityAttributes,
+                             pVertexColorAttributes);
+}
+
+void MeshDecompression::ResetOutputBuffers()
+{
+    mpImpl->ResetOutputBuffers();
+}
+
 MeshDecompression::eStatus MeshDecompression::Run(const char* pCompressedData,
                                                   const size_t compressedDataSizeInBytes)
 {
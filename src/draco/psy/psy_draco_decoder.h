@@ -31,6 +31,50 @@ public:
     MeshDecompression();
     ~MeshDecompression();
 
+    /*
+    * - decodingThreadsCount (maximum number of threads used for decompression)
+    *   + 1: decompress all attributes on the calling thread (default)
+    *   + ?: decompress independent attributes in parallel, effective only for
+    *     data compressed with MeshCompression::SetParallelDecompressionSupport
+    */
+    void SetDecodingThreadsCount(const int);
+
+    /*
+    * - isTemporalPredictionEnabled (keep the previous frame for prediction)
+    *   + false: frames compressed with temporal prediction can't be
+    *     decompressed, no copy of the decompressed attributes is kept (default)
+    *   + true: required for data compressed with
+    *     MeshCompression::SetTemporalPrediction, all frames of the sequence
+    *     must be decompressed in order
+    * - should be set before the first full mesh of a sequence is decompressed
+    */
+    void SetTemporalPrediction(const bool);
+
+    /*
+    * Registers caller owned buffers the following Run() calls decompress the
+    * mesh into. Vertex positions, visibility and vertex color attributes are
+    * written directly by the final decoding step (e.g. dequantization), so
+    * no intermediate copy of the mesh is made and GetMesh() is not needed.
+    * - pVertices, vertexStride, pIndices, pVisibilityAttributes and
+    *   pVertexColorAttributes have the same meaning as in GetMesh()
+    * - maxVerticesCount, maxFacesCount (capacity of the buffers)
+    *   + Run() fails for meshes that don't fit into the buffers
+    */
+    void SetOutputBuffers(float* pVertices,
+                          const size_t vertexStride,
+                          const size_t maxVerticesCount,
+                          unsigned int* pIndices,
+                          const size_t maxFacesCount,
+                          unsigned char* pVisibilityAttributes,
+                          unsigned char* pVertexColorAttributes);
+
+    /*
+    * Unregisters the output buffers, Run() decompresses into internal storage
+    * - the last decompressed mesh is copied from the output buffers, so they
+    *   must still be valid and GetMesh() keeps returning that mesh
+    */
+    void ResetOutputBuffers();
+
     eStatus Run(const char* pCompressedData,
                 const size_t compressedDataSizeInBytes);
 
@@ -103,7 +103,12 @@ protected:
         const auto status = ::draco::MeshEdgeBreakerEncoder::EncodeConnectivity();
         if (status)
         {
-            mpEncoderState = std::move(CloneEncoderImplState());
+            // - the state from the previous full frame is overwritten in place
+            //   to avoid reallocating it on every frame
+            if (!mpEncoderState || !CopyEncoderImplState(*mpEncoderState))
+            {
+                mpEncoderState = std::move(CloneEncoderImplState());
+            }
         }
         return status;
     }
@@ -123,6 +128,7 @@ public:
         mVertexPositionQuantizationBitsCount(vertexPositionQuantizationBitsCount),
         mHasVisibilityInfo(hasVisibilityInfo),
         mHasVertexColorInfo(hasVertexColorInfo),
+        mIsTemporalPredictionEnabled(false),
         mPositionAttributeId(0),
         mVertexColorAttributeId(-1),
         mVisibilityAttributeId(-1)
@@ -188,28 +194,112 @@ public:
                                               mVertexPositionQuantizationBitsCount);
     }
 
-    void UpdateGeometryAttributeValues(const uint8_t* pValues,
-                                       const size_t stride,
-                                       const size_t verticesCount,
-                                       ::draco::PointAttribute* pPointAttribute)
+    void SetEncodingThreadsCount(const int encodingThreadsCount)
     {
-        pPointAttribute->SetIdentityMapping();
-        pPointAttribute->Resize(verticesCount);
-        pPointAttribute->Reset(verticesCount);
-        const size_t data_sz_in_bytes = pPointAttribute->byte_stride();
-        const auto dst_stride = pPointAttribute->byte_stride();
-        uint8_t* p_dst = pPointAttribute->buffer()->data();
-        if (stride == static_cast<size_t>(dst_stride))
+        mpCompressionOptions->SetGlobalInt("num_encoding_threads",
+                                           std::max(1, encodingThreadsCount));
+    }
+
+    void SetParallelDecompressionSupport(const bool isParallelDecompressionSupported)
+    {
+        mpCompressionOptions->SetGlobalBool("encode_attribute_offsets",
+                                            isParallelDecompressionSupported);
+    }
+
+    void SetTemporalPrediction(const bool isTemporalPredictionEnabled)
+    {
+        mIsTemporalPredictionEnabled = isTemporalPredictionEnabled;
+        mpCompressionOptions->SetGlobalBool("store_reference_attributes",
+                                            isTemporalPredictionEnabled);
+    }
+
+    MeshCompression::eStatus SetEntropyCoderStatesCount(const int entropyCoderStatesCount)
+    {
+        // - only the state counts supported by the symbol coding are accepted,
+        //   the previous value is kept otherwise
+        if (entropyCoderStatesCount != 1 && entropyCoderStatesCount != 2 &&
+            entropyCoderStatesCount != 4 && entropyCoderStatesCount != 8)
         {
-            memcpy(p_dst, pValues, verticesCount * data_sz_in_bytes);
+            mStatus = ::draco::Status(::draco::Status::Code::INVALID_PARAMETER,
+                                      "Unsupported number of entropy coder states.");
+            return eStatus::FAILED;
         }
-        else
+        mpCompressionOptions->SetGlobalInt("symbol_encoding_num_interleaved_states",
+                                           entropyCoderStatesCount);
+        return eStatus::SUCCEED;
+    }
+
+    void UpdateTemporalPredictionOptions(const float* pVertices,
+                                         const size_t vertexStride,
+                                         const size_t verticesCount,
+                                         const bool isIncrementalCompression)
+    {
+        // - the previous frame is used as a reference only for incremental meshes,
+        //   full meshes use the default prediction
+        const int prediction_scheme = isIncrementalCompression ?
+            ::draco::MESH_PREDICTION_TEMPORAL : -1;
+        mpCompressionOptions->SetAttributeInt(::draco::GeometryAttribute::POSITION,
+                                              "prediction_scheme", prediction_scheme);
+        mpCompressionOptions->SetAttributeInt(::draco::GeometryAttribute::GENERIC,
+                                              "prediction_scheme", prediction_scheme);
+        mpCompressionOptions->SetAttributeInt(::draco::GeometryAttribute::COLOR,
+                                              "prediction_scheme", prediction_scheme);
+        if (isIncrementalCompression || 0 == mVertexPositionQuantizationBitsCount)
+        {
+            return;
+        }
+
+        // - quantized positions of consecutive frames are comparable only when
+        //   they share the quantization bounds, keep the bounds of this full mesh
+        //   for the following incremental meshes
+        float min_values[3] = { 0.0f, 0.0f, 0.0f };
+        float max_values[3] = { 0.0f, 0.0f, 0.0f };
+        const uint8_t* p_vertex = reinterpret_cast<const uint8_t*>(pVertices);
+        for (size_t i = 0; i < verticesCount; ++i, p_vertex += vertexStride)
         {
-            for (size_t i = 0; i < verticesCount; ++i, pValues += stride, p_dst += dst_stride)
+            const float* p_position = reinterpret_cast<const float*>(p_vertex);
+            for (int c = 0; c < 3; ++c)
             {
-                memcpy(p_dst, pValues, data_sz_in_bytes);
+                if (0 == i || p_position[c] < min_values[c])
+                {
+                    min_values[c] = p_position[c];
+                }
+                if (0 == i || p_position[c] > max_values[c])
+                {
+                    max_values[c] = p_position[c];
+                }
             }
         }
+        float range = 0.0f;
+        for (int c = 0; c < 3; ++c)
+        {
+            range = std::max(range, max_values[c] - min_values[c]);
+        }
+        if (0.0f == range)
+        {
+            range = 1.0f;
+        }
+        mpCompressionOptions->SetAttributeVector(::draco::GeometryAttribute::POSITION,
+                                                 "quantization_origin", 3, min_values);
+        mpCompressionOptions->SetAttributeFloat(::draco::GeometryAttribute::POSITION,
+                                                "quantization_range", range);
+    } // UpdateTemporalPredictionOptions
+
+    bool UpdateGeometryAttributeValues(const uint8_t* pValues,
+                                       const size_t stride,
+                                       const size_t verticesCount,
+                                       ::draco::PointAttribute* pPointAttribute)
+    {
+        // - the attribute reads the caller's arrays in place, they only need to be valid
+        //   until the mesh is encoded in Run()
+        pPointAttribute->SetIdentityMapping();
+        if (!pPointAttribute->ResetExternal(pValues, verticesCount, static_cast<int64_t>(stride)))
+        {
+            // - don't keep referencing the arrays of the previous frame
+            pPointAttribute->ResetExternal(nullptr, 0, 0);
+            return false;
+        }
+        return true;
     } // UpdateGeometryAttributeValues
 
     MeshCompression::eStatus Run(const float* pVertices,
@@ -244,21 +334,7 @@ public:
         if (false == is_incremental_compression)
         {
             const size_t faces_count = indicesCount / 3;
-            {
-                // - we can use SetFace() to update a face at an index,
-                //   however, each call will have a check valid index inside the implementation
-                // - instead of, I'm doing an allocation memory first and then push data onto
-                mpMesh->SetNumFaces(faces_count); // allocation purpose
-                mpMesh->SetNumFaces(0);
-            }
-            ::draco::Mesh::Face face;
-            for (size_t i = 0, j = 0; i < faces_count; i++)
-            {
-                face[0] = static_cast<int32_t>(pIndices[j++]);
-                face[1] = static_cast<int32_t>(pIndices[j++]);
-                face[2] = static_cast<int32_t>(pIndices[j++]);
-                mpMesh->AddFace(face);
-            }
+            mpMesh->SetFaces(pIndices, faces_count);
         }
 
         // update point attributes
@@ -266,32 +342,51 @@ public:
             mpMesh->set_num_points(static_cast<int32_t>(verticesCount));
 
             // vertex positions
-            UpdateGeometryAttributeValues(reinterpret_cast<const uint8_t*>(pVertices),
-                                          vertexStride,
-                                          verticesCount,
-                                          mpMesh->attribute(mPositionAttributeId));
+            bool isUpdated = UpdateGeometryAttributeValues(reinterpret_cast<const uint8_t*>(pVertices),
+                                                           vertexStride,
+                                                           verticesCount,
+                                                           mpMesh->attribute(mPositionAttributeId));
 
             // update visibility info
             if (mVisibilityAttributeId >= 0)
             {
                 assert(nullptr != pVisibilityAttributes);
-                UpdateGeometryAttributeValues(pVisibilityAttributes,
-                                              sizeof(uint8_t),
-                                              verticesCount,
-                                              mpMesh->attribute(mVisibilityAttributeId));
+                isUpdated = UpdateGeometryAttributeValues(pVisibilityAttributes,
+                                                          sizeof(uint8_t),
+                                                          verticesCount,
+                                                          mpMesh->attribute(mVisibilityAttributeId)) &&
+                            isUpdated;
             }
 
             // update vertex color info
             if (mVertexColorAttributeId >= 0)
             {
                 assert(nullptr != pVertexColorAttributes);
-                UpdateGeometryAttributeValues(pVertexColorAttributes,
-                                              sizeof(uint8_t) * 3,
-                                              verticesCount,
-                                              mpMesh->attribute(mVertexColorAttributeId));
+                isUpdated = UpdateGeometryAttributeValues(pVertexColorAttributes,
+                                                          sizeof(uint8_t) * 3,
+                                                          verticesCount,
+                                                          mpMesh->attribute(mVertexColorAttributeId)) &&
+                            isUpdated;
+            }
+
+            // - all attributes are updated first so none of them references
+            //   the arrays of the previous frame
+            if (!isUpdated)
+            {
+                mStatus = ::draco::Status(::draco::Status::Code::INVALID_PARAMETER,
+                                          "Vertex stride is smaller than the vertex size.");
+                return eStatus::FAILED;
             }
         }
 
+        if (mIsTemporalPredictionEnabled)
+        {
+            UpdateTemporalPredictionOptions(pVertices,
+                                            vertexStride,
+                                            verticesCount,
+                                            is_incremental_compression);
+        }
+
         // run compression
         {
             PSY_DRACO_PROFILE_SECTION("MeshCompression::Impl::Run (EncodeMeshToBuffer)");
@@ -310,6 +405,7 @@ public:
     int mVertexPositionQuantizationBitsCount;
     bool mHasVisibilityInfo;
     bool mHasVertexColorInfo;
+    bool mIsTemporalPredictionEnabled;
 
     int mPositionAttributeId;
     int mVertexColorAttributeId;
@@ -343,6 +439,26 @@ MeshCompression::~MeshCompression()
     mpImpl = nullptr;
 }
 
+void MeshCompression::SetEncodingThreadsCount(const int encodingThreadsCount)
+{
+    mpImpl->SetEncodingThreadsCount(encodingThreadsCount);
+}
+
+void MeshCompression::SetParallelDecompressionSupport(const bool isParallelDecompressionSupported)
+{
+    mpImpl->SetParallelDecompressionSupport(isParallelDecompressionSupported);
+}
+
+void MeshCompression::SetTemporalPrediction(const bool isTemporalPredictionEnabled)
+{
+    mpImpl->SetTemporalPrediction(isTemporalPredictionEnabled);
+}
+
+MeshCompression::eStatus MeshCompression::SetEntropyCoderStatesCount(const int entropyCoderStatesCount)
+{
+    return mpImpl->SetEntropyCoderStatesCount(entropyCoderStatesCount);
+}
+
 bool MeshCompression::IsVisiblityInfoCompressing() const
 {
     return mpImpl->mHasVisibilityInfo;
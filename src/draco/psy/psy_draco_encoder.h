@@ -47,6 +47,44 @@ public:
 
     void SetVertexPositionQuantizationBitsCount(const int);
 
+    /*
+    * - encodingThreadsCount (maximum number of threads used for compression)
+    *   + 1: compress all attributes on the calling thread (default)
+    *   + ?: compress independent attributes in parallel,
+    *     the compressed data is the same as for the single threaded compression
+    */
+    void SetEncodingThreadsCount(const int);
+
+    /*
+    * - isParallelDecompressionSupported (store sizes of compressed attributes)
+    *   + false: compressed data can be decompressed by any decoder (default)
+    *   + true: independent attributes can be decompressed in parallel
+    *     (see MeshDecompression::SetDecodingThreadsCount), requires a decoder
+    *     supporting attribute offsets
+    */
+    void SetParallelDecompressionSupport(const bool);
+
+    /*
+    * - isTemporalPredictionEnabled (predict incremental meshes from the previous frame)
+    *   + false: each frame is compressed independently (default)
+    *   + true: attributes of incremental meshes are predicted from the previously
+    *     compressed frame, vertex positions of all frames are quantized using
+    *     the bounds of the last full mesh, requires a decoder that decompressed
+    *     all previous frames of the sequence in order with
+    *     MeshDecompression::SetTemporalPrediction enabled
+    * - should be set before the first full mesh of a sequence is compressed
+    */
+    void SetTemporalPrediction(const bool);
+
+    /*
+    * - entropyCoderStatesCount (number of interleaved states of the attribute entropy coder)
+    *   + 1: compressed data can be decompressed by any decoder (default)
+    *   + 2, 4, 8: faster decompression, compressed data is slightly larger,
+    *     requires a decoder supporting interleaved entropy coding
+    * - fails for other values, the previous setting is kept in that case
+    */
+    eStatus SetEntropyCoderStatesCount(const int);
+
     bool IsVisiblityInfoCompressing() const;
 
     bool IsVertexColorInfoCompressing() const;
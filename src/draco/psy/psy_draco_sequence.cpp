@@ -0,0 +1,616 @@
+/*
+* @file psy_draco_sequence.cpp
+*
+* Copyright (c) 2018 Personify Inc.
+*
+* @brief
+*   Implements the container for sequences of compressed meshes
+*/
+
+#include "psy_draco_sequence.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined (_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace psy
+{
+namespace draco
+{
+
+static const char kSequenceHeaderMagic[4] = { 'P', 'S', 'Y', 'S' };
+static const char kSequenceFooterMagic[4] = { 'P', 'S', 'Y', 'E' };
+
+class SequenceWriter::Impl
+{
+public:
+    Impl() :
+        mpFile(nullptr),
+        mIsOpen(false),
+        mOffset(0)
+    {
+    }
+
+    ~Impl()
+    {
+        CloseFile();
+    }
+
+    SequenceWriter::eStatus Open(const char* pFilePath)
+    {
+        CloseFile();
+        mData.clear();
+        mEntries.clear();
+        mKeyFrames.clear();
+        mOffset = 0;
+        mIsOpen = false;
+        if (nullptr != pFilePath)
+        {
+            mpFile = fopen(pFilePath, "wb");
+            if (nullptr == mpFile)
+            {
+                return Fail("Failed to open the sequence file.");
+            }
+        }
+        mIsOpen = true;
+
+        SequenceFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.mMagic, kSequenceHeaderMagic, sizeof(header.mMagic));
+        header.mMajorVersion = PSY_DRACO_SEQUENCE_MAJOR_VERSION;
+        header.mMinorVersion = PSY_DRACO_SEQUENCE_MINOR_VERSION;
+        return Write(&header, sizeof(header));
+    }
+
+    SequenceWriter::eStatus AddFrame(const char* pCompressedData,
+                                     const size_t compressedDataSizeInBytes,
+                                     const int64_t timestamp)
+    {
+        if (!mIsOpen)
+        {
+            return Fail("The sequence is not open.");
+        }
+        if (nullptr == pCompressedData ||
+            compressedDataSizeInBytes < sizeof(Header) ||
+            compressedDataSizeInBytes > std::numeric_limits<uint32_t>::max())
+        {
+            return Fail("Invalid frame data.");
+        }
+        Header header;
+        memcpy(&header, pCompressedData, sizeof(header));
+        if (header.mMeshType != MeshType::FULL_MESH &&
+            header.mMeshType != MeshType::INCREMENTAL_MESH)
+        {
+            return Fail("Invalid frame mesh type.");
+        }
+        if (header.mMeshType == MeshType::INCREMENTAL_MESH && mKeyFrames.empty())
+        {
+            return Fail("The first frame of a sequence must be a full mesh.");
+        }
+        if (!mEntries.empty() && timestamp < mEntries.back().mTimestamp)
+        {
+            return Fail("Frame timestamps must not decrease.");
+        }
+
+        SequenceFrameEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.mOffset = mOffset;
+        entry.mSize = static_cast<uint32_t>(compressedDataSizeInBytes);
+        entry.mTimestamp = timestamp;
+        entry.mMeshType = header.mMeshType;
+        if (header.mMeshType == MeshType::FULL_MESH)
+        {
+            mKeyFrames.push_back(static_cast<uint32_t>(mEntries.size()));
+        }
+        entry.mKeyFrameIndex = mKeyFrames.back();
+        if (Write(pCompressedData, compressedDataSizeInBytes) != eStatus::SUCCEED)
+        {
+            return eStatus::FAILED;
+        }
+        mEntries.push_back(entry);
+        return eStatus::SUCCEED;
+    }
+
+    SequenceWriter::eStatus Close()
+    {
+        if (!mIsOpen)
+        {
+            return Fail("The sequence is not open.");
+        }
+        SequenceFileFooter footer;
+        memset(&footer, 0, sizeof(footer));
+        footer.mIndexOffset = mOffset;
+        footer.mFramesCount = static_cast<uint32_t>(mEntries.size());
+        footer.mKeyFramesCount = static_cast<uint32_t>(mKeyFrames.size());
+        memcpy(footer.mMagic, kSequenceFooterMagic, sizeof(footer.mMagic));
+
+        // - the index is written at the end so frames can be streamed to the
+        //   output without knowing the length of the sequence in advance
+        if ((!mEntries.empty() &&
+             Write(mEntries.data(), mEntries.size() * sizeof(SequenceFrameEntry)) != eStatus::SUCCEED) ||
+            (!mKeyFrames.empty() &&
+             Write(mKeyFrames.data(), mKeyFrames.size() * sizeof(uint32_t)) != eStatus::SUCCEED) ||
+            Write(&footer, sizeof(footer)) != eStatus::SUCCEED)
+        {
+            return eStatus::FAILED;
+        }
+        mIsOpen = false;
+        if (nullptr != mpFile && 0 != fclose(mpFile))
+        {
+            mpFile = nullptr;
+            return Fail("Failed to close the sequence file.");
+        }
+        mpFile = nullptr;
+        return eStatus::SUCCEED;
+    }
+
+    SequenceWriter::eStatus Write(const void* pData, const size_t sizeInBytes)
+    {
+        if (nullptr != mpFile)
+        {
+            if (fwrite(pData, 1, sizeInBytes, mpFile) != sizeInBytes)
+            {
+                return Fail("Failed to write the sequence file.");
+            }
+        }
+        else
+        {
+            const char* p_data = static_cast<const char*>(pData);
+            mData.insert(mData.end(), p_data, p_data + sizeInBytes);
+        }
+        mOffset += sizeInBytes;
+        return eStatus::SUCCEED;
+    }
+
+    SequenceWriter::eStatus Fail(const char* pErrorMessage)
+    {
+        mErrorMessage = pErrorMessage;
+        return eStatus::FAILED;
+    }
+
+    void CloseFile()
+    {
+        if (nullptr != mpFile)
+        {
+            fclose(mpFile);
+            mpFile = nullptr;
+        }
+    }
+
+    FILE* mpFile;
+    bool mIsOpen;
+    uint64_t mOffset;
+    std::vector<char> mData;
+    std::vector<SequenceFrameEntry> mEntries;
+    std::vector<uint32_t> mKeyFrames;
+    std::string mErrorMessage;
+}; // SequenceWriter::Impl
+
+SequenceWriter::SequenceWriter(const SequenceWriter&) : mpImpl(nullptr) {}
+SequenceWriter& SequenceWriter::operator=(const SequenceWriter&) { return *this; }
+
+SequenceWriter::SequenceWriter()
+{
+    mpImpl = new Impl();
+}
+
+SequenceWriter::~SequenceWriter()
+{
+    if (mpImpl)
+    {
+        delete mpImpl;
+    }
+    mpImpl = nullptr;
+}
+
+SequenceWriter::eStatus SequenceWriter::Open(const char* pFilePath)
+{
+    return mpImpl->Open(pFilePath);
+}
+
+SequenceWriter::eStatus SequenceWriter::AddFrame(const char* pCompressedData,
+                                                 const size_t compressedDataSizeInBytes,
+                                                 const int64_t timestamp)
+{
+    return mpImpl->AddFrame(pCompressedData, compressedDataSizeInBytes, timestamp);
+}
+
+SequenceWriter::eStatus SequenceWriter::Close()
+{
+    return mpImpl->Close();
+}
+
+const char* SequenceWriter::GetData() const
+{
+    return mpImpl->mData.empty() ? nullptr : mpImpl->mData.data();
+}
+
+size_t SequenceWriter::GetDataSizeInBytes() const
+{
+    return mpImpl->mData.size();
+}
+
+size_t SequenceWriter::GetFramesCount() const
+{
+    return mpImpl->mEntries.size();
+}
+
+const char* SequenceWriter::GetLastErrorMessage() const
+{
+    return mpImpl->mErrorMessage.c_str();
+}
+
+class SequenceReader::Impl
+{
+public:
+    Impl() :
+        mpData(nullptr),
+        mDataSizeInBytes(0),
+        mpEntries(nullptr),
+        mpKeyFrames(nullptr),
+        mFramesCount(0),
+        mKeyFramesCount(0),
+        mpMappedData(nullptr),
+        mMappedSizeInBytes(0)
+#if defined (_WIN32)
+        , mFileHandle(INVALID_HANDLE_VALUE),
+        mMappingHandle(nullptr)
+#endif
+    {
+    }
+
+    ~Impl()
+    {
+        Close();
+    }
+
+    SequenceReader::eStatus OpenFile(const char* pFilePath)
+    {
+        Close();
+        if (!MapFile(pFilePath))
+        {
+            Close();
+            return Fail("Failed to map the sequence file.");
+        }
+        return ParseIndex(static_cast<const char*>(mpMappedData), mMappedSizeInBytes);
+    }
+
+    SequenceReader::eStatus OpenMemory(const char* pData, const size_t dataSizeInBytes)
+    {
+        Close();
+        if (nullptr == pData)
+        {
+            return Fail("Invalid sequence data.");
+        }
+        return ParseIndex(pData, dataSizeInBytes);
+    }
+
+    SequenceReader::eStatus ParseIndex(const char* pData, const size_t dataSizeInBytes)
+    {
+        if (dataSizeInBytes < sizeof(SequenceFileHeader) + sizeof(SequenceFileFooter))
+        {
+            return Fail("The sequence data are too short.");
+        }
+        SequenceFileHeader header;
+        memcpy(&header, pData, sizeof(header));
+        if (0 != memcmp(header.mMagic, kSequenceHeaderMagic, sizeof(header.mMagic)))
+        {
+            return Fail("Not a sequence file.");
+        }
+        if (header.mMajorVersion != PSY_DRACO_SEQUENCE_MAJOR_VERSION)
+        {
+            return Fail("Unsupported sequence version.");
+        }
+        SequenceFileFooter footer;
+        memcpy(&footer, pData + dataSizeInBytes - sizeof(footer), sizeof(footer));
+        if (0 != memcmp(footer.mMagic, kSequenceFooterMagic, sizeof(footer.mMagic)))
+        {
+            return Fail("The sequence index is missing.");
+        }
+        const uint64_t index_size =
+            static_cast<uint64_t>(footer.mFramesCount) * sizeof(SequenceFrameEntry) +
+            static_cast<uint64_t>(footer.mKeyFramesCount) * sizeof(uint32_t);
+        // - the footer fields are not trusted, sizes are compared by subtraction
+        //   so corrupted values can't overflow
+        const uint64_t index_end = dataSizeInBytes - sizeof(footer);
+        if (footer.mIndexOffset < sizeof(SequenceFileHeader) ||
+            footer.mIndexOffset > index_end ||
+            index_size != index_end - footer.mIndexOffset)
+        {
+            return Fail("Invalid sequence index.");
+        }
+
+        // - the index is used in place, the entries are packed so they can be
+        //   read from any address
+        const auto* p_entries = reinterpret_cast<const SequenceFrameEntry*>(pData + footer.mIndexOffset);
+        const auto* p_key_frames = reinterpret_cast<const uint32_t*>(p_entries + footer.mFramesCount);
+        for (uint32_t i = 0; i < footer.mFramesCount; ++i)
+        {
+            const SequenceFrameEntry& r_entry = p_entries[i];
+            if (r_entry.mOffset < sizeof(SequenceFileHeader) ||
+                r_entry.mSize > footer.mIndexOffset ||
+                r_entry.mOffset > footer.mIndexOffset - r_entry.mSize ||
+                r_entry.mKeyFrameIndex > i ||
+                p_entries[r_entry.mKeyFrameIndex].mMeshType != MeshType::FULL_MESH)
+            {
+                return Fail("Invalid sequence frame entry.");
+            }
+        }
+        for (uint32_t i = 0; i < footer.mKeyFramesCount; ++i)
+        {
+            uint32_t key_frame;
+            memcpy(&key_frame, p_key_frames + i, sizeof(key_frame));
+            if (key_frame >= footer.mFramesCount ||
+                p_entries[key_frame].mMeshType != MeshType::FULL_MESH)
+            {
+                return Fail("Invalid sequence key frame.");
+            }
+        }
+
+        mpData = pData;
+        mDataSizeInBytes = dataSizeInBytes;
+        mpEntries = p_entries;
+        mpKeyFrames = p_key_frames;
+        mFramesCount = footer.mFramesCount;
+        mKeyFramesCount = footer.mKeyFramesCount;
+        return eStatus::SUCCEED;
+    }
+
+    size_t FindFrame(const int64_t timestamp) const
+    {
+        // - timestamps are non decreasing, find the first frame past the timestamp
+        size_t first = 0;
+        size_t count = mFramesCount;
+        while (count > 0)
+        {
+            const size_t step = count / 2;
+            if (mpEntries[first + step].mTimestamp <= timestamp)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+        return (first > 0) ? (first - 1) : mFramesCount;
+    }
+
+    void Prefetch(const size_t firstFrameIndex, const size_t framesCount) const
+    {
+        if (nullptr == mpMappedData || firstFrameIndex >= mFramesCount || 0 == framesCount)
+        {
+            return;
+        }
+        // - the count is clamped by subtraction, firstFrameIndex + framesCount can overflow
+        const size_t remaining_frames_count = mFramesCount - firstFrameIndex;
+        const size_t prefetched_frames_count =
+            (framesCount > remaining_frames_count) ? remaining_frames_count : framesCount;
+        const size_t last_frame_index = firstFrameIndex + prefetched_frames_count - 1;
+        const uint64_t begin = mpEntries[firstFrameIndex].mOffset;
+        const uint64_t end = mpEntries[last_frame_index].mOffset + mpEntries[last_frame_index].mSize;
+#if defined (_WIN32)
+        // - PrefetchVirtualMemory is not available on all supported versions of Windows
+        (void)begin;
+        (void)end;
+#else
+        const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        const uint64_t aligned_begin = begin - begin % page_size;
+        posix_madvise(static_cast<char*>(mpMappedData) + aligned_begin,
+                      static_cast<size_t>(end - aligned_begin),
+                      POSIX_MADV_WILLNEED);
+#endif
+    }
+
+    bool MapFile(const char* pFilePath)
+    {
+        if (nullptr == pFilePath)
+        {
+            return false;
+        }
+#if defined (_WIN32)
+        mFileHandle = CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (INVALID_HANDLE_VALUE == mFileHandle)
+        {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(mFileHandle, &file_size) || 0 == file_size.QuadPart)
+        {
+            return false;
+        }
+        mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (nullptr == mMappingHandle)
+        {
+            return false;
+        }
+        mpMappedData = MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (nullptr == mpMappedData)
+        {
+            return false;
+        }
+        mMappedSizeInBytes = static_cast<size_t>(file_size.QuadPart);
+#else
+        const int fd = open(pFilePath, O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat file_stat;
+        if (0 != fstat(fd, &file_stat) || 0 == file_stat.st_size)
+        {
+            close(fd);
+            return false;
+        }
+        void* p_mapped_data = mmap(nullptr, static_cast<size_t>(file_stat.st_size),
+                                   PROT_READ, MAP_PRIVATE, fd, 0);
+        // - the mapping stays valid after the descriptor is closed
+        close(fd);
+        if (MAP_FAILED == p_mapped_data)
+        {
+            return false;
+        }
+        mpMappedData = p_mapped_data;
+        mMappedSizeInBytes = static_cast<size_t>(file_stat.st_size);
+#endif
+        return true;
+    }
+
+    void Close()
+    {
+#if defined (_WIN32)
+        if (nullptr != mpMappedData)
+        {
+            UnmapViewOfFile(mpMappedData);
+        }
+        if (nullptr != mMappingHandle)
+        {
+            CloseHandle(mMappingHandle);
+            mMappingHandle = nullptr;
+        }
+        if (INVALID_HANDLE_VALUE != mFileHandle)
+        {
+            CloseHandle(mFileHandle);
+            mFileHandle = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (nullptr != mpMappedData)
+        {
+            munmap(mpMappedData, mMappedSizeInBytes);
+        }
+#endif
+        mpMappedData = nullptr;
+        mMappedSizeInBytes = 0;
+        mpData = nullptr;
+        mDataSizeInBytes = 0;
+        mpEntries = nullptr;
+        mpKeyFrames = nullptr;
+        mFramesCount = 0;
+        mKeyFramesCount = 0;
+    }
+
+    SequenceReader::eStatus Fail(const char* pErrorMessage)
+    {
+        mErrorMessage = pErrorMessage;
+        return eStatus::FAILED;
+    }
+
+    const char* mpData;
+    size_t mDataSizeInBytes;
+    const SequenceFrameEntry* mpEntries;
+    const uint32_t* mpKeyFrames;
+    size_t mFramesCount;
+    size_t mKeyFramesCount;
+    void* mpMappedData;
+    size_t mMappedSizeInBytes;
+#if defined (_WIN32)
+    HANDLE mFileHandle;
+    HANDLE mMappingHandle;
+#endif
+    std::string mErrorMessage;
+}; // SequenceReader::Impl
+
+SequenceReader::SequenceReader(const SequenceReader&) : mpImpl(nullptr) {}
+SequenceReader& SequenceReader::operator=(const SequenceReader&) { return *this; }
+
+SequenceReader::SequenceReader()
+{
+    mpImpl = new Impl();
+}
+
+SequenceReader::~SequenceReader()
+{
+    if (mpImpl)
+    {
+        delete mpImpl;
+    }
+    mpImpl = nullptr;
+}
+
+SequenceReader::eStatus SequenceReader::Open(const char* pFilePath)
+{
+    return mpImpl->OpenFile(pFilePath);
+}
+
+SequenceReader::eStatus SequenceReader::Open(const char* pData, const size_t dataSizeInBytes)
+{
+    return mpImpl->OpenMemory(pData, dataSizeInBytes);
+}
+
+void SequenceReader::Close()
+{
+    mpImpl->Close();
+}
+
+size_t SequenceReader::GetFramesCount() const
+{
+    return mpImpl->mFramesCount;
+}
+
+size_t SequenceReader::GetKeyFramesCount() const
+{
+    return mpImpl->mKeyFramesCount;
+}
+
+const SequenceFrameEntry* SequenceReader::GetFrameEntry(const size_t frameIndex) const
+{
+    if (frameIndex >= mpImpl->mFramesCount)
+    {
+        return nullptr;
+    }
+    return &mpImpl->mpEntries[frameIndex];
+}
+
+const char* SequenceReader::GetFrameData(const size_t frameIndex) const
+{
+    if (frameIndex >= mpImpl->mFramesCount)
+    {
+        return nullptr;
+    }
+    return mpImpl->mpData + mpImpl->mpEntries[frameIndex].mOffset;
+}
+
+size_t SequenceReader::GetKeyFrame(const size_t keyFrameIndex) const
+{
+    if (keyFrameIndex >= mpImpl->mKeyFramesCount)
+    {
+        return mpImpl->mFramesCount;
+    }
+    uint32_t key_frame;
+    memcpy(&key_frame, mpImpl->mpKeyFrames + keyFrameIndex, sizeof(key_frame));
+    return key_frame;
+}
+
+size_t SequenceReader::FindFrame(const int64_t timestamp) const
+{
+    return mpImpl->FindFrame(timestamp);
+}
+
+void SequenceReader::Prefetch(const size_t firstFrameIndex, const size_t framesCount) const
+{
+    mpImpl->Prefetch(firstFrameIndex, framesCount);
+}
+
+const char* SequenceReader::GetLastErrorMessage() const
+{
+    return mpImpl->mErrorMessage.c_str();
+}
+
+}; // namespace draco
+}; // namespace psy
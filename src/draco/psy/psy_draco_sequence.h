@@ -0,0 +1,188 @@
+/*
+* @file psy_draco_sequence.h
+*
+* Copyright (c) 2018 Personify Inc.
+*
+* @brief
+*   Container for sequences of compressed meshes
+*
+*   A sequence file stores the frames produced by MeshCompression one after
+*   another, followed by a seek index. FULL_MESH frames are key frames that can
+*   be decompressed on their own, INCREMENTAL_MESH frames need all the frames
+*   since the preceding key frame to be decompressed first (in order, with the
+*   same MeshDecompression instance).
+*
+*   layout (all values are little endian)
+*   - SequenceFileHeader
+*   - frame data, each frame is the unmodified output of MeshCompression
+*   - SequenceFrameEntry for each frame
+*   - uint32_t frame index of each key frame
+*   - SequenceFileFooter
+*/
+
+#ifndef PSY_DRACO_SEQUENCE_H
+#define PSY_DRACO_SEQUENCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psy_draco.h"
+
+namespace psy
+{
+namespace draco
+{
+
+/*
+ * change logs
+ * - 1.0: 2018/02/12 (*)
+ *     + key frame index, frame sizes and timestamps
+ */
+#define PSY_DRACO_SEQUENCE_MAJOR_VERSION 1
+#define PSY_DRACO_SEQUENCE_MINOR_VERSION 0
+
+#pragma pack(push, 1)
+
+struct PSY_DRACO_API SequenceFileHeader
+{
+    char mMagic[4]; /* "PSYS" */
+    uint8_t mMajorVersion;
+    uint8_t mMinorVersion;
+    uint16_t mReserved;
+};
+
+struct PSY_DRACO_API SequenceFrameEntry
+{
+    uint64_t mOffset; /* from the beginning of the file */
+    uint32_t mSize;
+    uint32_t mKeyFrameIndex; /* index of the frame decompression starts from */
+    int64_t mTimestamp; /* caller defined units, non decreasing */
+    MeshType mMeshType;
+    uint8_t mReserved[7];
+};
+
+struct PSY_DRACO_API SequenceFileFooter
+{
+    uint64_t mIndexOffset; /* offset of the first SequenceFrameEntry */
+    uint32_t mFramesCount;
+    uint32_t mKeyFramesCount;
+    char mMagic[4]; /* "PSYE" */
+    uint32_t mReserved;
+};
+
+#pragma pack(pop)
+
+/* Writes compressed frames into a sequence file or into memory */
+class PSY_DRACO_API SequenceWriter
+{
+public:
+    enum eStatus
+    {
+        SUCCEED = 0,
+        FAILED
+    };
+
+    SequenceWriter();
+    ~SequenceWriter();
+
+    /*
+    * Starts a new sequence
+    * - pFilePath (output file)
+    *   + nullptr: the sequence is stored in memory, see GetData()
+    *   + ?: frames are written to the file as they are added
+    */
+    eStatus Open(const char* pFilePath = nullptr);
+
+    /*
+    * Appends a frame compressed by MeshCompression
+    * - the first frame must be a FULL_MESH
+    * - timestamps must not decrease
+    */
+    eStatus AddFrame(const char* pCompressedData,
+                     const size_t compressedDataSizeInBytes,
+                     const int64_t timestamp);
+
+    /* Writes the seek index and closes the output, no frames can be added afterwards */
+    eStatus Close();
+
+    /* The sequence stored in memory, valid after Close() */
+    const char* GetData() const;
+    size_t GetDataSizeInBytes() const;
+
+    size_t GetFramesCount() const;
+
+    const char* GetLastErrorMessage() const;
+
+private:
+    /* SequenceWriter is non-copyable */
+    SequenceWriter(const SequenceWriter&);
+    SequenceWriter& operator=(const SequenceWriter&);
+
+    class Impl;
+    Impl* mpImpl;
+}; // SequenceWriter
+
+/*
+* Provides random access to the frames of a sequence. Files are memory mapped,
+* frame data are never copied and only the index is parsed when the sequence
+* is opened.
+*/
+class PSY_DRACO_API SequenceReader
+{
+public:
+    enum eStatus
+    {
+        SUCCEED = 0,
+        FAILED
+    };
+
+    SequenceReader();
+    ~SequenceReader();
+
+    /* Maps the sequence file into memory */
+    eStatus Open(const char* pFilePath);
+
+    /* Uses caller owned memory, the data must outlive the reader */
+    eStatus Open(const char* pData, const size_t dataSizeInBytes);
+
+    void Close();
+
+    size_t GetFramesCount() const;
+    size_t GetKeyFramesCount() const;
+
+    /* Returns nullptr for invalid frame indices */
+    const SequenceFrameEntry* GetFrameEntry(const size_t frameIndex) const;
+
+    /* Returns the data that can be passed to MeshDecompression::Run() */
+    const char* GetFrameData(const size_t frameIndex) const;
+
+    /* Returns the frame index of the i-th key frame */
+    size_t GetKeyFrame(const size_t keyFrameIndex) const;
+
+    /*
+    * Returns the index of the last frame with timestamp <= timestamp or
+    * GetFramesCount() when there is no such frame
+    */
+    size_t FindFrame(const int64_t timestamp) const;
+
+    /*
+    * Hints that frames [firstFrameIndex, firstFrameIndex + framesCount) are
+    * going to be read soon, the data are paged in asynchronously when
+    * supported by the platform
+    */
+    void Prefetch(const size_t firstFrameIndex, const size_t framesCount) const;
+
+    const char* GetLastErrorMessage() const;
+
+private:
+    /* SequenceReader is non-copyable */
+    SequenceReader(const SequenceReader&);
+    SequenceReader& operator=(const SequenceReader&);
+
+    class Impl;
+    Impl* mpImpl;
+}; // SequenceReader
+
+}; // namespace draco
+}; // namespace psy
+
+#endif // PSY_DRACO_SEQUENCE_H
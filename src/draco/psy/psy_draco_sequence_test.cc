@@ -0,0 +1,264 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/psy/psy_draco_sequence.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+using psy::draco::SequenceFileFooter;
+using psy::draco::SequenceFrameEntry;
+using psy::draco::SequenceReader;
+using psy::draco::SequenceWriter;
+
+class PsyDracoSequenceTest : public ::testing::Test {
+ protected:
+  static constexpr int kNumFrames = 10;
+  static constexpr int kKeyFrameInterval = 4;
+
+  PsyDracoSequenceTest() {
+    // Frames start with the psy header followed by arbitrary data. Every
+    // kKeyFrameInterval-th frame is a full mesh.
+    for (int i = 0; i < kNumFrames; ++i) {
+      psy::draco::Header header;
+      header.mMajorVersion = PSY_DRACO_API_MAJOR_VERSION;
+      header.mMinorVersion = PSY_DRACO_API_MINOR_VERSION;
+      header.mMeshType = (i % kKeyFrameInterval == 0)
+                             ? psy::draco::FULL_MESH
+                             : psy::draco::INCREMENTAL_MESH;
+      std::vector<char> frame(sizeof(header) + 16 + 7 * i);
+      memcpy(frame.data(), &header, sizeof(header));
+      for (size_t j = sizeof(header); j < frame.size(); ++j) {
+        frame[j] = static_cast<char>(i * 31 + j);
+      }
+      frames_.push_back(frame);
+    }
+  }
+
+  // Writes all frames with timestamps 10 * frame index into |writer|.
+  void WriteFrames(SequenceWriter *writer) {
+    for (int i = 0; i < kNumFrames; ++i) {
+      ASSERT_EQ(writer->AddFrame(frames_[i].data(), frames_[i].size(), 10 * i),
+                SequenceWriter::SUCCEED)
+          << writer->GetLastErrorMessage();
+    }
+    ASSERT_EQ(writer->Close(), SequenceWriter::SUCCEED);
+  }
+
+  // Returns an in-memory sequence with all frames.
+  std::vector<char> CreateSequence() {
+    SequenceWriter writer;
+    EXPECT_EQ(writer.Open(), SequenceWriter::SUCCEED);
+    WriteFrames(&writer);
+    return std::vector<char>(writer.GetData(),
+                             writer.GetData() + writer.GetDataSizeInBytes());
+  }
+
+  // Verifies that all frames can be read back from |reader| by their index.
+  void VerifyFrames(const SequenceReader &reader) {
+    ASSERT_EQ(reader.GetFramesCount(), static_cast<size_t>(kNumFrames));
+    ASSERT_EQ(reader.GetKeyFramesCount(), static_cast<size_t>(3));
+    for (int i = 0; i < kNumFrames; ++i) {
+      const SequenceFrameEntry *const entry = reader.GetFrameEntry(i);
+      ASSERT_NE(entry, nullptr);
+      // The entries are packed, so the fields are copied before comparison.
+      ASSERT_EQ(static_cast<size_t>(entry->mSize), frames_[i].size());
+      ASSERT_EQ(static_cast<int64_t>(entry->mTimestamp), 10 * i);
+      ASSERT_EQ(static_cast<int>(entry->mKeyFrameIndex),
+                i - i % kKeyFrameInterval);
+      ASSERT_EQ(memcmp(reader.GetFrameData(i), frames_[i].data(),
+                       frames_[i].size()),
+                0);
+    }
+    ASSERT_EQ(reader.GetFrameEntry(kNumFrames), nullptr);
+    ASSERT_EQ(reader.GetFrameData(kNumFrames), nullptr);
+    for (size_t i = 0; i < reader.GetKeyFramesCount(); ++i) {
+      ASSERT_EQ(reader.GetKeyFrame(i), i * kKeyFrameInterval);
+    }
+    ASSERT_EQ(reader.FindFrame(-1), reader.GetFramesCount());
+    ASSERT_EQ(reader.FindFrame(0), 0u);
+    ASSERT_EQ(reader.FindFrame(25), 2u);
+    ASSERT_EQ(reader.FindFrame(1000), static_cast<size_t>(kNumFrames - 1));
+  }
+
+  // Returns a copy of the footer of |sequence|.
+  static SequenceFileFooter GetFooter(const std::vector<char> &sequence) {
+    SequenceFileFooter footer;
+    memcpy(&footer, sequence.data() + sequence.size() - sizeof(footer),
+           sizeof(footer));
+    return footer;
+  }
+
+  static void SetFooter(const SequenceFileFooter &footer,
+                        std::vector<char> *sequence) {
+    memcpy(sequence->data() + sequence->size() - sizeof(footer), &footer,
+           sizeof(footer));
+  }
+
+  std::vector<std::vector<char>> frames_;
+};
+
+TEST_F(PsyDracoSequenceTest, TestMemoryRoundTrip) {
+  const std::vector<char> sequence = CreateSequence();
+  SequenceReader reader;
+  ASSERT_EQ(reader.Open(sequence.data(), sequence.size()),
+            SequenceReader::SUCCEED)
+      << reader.GetLastErrorMessage();
+  VerifyFrames(reader);
+}
+
+TEST_F(PsyDracoSequenceTest, TestFileRoundTrip) {
+  const std::string path = ::testing::TempDir() + "psy_draco_sequence.psys";
+  {
+    SequenceWriter writer;
+    ASSERT_EQ(writer.Open(path.c_str()), SequenceWriter::SUCCEED);
+    WriteFrames(&writer);
+  }
+  {
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(path.c_str()), SequenceReader::SUCCEED)
+        << reader.GetLastErrorMessage();
+    VerifyFrames(reader);
+    reader.Prefetch(2, 5);
+    // Counts past the end of the sequence are clamped without overflowing.
+    reader.Prefetch(2, std::numeric_limits<size_t>::max());
+  }
+  remove(path.c_str());
+}
+
+TEST_F(PsyDracoSequenceTest, TestInvalidFrames) {
+  SequenceWriter writer;
+  ASSERT_EQ(writer.Open(), SequenceWriter::SUCCEED);
+  // The first frame must be a full mesh.
+  ASSERT_EQ(writer.AddFrame(frames_[1].data(), frames_[1].size(), 0),
+            SequenceWriter::FAILED);
+  ASSERT_EQ(writer.AddFrame(frames_[0].data(), frames_[0].size(), 10),
+            SequenceWriter::SUCCEED);
+  // Timestamps must not decrease.
+  ASSERT_EQ(writer.AddFrame(frames_[1].data(), frames_[1].size(), 5),
+            SequenceWriter::FAILED);
+  ASSERT_EQ(writer.AddFrame(frames_[1].data(), 1, 20), SequenceWriter::FAILED);
+  ASSERT_EQ(writer.GetFramesCount(), 1u);
+}
+
+TEST_F(PsyDracoSequenceTest, TestTruncatedSequence) {
+  const std::vector<char> sequence = CreateSequence();
+  for (size_t size = 0; size < sequence.size(); ++size) {
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(sequence.data(), size), SequenceReader::FAILED)
+        << "Truncated sequence of size " << size << " was accepted.";
+    ASSERT_EQ(reader.GetFramesCount(), 0u);
+  }
+}
+
+TEST_F(PsyDracoSequenceTest, TestCorruptedFooter) {
+  const std::vector<char> sequence = CreateSequence();
+  const SequenceFileFooter footer = GetFooter(sequence);
+
+  // Index offsets that would overflow when the index size is added.
+  const uint64_t invalid_offsets[] = {
+      std::numeric_limits<uint64_t>::max(),
+      std::numeric_limits<uint64_t>::max() - sequence.size() + 1,
+      footer.mIndexOffset + 1, footer.mIndexOffset - 1, 0};
+  for (const uint64_t offset : invalid_offsets) {
+    std::vector<char> corrupted = sequence;
+    SequenceFileFooter corrupted_footer = footer;
+    corrupted_footer.mIndexOffset = offset;
+    SetFooter(corrupted_footer, &corrupted);
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+              SequenceReader::FAILED)
+        << "Index offset " << offset << " was accepted.";
+  }
+
+  // Frame counts that don't match the size of the index.
+  const uint32_t invalid_counts[] = {std::numeric_limits<uint32_t>::max(),
+                                     footer.mFramesCount + 1,
+                                     footer.mFramesCount - 1};
+  for (const uint32_t count : invalid_counts) {
+    std::vector<char> corrupted = sequence;
+    SequenceFileFooter corrupted_footer = footer;
+    corrupted_footer.mFramesCount = count;
+    SetFooter(corrupted_footer, &corrupted);
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+              SequenceReader::FAILED)
+        << "Frames count " << count << " was accepted.";
+  }
+}
+
+TEST_F(PsyDracoSequenceTest, TestCorruptedFrameEntry) {
+  const std::vector<char> sequence = CreateSequence();
+  const SequenceFileFooter footer = GetFooter(sequence);
+  const size_t last_entry_offset =
+      footer.mIndexOffset + (kNumFrames - 1) * sizeof(SequenceFrameEntry);
+  SequenceFrameEntry entry;
+  memcpy(&entry, sequence.data() + last_entry_offset, sizeof(entry));
+
+  // Frames that would end past the index, including offsets for which the
+  // end of the frame overflows.
+  const uint64_t invalid_offsets[] = {
+      std::numeric_limits<uint64_t>::max(),
+      std::numeric_limits<uint64_t>::max() - entry.mSize + 1,
+      footer.mIndexOffset - entry.mSize + 1, 0};
+  for (const uint64_t offset : invalid_offsets) {
+    std::vector<char> corrupted = sequence;
+    SequenceFrameEntry corrupted_entry = entry;
+    corrupted_entry.mOffset = offset;
+    memcpy(corrupted.data() + last_entry_offset, &corrupted_entry,
+           sizeof(corrupted_entry));
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+              SequenceReader::FAILED)
+        << "Frame offset " << offset << " was accepted.";
+  }
+
+  const uint32_t invalid_sizes[] = {std::numeric_limits<uint32_t>::max(),
+                                    entry.mSize + 1};
+  for (const uint32_t size : invalid_sizes) {
+    std::vector<char> corrupted = sequence;
+    SequenceFrameEntry corrupted_entry = entry;
+    corrupted_entry.mSize = size;
+    memcpy(corrupted.data() + last_entry_offset, &corrupted_entry,
+           sizeof(corrupted_entry));
+    SequenceReader reader;
+    ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+              SequenceReader::FAILED)
+        << "Frame size " << size << " was accepted.";
+  }
+
+  // Key frames must precede the frame and they must be full meshes.
+  std::vector<char> corrupted = sequence;
+  SequenceFrameEntry corrupted_entry = entry;
+  corrupted_entry.mKeyFrameIndex = kNumFrames;
+  memcpy(corrupted.data() + last_entry_offset, &corrupted_entry,
+         sizeof(corrupted_entry));
+  SequenceReader reader;
+  ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+            SequenceReader::FAILED);
+  corrupted_entry.mKeyFrameIndex = kNumFrames - 3;
+  memcpy(corrupted.data() + last_entry_offset, &corrupted_entry,
+         sizeof(corrupted_entry));
+  ASSERT_EQ(reader.Open(corrupted.data(), corrupted.size()),
+            SequenceReader::FAILED);
+}
+
+}  // namespace